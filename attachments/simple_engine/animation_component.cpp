@@ -18,23 +18,52 @@
 #include "entity.h"
 #include "transform_component.h"
 
-#include <algorithm>
-#include <iostream>
+#include <cmath>
+
+AnimationComponent::~AnimationComponent()
+{
+	if (registered)
+	{
+		AnimationSystem::GetInstance().Unregister(this);
+	}
+}
+
+void AnimationComponent::Initialize()
+{
+	if (!registered)
+	{
+		AnimationSystem::GetInstance().Register(this);
+		registered = true;
+	}
+}
 
 void AnimationComponent::Update(std::chrono::milliseconds deltaTime)
 {
+	if (!registered)
+	{
+		Advance(deltaTime);
+	}
+}
+
+std::pair<uint32_t, uint32_t> AnimationComponent::Advance(std::chrono::milliseconds deltaTime)
+{
+	// Registered components are advanced by the system, not by Entity::Update, so apply its active checks here
+	if (!IsActive() || (owner && !owner->IsActive()))
+	{
+		return {0u, 0u};
+	}
 	if (!playing || currentAnimationIndex < 0 ||
-	    currentAnimationIndex >= static_cast<int>(animations.size()))
+	    currentAnimationIndex >= static_cast<int>(compiledAnimations.size()))
 	{
-		return;
+		return {0u, 0u};
 	}
 
-	const Animation &anim     = animations[currentAnimationIndex];
-	float            duration = anim.GetDuration();
+	const CompiledAnimation &clip     = compiledAnimations[currentAnimationIndex];
+	float                    duration = clip.GetDuration();
 
 	if (duration <= 0.0f)
 	{
-		return;
+		return {0u, 0u};
 	}
 
 	// Advance time
@@ -66,233 +95,79 @@ void AnimationComponent::Update(std::chrono::milliseconds deltaTime)
 				if (transform)
 				{
 					basePositions[nodeIndex] = transform->GetPosition();
-					// Convert Euler angles to quaternion for proper rotation composition
-					glm::vec3 eulerAngles    = transform->GetRotation();
-					baseRotations[nodeIndex] = glm::quat(eulerAngles);
+					baseRotations[nodeIndex] = transform->GetRotationQuaternion();
 					baseScales[nodeIndex]    = transform->GetScale();
 				}
 			}
 		}
 	}
 
-	// Apply animation to all channels
-	for (const auto &channel : anim.channels)
+	if (boundAnimationIndex != currentAnimationIndex)
 	{
-		if (channel.samplerIndex < 0 ||
-		    channel.samplerIndex >= static_cast<int>(anim.samplers.size()))
-		{
-			continue;
-		}
-
-		const AnimationSampler &sampler = anim.samplers[channel.samplerIndex];
+		BindTracks();
+	}
 
-		// Find the target entity for this node
-		auto entityIt = nodeToEntity.find(channel.targetNode);
-		if (entityIt == nodeToEntity.end() || !entityIt->second)
-		{
-			continue;
-		}
+	clip.Sample(currentTime, cursors, pose);
 
-		Entity *targetEntity = entityIt->second;
-		auto   *transform    = targetEntity->GetComponent<TransformComponent>();
-		if (!transform)
+	// Apply the sampled values; animation transforms are applied RELATIVE to the base transform
+	const auto &tracks = clip.GetTracks();
+	for (size_t i = 0; i < tracks.size(); ++i)
+	{
+		const TrackBinding &binding = bindings[i];
+		if (!binding.target)
 		{
 			continue;
 		}
-
-		// Get base transform for this node (defaults to identity if not found)
-		glm::vec3 basePos   = basePositions.count(channel.targetNode) ?
-		                          basePositions[channel.targetNode] :
-		                          glm::vec3(0.0f);
-		glm::quat baseRot   = baseRotations.count(channel.targetNode) ?
-		                          baseRotations[channel.targetNode] :
-		                          glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-		glm::vec3 baseScale = baseScales.count(channel.targetNode) ?
-		                          baseScales[channel.targetNode] :
-		                          glm::vec3(1.0f);
-
-		// Sample and apply the appropriate transform property
-		// Animation transforms are applied RELATIVE to the base transform
-		switch (channel.path)
+		switch (tracks[i].path)
 		{
 			case AnimationPath::Translation:
-			{
-				glm::vec3 animTranslation = SampleVec3(sampler, currentTime);
-				// Apply animation translation relative to base position
-				transform->SetPosition(basePos + animTranslation);
+				binding.target->SetPosition(binding.basePosition + glm::vec3(pose.x[i], pose.y[i], pose.z[i]));
 				break;
-			}
 			case AnimationPath::Rotation:
-			{
-				glm::quat animRotation = SampleQuat(sampler, currentTime);
-				// Compose rotations using quaternion multiplication (order matters!)
 				// Final rotation = base rotation * animation delta rotation
-				glm::quat finalRotation = baseRot * animRotation;
-				// Convert to Euler angles for the transform component
-				transform->SetRotation(glm::eulerAngles(finalRotation));
+				binding.target->SetRotationQuaternion(binding.baseRotation * glm::quat(pose.w[i], pose.x[i], pose.y[i], pose.z[i]));
 				break;
-			}
 			case AnimationPath::Scale:
-			{
-				glm::vec3 animScale = SampleVec3(sampler, currentTime);
 				// Multiply scales (animation scale is a factor, not an offset)
-				transform->SetScale(baseScale * animScale);
+				binding.target->SetScale(binding.baseScale * glm::vec3(pose.x[i], pose.y[i], pose.z[i]));
 				break;
-			}
 			case AnimationPath::Weights:
 				// Morph target weights not yet implemented
 				break;
 		}
 	}
+	return {static_cast<uint32_t>(tracks.size()), cursors.seeks};
 }
 
-void AnimationComponent::FindKeyframes(const std::vector<float> &times, float time,
-                                       size_t &outIndex0, size_t &outIndex1, float &outT) const
-{
-	if (times.empty())
-	{
-		outIndex0 = 0;
-		outIndex1 = 0;
-		outT      = 0.0f;
-		return;
-	}
-
-	if (times.size() == 1 || time <= times.front())
-	{
-		outIndex0 = 0;
-		outIndex1 = 0;
-		outT      = 0.0f;
-		return;
-	}
-
-	if (time >= times.back())
-	{
-		outIndex0 = times.size() - 1;
-		outIndex1 = times.size() - 1;
-		outT      = 0.0f;
-		return;
-	}
-
-	// Binary search for the keyframe
-	auto it = std::lower_bound(times.begin(), times.end(), time);
-	if (it == times.begin())
-	{
-		outIndex0 = 0;
-		outIndex1 = 0;
-		outT      = 0.0f;
-		return;
-	}
-
-	outIndex1 = static_cast<size_t>(std::distance(times.begin(), it));
-	outIndex0 = outIndex1 - 1;
-
-	float t0 = times[outIndex0];
-	float t1 = times[outIndex1];
-	float dt = t1 - t0;
-
-	if (dt > 0.0f)
-	{
-		outT = (time - t0) / dt;
-	}
-	else
-	{
-		outT = 0.0f;
-	}
-}
-
-glm::vec3 AnimationComponent::SampleVec3(const AnimationSampler &sampler, float time) const
-{
-	if (sampler.inputTimes.empty() || sampler.outputValues.size() < 3)
-	{
-		return glm::vec3(0.0f);
-	}
-
-	size_t index0, index1;
-	float  t;
-	FindKeyframes(sampler.inputTimes, time, index0, index1, t);
-
-	// Get values at keyframes (3 floats per vec3)
-	size_t offset0 = index0 * 3;
-	size_t offset1 = index1 * 3;
-
-	if (offset0 + 2 >= sampler.outputValues.size())
-	{
-		offset0 = sampler.outputValues.size() - 3;
-	}
-	if (offset1 + 2 >= sampler.outputValues.size())
-	{
-		offset1 = sampler.outputValues.size() - 3;
-	}
-
-	glm::vec3 v0(sampler.outputValues[offset0],
-	             sampler.outputValues[offset0 + 1],
-	             sampler.outputValues[offset0 + 2]);
-	glm::vec3 v1(sampler.outputValues[offset1],
-	             sampler.outputValues[offset1 + 1],
-	             sampler.outputValues[offset1 + 2]);
-
-	// Interpolate based on interpolation type
-	switch (sampler.interpolation)
-	{
-		case AnimationInterpolation::Step:
-			return v0;
-		case AnimationInterpolation::Linear:
-			return glm::mix(v0, v1, t);
-		case AnimationInterpolation::CubicSpline:
-			// For cubic spline, the output has in-tangent, value, out-tangent
-			// Simplified: just use linear interpolation for now
-			// Full cubic spline would require reading tangents from output data
-			return glm::mix(v0, v1, t);
-		default:
-			return glm::mix(v0, v1, t);
-	}
-}
-
-glm::quat AnimationComponent::SampleQuat(const AnimationSampler &sampler, float time) const
+void AnimationComponent::BindTracks()
 {
-	if (sampler.inputTimes.empty() || sampler.outputValues.size() < 4)
-	{
-		return glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
-	}
-
-	size_t index0, index1;
-	float  t;
-	FindKeyframes(sampler.inputTimes, time, index0, index1, t);
-
-	// Get values at keyframes (4 floats per quaternion: x, y, z, w)
-	size_t offset0 = index0 * 4;
-	size_t offset1 = index1 * 4;
-
-	if (offset0 + 3 >= sampler.outputValues.size())
-	{
-		offset0 = sampler.outputValues.size() - 4;
-	}
-	if (offset1 + 3 >= sampler.outputValues.size())
+	const auto &tracks = compiledAnimations[currentAnimationIndex].GetTracks();
+	bindings.assign(tracks.size(), TrackBinding{});
+	for (size_t i = 0; i < tracks.size(); ++i)
 	{
-		offset1 = sampler.outputValues.size() - 4;
-	}
-
-	// glTF quaternions are stored as (x, y, z, w)
-	glm::quat q0(sampler.outputValues[offset0 + 3],         // w
-	             sampler.outputValues[offset0],             // x
-	             sampler.outputValues[offset0 + 1],         // y
-	             sampler.outputValues[offset0 + 2]);        // z
-	glm::quat q1(sampler.outputValues[offset1 + 3],         // w
-	             sampler.outputValues[offset1],             // x
-	             sampler.outputValues[offset1 + 1],         // y
-	             sampler.outputValues[offset1 + 2]);        // z
+		const int node     = tracks[i].targetNode;
+		auto      entityIt = nodeToEntity.find(node);
+		if (entityIt == nodeToEntity.end() || !entityIt->second)
+		{
+			continue;
+		}
 
-	// Interpolate based on interpolation type
-	switch (sampler.interpolation)
-	{
-		case AnimationInterpolation::Step:
-			return q0;
-		case AnimationInterpolation::Linear:
-			return glm::slerp(q0, q1, t);
-		case AnimationInterpolation::CubicSpline:
-			// Simplified: use slerp for now
-			return glm::slerp(q0, q1, t);
-		default:
-			return glm::slerp(q0, q1, t);
+		TrackBinding &binding = bindings[i];
+		binding.target        = entityIt->second->GetComponent<TransformComponent>();
+		// Base transform for this node (defaults to identity if not found)
+		if (auto it = basePositions.find(node); it != basePositions.end())
+		{
+			binding.basePosition = it->second;
+		}
+		if (auto it = baseRotations.find(node); it != baseRotations.end())
+		{
+			binding.baseRotation = it->second;
+		}
+		if (auto it = baseScales.find(node); it != baseScales.end())
+		{
+			binding.baseScale = it->second;
+		}
 	}
+	cursors.Reset();
+	boundAnimationIndex = currentAnimationIndex;
 }
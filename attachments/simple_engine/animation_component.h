@@ -20,8 +20,10 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "animation_system.h"
 #include "component.h"
 #include "model_loader.h"
 
@@ -33,6 +35,11 @@ class TransformComponent;
  *
  * This component stores animation clips and plays them back by interpolating
  * keyframes and applying transforms to target nodes (entities).
+ *
+ * Clips are compiled to SoA keyframes when set, and each track keeps a cursor
+ * so forward playback does not search the key times. Once added to an entity
+ * the component is driven by AnimationSystem, which updates all components in
+ * parallel; Update() only does the work for components that never registered.
  */
 class AnimationComponent final : public Component
 {
@@ -45,6 +52,16 @@ class AnimationComponent final : public Component
 	    Component(componentName)
 	{}
 
+	/**
+	 * @brief Destructor; unregisters from the animation system.
+	 */
+	~AnimationComponent() override;
+
+	/**
+	 * @brief Register with the shared AnimationSystem.
+	 */
+	void Initialize() override;
+
 	/**
 	 * @brief Set the animations for this component.
 	 * @param anims Vector of Animation clips to use.
@@ -52,6 +69,13 @@ class AnimationComponent final : public Component
 	void SetAnimations(const std::vector<Animation> &anims)
 	{
 		animations = anims;
+		compiledAnimations.clear();
+		compiledAnimations.reserve(animations.size());
+		for (const Animation &anim : animations)
+		{
+			compiledAnimations.push_back(CompiledAnimation::Compile(anim));
+		}
+		boundAnimationIndex = -1;
 		if (!animations.empty())
 		{
 			currentAnimationIndex = 0;
@@ -74,7 +98,8 @@ class AnimationComponent final : public Component
 	 */
 	void SetNodeToEntityMap(const std::unordered_map<int, Entity *> &mapping)
 	{
-		nodeToEntity = mapping;
+		nodeToEntity        = mapping;
+		boundAnimationIndex = -1;
 	}
 
 	/**
@@ -185,13 +210,26 @@ class AnimationComponent final : public Component
 
 	/**
 	 * @brief Update the animation, advancing time and applying transforms.
+	 * Does nothing once the component is registered with AnimationSystem, which calls Advance instead.
 	 * @param deltaTime The time elapsed since the last update.
 	 */
 	void Update(std::chrono::milliseconds deltaTime) override;
 
   private:
+	friend class AnimationSystem;
+
+	// Target and base transform of one compiled track; the animated value is applied relative to the base
+	struct TrackBinding
+	{
+		TransformComponent *target       = nullptr;
+		glm::vec3           basePosition = glm::vec3(0.0f);
+		glm::quat           baseRotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+		glm::vec3           baseScale    = glm::vec3(1.0f);
+	};
+
 	std::vector<Animation>            animations;
-	std::unordered_map<int, Entity *> nodeToEntity;        // Maps glTF node index to Entity
+	std::vector<CompiledAnimation>    compiledAnimations;        // parallel to animations
+	std::unordered_map<int, Entity *> nodeToEntity;              // Maps glTF node index to Entity
 
 	// Store base transforms for each animated node (captured when animation starts)
 	// Animation transforms are applied relative to these base transforms
@@ -199,36 +237,28 @@ class AnimationComponent final : public Component
 	std::unordered_map<int, glm::quat> baseRotations;        // Quaternions for proper rotation composition
 	std::unordered_map<int, glm::vec3> baseScales;
 
+	// Per-track state for the clip bound in boundAnimationIndex
+	std::vector<TrackBinding> bindings;
+	int                       boundAnimationIndex = -1;
+	AnimationCursors          cursors;
+	AnimationPose             pose;
+
 	int   currentAnimationIndex = -1;
 	float currentTime           = 0.0f;
 	float playbackSpeed         = 1.0f;
 	bool  playing               = false;
 	bool  looping               = true;
+	bool  registered            = false;
 
 	/**
-	 * @brief Sample a vec3 value from a sampler at a given time.
-	 * @param sampler The animation sampler.
-	 * @param time The time to sample at.
-	 * @return The interpolated vec3 value.
-	 */
-	[[nodiscard]] glm::vec3 SampleVec3(const AnimationSampler &sampler, float time) const;
-
-	/**
-	 * @brief Sample a quaternion value from a sampler at a given time.
-	 * @param sampler The animation sampler.
-	 * @param time The time to sample at.
-	 * @return The interpolated quaternion value.
+	 * @brief Advance time, sample the current clip and apply it to the target transforms.
+	 * @param deltaTime The time elapsed since the last update.
+	 * @return The number of tracks sampled and how many of them needed a binary search.
 	 */
-	[[nodiscard]] glm::quat SampleQuat(const AnimationSampler &sampler, float time) const;
+	std::pair<uint32_t, uint32_t> Advance(std::chrono::milliseconds deltaTime);
 
 	/**
-	 * @brief Find the keyframe indices for interpolation.
-	 * @param times The input time array.
-	 * @param time The current time.
-	 * @param outIndex0 Output: the lower keyframe index.
-	 * @param outIndex1 Output: the upper keyframe index.
-	 * @param outT Output: the interpolation factor (0-1).
+	 * @brief Resolve target transforms and base values for every track of the current clip.
 	 */
-	void FindKeyframes(const std::vector<float> &times, float time,
-	                   size_t &outIndex0, size_t &outIndex1, float &outT) const;
+	void BindTracks();
 };
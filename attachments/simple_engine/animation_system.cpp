@@ -0,0 +1,643 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "animation_system.h"
+
+#include "animation_component.h"
+#include "entity.h"
+#include "profiler.h"
+#include "thread_pool.h"
+#include "transform_component.h"
+
+#include <cmath>
+#include <future>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define ANIMATION_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+namespace
+{
+using Kind = CompiledAnimation::Kind;
+
+// A forward step that crosses more keys than this is treated as a seek
+constexpr uint32_t MaxCursorSteps = 8;
+
+double MsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Lane helpers so the interpolation kernels below are written once for scalars and SIMD vectors.
+template <typename V>
+V Gather(const float *base, const uint32_t *index);
+template <typename V>
+V Load(const float *p);
+
+template <>
+float Gather<float>(const float *base, const uint32_t *index)
+{
+	return base[*index];
+}
+template <>
+float Load<float>(const float *p)
+{
+	return *p;
+}
+inline void Store(float *p, float v)
+{
+	*p = v;
+}
+inline float Sqrt(float v)
+{
+	return std::sqrt(v);
+}
+inline float Abs(float v)
+{
+	return std::fabs(v);
+}
+inline float SignOne(float v)
+{
+	return v < 0.0f ? -1.0f : 1.0f;
+}
+
+#if defined(ANIMATION_SSE2)
+struct Float4
+{
+	__m128 v;
+	Float4() = default;
+	Float4(__m128 x) :
+	    v(x)
+	{}
+	Float4(float x) :
+	    v(_mm_set1_ps(x))
+	{}
+};
+inline Float4 operator+(Float4 a, Float4 b)
+{
+	return _mm_add_ps(a.v, b.v);
+}
+inline Float4 operator-(Float4 a, Float4 b)
+{
+	return _mm_sub_ps(a.v, b.v);
+}
+inline Float4 operator*(Float4 a, Float4 b)
+{
+	return _mm_mul_ps(a.v, b.v);
+}
+inline Float4 operator/(Float4 a, Float4 b)
+{
+	return _mm_div_ps(a.v, b.v);
+}
+template <>
+Float4 Gather<Float4>(const float *base, const uint32_t *index)
+{
+	return _mm_setr_ps(base[index[0]], base[index[1]], base[index[2]], base[index[3]]);
+}
+template <>
+Float4 Load<Float4>(const float *p)
+{
+	return _mm_loadu_ps(p);
+}
+inline void Store(float *p, Float4 v)
+{
+	_mm_storeu_ps(p, v.v);
+}
+inline Float4 Sqrt(Float4 v)
+{
+	return _mm_sqrt_ps(v.v);
+}
+inline Float4 Abs(Float4 v)
+{
+	return _mm_andnot_ps(_mm_set1_ps(-0.0f), v.v);
+}
+inline Float4 SignOne(Float4 v)
+{
+	return _mm_or_ps(_mm_set1_ps(1.0f), _mm_and_ps(_mm_set1_ps(-0.0f), v.v));
+}
+#endif
+
+struct KeyArrays
+{
+	const float *value[4];
+	const float *in[4];
+	const float *out[4];
+};
+
+struct SegmentView
+{
+	const uint32_t *k0;
+	const uint32_t *k1;
+	const float    *u;
+	const float    *dt;
+};
+
+// Sample the tracks [i, i + lane count) that all share one kind.
+template <typename V>
+void SampleLanes(Kind kind, const KeyArrays &keys, const SegmentView &seg, float *const out[4], uint32_t i)
+{
+	const bool     isQuat = kind >= Kind::QuatStep;
+	const uint32_t width  = isQuat ? 4u : 3u;
+	V              r[4]   = {V(0.0f), V(0.0f), V(0.0f), V(0.0f)};
+
+	switch (kind)
+	{
+		case Kind::Vec3Step:
+		case Kind::QuatStep:
+			for (uint32_t c = 0; c < width; ++c)
+			{
+				r[c] = Gather<V>(keys.value[c], seg.k0 + i);
+			}
+			break;
+		case Kind::Vec3Linear:
+		{
+			const V u = Load<V>(seg.u + i);
+			for (uint32_t c = 0; c < 3; ++c)
+			{
+				const V a = Gather<V>(keys.value[c], seg.k0 + i);
+				const V b = Gather<V>(keys.value[c], seg.k1 + i);
+				r[c]      = a + (b - a) * u;
+			}
+			break;
+		}
+		case Kind::QuatLinear:
+		{
+			// nlerp with the interpolation parameter corrected by a fitted polynomial so the
+			// result tracks slerp closely (see "Approximating slerp", A. Kapoulkine, 2015).
+			V a[4], b[4];
+			V d(0.0f);
+			for (uint32_t c = 0; c < 4; ++c)
+			{
+				a[c] = Gather<V>(keys.value[c], seg.k0 + i);
+				b[c] = Gather<V>(keys.value[c], seg.k1 + i);
+				d    = d + a[c] * b[c];
+			}
+			const V sign = SignOne(d);
+			d            = Abs(d);
+			const V u    = Load<V>(seg.u + i);
+			const V A    = V(1.0904f) + d * (V(-3.2452f) + d * (V(3.55645f) - d * V(1.43519f)));
+			const V B    = V(0.848013f) + d * (V(-1.06021f) + d * V(0.215638f));
+			const V h    = u - V(0.5f);
+			const V k    = A * h * h + B;
+			const V t    = u + u * h * (u - V(1.0f)) * k;
+			const V wa   = V(1.0f) - t;
+			const V wb   = t * sign;
+			for (uint32_t c = 0; c < 4; ++c)
+			{
+				r[c] = a[c] * wa + b[c] * wb;
+			}
+			break;
+		}
+		case Kind::Vec3Cubic:
+		case Kind::QuatCubic:
+		{
+			// glTF cubic spline: Hermite basis with tangents scaled by the segment length
+			const V u   = Load<V>(seg.u + i);
+			const V dt  = Load<V>(seg.dt + i);
+			const V u2  = u * u;
+			const V u3  = u2 * u;
+			const V h00 = V(2.0f) * u3 - V(3.0f) * u2 + V(1.0f);
+			const V h10 = (u3 - V(2.0f) * u2 + u) * dt;
+			const V h01 = V(3.0f) * u2 - V(2.0f) * u3;
+			const V h11 = (u3 - u2) * dt;
+			for (uint32_t c = 0; c < width; ++c)
+			{
+				const V p0 = Gather<V>(keys.value[c], seg.k0 + i);
+				const V m0 = Gather<V>(keys.out[c], seg.k0 + i);
+				const V p1 = Gather<V>(keys.value[c], seg.k1 + i);
+				const V m1 = Gather<V>(keys.in[c], seg.k1 + i);
+				r[c]       = p0 * h00 + m0 * h10 + p1 * h01 + m1 * h11;
+			}
+			break;
+		}
+		default:
+			break;
+	}
+
+	if (kind == Kind::QuatLinear || kind == Kind::QuatCubic)
+	{
+		const V invLength = V(1.0f) / Sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			r[c] = r[c] * invLength;
+		}
+	}
+	for (uint32_t c = 0; c < width; ++c)
+	{
+		Store(out[c] + i, r[c]);
+	}
+}
+
+Animation MakeBenchmarkClip(uint32_t nodeCount, std::mt19937 &rng)
+{
+	std::uniform_real_distribution<float> value(-1.0f, 1.0f);
+	std::uniform_real_distribution<float> spacing(0.02f, 0.1f);
+
+	Animation clip;
+	clip.name = "benchmark";
+	for (uint32_t node = 0; node < nodeCount; ++node)
+	{
+		for (AnimationPath path : {AnimationPath::Translation, AnimationPath::Rotation, AnimationPath::Scale})
+		{
+			const uint32_t   width = path == AnimationPath::Rotation ? 4u : 3u;
+			AnimationSampler sampler;
+			float            t = 0.0f;
+			while (t < 2.0f)
+			{
+				sampler.inputTimes.push_back(t);
+				glm::vec4 v(value(rng), value(rng), value(rng), value(rng));
+				if (path == AnimationPath::Rotation)
+				{
+					v = glm::normalize(v);
+				}
+				for (uint32_t c = 0; c < width; ++c)
+				{
+					sampler.outputValues.push_back(v[static_cast<int>(c)]);
+				}
+				t += spacing(rng);
+			}
+			clip.channels.push_back({static_cast<int>(clip.samplers.size()), static_cast<int>(node), path});
+			clip.samplers.push_back(std::move(sampler));
+		}
+	}
+	return clip;
+}
+}        // namespace
+
+CompiledAnimation CompiledAnimation::Compile(const Animation &animation)
+{
+	CompiledAnimation result;
+
+	// Bucket channels by kind first so each kind is a contiguous run of tracks
+	struct Pending
+	{
+		const AnimationChannel *channel;
+		uint32_t                keyCount;
+	};
+	std::array<std::vector<Pending>, static_cast<size_t>(Kind::Count)> buckets;
+	for (const AnimationChannel &channel : animation.channels)
+	{
+		if (channel.samplerIndex < 0 || channel.samplerIndex >= static_cast<int>(animation.samplers.size()) ||
+		    channel.path == AnimationPath::Weights)
+		{
+			continue;
+		}
+		const AnimationSampler &sampler = animation.samplers[channel.samplerIndex];
+		const bool              isQuat  = channel.path == AnimationPath::Rotation;
+		const bool              cubic   = sampler.interpolation == AnimationInterpolation::CubicSpline;
+		const size_t            stride  = (isQuat ? 4u : 3u) * (cubic ? 3u : 1u);
+		const auto              keys    = static_cast<uint32_t>(std::min(sampler.inputTimes.size(), sampler.outputValues.size() / stride));
+		if (keys == 0)
+		{
+			continue;
+		}
+
+		uint32_t kind = isQuat ? static_cast<uint32_t>(Kind::QuatStep) : static_cast<uint32_t>(Kind::Vec3Step);
+		if (sampler.interpolation == AnimationInterpolation::Linear)
+		{
+			kind += 1;
+		}
+		else if (cubic)
+		{
+			kind += 2;
+		}
+		buckets[kind].push_back({&channel, keys});
+	}
+
+	for (size_t kind = 0; kind < buckets.size(); ++kind)
+	{
+		result.kindOffsets[kind] = static_cast<uint32_t>(result.tracks.size());
+		const bool isQuat        = kind >= static_cast<size_t>(Kind::QuatStep);
+		const bool cubic         = kind == static_cast<size_t>(Kind::Vec3Cubic) || kind == static_cast<size_t>(Kind::QuatCubic);
+		const uint32_t width     = isQuat ? 4u : 3u;
+
+		for (const Pending &pending : buckets[kind])
+		{
+			const AnimationSampler &sampler = animation.samplers[pending.channel->samplerIndex];
+			Track                   track;
+			track.targetNode = pending.channel->targetNode;
+			track.path       = pending.channel->path;
+			track.firstKey   = static_cast<uint32_t>(result.times.size());
+			track.keyCount   = pending.keyCount;
+
+			const float *out = sampler.outputValues.data();
+			for (uint32_t k = 0; k < pending.keyCount; ++k)
+			{
+				result.times.push_back(sampler.inputTimes[k]);
+				// Cubic outputs are (in-tangent, value, out-tangent) triples per key
+				const float *value   = out + (cubic ? (k * 3u + 1u) : k) * width;
+				const float *inTan   = cubic ? out + (k * 3u) * width : nullptr;
+				const float *outTan  = cubic ? out + (k * 3u + 2u) * width : nullptr;
+				auto         element = [width](const float *p, uint32_t c) { return p && c < width ? p[c] : 0.0f; };
+				result.vx.push_back(element(value, 0));
+				result.vy.push_back(element(value, 1));
+				result.vz.push_back(element(value, 2));
+				result.vw.push_back(element(value, 3));
+				result.inX.push_back(element(inTan, 0));
+				result.inY.push_back(element(inTan, 1));
+				result.inZ.push_back(element(inTan, 2));
+				result.inW.push_back(element(inTan, 3));
+				result.outX.push_back(element(outTan, 0));
+				result.outY.push_back(element(outTan, 1));
+				result.outZ.push_back(element(outTan, 2));
+				result.outW.push_back(element(outTan, 3));
+			}
+			result.duration = std::max(result.duration, sampler.inputTimes[pending.keyCount - 1]);
+			result.tracks.push_back(track);
+		}
+	}
+	result.kindOffsets.back() = static_cast<uint32_t>(result.tracks.size());
+	return result;
+}
+
+void CompiledAnimation::FindSegments(float time, AnimationCursors &cursors) const
+{
+	const auto trackCount = static_cast<uint32_t>(tracks.size());
+	if (cursors.keys.size() != trackCount)
+	{
+		cursors.keys.assign(trackCount, 0u);
+		cursors.lastTime = -1.0f;
+	}
+	cursors.k0.resize(trackCount);
+	cursors.k1.resize(trackCount);
+	cursors.u.resize(trackCount);
+	cursors.dt.resize(trackCount);
+	cursors.seeks = 0;
+
+	const bool forward = cursors.lastTime >= 0.0f && time >= cursors.lastTime;
+	for (uint32_t i = 0; i < trackCount; ++i)
+	{
+		const Track &track = tracks[i];
+		const float *t     = times.data() + track.firstKey;
+		const uint32_t last = track.keyCount - 1;
+
+		// Before the first or after the last key the value is held
+		if (last == 0 || time <= t[0] || time >= t[last])
+		{
+			const uint32_t k = (last == 0 || time <= t[0]) ? 0u : last;
+			cursors.keys[i]  = k;
+			cursors.k0[i]    = track.firstKey + k;
+			cursors.k1[i]    = track.firstKey + k;
+			cursors.u[i]     = 0.0f;
+			cursors.dt[i]    = 0.0f;
+			continue;
+		}
+
+		// Find k with t[k] <= time < t[k + 1]; here t[0] < time < t[last]
+		uint32_t k     = cursors.keys[i];
+		bool     found = false;
+		if (forward && k < last && t[k] <= time)
+		{
+			for (uint32_t step = 0; step < MaxCursorSteps; ++step)
+			{
+				if (t[k + 1] > time)
+				{
+					found = true;
+					break;
+				}
+				++k;
+			}
+		}
+		if (!found)
+		{
+			k = static_cast<uint32_t>(std::upper_bound(t, t + track.keyCount, time) - t) - 1u;
+			++cursors.seeks;
+		}
+
+		const float dt  = t[k + 1] - t[k];
+		cursors.keys[i] = k;
+		cursors.k0[i]   = track.firstKey + k;
+		cursors.k1[i]   = track.firstKey + k + 1u;
+		cursors.dt[i]   = dt;
+		cursors.u[i]    = dt > 0.0f ? (time - t[k]) / dt : 0.0f;
+	}
+	cursors.lastTime = time;
+}
+
+void CompiledAnimation::Sample(float time, AnimationCursors &cursors, AnimationPose &pose) const
+{
+	FindSegments(time, cursors);
+
+	const size_t trackCount = tracks.size();
+	pose.x.resize(trackCount);
+	pose.y.resize(trackCount);
+	pose.z.resize(trackCount);
+	pose.w.resize(trackCount);
+
+	const KeyArrays   keys{{vx.data(), vy.data(), vz.data(), vw.data()},
+	                       {inX.data(), inY.data(), inZ.data(), inW.data()},
+	                       {outX.data(), outY.data(), outZ.data(), outW.data()}};
+	const SegmentView seg{cursors.k0.data(), cursors.k1.data(), cursors.u.data(), cursors.dt.data()};
+	float *const      out[4] = {pose.x.data(), pose.y.data(), pose.z.data(), pose.w.data()};
+
+	for (size_t kind = 0; kind < static_cast<size_t>(Kind::Count); ++kind)
+	{
+		uint32_t       i   = kindOffsets[kind];
+		const uint32_t end = kindOffsets[kind + 1];
+#if defined(ANIMATION_SSE2)
+		for (; i + 4 <= end; i += 4)
+		{
+			SampleLanes<Float4>(static_cast<Kind>(kind), keys, seg, out, i);
+		}
+#endif
+		for (; i < end; ++i)
+		{
+			SampleLanes<float>(static_cast<Kind>(kind), keys, seg, out, i);
+		}
+	}
+}
+
+AnimationSystem &AnimationSystem::GetInstance()
+{
+	static AnimationSystem instance;
+	return instance;
+}
+
+void AnimationSystem::Register(AnimationComponent *component)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	components.push_back(component);
+}
+
+void AnimationSystem::Unregister(AnimationComponent *component)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	std::erase(components, component);
+}
+
+void AnimationSystem::Update(std::chrono::milliseconds deltaTime, ThreadPool *pool, uint32_t taskCount)
+{
+	PROFILE_SCOPE("AnimationSystem::Update");
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto                  start = std::chrono::steady_clock::now();
+
+	// Components only touch their own cursors, pose and target transforms, so groups can run concurrently
+	struct GroupStats
+	{
+		uint32_t tracks = 0;
+		uint32_t seeks  = 0;
+	};
+	auto runGroup = [this, deltaTime](size_t begin, size_t end) {
+		GroupStats group;
+		for (size_t i = begin; i < end; ++i)
+		{
+			const auto [tracks, seeks] = components[i]->Advance(deltaTime);
+			group.tracks += tracks;
+			group.seeks += seeks;
+		}
+		return group;
+	};
+
+	GroupStats total;
+	const size_t count = components.size();
+	if (!pool || taskCount <= 1 || count < 2)
+	{
+		total = runGroup(0, count);
+	}
+	else
+	{
+		const size_t                         chunk = (count + taskCount - 1) / taskCount;
+		std::vector<std::future<GroupStats>> futures;
+		for (size_t b = 0; b < count; b += chunk)
+		{
+			futures.push_back(pool->enqueue(runGroup, b, std::min(count, b + chunk)));
+		}
+		for (auto &f : futures)
+		{
+			f.wait();
+		}
+		for (auto &f : futures)
+		{
+			const GroupStats group = f.get();
+			total.tracks += group.tracks;
+			total.seeks += group.seeks;
+		}
+	}
+
+	stats.components = static_cast<uint32_t>(count);
+	stats.tracks     = total.tracks;
+	stats.seeks      = total.seeks;
+	stats.updateMs   = MsSince(start);
+}
+
+AnimationSystem::Stats AnimationSystem::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+AnimationSystem::BenchmarkResult AnimationSystem::Benchmark(uint32_t nodeCount, ThreadPool *pool, uint32_t taskCount, uint32_t frames)
+{
+	BenchmarkResult result;
+	if (nodeCount == 0 || frames == 0)
+	{
+		return result;
+	}
+
+	// One clip per hundred nodes, like many animated props each driven by its own component
+	constexpr uint32_t             nodesPerClip = 100;
+	std::mt19937                   rng(42u);
+	std::vector<CompiledAnimation> clips;
+	for (uint32_t n = 0; n < nodeCount; n += nodesPerClip)
+	{
+		clips.push_back(CompiledAnimation::Compile(MakeBenchmarkClip(std::min(nodesPerClip, nodeCount - n), rng)));
+	}
+	std::vector<AnimationCursors> cursors(clips.size());
+	std::vector<AnimationPose>    poses(clips.size());
+
+	auto runFrames = [&](bool resetCursors, ThreadPool *framePool) {
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t frame = 0; frame < frames; ++frame)
+		{
+			const float time   = std::fmod(static_cast<float>(frame) / 60.0f, 2.0f);
+			auto        sample = [&](size_t begin, size_t end) {
+				for (size_t c = begin; c < end; ++c)
+				{
+					if (resetCursors)
+					{
+						cursors[c].Reset();
+					}
+					clips[c].Sample(time, cursors[c], poses[c]);
+				}
+			};
+			if (!framePool || taskCount <= 1)
+			{
+				sample(0, clips.size());
+				continue;
+			}
+			const size_t                   chunk = (clips.size() + taskCount - 1) / taskCount;
+			std::vector<std::future<void>> futures;
+			for (size_t b = 0; b < clips.size(); b += chunk)
+			{
+				futures.push_back(framePool->enqueue(sample, b, std::min(clips.size(), b + chunk)));
+			}
+			for (auto &f : futures)
+			{
+				f.wait();
+			}
+			for (auto &f : futures)
+			{
+				f.get();
+			}
+		}
+		return MsSince(start) / static_cast<double>(frames);
+	};
+
+	result.searchMs   = runFrames(true, nullptr);
+	result.cursorMs   = runFrames(false, nullptr);
+	result.parallelMs = runFrames(false, pool);
+	return result;
+}
+
+uint32_t AnimationSystem::CheckInactiveOwners()
+{
+	std::mt19937    rng(7u);
+	const Animation clip = MakeBenchmarkClip(1, rng);
+
+	// Returns whether advancing the animation changed its target's transform
+	auto targetMoves = [&clip](bool ownerActive) {
+		Entity animated("AnimationCheck");
+		Entity target("AnimationCheckTarget");
+		auto  *transform = target.AddComponent<TransformComponent>();
+		auto  *animation = animated.AddComponent<AnimationComponent>();
+		animation->SetAnimations({clip});
+		animation->SetNodeToEntityMap({{0, &target}});
+		animation->Play(0);
+		animated.SetActive(ownerActive);
+
+		const glm::vec3 position = transform->GetPosition();
+		const glm::quat rotation = transform->GetRotationQuaternion();
+		const glm::vec3 scale    = transform->GetScale();
+		for (int frame = 0; frame < 8; ++frame)
+		{
+			animation->Advance(std::chrono::milliseconds(16));
+		}
+		return transform->GetPosition() != position || transform->GetRotationQuaternion() != rotation || transform->GetScale() != scale;
+	};
+
+	uint32_t failures = 0;
+	if (targetMoves(false))
+	{
+		failures++;
+	}
+	if (!targetMoves(true))
+	{
+		failures++;
+	}
+	return failures;
+}
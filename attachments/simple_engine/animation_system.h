@@ -0,0 +1,189 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include "model_loader.h"
+
+class AnimationComponent;
+class ThreadPool;
+
+/**
+ * @brief Per-track sampled values, one entry per track of a CompiledAnimation.
+ * Translation and scale tracks use x, y, z; rotation tracks use all four (quaternion x, y, z, w).
+ */
+struct AnimationPose
+{
+	std::vector<float> x, y, z, w;
+};
+
+/**
+ * @brief Keyframe cursors of one playback of a CompiledAnimation.
+ * Forward playback advances each cursor by the few keys that were crossed
+ * since the previous sample; seeking backwards falls back to a binary search.
+ */
+struct AnimationCursors
+{
+	std::vector<uint32_t> keys;
+	float                 lastTime = -1.0f;
+	uint32_t              seeks    = 0;        // binary searches performed by the last Sample
+
+	// Segment chosen for each track by the last Sample: absolute key indices, blend factor and length
+	std::vector<uint32_t> k0, k1;
+	std::vector<float>    u, dt;
+
+	void Reset()
+	{
+		std::fill(keys.begin(), keys.end(), 0u);
+		lastTime = -1.0f;
+	}
+};
+
+/**
+ * @brief An Animation clip converted to structure-of-arrays keyframes for batched sampling.
+ *
+ * Every T/R/S channel becomes a track. Tracks are grouped by kind (value width
+ * and interpolation), so Sample() evaluates each group four tracks at a time
+ * with SSE2 where available. Rotations use a corrected nlerp that stays
+ * within about 1e-3 radians of slerp even for keys far apart, and cubic-spline
+ * channels are evaluated with the glTF Hermite basis (in/out tangents).
+ */
+class CompiledAnimation
+{
+  public:
+	enum class Kind : uint8_t
+	{
+		Vec3Step,
+		Vec3Linear,
+		Vec3Cubic,
+		QuatStep,
+		QuatLinear,
+		QuatCubic,
+		Count
+	};
+
+	struct Track
+	{
+		int           targetNode = -1;
+		AnimationPath path       = AnimationPath::Translation;
+		uint32_t      firstKey   = 0;        // into the time and value arrays
+		uint32_t      keyCount   = 0;
+	};
+
+	/**
+	 * @brief Build the SoA form of a clip. Channels without keys or with unsupported paths are dropped.
+	 * @param animation The source clip.
+	 * @return The compiled clip.
+	 */
+	static CompiledAnimation Compile(const Animation &animation);
+
+	/**
+	 * @brief Sample every track at the given time.
+	 * @param time Clip time in seconds.
+	 * @param cursors Playback state; resized to the track count on first use.
+	 * @param pose Receives the sampled values.
+	 */
+	void Sample(float time, AnimationCursors &cursors, AnimationPose &pose) const;
+
+	const std::vector<Track> &GetTracks() const
+	{
+		return tracks;
+	}
+
+	float GetDuration() const
+	{
+		return duration;
+	}
+
+  private:
+	std::vector<Track> tracks;        // sorted by kind
+	std::array<uint32_t, static_cast<size_t>(Kind::Count) + 1> kindOffsets{};
+
+	// Keyframes of all tracks; a track owns [firstKey, firstKey + keyCount)
+	std::vector<float> times;
+	std::vector<float> vx, vy, vz, vw;
+	std::vector<float> inX, inY, inZ, inW;           // cubic-spline in-tangents
+	std::vector<float> outX, outY, outZ, outW;        // cubic-spline out-tangents
+	float              duration = 0.0f;
+
+	void FindSegments(float time, AnimationCursors &cursors) const;
+};
+
+/**
+ * @brief Drives all AnimationComponents once per frame, in parallel when a pool is supplied.
+ */
+class AnimationSystem
+{
+  public:
+	struct Stats
+	{
+		uint32_t components = 0;
+		uint32_t tracks     = 0;
+		uint32_t seeks      = 0;        // cursor binary searches (loops and seeks); 0 in steady forward playback
+		double   updateMs   = 0.0;
+	};
+
+	struct BenchmarkResult
+	{
+		double cursorMs   = 0.0;        // per frame, cached cursors, serial
+		double searchMs   = 0.0;        // per frame, binary search for every track, serial
+		double parallelMs = 0.0;        // per frame, cached cursors, split across the pool
+	};
+
+	/**
+	 * @brief Get the system that AnimationComponents register with when they are added to an entity.
+	 * @return The shared animation system.
+	 */
+	static AnimationSystem &GetInstance();
+
+	void Register(AnimationComponent *component);
+	void Unregister(AnimationComponent *component);
+
+	/**
+	 * @brief Advance, sample and apply every registered component.
+	 * @param deltaTime Frame time.
+	 * @param pool Optional pool; components are split into taskCount groups.
+	 * @param taskCount Number of groups.
+	 */
+	void Update(std::chrono::milliseconds deltaTime, ThreadPool *pool = nullptr, uint32_t taskCount = 1);
+
+	Stats GetStats() const;
+
+	/**
+	 * @brief Time sampling of nodeCount synthetic nodes with animated translation, rotation and scale.
+	 * @return Average milliseconds per frame for each strategy.
+	 */
+	static BenchmarkResult Benchmark(uint32_t nodeCount, ThreadPool *pool, uint32_t taskCount, uint32_t frames = 120);
+
+	/**
+	 * @brief Check that an animation on an inactive entity leaves its targets alone, while the
+	 * same animation on an active entity moves them.
+	 * @return Number of failed expectations; 0 when both hold.
+	 */
+	static uint32_t CheckInactiveOwners();
+
+  private:
+	std::vector<AnimationComponent *> components;
+	Stats                             stats;
+	mutable std::mutex                mutex;
+};
@@ -0,0 +1,136 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "content_hash.h"
+
+#include <cstring>
+
+namespace
+{
+constexpr uint64_t Prime1 = 0x9E3779B185EBCA87ull;
+constexpr uint64_t Prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr uint64_t Prime3 = 0x165667B19E3779F9ull;
+constexpr uint64_t Prime4 = 0x85EBCA77C2B2AE63ull;
+constexpr uint64_t Prime5 = 0x27D4EB2F165667C5ull;
+
+uint64_t Rotl(uint64_t value, int bits)
+{
+	return (value << bits) | (value >> (64 - bits));
+}
+
+uint64_t Read64(const uint8_t *bytes)
+{
+	uint64_t value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+uint32_t Read32(const uint8_t *bytes)
+{
+	uint32_t value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+uint64_t Round(uint64_t accumulator, uint64_t input)
+{
+	accumulator += input * Prime2;
+	accumulator = Rotl(accumulator, 31);
+	return accumulator * Prime1;
+}
+
+uint64_t MergeRound(uint64_t accumulator, uint64_t lane)
+{
+	accumulator ^= Round(0, lane);
+	return accumulator * Prime1 + Prime4;
+}
+
+uint64_t Avalanche(uint64_t hash)
+{
+	hash ^= hash >> 33;
+	hash *= Prime2;
+	hash ^= hash >> 29;
+	hash *= Prime3;
+	hash ^= hash >> 32;
+	return hash;
+}
+}        // namespace
+
+namespace ContentHash
+{
+Digest Compute(const void *data, size_t size, uint64_t seed)
+{
+	const auto    *bytes = static_cast<const uint8_t *>(data);
+	const uint8_t *end   = bytes + size;
+
+	// Both halves start from the same lanes, merged in opposite orders with different rotations
+	uint64_t low;
+	uint64_t high;
+	if (size >= 32)
+	{
+		uint64_t lanes[4] = {seed + Prime1 + Prime2, seed + Prime2, seed, seed - Prime1};
+		for (; end - bytes >= 32; bytes += 32)
+		{
+			lanes[0] = Round(lanes[0], Read64(bytes));
+			lanes[1] = Round(lanes[1], Read64(bytes + 8));
+			lanes[2] = Round(lanes[2], Read64(bytes + 16));
+			lanes[3] = Round(lanes[3], Read64(bytes + 24));
+		}
+		low  = Rotl(lanes[0], 1) + Rotl(lanes[1], 7) + Rotl(lanes[2], 12) + Rotl(lanes[3], 18);
+		high = Rotl(lanes[3], 3) + Rotl(lanes[2], 11) + Rotl(lanes[1], 19) + Rotl(lanes[0], 29);
+		for (int i = 0; i < 4; ++i)
+		{
+			low  = MergeRound(low, lanes[i]);
+			high = MergeRound(high, lanes[3 - i]);
+		}
+	}
+	else
+	{
+		low  = seed + Prime5;
+		high = seed ^ Prime3;
+	}
+	low += size;
+	high += size * Prime4;
+
+	// The last 31 bytes or fewer
+	for (; end - bytes >= 8; bytes += 8)
+	{
+		const uint64_t k = Round(0, Read64(bytes));
+		low              = Rotl(low ^ k, 27) * Prime1 + Prime4;
+		high             = Rotl(high + k, 29) * Prime2 + Prime3;
+	}
+	if (end - bytes >= 4)
+	{
+		const uint64_t k = Read32(bytes) * Prime1;
+		low              = Rotl(low ^ k, 23) * Prime2 + Prime3;
+		high             = Rotl(high + k, 21) * Prime3 + Prime5;
+		bytes += 4;
+	}
+	for (; bytes < end; ++bytes)
+	{
+		const uint64_t k = *bytes * Prime5;
+		low              = Rotl(low ^ k, 11) * Prime1;
+		high             = Rotl(high + k, 13) * Prime2;
+	}
+	return {Avalanche(low), Avalanche(high ^ Rotl(low, 32))};
+}
+
+Digest Combine(const Digest &first, const Digest &second)
+{
+	return {Avalanche(Rotl(first.low, 29) * Prime1 + second.low + (second.high ^ Prime4)),
+	        Avalanche(Rotl(first.high, 17) * Prime2 + second.high + (second.low ^ Prime5))};
+}
+}        // namespace ContentHash
@@ -0,0 +1,74 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief 128-bit digests of decoded asset data, for content-addressed caches.
+ *
+ * Identical textures and meshes loaded under different paths, or from different
+ * glTF files, have the same digest, so the renderer and model loader can keep one
+ * copy of them. The hash reads four 64-bit lanes per 32-byte block, in the manner
+ * of xxHash64, and finalizes the lanes twice to get 128 bits. It is not
+ * cryptographic: it only has to make accidental collisions negligible.
+ */
+namespace ContentHash
+{
+struct Digest
+{
+	uint64_t low  = 0;
+	uint64_t high = 0;
+
+	bool operator==(const Digest &other) const = default;
+
+	// The zero digest means "no content hash"
+	explicit operator bool() const
+	{
+		return (low | high) != 0;
+	}
+};
+
+struct DigestHasher
+{
+	size_t operator()(const Digest &digest) const
+	{
+		return static_cast<size_t>(digest.low);
+	}
+};
+
+/**
+ * @brief Hash a block of memory.
+ * @param data The bytes.
+ * @param size Their count.
+ * @param seed Distinguishes digests of the same bytes used for different purposes.
+ */
+Digest Compute(const void *data, size_t size, uint64_t seed = 0);
+
+template <typename T>
+Digest Compute(std::span<const T> values, uint64_t seed = 0)
+{
+	return Compute(values.data(), values.size_bytes(), seed);
+}
+
+/**
+ * @brief Hash a sequence of digests; the order matters.
+ */
+Digest Combine(const Digest &first, const Digest &second);
+}        // namespace ContentHash
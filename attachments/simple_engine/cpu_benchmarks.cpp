@@ -0,0 +1,241 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "cpu_benchmarks.h"
+
+#include "animation_system.h"
+#include "debug_system.h"
+#include "frustum_cull.h"
+#include "light_clusterer.h"
+#include "occlusion_culler.h"
+#include "perf_run.h"
+#include "resource_manager.h"
+#include "spatial_index.h"
+#include "thread_pool.h"
+#include "transform_system.h"
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+namespace
+{
+struct Entry
+{
+	const char *name;
+	std::function<void(ThreadPool &, uint32_t, BenchmarkReport &)> run;        // pool, task count, report
+};
+
+void BenchmarkOcclusion(ThreadPool &pool, uint32_t tasks, BenchmarkReport &report)
+{
+	const auto r = OcclusionCuller::Benchmark(256, 128, 512, 100000, &pool, tasks);
+	report.Add("occlusion", "rasterMs", r.rasterMs);
+	report.Add("occlusion", "rasterPoolMs", r.rasterPoolMs);
+	report.Add("occlusion", "testMs", r.testMs);
+	report.Add("occlusion", "triangles", r.triangles);
+	report.Add("occlusion", "tested", r.tested);
+	report.Add("occlusion", "hidden", r.hidden);
+}
+
+void BenchmarkFrustumCull(ThreadPool &, uint32_t, BenchmarkReport &report)
+{
+	const auto r = FrustumCullKernel::Benchmark(100000, 64);
+	for (const auto &path : r.paths)
+	{
+		const std::string name = FrustumCullKernel::GetIsaName(path.isa);
+		report.Add("frustum-cull", name + "Ms", path.ms);
+		report.Add("frustum-cull", name + "Mismatches", path.mismatches);
+		if (path.mismatches != 0)
+		{
+			report.AddFailure("frustum-cull", name + " differs from the scalar path in " + std::to_string(path.mismatches) + " of " + std::to_string(r.lists) + " lists");
+		}
+	}
+	report.Add("frustum-cull", "boxTestMismatches", r.boxTestMismatches);
+	if (r.boxTestMismatches != 0)
+	{
+		report.AddFailure("frustum-cull", std::to_string(r.boxTestMismatches) + " boxes away from a plane disagree with the p-vertex test");
+	}
+}
+
+void BenchmarkLightClustering(ThreadPool &pool, uint32_t tasks, BenchmarkReport &report)
+{
+	const auto r = LightClusterer::Benchmark(10000, 1920, 1080, &pool, tasks);
+	report.Add("light-clustering", "clusterMs", r.clusterMs);
+	report.Add("light-clustering", "clusterPoolMs", r.clusterPoolMs);
+	report.Add("light-clustering", "zbinMs", r.zbinMs);
+	report.Add("light-clustering", "clusterBytes", static_cast<double>(r.clusterBytes));
+	report.Add("light-clustering", "zbinBytes", static_cast<double>(r.zbinBytes));
+	report.Add("light-clustering", "zbinMissing", r.missing);
+	if (r.missing != 0)
+	{
+		report.AddFailure("light-clustering", std::to_string(r.missing) + " cluster lights missing from the z-binned lists");
+	}
+
+	// The optimized build against the shader port, uncapped and with most clusters at the cap
+	const uint32_t mismatches       = LightClusterer::CheckAgainstReference(2000, 640, 360, 256, &pool, tasks);
+	const uint32_t cappedMismatches = LightClusterer::CheckAgainstReference(2000, 640, 360, 4, &pool, tasks);
+	report.Add("light-clustering", "referenceMismatches", mismatches);
+	report.Add("light-clustering", "cappedReferenceMismatches", cappedMismatches);
+	if (mismatches + cappedMismatches != 0)
+	{
+		report.AddFailure("light-clustering", std::to_string(mismatches + cappedMismatches) + " clusters differ from the shader reference");
+	}
+}
+
+void BenchmarkSpatialIndex(ThreadPool &, uint32_t, BenchmarkReport &report)
+{
+	const auto r = SpatialIndex::Benchmark(100000, 32);
+	report.Add("spatial-index", "buildMs", r.buildMs);
+	report.Add("spatial-index", "treeMs", r.treeMs);
+	report.Add("spatial-index", "flatMs", r.flatMs);
+	report.Add("spatial-index", "kernelMs", r.kernelMs);
+	report.Add("spatial-index", "visible", r.visible);
+	report.Add("spatial-index", "height", r.height);
+	report.Add("spatial-index", "mismatches", r.mismatches);
+	if (r.mismatches != 0)
+	{
+		report.AddFailure("spatial-index", "the tree and the flat test disagree in " + std::to_string(r.mismatches) + " views");
+	}
+}
+
+void BenchmarkTransformUpdate(ThreadPool &pool, uint32_t tasks, BenchmarkReport &report)
+{
+	report.Add("transform-update", "sparseDirtyMs", TransformSystem::Benchmark(100000, 0.01f, &pool, tasks));
+	report.Add("transform-update", "allDirtyMs", TransformSystem::Benchmark(100000, 1.0f, &pool, tasks));
+}
+
+void BenchmarkAnimationSampling(ThreadPool &pool, uint32_t tasks, BenchmarkReport &report)
+{
+	const auto r = AnimationSystem::Benchmark(10000, &pool, tasks);
+	report.Add("animation-sampling", "cursorMs", r.cursorMs);
+	report.Add("animation-sampling", "searchMs", r.searchMs);
+	report.Add("animation-sampling", "parallelMs", r.parallelMs);
+
+	const uint32_t inactiveFailures = AnimationSystem::CheckInactiveOwners();
+	report.Add("animation-sampling", "inactiveOwnerFailures", inactiveFailures);
+	if (inactiveFailures != 0)
+	{
+		report.AddFailure("animation-sampling", "animations on inactive entities moved their targets, or active ones did not");
+	}
+}
+
+void BenchmarkLogging(ThreadPool &, uint32_t, BenchmarkReport &report)
+{
+	const auto r = DebugSystem::Benchmark(8, 50000);
+	report.Add("logging", "threads", r.threads);
+	report.Add("logging", "asyncCallsPerSecond", r.asyncCallsPerSecond);
+	report.Add("logging", "syncCallsPerSecond", r.syncCallsPerSecond);
+	report.Add("logging", "repeatedCallsPerSecond", r.repeatedCallsPerSecond);
+	report.Add("logging", "asyncWritten", static_cast<double>(r.asyncStats.written));
+	report.Add("logging", "asyncDropped", static_cast<double>(r.asyncStats.dropped));
+	report.Add("logging", "repeatedSuppressed", static_cast<double>(r.repeatedStats.suppressed));
+}
+
+void BenchmarkResourceHandles(ThreadPool &, uint32_t, BenchmarkReport &report)
+{
+	const auto r = ResourceManager::Benchmark(10000);
+	report.Add("resource-handles", "resources", r.resources);
+	report.Add("resource-handles", "lookups", static_cast<double>(r.lookups));
+	report.Add("resource-handles", "handleLookupsPerSecond", r.handleLookupsPerSecond);
+	report.Add("resource-handles", "idLookupsPerSecond", r.idLookupsPerSecond);
+	report.Add("resource-handles", "nestedMapLookupsPerSecond", r.nestedMapLookupsPerSecond);
+}
+
+void BenchmarkAsyncLoading(ThreadPool &pool, uint32_t, BenchmarkReport &report)
+{
+	const auto r = ResourceManager::BenchmarkAsyncLoading(&pool, 16);
+	report.Add("async-loading", "resources", r.resources);
+	report.Add("async-loading", "coalesced", static_cast<double>(r.coalesced));
+	report.Add("async-loading", "synchronousMs", r.synchronousMs);
+	report.Add("async-loading", "asynchronousMs", r.asynchronousMs);
+	if (r.asynchronousMs == 0.0)
+	{
+		report.AddFailure("async-loading", "not every model finished loading asynchronously");
+	}
+
+	const uint32_t unloadFailures = ResourceManager::CheckUnloadWithQueuedDependent(&pool);
+	report.Add("async-loading", "unloadWithDependentFailures", unloadFailures);
+	if (unloadFailures != 0)
+	{
+		report.AddFailure("async-loading", "a load waiting for a resource unloaded mid-load was not failed");
+	}
+}
+
+const std::vector<Entry> &GetEntries()
+{
+	static const std::vector<Entry> entries = {
+	    {"frustum-cull", BenchmarkFrustumCull},
+	    {"occlusion", BenchmarkOcclusion},
+	    {"light-clustering", BenchmarkLightClustering},
+	    {"spatial-index", BenchmarkSpatialIndex},
+	    {"transform-update", BenchmarkTransformUpdate},
+	    {"animation-sampling", BenchmarkAnimationSampling},
+	    {"logging", BenchmarkLogging},
+	    {"resource-handles", BenchmarkResourceHandles},
+	    {"async-loading", BenchmarkAsyncLoading},
+	};
+	return entries;
+}
+}        // namespace
+
+namespace CpuBenchmarks
+{
+std::vector<std::string> GetNames()
+{
+	std::vector<std::string> names;
+	for (const auto &entry : GetEntries())
+	{
+		names.emplace_back(entry.name);
+	}
+	return names;
+}
+
+bool Run(const std::string &names, BenchmarkReport &report)
+{
+	std::vector<const Entry *> selected;
+	std::istringstream         list(names);
+	std::string                name;
+	while (std::getline(list, name, ','))
+	{
+		if (name == "all")
+		{
+			for (const auto &entry : GetEntries())
+			{
+				selected.push_back(&entry);
+			}
+			continue;
+		}
+		const auto it = std::find_if(GetEntries().begin(), GetEntries().end(), [&name](const Entry &entry) { return name == entry.name; });
+		if (it == GetEntries().end())
+		{
+			return false;
+		}
+		selected.push_back(&*it);
+	}
+
+	const uint32_t tasks = std::max(1u, std::thread::hardware_concurrency());
+	ThreadPool     pool(tasks);
+	for (const Entry *entry : selected)
+	{
+		std::cout << "Running benchmark " << entry->name << std::endl;
+		entry->run(pool, tasks, report);
+	}
+	return true;
+}
+}        // namespace CpuBenchmarks
@@ -0,0 +1,44 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <vector>
+
+class BenchmarkReport;
+
+/**
+ * @brief CPU benchmarks and self-checks of the engine's systems, run from the command line.
+ *
+ * They need neither a window nor a GPU, so their numbers can be reproduced on any
+ * machine with "--benchmark <names> --report out.json".
+ */
+namespace CpuBenchmarks
+{
+/**
+ * @brief Get the names accepted by Run.
+ */
+std::vector<std::string> GetNames();
+
+/**
+ * @brief Run benchmarks on a pool with one worker per hardware thread.
+ * @param names Comma-separated benchmark names, or "all".
+ * @param report Receives the results.
+ * @return False if a name is unknown; nothing is run then.
+ */
+bool Run(const std::string &names, BenchmarkReport &report);
+}        // namespace CpuBenchmarks
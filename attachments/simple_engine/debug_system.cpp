@@ -0,0 +1,410 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "debug_system.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace {
+// Ring of the calling thread, cached for the instance that created it
+thread_local uint64_t threadRingInstance = 0;
+thread_local void* threadRing = nullptr;
+
+std::atomic<uint64_t> nextInstanceId{1};
+
+int64_t SystemNowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// FNV-1a over level, tag and message; identifies repeated messages for the rate limiter
+uint64_t HashMessage(LogLevel level, std::string_view tag, std::string_view message) {
+  uint64_t hash = 14695981039346656037ull ^ static_cast<uint64_t>(level);
+  auto mix = [&hash](std::string_view text) {
+    for (char c : text) {
+      hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ull;
+    }
+    hash = (hash ^ 0xFFu) * 1099511628211ull;
+  };
+  mix(tag);
+  mix(message);
+  return hash;
+}
+
+const char* LevelName(uint8_t level) {
+  switch (static_cast<LogLevel>(level)) {
+    case LogLevel::Debug:
+      return "DEBUG";
+    case LogLevel::Info:
+      return "INFO";
+    case LogLevel::Warning:
+      return "WARNING";
+    case LogLevel::Error:
+      return "ERROR";
+    case LogLevel::Fatal:
+      return "FATAL";
+  }
+  return "?";
+}
+} // namespace
+
+DebugSystem::DebugSystem() : instanceId(nextInstanceId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+DebugSystem::~DebugSystem() {
+  {
+    std::lock_guard<std::mutex> lock(writerWakeMutex);
+    writerStop = true;
+  }
+  writerWake.notify_one();
+  if (writerThread.joinable()) {
+    writerThread.join();
+  }
+  std::lock_guard<std::mutex> lock(writeMutex);
+  DrainAndWrite(nullptr);
+}
+
+bool DebugSystem::Initialize(const std::string& logFilePath) {
+  {
+    std::lock_guard<std::mutex> lock(writeMutex);
+
+    // Open log file
+    logFile.open(logFilePath, std::ios::out | std::ios::trunc);
+    if (!logFile.is_open()) {
+      std::cerr << "Failed to open log file: " << logFilePath << std::endl;
+      return false;
+    }
+  }
+
+  // Log initialization
+  Log(LogLevel::Info, "DebugSystem", "Debug system initialized");
+
+  initialized = true;
+  return true;
+}
+
+void DebugSystem::Cleanup() {
+  if (initialized) {
+    // Log cleanup
+    Log(LogLevel::Info, "DebugSystem", "Debug system shutting down");
+
+    // Write everything still queued, then close the log file
+    std::lock_guard<std::mutex> lock(writeMutex);
+    DrainAndWrite(nullptr);
+    if (logFile.is_open()) {
+      logFile.close();
+    }
+
+    initialized = false;
+  }
+}
+
+DebugSystem::LogRing& DebugSystem::GetThreadRing() {
+  if (threadRingInstance != instanceId || !threadRing) {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    const auto self = std::this_thread::get_id();
+    LogRing* ring = nullptr;
+    // The thread may have used another instance in between; reuse the ring it already owns here
+    for (auto& r : rings) {
+      if (r->owner == self) {
+        ring = r.get();
+        break;
+      }
+    }
+    if (!ring) {
+      rings.push_back(std::make_unique<LogRing>());
+      ring = rings.back().get();
+      ring->owner = self;
+    }
+    threadRingInstance = instanceId;
+    threadRing = ring;
+  }
+  return *static_cast<LogRing*>(threadRing);
+}
+
+bool DebugSystem::AllowRepeat(LogRing& ring, uint64_t hash, uint32_t& suppressedBefore) {
+  const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+  RepeatEntry& entry = ring.repeats[hash % REPEAT_SLOTS];
+  if (entry.hash != hash || now - entry.windowStartNs >= 1'000'000'000) {
+    // New message in this slot or a new one-second window: let it through and report what was skipped
+    suppressedBefore = entry.hash == hash ? entry.suppressed : 0;
+    entry = RepeatEntry{.hash = hash, .windowStartNs = now, .count = 1, .suppressed = 0};
+    return true;
+  }
+  if (++entry.count <= MAX_REPEATS_PER_SECOND) {
+    return true;
+  }
+  entry.suppressed++;
+  return false;
+}
+
+void DebugSystem::FillRecord(LogRecord& record, LogLevel level, std::string_view tag, std::string_view message) {
+  record.timeNs = SystemNowNs();
+  record.level = static_cast<uint8_t>(level);
+  record.tagLength = static_cast<uint8_t>(std::min(tag.size(), TAG_CAPACITY));
+  std::memcpy(record.tag, tag.data(), record.tagLength);
+  record.messageLength = static_cast<uint16_t>(std::min(message.size(), MESSAGE_CAPACITY));
+  std::memcpy(record.message, message.data(), record.messageLength);
+  record.truncated = message.size() > MESSAGE_CAPACITY;
+}
+
+void DebugSystem::Log(LogLevel level, std::string_view tag, std::string_view message) {
+  if (level == LogLevel::Fatal) {
+    // Written on the caller's thread so the message is out before the crash handler runs.
+    // The writer may be stuck in a crashing process, so don't wait for it.
+    LogRecord record;
+    FillRecord(record, level, tag, message);
+    if (writeMutex.try_lock()) {
+      DrainAndWrite(&record);
+      writeMutex.unlock();
+    } else {
+      std::string line;
+      FormatRecord(record, line);
+      std::cerr << line << std::flush;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    if (crashHandler) {
+      crashHandler(std::string(message));
+    }
+    return;
+  }
+
+  LogRing& ring = GetThreadRing();
+  uint32_t suppressedBefore = 0;
+  if (!AllowRepeat(ring, HashMessage(level, tag, message), suppressedBefore)) {
+    ring.suppressed.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if (!asynchronous.load(std::memory_order_relaxed)) {
+    LogRecord record;
+    FillRecord(record, level, tag, message);
+    record.suppressed = suppressedBefore;
+    std::lock_guard<std::mutex> lock(writeMutex);
+    DrainAndWrite(&record);
+    return;
+  }
+
+  const uint64_t head = ring.head.load(std::memory_order_relaxed);
+  const uint64_t pending = head - ring.tail.load(std::memory_order_acquire);
+  if (pending >= RING_CAPACITY) {
+    ring.dropped.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  LogRecord& record = ring.records[head % RING_CAPACITY];
+  FillRecord(record, level, tag, message);
+  record.suppressed = suppressedBefore;
+  ring.head.store(head + 1, std::memory_order_release);
+
+  std::call_once(writerStarted, [this]() { StartWriter(); });
+  // Wake the writer early for errors and before the ring fills up; otherwise it polls
+  if (level >= LogLevel::Error || pending + 1 == RING_CAPACITY / 2) {
+    writerWake.notify_one();
+  }
+}
+
+void DebugSystem::Flush() {
+  std::lock_guard<std::mutex> lock(writeMutex);
+  DrainAndWrite(nullptr);
+}
+
+DebugSystem::LogStats DebugSystem::GetStats() const {
+  LogStats stats;
+  stats.written = written.load(std::memory_order_relaxed);
+  std::lock_guard<std::mutex> lock(ringsMutex);
+  for (const auto& ring : rings) {
+    stats.dropped += ring->dropped.load(std::memory_order_relaxed);
+    stats.suppressed += ring->suppressed.load(std::memory_order_relaxed);
+  }
+  return stats;
+}
+
+void DebugSystem::StartWriter() {
+  writerThread = std::thread([this]() { WriterThreadMain(); });
+}
+
+void DebugSystem::WriterThreadMain() {
+  bool stop = false;
+  while (!stop) {
+    {
+      std::unique_lock<std::mutex> lock(writerWakeMutex);
+      writerWake.wait_for(lock, WRITER_INTERVAL, [this]() { return writerStop; });
+      stop = writerStop;
+    }
+    std::lock_guard<std::mutex> lock(writeMutex);
+    DrainAndWrite(nullptr);
+  }
+}
+
+void DebugSystem::FormatRecord(const LogRecord& record, std::string& out) {
+  // localtime/strftime only run when the second changes (callers hold writeMutex)
+  const int64_t second = record.timeNs / 1'000'000'000;
+  if (second != cachedSecond) {
+    const auto time = static_cast<std::time_t>(second);
+    std::strftime(cachedTime, sizeof(cachedTime), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
+    cachedSecond = second;
+  }
+  char millis[8];
+  std::snprintf(millis, sizeof(millis), ".%03d", static_cast<int>((record.timeNs / 1'000'000) % 1000));
+
+  out.append(cachedTime);
+  out.append(millis);
+  out.append(" [").append(LevelName(record.level)).append("] [");
+  out.append(record.tag, record.tagLength).append("] ");
+  out.append(record.message, record.messageLength);
+  if (record.truncated) {
+    out.append("...");
+  }
+  if (record.suppressed > 0) {
+    out.append(" (").append(std::to_string(record.suppressed)).append(" repeats suppressed)");
+  }
+  out.push_back('\n');
+}
+
+void DebugSystem::DrainAndWrite(const LogRecord* extra) {
+  batch.clear();
+  {
+    std::lock_guard<std::mutex> lock(ringsMutex);
+    for (auto& ring : rings) {
+      const uint64_t tail = ring->tail.load(std::memory_order_relaxed);
+      const uint64_t head = ring->head.load(std::memory_order_acquire);
+      for (uint64_t i = tail; i < head; ++i) {
+        batch.push_back(ring->records[i % RING_CAPACITY]);
+      }
+      ring->tail.store(head, std::memory_order_release);
+
+      const uint64_t dropped = ring->dropped.load(std::memory_order_relaxed);
+      if (dropped != ring->droppedReported) {
+        LogRecord note;
+        FillRecord(note, LogLevel::Warning, "DebugSystem", std::to_string(dropped - ring->droppedReported) + " messages dropped (log ring full)");
+        batch.push_back(note);
+        ring->droppedReported = dropped;
+      }
+    }
+  }
+  if (extra) {
+    batch.push_back(*extra);
+  }
+  if (batch.empty()) {
+    return;
+  }
+
+  // Rings are drained one after another; restore the global order
+  std::stable_sort(batch.begin(), batch.end(), [](const LogRecord& a, const LogRecord& b) {
+    return a.timeNs < b.timeNs;
+  });
+
+  consoleText.clear();
+  errorText.clear();
+  fileText.clear();
+  for (const auto& record : batch) {
+    const size_t start = fileText.size();
+    FormatRecord(record, fileText);
+    if (consoleOutput) {
+      std::string& console = record.level >= static_cast<uint8_t>(LogLevel::Warning) ? errorText : consoleText;
+      console.append(fileText, start, std::string::npos);
+    }
+  }
+
+  if (!consoleText.empty()) {
+    std::cout.write(consoleText.data(), static_cast<std::streamsize>(consoleText.size()));
+    std::cout.flush();
+  }
+  if (!errorText.empty()) {
+    std::cerr.write(errorText.data(), static_cast<std::streamsize>(errorText.size()));
+    std::cerr.flush();
+  }
+  if (logFile.is_open()) {
+    logFile.write(fileText.data(), static_cast<std::streamsize>(fileText.size()));
+    logFile.flush();
+  }
+  written.fetch_add(batch.size(), std::memory_order_relaxed);
+
+  // Call registered callbacks
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!logCallbacks.empty()) {
+    for (const auto& record : batch) {
+      const std::string tag(record.tag, record.tagLength);
+      const std::string message(record.message, record.messageLength);
+      for (const auto& kv : logCallbacks) {
+        kv.second(static_cast<LogLevel>(record.level), tag, message);
+      }
+    }
+  }
+}
+
+DebugSystem::LogBenchmarkResult DebugSystem::Benchmark(uint32_t threadCount, uint32_t callsPerThread) {
+  LogBenchmarkResult result;
+  result.threads = std::max(1u, threadCount);
+  result.callsPerThread = callsPerThread;
+
+  const std::string path = "log_benchmark.log";
+
+  // Runs one pass on a fresh instance and returns calls per second
+  auto run = [&](bool async, bool repeated, LogStats* stats) {
+    DebugSystem bench;
+    bench.consoleOutput = false;
+    bench.SetAsynchronous(async);
+    bench.Initialize(path);
+
+    std::atomic<uint32_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    threads.reserve(result.threads);
+    for (uint32_t t = 0; t < result.threads; ++t) {
+      threads.emplace_back([&, t]() {
+        ready.fetch_add(1, std::memory_order_relaxed);
+        while (!go.load(std::memory_order_acquire)) {
+          std::this_thread::yield();
+        }
+        char text[64];
+        for (uint32_t i = 0; i < callsPerThread; ++i) {
+          const int length = repeated
+                               ? std::snprintf(text, sizeof(text), "Benchmark message from thread %u", t)
+                               : std::snprintf(text, sizeof(text), "Benchmark message %u from thread %u", i, t);
+          bench.Log(LogLevel::Info, "Benchmark", std::string_view(text, static_cast<size_t>(length)));
+        }
+      });
+    }
+    while (ready.load(std::memory_order_relaxed) < result.threads) {
+      std::this_thread::yield();
+    }
+    const auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    bench.Cleanup();
+    if (stats) {
+      *stats = bench.GetStats();
+    }
+    const double calls = static_cast<double>(result.threads) * static_cast<double>(callsPerThread);
+    return seconds > 0.0 ? calls / seconds : 0.0;
+  };
+
+  result.asyncCallsPerSecond = run(true, false, &result.asyncStats);
+  result.syncCallsPerSecond = run(false, false, nullptr);
+  result.repeatedCallsPerSecond = run(true, true, &result.repeatedStats);
+
+  std::error_code ec;
+  std::filesystem::remove(path, ec);
+  return result;
+}
@@ -16,7 +16,11 @@
  */
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <ctime>
 #include <fstream>
 #include <functional>
@@ -24,7 +28,10 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 /**
  * @brief Enum for different log levels.
@@ -42,9 +49,33 @@ enum class LogLevel {
  *
  * This class implements the debugging system as described in the Tooling chapter:
  * @see en/Building_a_Simple_Engine/Tooling/03_debugging_and_renderdoc.adoc
+ *
+ * Log() does not format or write anything on the calling thread. It copies the message into a
+ * fixed-size record in the thread's own lock-free ring; a background writer thread drains all
+ * rings in batches, formats the records and writes them to the console, the log file and the
+ * registered callbacks. When a ring is full the record is dropped and counted rather than
+ * blocking the caller. A thread repeating the same message more than MAX_REPEATS_PER_SECOND
+ * times a second has the extra copies suppressed; the next copy that gets through reports how
+ * many were skipped. Fatal messages are written synchronously before the crash handler runs.
  */
 class DebugSystem {
   public:
+    struct LogStats {
+      uint64_t written = 0;    // records written by the backend
+      uint64_t dropped = 0;    // records lost because a thread's ring was full
+      uint64_t suppressed = 0; // repeated messages skipped by the rate limiter
+    };
+
+    struct LogBenchmarkResult {
+      uint32_t threads = 0;
+      uint64_t callsPerThread = 0;
+      double asyncCallsPerSecond = 0.0;    // distinct messages, asynchronous backend
+      double syncCallsPerSecond = 0.0;     // distinct messages, formatted and written by the caller
+      double repeatedCallsPerSecond = 0.0; // one repeated message, asynchronous backend
+      LogStats asyncStats;
+      LogStats repeatedStats;
+    };
+
     /**
 	 * @brief Get the singleton instance of the debug system.
 	 * @return Reference to the debug system instance.
@@ -59,111 +90,51 @@ class DebugSystem {
 	 * @param logFilePath The path to the log file.
 	 * @return True if initialization was successful, false otherwise.
 	 */
-    bool Initialize(const std::string& logFilePath = "engine.log") {
-      std::lock_guard<std::mutex> lock(mutex);
-
-      // Open log file
-      logFile.open(logFilePath, std::ios::out | std::ios::trunc);
-      if (!logFile.is_open()) {
-        std::cerr << "Failed to open log file: " << logFilePath << std::endl;
-        return false;
-      }
-
-      // Log initialization
-      Log(LogLevel::Info, "DebugSystem", "Debug system initialized");
-
-      initialized = true;
-      return true;
-    }
+    bool Initialize(const std::string& logFilePath = "engine.log");
 
     /**
-	 * @brief Clean up debug system resources.
+	 * @brief Clean up debug system resources. Pending messages are written first.
 	 */
-    void Cleanup() {
-      std::lock_guard<std::mutex> lock(mutex);
-
-      if (initialized) {
-        // Log cleanup
-        Log(LogLevel::Info, "DebugSystem", "Debug system shutting down");
-
-        // Close log file
-        if (logFile.is_open()) {
-          logFile.close();
-        }
-
-        initialized = false;
-      }
-    }
+    void Cleanup();
 
     /**
-	 * @brief Log a message.
+	 * @brief Log a message. Does not block on I/O; the message is truncated to fit a record.
 	 * @param level The log level.
 	 * @param tag The tag for the log message.
 	 * @param message The log message.
 	 */
-    void Log(LogLevel level, const std::string& tag, const std::string& message) {
-      std::lock_guard<std::mutex> lock(mutex);
-
-      // Get current time
-      auto now = std::chrono::system_clock::now();
-      auto time = std::chrono::system_clock::to_time_t(now);
-      auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-
-      char timeStr[20];
-      std::strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", std::localtime(&time));
-
-      // Format log message
-      std::string levelStr;
-      switch (level) {
-        case LogLevel::Debug:
-          levelStr = "DEBUG";
-          break;
-        case LogLevel::Info:
-          levelStr = "INFO";
-          break;
-        case LogLevel::Warning:
-          levelStr = "WARNING";
-          break;
-        case LogLevel::Error:
-          levelStr = "ERROR";
-          break;
-        case LogLevel::Fatal:
-          levelStr = "FATAL";
-          break;
-      }
+    void Log(LogLevel level, std::string_view tag, std::string_view message);
 
-      std::string formattedMessage =
-          std::string(timeStr) + "." + std::to_string(ms.count()) +
-          " [" + levelStr + "] " +
-          "[" + tag + "] " +
-          message;
-
-      // Write to console
-      if (level >= LogLevel::Warning) {
-        std::cerr << formattedMessage << std::endl;
-      } else {
-        std::cout << formattedMessage << std::endl;
-      }
+    /**
+	 * @brief Write all messages logged so far before returning.
+	 */
+    void Flush();
 
-      // Write to log file
-      if (logFile.is_open()) {
-        logFile << formattedMessage << std::endl;
-        logFile.flush();
-      }
+    /**
+	 * @brief Choose between the background writer (default) and writing on the calling thread.
+	 * @param enable True to write asynchronously.
+	 */
+    void SetAsynchronous(bool enable) {
+      asynchronous.store(enable, std::memory_order_relaxed);
+    }
 
-      // Call registered callbacks
-      for (const auto& kv : logCallbacks) {
-        kv.second(level, tag, message);
-      }
+    /**
+	 * @brief Get the logging counters.
+	 * @return Records written, dropped and suppressed so far.
+	 */
+    LogStats GetStats() const;
 
-      // If fatal, trigger crash handler
-      if (level == LogLevel::Fatal && crashHandler) {
-        crashHandler(formattedMessage);
-      }
-    }
+    /**
+	 * @brief Measure log calls per second from several threads on a private instance
+	 * that writes to a scratch file instead of the console.
+	 * @param threadCount Number of logging threads.
+	 * @param callsPerThread Messages logged by each thread per run.
+	 * @return Throughput of the asynchronous and synchronous paths.
+	 */
+    static LogBenchmarkResult Benchmark(uint32_t threadCount = 8, uint32_t callsPerThread = 50000);
 
     /**
-	 * @brief Register a log callback.
+	 * @brief Register a log callback. Callbacks run on the writer thread.
 	 * @param callback The callback function to be called when a log message is generated.
 	 * @return An ID that can be used to unregister the callback.
 	 */
@@ -227,17 +198,17 @@ class DebugSystem {
 
   protected:
     // Protected constructor for inheritance
-    DebugSystem() = default;
-    virtual ~DebugSystem() = default;
+    DebugSystem();
+    virtual ~DebugSystem();
 
     // Delete copy constructor and assignment operator
     DebugSystem(const DebugSystem&) = delete;
     DebugSystem& operator=(const DebugSystem&) = delete;
 
-    // Mutex for thread safety
+    // Mutex for callbacks, the crash handler and measurements
     std::mutex mutex;
 
-    // Log file
+    // Log file (guarded by writeMutex)
     std::ofstream logFile;
 
     // Initialization flag
@@ -252,6 +223,77 @@ class DebugSystem {
 
     // Performance measurements
     std::unordered_map<std::string, std::chrono::high_resolution_clock::time_point> measurements;
+
+  private:
+    static constexpr size_t TAG_CAPACITY = 32;
+    static constexpr size_t MESSAGE_CAPACITY = 463;
+    static constexpr uint32_t RING_CAPACITY = 512;
+    static constexpr uint32_t REPEAT_SLOTS = 64;
+    static constexpr uint32_t MAX_REPEATS_PER_SECOND = 10;
+    static constexpr std::chrono::milliseconds WRITER_INTERVAL{10};
+
+    // Fixed-size message copy; 512 bytes
+    struct LogRecord {
+      int64_t timeNs = 0;      // system clock
+      uint32_t suppressed = 0; // copies of this message skipped since the previous one
+      uint16_t messageLength = 0;
+      uint8_t tagLength = 0;
+      uint8_t level = 0;
+      bool truncated = false;
+      char tag[TAG_CAPACITY];
+      char message[MESSAGE_CAPACITY];
+    };
+
+    struct RepeatEntry {
+      uint64_t hash = 0;
+      int64_t windowStartNs = 0;
+      uint32_t count = 0;
+      uint32_t suppressed = 0;
+    };
+
+    // Single-producer (owning thread) / single-consumer (holder of writeMutex) ring
+    struct LogRing {
+      std::array<LogRecord, RING_CAPACITY> records;
+      std::atomic<uint64_t> head{0}; // records written by the owner
+      std::atomic<uint64_t> tail{0}; // records consumed by the writer
+      std::atomic<uint64_t> dropped{0};
+      std::atomic<uint64_t> suppressed{0};
+      uint64_t droppedReported = 0;
+      std::array<RepeatEntry, REPEAT_SLOTS> repeats{}; // rate limiter, owner only
+      std::thread::id owner;
+    };
+
+    const uint64_t instanceId;
+    std::atomic<bool> asynchronous{true};
+    bool consoleOutput = true;
+
+    // Per-thread rings
+    mutable std::mutex ringsMutex;
+    std::vector<std::unique_ptr<LogRing>> rings;
+
+    // Background writer. writeMutex serializes draining the rings and all output.
+    std::mutex writeMutex;
+    std::vector<LogRecord> batch;
+    std::string consoleText;
+    std::string errorText;
+    std::string fileText;
+    int64_t cachedSecond = -1;
+    char cachedTime[20] = {};
+    std::atomic<uint64_t> written{0};
+
+    std::once_flag writerStarted;
+    std::thread writerThread;
+    std::mutex writerWakeMutex;
+    std::condition_variable writerWake;
+    bool writerStop = false;
+
+    LogRing& GetThreadRing();
+    static bool AllowRepeat(LogRing& ring, uint64_t hash, uint32_t& suppressedBefore);
+    static void FillRecord(LogRecord& record, LogLevel level, std::string_view tag, std::string_view message);
+    void StartWriter();
+    void WriterThreadMain();
+    void DrainAndWrite(const LogRecord* extra);
+    void FormatRecord(const LogRecord& record, std::string& out);
 };
 
 // Convenience macros for logging
@@ -0,0 +1,109 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "draw_sort.h"
+
+#include <array>
+#include <bit>
+#include <cmath>
+
+uint32_t DrawSortKey::QuantizeDistance(float distance, uint32_t bits)
+{
+	if (!(distance > 0.0f))
+	{
+		return 0u;        // also catches NaN
+	}
+	if (std::isinf(distance))
+	{
+		distance = 3.0e38f;
+	}
+	// Sign bit is zero, so the remaining 31 bits are monotonic in the value.
+	const uint32_t pattern = std::bit_cast<uint32_t>(distance);
+	return bits >= 31u ? pattern : (pattern >> (31u - bits));
+}
+
+uint64_t DrawSortKey::MakeOpaque(uint32_t pipelineId, uint32_t materialId, uint32_t meshId, float distance)
+{
+	uint64_t key = static_cast<uint64_t>(Pass::Opaque) << 62;
+	key |= static_cast<uint64_t>(pipelineId & 0xFu) << 58;
+	key |= static_cast<uint64_t>(materialId & 0xFFFFu) << 42;
+	key |= static_cast<uint64_t>(meshId & 0xFFFFFu) << 22;
+	key |= static_cast<uint64_t>(QuantizeDistance(distance, 22u));
+	return key;
+}
+
+uint64_t DrawSortKey::MakeTransparent(float distance, bool isLiquid, uint32_t pipelineId)
+{
+	const uint32_t inverted = 0x7FFFFFFFu - QuantizeDistance(distance, 31u);
+	uint64_t       key      = static_cast<uint64_t>(Pass::Transparent) << 62;
+	key |= static_cast<uint64_t>(inverted) << 31;
+	key |= static_cast<uint64_t>(isLiquid ? 0u : 1u) << 30;
+	key |= static_cast<uint64_t>(pipelineId & 0xFu) << 26;
+	return key;
+}
+
+void DrawKeySorter::Sort(std::vector<Entry> &entries)
+{
+	const size_t count = entries.size();
+	if (count < 2)
+	{
+		return;
+	}
+
+	// Build all eight digit histograms in a single read of the input.
+	std::array<std::array<uint32_t, 256>, 8> histograms{};
+	for (const Entry &e : entries)
+	{
+		for (uint32_t d = 0; d < 8; ++d)
+		{
+			++histograms[d][(e.key >> (d * 8u)) & 0xFFu];
+		}
+	}
+
+	scratch.resize(count);
+	Entry *src = entries.data();
+	Entry *dst = scratch.data();
+
+	for (uint32_t d = 0; d < 8; ++d)
+	{
+		auto &hist = histograms[d];
+		// Every key shares this digit: the pass would be an identity permutation.
+		if (hist[(src[0].key >> (d * 8u)) & 0xFFu] == count)
+		{
+			continue;
+		}
+
+		uint32_t offset = 0;
+		for (uint32_t &bucket : hist)
+		{
+			const uint32_t c = bucket;
+			bucket           = offset;
+			offset += c;
+		}
+
+		const uint32_t shift = d * 8u;
+		for (size_t i = 0; i < count; ++i)
+		{
+			dst[hist[(src[i].key >> shift) & 0xFFu]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
+
+	if (src != entries.data())
+	{
+		entries.swap(scratch);
+	}
+}
@@ -0,0 +1,86 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief 64-bit draw sort keys and a stable LSD radix sort over them.
+ *
+ * Opaque key layout (most significant first):
+ *   [63..62] pass
+ *   [61..58] pipeline id
+ *   [57..42] material id
+ *   [41..22] mesh id
+ *   [21..0]  quantized view distance (front-to-back)
+ *
+ * Transparent key layout:
+ *   [63..62] pass
+ *   [61..31] inverted distance (back-to-front, exact float ordering)
+ *   [30]     0 for liquids so they draw before the glass that contains them
+ *   [29..26] pipeline id
+ *
+ * Ids are truncated to their field width; a collision only weakens grouping,
+ * it never affects correctness.
+ */
+class DrawSortKey
+{
+  public:
+	enum class Pass : uint32_t
+	{
+		Opaque      = 0,
+		Transparent = 1
+	};
+
+	static uint64_t MakeOpaque(uint32_t pipelineId, uint32_t materialId, uint32_t meshId, float distance);
+	static uint64_t MakeTransparent(float distance, bool isLiquid, uint32_t pipelineId);
+
+	/**
+	 * @brief Map a non-negative distance to an integer with the same ordering.
+	 * Uses the IEEE-754 bit pattern (monotonic for positive floats) so no far
+	 * plane is needed; the top `bits` bits of the pattern are kept.
+	 */
+	static uint32_t QuantizeDistance(float distance, uint32_t bits);
+};
+
+/**
+ * @brief Stable LSD radix sort of (key, index) pairs, 8 bits per pass.
+ *
+ * Digit passes whose histogram has a single non-empty bucket are skipped, so
+ * keys that share their high bits (e.g. one pass, few pipelines) only pay for
+ * the digits that actually vary. Scratch storage is kept between calls to
+ * avoid per-frame allocations.
+ */
+class DrawKeySorter
+{
+  public:
+	struct Entry
+	{
+		uint64_t key;
+		uint32_t index;
+	};
+
+	/**
+	 * @brief Sort entries in place by ascending key.
+	 * @param entries The entries to sort.
+	 */
+	void Sort(std::vector<Entry> &entries);
+
+  private:
+	std::vector<Entry> scratch;
+};
@@ -15,8 +15,11 @@
  * limitations under the License.
  */
 #include "engine.h"
+#include "animation_system.h"
 #include "mesh_component.h"
+#include "profiler.h"
 #include "scene_loading.h"
+#include "transform_system.h"
 
 #include <algorithm>
 #include <chrono>
@@ -61,7 +64,7 @@ Engine::~Engine() {
   Cleanup();
 }
 
-bool Engine::Initialize(const std::string& appName, int width, int height, bool enableValidationLayers) {
+bool Engine::Initialize(const std::string& appName, int width, int height, bool enableValidationLayers, bool headless) {
   // Create platform
 #if defined(PLATFORM_ANDROID)
   // For Android, the platform is created with the android_app
@@ -71,7 +74,11 @@ bool Engine::Initialize(const std::string& appName, int width, int height, bool
   // Record main thread identity for deferring destructive operations from background threads
   mainThreadId = std::this_thread::get_id();
 
-  platform = CreatePlatform();
+  if (headless) {
+    platform = std::make_unique<HeadlessPlatform>();
+  } else {
+    platform = CreatePlatform();
+  }
   if (!platform->Initialize(appName, width, height)) {
     return false;
   }
@@ -118,6 +125,14 @@ bool Engine::Initialize(const std::string& appName, int width, int height, bool
     // ImGui via constructor, then connect audio system
     imguiSystem = std::make_unique<ImGuiSystem>(renderer.get(), width, height);
     imguiSystem->SetAudioSystem(audioSystem.get());
+    imguiSystem->SetPhysicsSystem(physicsSystem.get());
+
+    // Worker pool for per-frame simulation jobs (animation, transform propagation)
+    jobWorkerCount = std::clamp(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1u, 1u, 8u);
+    jobThreadPool = std::make_unique<ThreadPool>(jobWorkerCount);
+    // Asynchronous resource loads get their own workers: a load blocked on I/O must not hold up a frame's jobs
+    loadThreadPool = std::make_unique<ThreadPool>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+    resourceManager->SetThreadPool(loadThreadPool.get());
   } catch (const std::exception& e) {
     std::cerr << "Subsystem initialization failed: " << e.what() << std::endl;
     return false;
@@ -140,6 +155,7 @@ void Engine::Run() {
   }
 
   running = true;
+  Profiler::GetInstance().SetThreadName("Main");
 
   // Main loop
   while (running) {
@@ -185,7 +201,160 @@ void Engine::Run() {
 
     // Render
     Render();
+
+    // Collect this frame's profiler events from all threads
+    Profiler::GetInstance().EndFrame();
+  }
+}
+
+bool Engine::RunPerformanceTest(const PerfRunConfig& config) {
+  if (!initialized) {
+    throw std::runtime_error("Engine not initialized");
+  }
+
+  CameraPath path = CameraPath::Orbit(config.orbitCenter, config.orbitRadius, config.orbitSeconds);
+  if (!config.cameraPathFile.empty() && !path.LoadFromFile(config.cameraPathFile)) {
+    std::cerr << "Failed to load camera path: " << config.cameraPathFile << std::endl;
+    return false;
+  }
+
+  running = true;
+  Profiler::GetInstance().SetThreadName("Main");
+
+  // Fixed step: every run simulates and renders the same sequence of camera poses
+  const TimeDelta frameDelta(config.frameDeltaMs);
+  auto runFrame = [&](uint32_t pathFrame) {
+    platform->ProcessEvents();
+    deltaTimeMs = frameDelta;
+    frameCount++;
+    Update(frameDelta);
+
+    // Applied after Update so the interactive camera controls don't override the pose
+    if (activeCamera) {
+      if (auto* cameraTransform = activeCamera->GetOwner()->GetComponent<TransformComponent>()) {
+        glm::vec3 position, target;
+        path.Sample(static_cast<float>(pathFrame) * static_cast<float>(config.frameDeltaMs) * 0.001f, position, target);
+        // The view matrix is built from the transform, so orient it towards the target as well
+        const glm::vec3 forward = target - position;
+        if (glm::length(forward) > 1e-4f) {
+          cameraTransform->SetRotation(glm::eulerAngles(glm::quatLookAt(glm::normalize(forward), glm::vec3(0.0f, 1.0f, 0.0f))));
+        }
+        cameraTransform->SetPosition(position);
+        activeCamera->SetTarget(target);
+        activeCamera->ForceViewMatrixUpdate();
+      }
+    }
+
+    Render();
+    Profiler::GetInstance().EndFrame();
+  };
+
+  PerfRunReport report;
+  report.deviceName = renderer->GetDeviceName();
+  report.scene = config.scene;
+  report.cameraPath = config.cameraPathFile.empty() ? "orbit" : config.cameraPathFile;
+  report.width = static_cast<uint32_t>(platform->GetWindowWidth());
+  report.height = static_cast<uint32_t>(platform->GetWindowHeight());
+  report.warmupFrames = config.warmupFrames;
+  report.frameDeltaMs = config.frameDeltaMs;
+  renderer->SetSyntheticLightCount(config.syntheticLights);
+
+  // Let the scene finish loading; textures and acceleration structures stream in while frames render.
+  // A scene that fails to load, or never finishes (e.g. the AS build keeps failing), fails the run.
+  const auto loadStart = std::chrono::steady_clock::now();
+  const auto loadDeadline = loadStart + std::chrono::seconds(config.loadTimeoutSeconds);
+  auto failRun = [&](std::string error) {
+    report.error = std::move(error);
+    renderer->WaitIdle();
+    running = false;
+    std::cerr << "Performance run failed: " << report.error << std::endl;
+    if (!report.WriteJson(config.reportPath)) {
+      std::cerr << "Failed to write performance report: " << config.reportPath << std::endl;
+    }
+    return false;
+  };
+  while (renderer->IsLoading()) {
+    std::string error;
+    if (renderer->HasLoadFailed()) {
+      error = "Failed to load the scene";
+    } else if (std::chrono::steady_clock::now() > loadDeadline) {
+      error = "Scene still loading after " + std::to_string(config.loadTimeoutSeconds) + " s (phase " + renderer->GetLoadingPhaseName() + ")";
+    }
+    if (!error.empty()) {
+      report.loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+      return failRun(std::move(error));
+    }
+    runFrame(0);
+  }
+  report.loadSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - loadStart).count();
+  for (uint32_t i = 0; i < config.warmupFrames; ++i) {
+    runFrame(0);
+  }
+
+  // The island sleeping scenario advances with the physics thread's simulated time; keep rendering
+  // frames with the camera at rest until it reports, so the measured frames below don't include it
+  if (config.sleepBenchmarkBodies > 0) {
+    constexpr auto sleepBenchmarkTimeout = std::chrono::seconds(60);
+    physicsSystem->StartSleepBenchmark(config.sleepBenchmarkBodies);
+    const auto sleepDeadline = std::chrono::steady_clock::now() + sleepBenchmarkTimeout;
+    PhysicsSystem::SleepBenchmarkResult sleepResult = physicsSystem->GetSleepBenchmarkResult();
+    while (sleepResult.running && std::chrono::steady_clock::now() < sleepDeadline) {
+      runFrame(0);
+      sleepResult = physicsSystem->GetSleepBenchmarkResult();
+    }
+    if (sleepResult.running) {
+      return failRun("Sleep benchmark still running after " + std::to_string(sleepBenchmarkTimeout.count()) + " s");
+    }
+    if (sleepResult.bodies == 0) {
+      return failRun("Sleep benchmark could not create any bodies (GPU physics unavailable or no free body capacity)");
+    }
+    report.sleepBenchmark = PerfRunReport::SleepBenchmark{
+      .bodies = sleepResult.bodies,
+      .sleepingBodies = sleepResult.sleepingBodies,
+      .awakeStepMs = sleepResult.awakeStepMs,
+      .awakeLatencyMs = sleepResult.awakeLatencyMs,
+      .sleepingStepMs = sleepResult.sleepingStepMs,
+      .sleepingLatencyMs = sleepResult.sleepingLatencyMs,
+      .settleSeconds = sleepResult.settleSeconds
+    };
+  }
+
+  const uint64_t uploadedBefore = renderer->GetBytesUploadedTotal();
+  const auto runStart = std::chrono::steady_clock::now();
+  for (uint32_t i = 0; i < config.frames; ++i) {
+    const auto frameStart = std::chrono::steady_clock::now();
+    runFrame(i);
+    const auto frameEnd = std::chrono::steady_clock::now();
+
+    report.AddFrame({
+      .cpuMs = std::chrono::duration<double, std::milli>(frameEnd - frameStart).count(),
+      .draws = renderer->GetLastFrameDrawCount(),
+      .visible = renderer->GetLastCullingVisibleCount(),
+      .culled = renderer->GetLastCullingCulledCount(),
+      .triangles = renderer->GetLastFrameTriangleCount(),
+      .fullDetailTriangles = renderer->GetLastFrameFullDetailTriangleCount(),
+      .clusters = renderer->GetLastFrameClusterCount(),
+      .clustersCulled = renderer->GetLastFrameClusterCulledCount(),
+      .lights = renderer->GetLastFrameLightCount(),
+      .lightUpdateMs = renderer->GetLastLightUpdateMs()
+    });
+  }
+  report.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+  report.uploadBytes = renderer->GetBytesUploadedTotal() - uploadedBefore;
+  report.averageUploadMs = renderer->GetAverageUploadMs();
+  report.cpuMeshBytes = MeshGeometry::GetResidentBytes();
+  report.vertexStride = renderer->GetVertexStride();
+
+  renderer->WaitIdle();
+  running = false;
+
+  if (!report.WriteJson(config.reportPath)) {
+    std::cerr << "Failed to write performance report: " << config.reportPath << std::endl;
+    return false;
   }
+  std::cout << "Performance report written to " << config.reportPath << " (p50 " << report.GetFrameMsPercentile(50.0)
+      << " ms, p99 " << report.GetFrameMsPercentile(99.0) << " ms)" << std::endl;
+  return true;
 }
 
 void Engine::Cleanup() {
@@ -202,7 +371,11 @@ void Engine::Cleanup() {
       entityMap.clear();
     }
 
-    // Clean up subsystems in reverse order of creation
+    // Clean up subsystems in reverse order of creation; resources may still be loading on the load workers
+    resourceManager->UnloadAllResources();
+    resourceManager->SetThreadPool(nullptr);
+    loadThreadPool.reset();
+    jobThreadPool.reset();
     imguiSystem.reset();
     physicsSystem.reset();
     audioSystem.reset();
@@ -337,6 +510,10 @@ const ResourceManager* Engine::GetResourceManager() const {
   return resourceManager.get();
 }
 
+ResourceManager* Engine::GetResourceManager() {
+  return resourceManager.get();
+}
+
 const Platform* Engine::GetPlatform() const {
   return platform.get();
 }
@@ -473,9 +650,13 @@ void Engine::handleKeyInput(uint32_t key, bool pressed) {
 }
 
 void Engine::Update(TimeDelta deltaTime) {
+  PROFILE_SCOPE("Engine::Update");
   // Apply any entity removals requested by background threads.
   ProcessPendingEntityRemovals();
 
+  // Finish asynchronous resource loads and run their callbacks, also while a scene is loading
+  resourceManager->Update();
+
   // During background scene loading we avoid touching the live entity
   // list from the main thread. This lets the loading thread construct
   // entities/components safely while the main thread only drives the
@@ -485,6 +666,10 @@ void Engine::Update(TimeDelta deltaTime) {
   ->
   IsLoading()
   ) {
+    // The loader keeps placing and parenting entities; resolve their world matrices once here so
+    // GetModelMatrix does not fall back to walking the ancestors under the hierarchy lock for every
+    // query until loading ends
+    TransformSystem::GetInstance().Update(jobThreadPool.get(), jobWorkerCount);
     if (imguiSystem) {
       imguiSystem->NewFrame();
     }
@@ -499,11 +684,18 @@ void Engine::Update(TimeDelta deltaTime) {
     physicsSystem->SetCameraPosition(currentCameraPosition);
   }
 
-  // Use real deltaTime for physics to maintain proper timing
-  physicsSystem->Update(deltaTime);
+  // Physics simulates in fixed steps (on its own thread when available); this applies the
+  // interpolated results to the entities
+  {
+    PROFILE_SCOPE("Physics update");
+    physicsSystem->Update(deltaTime);
+  }
 
   // Update audio system
-  audioSystem->Update(deltaTime);
+  {
+    PROFILE_SCOPE("Audio update");
+    audioSystem->Update(deltaTime);
+  }
 
   // Update ImGui system
   imguiSystem->NewFrame();
@@ -524,11 +716,19 @@ void Engine::Update(TimeDelta deltaTime) {
       snapshot.push_back(uptr.get());
     }
   }
-  for (Entity* entity : snapshot) {
-    if (!entity || !entity->IsActive())
-      continue;
-    entity->Update(deltaTime);
+  {
+    PROFILE_SCOPE("Entity update");
+    for (Entity* entity : snapshot) {
+      if (!entity || !entity->IsActive())
+        continue;
+      entity->Update(deltaTime);
+    }
   }
+
+  // Sample all animation clips in parallel, then resolve world matrices for everything
+  // physics, animation and scripts moved this frame, before culling
+  AnimationSystem::GetInstance().Update(deltaTime, jobThreadPool.get(), jobWorkerCount);
+  TransformSystem::GetInstance().Update(jobThreadPool.get(), jobWorkerCount);
 }
 
 void Engine::Render() {
@@ -1003,6 +1203,14 @@ bool Engine::InitializeAndroid(android_app* app, const std::string& appName, boo
     // ImGui via constructor, then connect audio system
     imguiSystem = std::make_unique<ImGuiSystem>(renderer.get(), width, height);
     imguiSystem->SetAudioSystem(audioSystem.get());
+    imguiSystem->SetPhysicsSystem(physicsSystem.get());
+
+    // Worker pool for per-frame simulation jobs (animation, transform propagation)
+    jobWorkerCount = std::clamp(std::thread::hardware_concurrency() > 1 ? std::thread::hardware_concurrency() - 1 : 1u, 1u, 8u);
+    jobThreadPool = std::make_unique<ThreadPool>(jobWorkerCount);
+    // Asynchronous resource loads get their own workers: a load blocked on I/O must not hold up a frame's jobs
+    loadThreadPool = std::make_unique<ThreadPool>(std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u));
+    resourceManager->SetThreadPool(loadThreadPool.get());
   } catch (const std::exception& e) {
     std::cerr << "Subsystem initialization failed: " << e.what() << std::endl;
     return false;
@@ -1036,5 +1244,8 @@ void Engine::RunAndroid() {
 
   // Render
   Render();
+
+  // Collect this frame's profiler events from all threads
+  Profiler::GetInstance().EndFrame();
 }
 #endif
\ No newline at end of file
@@ -30,10 +30,12 @@
 #include "entity.h"
 #include "imgui_system.h"
 #include "model_loader.h"
+#include "perf_run.h"
 #include "physics_system.h"
 #include "platform.h"
 #include "renderer.h"
 #include "resource_manager.h"
+#include "thread_pool.h"
 
 /**
  * @brief Main engine class that manages the game loop and subsystems.
@@ -61,15 +63,25 @@ class Engine
 	 * @param width The width of the window.
 	 * @param height The height of the window.
 	 * @param enableValidationLayers Whether to enable Vulkan validation layers.
+	 * @param headless Render into offscreen images of the given size instead of a window.
 	 * @return True if initialization was successful, false otherwise.
 	 */
-	bool Initialize(const std::string &appName, int width, int height, bool enableValidationLayers = true);
+	bool Initialize(const std::string &appName, int width, int height, bool enableValidationLayers = true, bool headless = false);
 
 	/**
 	 * @brief Run the main game loop.
 	 */
 	void Run();
 
+	/**
+	 * @brief Run a scripted performance test instead of the interactive loop.
+	 * Waits for loading to finish, renders the warm-up frames, then moves the camera along
+	 * the configured path with a fixed time step and writes a JSON report of the measured frames.
+	 * @param config The run settings.
+	 * @return True if the report was written.
+	 */
+	bool RunPerformanceTest(const PerfRunConfig &config);
+
 	/**
 	 * @brief Clean up engine resources.
 	 */
@@ -129,6 +141,7 @@ class Engine
 	 * @return A pointer to the resource manager.
 	 */
 	const ResourceManager *GetResourceManager() const;
+	ResourceManager       *GetResourceManager();
 
 	/**
 	 * @brief Get the platform.
@@ -219,6 +232,9 @@ class Engine
 	std::unique_ptr<AudioSystem>     audioSystem;
 	std::unique_ptr<PhysicsSystem>   physicsSystem;
 	std::unique_ptr<ImGuiSystem>     imguiSystem;
+	std::unique_ptr<ThreadPool>      jobThreadPool;         // per-frame simulation jobs
+	uint32_t                         jobWorkerCount = 1;
+	std::unique_ptr<ThreadPool>      loadThreadPool;        // ResourceManager::LoadResourceAsync
 
 	// Entities
 	// NOTE: Entities can be created from a background loading thread (see `main.cpp`).
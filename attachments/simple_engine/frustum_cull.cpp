@@ -0,0 +1,477 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "frustum_cull.h"
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#	define FRUSTUM_CULL_X86 1
+#	include <immintrin.h>
+#	if defined(_MSC_VER) && !defined(__clang__)
+#		include <intrin.h>
+#		define FRUSTUM_CULL_TARGET(isa)
+#	else
+#		define FRUSTUM_CULL_TARGET(isa) __attribute__((target(isa)))
+#	endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define FRUSTUM_CULL_NEON 1
+#	include <arm_neon.h>
+#endif
+
+uint32_t AABBSoA::Add(const glm::vec3 &min, const glm::vec3 &max)
+{
+	const uint32_t slot = static_cast<uint32_t>(Size());
+	centerX.push_back(0.0f);
+	centerY.push_back(0.0f);
+	centerZ.push_back(0.0f);
+	extentX.push_back(0.0f);
+	extentY.push_back(0.0f);
+	extentZ.push_back(0.0f);
+	Set(slot, min, max);
+	return slot;
+}
+
+void AABBSoA::Set(uint32_t slot, const glm::vec3 &min, const glm::vec3 &max)
+{
+	const glm::vec3 c = 0.5f * (min + max);
+	const glm::vec3 e = 0.5f * (max - min);
+	centerX[slot]     = c.x;
+	centerY[slot]     = c.y;
+	centerZ[slot]     = c.z;
+	extentX[slot]     = e.x;
+	extentY[slot]     = e.y;
+	extentZ[slot]     = e.z;
+}
+
+uint32_t AABBSoA::Remove(uint32_t slot)
+{
+	const uint32_t last = static_cast<uint32_t>(Size() - 1);
+	for (auto *v : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ})
+	{
+		(*v)[slot] = (*v)[last];
+		v->pop_back();
+	}
+	return last;
+}
+
+void AABBSoA::Clear()
+{
+	for (auto *v : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ})
+	{
+		v->clear();
+	}
+}
+
+namespace
+{
+constexpr float CullEpsilon = 0.01f;
+
+struct PlaneSet
+{
+	float nx[6], ny[6], nz[6], w[6];
+	float ax[6], ay[6], az[6];
+
+	explicit PlaneSet(const glm::vec4 (&planes)[6])
+	{
+		for (int i = 0; i < 6; ++i)
+		{
+			nx[i] = planes[i].x;
+			ny[i] = planes[i].y;
+			nz[i] = planes[i].z;
+			w[i]  = planes[i].w;
+			ax[i] = std::fabs(planes[i].x);
+			ay[i] = std::fabs(planes[i].y);
+			az[i] = std::fabs(planes[i].z);
+		}
+	}
+};
+
+// Reference implementation; also handles the tail of the vector paths.
+uint32_t CullScalar(const AABBSoA &b, const PlaneSet &p, size_t begin, size_t end, uint32_t *out)
+{
+	uint32_t count = 0;
+	for (size_t i = begin; i < end; ++i)
+	{
+		bool outside = false;
+		for (int k = 0; k < 6; ++k)
+		{
+			const float d = ((p.nx[k] * b.centerX[i] + p.ny[k] * b.centerY[i]) + p.nz[k] * b.centerZ[i]) + p.w[k];
+			const float r = (p.ax[k] * b.extentX[i] + p.ay[k] * b.extentY[i]) + p.az[k] * b.extentZ[i];
+			outside |= (d + r < -CullEpsilon);
+		}
+		if (!outside)
+		{
+			out[count++] = static_cast<uint32_t>(i);
+		}
+	}
+	return count;
+}
+
+template <typename Mask>
+inline uint32_t EmitMask(Mask visible, size_t base, uint32_t *out)
+{
+	uint32_t count = 0;
+	while (visible)
+	{
+#if defined(_MSC_VER) && !defined(__clang__)
+		unsigned long bit;
+		_BitScanForward(&bit, static_cast<unsigned long>(visible));
+#else
+		const unsigned bit = static_cast<unsigned>(__builtin_ctz(static_cast<unsigned>(visible)));
+#endif
+		out[count++] = static_cast<uint32_t>(base + bit);
+		visible &= visible - 1;
+	}
+	return count;
+}
+
+#if defined(FRUSTUM_CULL_X86)
+uint32_t CullSSE2(const AABBSoA &b, const PlaneSet &p, uint32_t *out)
+{
+	const size_t   n      = b.Size();
+	const size_t   vecEnd = n & ~size_t(3);
+	const __m128   negEps = _mm_set1_ps(-CullEpsilon);
+	uint32_t       count  = 0;
+	for (size_t i = 0; i < vecEnd; i += 4)
+	{
+		const __m128 cx = _mm_loadu_ps(&b.centerX[i]), cy = _mm_loadu_ps(&b.centerY[i]), cz = _mm_loadu_ps(&b.centerZ[i]);
+		const __m128 ex = _mm_loadu_ps(&b.extentX[i]), ey = _mm_loadu_ps(&b.extentY[i]), ez = _mm_loadu_ps(&b.extentZ[i]);
+		__m128       outside = _mm_setzero_ps();
+		for (int k = 0; k < 6; ++k)
+		{
+			__m128 d = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.nx[k]), cx), _mm_mul_ps(_mm_set1_ps(p.ny[k]), cy));
+			d        = _mm_add_ps(_mm_add_ps(d, _mm_mul_ps(_mm_set1_ps(p.nz[k]), cz)), _mm_set1_ps(p.w[k]));
+			__m128 r = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.ax[k]), ex), _mm_mul_ps(_mm_set1_ps(p.ay[k]), ey));
+			r        = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(p.az[k]), ez));
+			outside  = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(d, r), negEps));
+		}
+		count += EmitMask(static_cast<uint32_t>(~_mm_movemask_ps(outside)) & 0xFu, i, out + count);
+	}
+	return count + CullScalar(b, p, vecEnd, n, out + count);
+}
+
+FRUSTUM_CULL_TARGET("avx2")
+uint32_t CullAVX2(const AABBSoA &b, const PlaneSet &p, uint32_t *out)
+{
+	const size_t n      = b.Size();
+	const size_t vecEnd = n & ~size_t(7);
+	const __m256 negEps = _mm256_set1_ps(-CullEpsilon);
+	uint32_t     count  = 0;
+	for (size_t i = 0; i < vecEnd; i += 8)
+	{
+		const __m256 cx = _mm256_loadu_ps(&b.centerX[i]), cy = _mm256_loadu_ps(&b.centerY[i]), cz = _mm256_loadu_ps(&b.centerZ[i]);
+		const __m256 ex = _mm256_loadu_ps(&b.extentX[i]), ey = _mm256_loadu_ps(&b.extentY[i]), ez = _mm256_loadu_ps(&b.extentZ[i]);
+		__m256       outside = _mm256_setzero_ps();
+		for (int k = 0; k < 6; ++k)
+		{
+			// Separate mul/add (no FMA) keeps results bit-identical to the scalar reference
+			__m256 d = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.nx[k]), cx), _mm256_mul_ps(_mm256_set1_ps(p.ny[k]), cy));
+			d        = _mm256_add_ps(_mm256_add_ps(d, _mm256_mul_ps(_mm256_set1_ps(p.nz[k]), cz)), _mm256_set1_ps(p.w[k]));
+			__m256 r = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.ax[k]), ex), _mm256_mul_ps(_mm256_set1_ps(p.ay[k]), ey));
+			r        = _mm256_add_ps(r, _mm256_mul_ps(_mm256_set1_ps(p.az[k]), ez));
+			outside  = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(d, r), negEps, _CMP_LT_OQ));
+		}
+		count += EmitMask(static_cast<uint32_t>(~_mm256_movemask_ps(outside)) & 0xFFu, i, out + count);
+	}
+	return count + CullScalar(b, p, vecEnd, n, out + count);
+}
+
+FRUSTUM_CULL_TARGET("avx512f")
+uint32_t CullAVX512(const AABBSoA &b, const PlaneSet &p, uint32_t *out)
+{
+	const size_t  n      = b.Size();
+	const size_t  vecEnd = n & ~size_t(15);
+	const __m512  negEps = _mm512_set1_ps(-CullEpsilon);
+	const __m512i lane   = _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	uint32_t      count  = 0;
+	for (size_t i = 0; i < vecEnd; i += 16)
+	{
+		const __m512 cx = _mm512_loadu_ps(&b.centerX[i]), cy = _mm512_loadu_ps(&b.centerY[i]), cz = _mm512_loadu_ps(&b.centerZ[i]);
+		const __m512 ex = _mm512_loadu_ps(&b.extentX[i]), ey = _mm512_loadu_ps(&b.extentY[i]), ez = _mm512_loadu_ps(&b.extentZ[i]);
+		__mmask16    outside = 0;
+		for (int k = 0; k < 6; ++k)
+		{
+			__m512 d = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(p.nx[k]), cx), _mm512_mul_ps(_mm512_set1_ps(p.ny[k]), cy));
+			d        = _mm512_add_ps(_mm512_add_ps(d, _mm512_mul_ps(_mm512_set1_ps(p.nz[k]), cz)), _mm512_set1_ps(p.w[k]));
+			__m512 r = _mm512_add_ps(_mm512_mul_ps(_mm512_set1_ps(p.ax[k]), ex), _mm512_mul_ps(_mm512_set1_ps(p.ay[k]), ey));
+			r        = _mm512_add_ps(r, _mm512_mul_ps(_mm512_set1_ps(p.az[k]), ez));
+			outside |= _mm512_cmp_ps_mask(_mm512_add_ps(d, r), negEps, _CMP_LT_OQ);
+		}
+		const __mmask16 visible = static_cast<__mmask16>(~outside);
+		// Compress the visible lane indices straight into the output list
+		_mm512_mask_compressstoreu_epi32(out + count, visible, _mm512_add_epi32(lane, _mm512_set1_epi32(static_cast<int>(i))));
+		count += static_cast<uint32_t>(std::popcount(static_cast<uint32_t>(visible)));
+	}
+	return count + CullScalar(b, p, vecEnd, n, out + count);
+}
+
+bool CpuSupports(FrustumCullKernel::Isa isa)
+{
+#	if defined(_MSC_VER) && !defined(__clang__)
+	int regs[4];
+	__cpuid(regs, 1);
+	const bool osxsave = (regs[2] & (1 << 27)) != 0;
+	const bool avx     = (regs[2] & (1 << 28)) != 0;
+	if (!osxsave || !avx)
+	{
+		return false;
+	}
+	const unsigned long long xcr0 = _xgetbv(0);
+	__cpuidex(regs, 7, 0);
+	if (isa == FrustumCullKernel::Isa::AVX2)
+	{
+		return (xcr0 & 0x6) == 0x6 && (regs[1] & (1 << 5)) != 0;
+	}
+	return (xcr0 & 0xE6) == 0xE6 && (regs[1] & (1 << 16)) != 0;
+#	else
+	__builtin_cpu_init();
+	return isa == FrustumCullKernel::Isa::AVX2 ? __builtin_cpu_supports("avx2") : __builtin_cpu_supports("avx512f");
+#	endif
+}
+#endif
+
+#if defined(FRUSTUM_CULL_NEON)
+uint32_t CullNEON(const AABBSoA &b, const PlaneSet &p, uint32_t *out)
+{
+	const size_t      n      = b.Size();
+	const size_t      vecEnd = n & ~size_t(3);
+	const float32x4_t negEps = vdupq_n_f32(-CullEpsilon);
+	const uint32x4_t  bits   = {1u, 2u, 4u, 8u};
+	uint32_t          count  = 0;
+	for (size_t i = 0; i < vecEnd; i += 4)
+	{
+		const float32x4_t cx = vld1q_f32(&b.centerX[i]), cy = vld1q_f32(&b.centerY[i]), cz = vld1q_f32(&b.centerZ[i]);
+		const float32x4_t ex = vld1q_f32(&b.extentX[i]), ey = vld1q_f32(&b.extentY[i]), ez = vld1q_f32(&b.extentZ[i]);
+		uint32x4_t        outside = vdupq_n_u32(0);
+		for (int k = 0; k < 6; ++k)
+		{
+			// vmulq/vaddq rather than vmlaq/vfmaq so rounding matches the scalar reference
+			float32x4_t d = vaddq_f32(vmulq_n_f32(cx, p.nx[k]), vmulq_n_f32(cy, p.ny[k]));
+			d             = vaddq_f32(vaddq_f32(d, vmulq_n_f32(cz, p.nz[k])), vdupq_n_f32(p.w[k]));
+			float32x4_t r = vaddq_f32(vmulq_n_f32(ex, p.ax[k]), vmulq_n_f32(ey, p.ay[k]));
+			r             = vaddq_f32(r, vmulq_n_f32(ez, p.az[k]));
+			outside       = vorrq_u32(outside, vcltq_f32(vaddq_f32(d, r), negEps));
+		}
+		const uint32_t mask = vaddvq_u32(vandq_u32(outside, bits));
+		count += EmitMask(~mask & 0xFu, i, out + count);
+	}
+	return count + CullScalar(b, p, vecEnd, n, out + count);
+}
+#endif
+}        // namespace
+
+bool FrustumCullKernel::IsSupported(Isa isa)
+{
+	switch (isa)
+	{
+		case Isa::Scalar:
+			return true;
+#if defined(FRUSTUM_CULL_X86)
+		case Isa::SSE2:
+			return true;
+		case Isa::AVX2:
+		case Isa::AVX512:
+			return CpuSupports(isa);
+#endif
+#if defined(FRUSTUM_CULL_NEON)
+		case Isa::NEON:
+			return true;
+#endif
+		default:
+			return false;
+	}
+}
+
+FrustumCullKernel::Isa FrustumCullKernel::DetectBestIsa()
+{
+#if defined(FRUSTUM_CULL_X86)
+	if (CpuSupports(Isa::AVX512))
+	{
+		return Isa::AVX512;
+	}
+	if (CpuSupports(Isa::AVX2))
+	{
+		return Isa::AVX2;
+	}
+	return Isa::SSE2;
+#elif defined(FRUSTUM_CULL_NEON)
+	return Isa::NEON;
+#else
+	return Isa::Scalar;
+#endif
+}
+
+const char *FrustumCullKernel::GetIsaName(Isa isa)
+{
+	switch (isa)
+	{
+		case Isa::SSE2:
+			return "SSE2";
+		case Isa::AVX2:
+			return "AVX2";
+		case Isa::AVX512:
+			return "AVX-512";
+		case Isa::NEON:
+			return "NEON";
+		default:
+			return "Scalar";
+	}
+}
+
+uint32_t FrustumCullKernel::Cull(Isa isa, const AABBSoA &boxes, const glm::vec4 (&planes)[6], std::vector<uint32_t> &outIndices)
+{
+	outIndices.resize(boxes.Size());
+	const PlaneSet p(planes);
+	uint32_t       count = 0;
+	switch (isa)
+	{
+#if defined(FRUSTUM_CULL_X86)
+		case Isa::SSE2:
+			count = CullSSE2(boxes, p, outIndices.data());
+			break;
+		case Isa::AVX2:
+			count = CullAVX2(boxes, p, outIndices.data());
+			break;
+		case Isa::AVX512:
+			count = CullAVX512(boxes, p, outIndices.data());
+			break;
+#endif
+#if defined(FRUSTUM_CULL_NEON)
+		case Isa::NEON:
+			count = CullNEON(boxes, p, outIndices.data());
+			break;
+#endif
+		default:
+			count = CullScalar(boxes, p, 0, boxes.Size(), outIndices.data());
+			break;
+	}
+	outIndices.resize(count);
+	return count;
+}
+
+bool FrustumCullKernel::IntersectsBox(const glm::vec3 &min, const glm::vec3 &max, const glm::vec4 (&planes)[6])
+{
+	for (const auto &p : planes)
+	{
+		const glm::vec3 n(p.x, p.y, p.z);
+		// Positive vertex: the corner furthest along the normal
+		const glm::vec3 v(n.x >= 0.0f ? max.x : min.x, n.y >= 0.0f ? max.y : min.y, n.z >= 0.0f ? max.z : min.z);
+		if (glm::dot(n, v) + p.w < -CullEpsilon)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+FrustumCullKernel::BenchmarkResult FrustumCullKernel::Benchmark(uint32_t boxCount, uint32_t planeSets)
+{
+	BenchmarkResult result;
+	for (Isa isa : {Isa::Scalar, Isa::SSE2, Isa::AVX2, Isa::AVX512, Isa::NEON})
+	{
+		if (IsSupported(isa))
+		{
+			result.paths.push_back({isa});
+		}
+	}
+
+	std::mt19937                          rng(29);
+	std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+	const auto randomPlanes = [&](glm::vec4 (&planes)[6]) {
+		for (auto &plane : planes)
+		{
+			glm::vec3 n(unit(rng), unit(rng), unit(rng));
+			n     = glm::length(n) > 1e-3f ? glm::normalize(n) : glm::vec3(0.0f, 1.0f, 0.0f);
+			plane = glm::vec4(n, 40.0f + unit(rng) * 60.0f);
+		}
+	};
+	const auto randomBoxes = [&](uint32_t count, AABBSoA &boxes, std::vector<glm::vec3> &corners) {
+		boxes.Clear();
+		corners.resize(static_cast<size_t>(count) * 2);
+		for (uint32_t i = 0; i < count; ++i)
+		{
+			const glm::vec3 center(unit(rng) * 100.0f, unit(rng) * 100.0f, unit(rng) * 100.0f);
+			const glm::vec3 extent(std::abs(unit(rng)) * 5.0f, std::abs(unit(rng)) * 5.0f, std::abs(unit(rng)) * 5.0f);
+			corners[2 * i]     = center - extent;
+			corners[2 * i + 1] = center + extent;
+			boxes.Add(corners[2 * i], corners[2 * i + 1]);
+		}
+	};
+
+	// Distance of a box from being culled, in double precision; near zero the float forms may disagree
+	const auto margin = [](const glm::vec3 &min, const glm::vec3 &max, const glm::vec4 (&planes)[6]) {
+		double closest = std::numeric_limits<double>::max();
+		for (const auto &p : planes)
+		{
+			double s = static_cast<double>(p.w) + CullEpsilon;
+			for (int a = 0; a < 3; ++a)
+			{
+				s += static_cast<double>(p[a]) * (p[a] >= 0.0f ? max[a] : min[a]);
+			}
+			closest = std::min(closest, s);
+		}
+		return closest;
+	};
+
+	AABBSoA                boxes;
+	std::vector<glm::vec3> corners;
+	std::vector<uint32_t>  reference, visible;
+	glm::vec4              planes[6];
+
+	// Timed set, plus every count up to 40 for the vector tails
+	for (uint32_t count = 0; count <= 40; ++count)
+	{
+		const bool timed = count == 40;
+		randomBoxes(timed ? boxCount : count, boxes, corners);
+		for (uint32_t s = 0; s < planeSets; ++s)
+		{
+			randomPlanes(planes);
+			for (auto &path : result.paths)
+			{
+				const auto start = std::chrono::steady_clock::now();
+				Cull(path.isa, boxes, planes, path.isa == Isa::Scalar ? reference : visible);
+				if (timed)
+				{
+					path.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / planeSets;
+				}
+				if (path.isa != Isa::Scalar && visible != reference)
+				{
+					++path.mismatches;
+				}
+			}
+			++result.lists;
+
+			size_t next = 0;
+			for (uint32_t i = 0; i < boxes.Size(); ++i)
+			{
+				const bool kernelVisible = next < reference.size() && reference[next] == i;
+				next += kernelVisible ? 1 : 0;
+				if (kernelVisible != IntersectsBox(corners[2 * i], corners[2 * i + 1], planes) &&
+				    std::abs(margin(corners[2 * i], corners[2 * i + 1], planes)) > 1e-3)
+				{
+					++result.boxTestMismatches;
+				}
+			}
+		}
+	}
+	return result;
+}
@@ -0,0 +1,121 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief World-space boxes stored as center/extent structure-of-arrays.
+ *
+ * Slots are dense; Remove swaps the last box into the freed slot and returns
+ * the slot it came from so owners can fix up their stored index.
+ */
+struct AABBSoA
+{
+	std::vector<float> centerX, centerY, centerZ;
+	std::vector<float> extentX, extentY, extentZ;
+
+	size_t Size() const
+	{
+		return centerX.size();
+	}
+
+	uint32_t Add(const glm::vec3 &min, const glm::vec3 &max);
+	void     Set(uint32_t slot, const glm::vec3 &min, const glm::vec3 &max);
+
+	/**
+	 * @brief Remove a slot by moving the last box into it.
+	 * @return The previous index of the moved box (equal to slot if none moved).
+	 */
+	uint32_t Remove(uint32_t slot);
+
+	void Clear();
+};
+
+/**
+ * @brief Batch frustum test over AABBSoA with a runtime-selected instruction set.
+ *
+ * A box is culled when, for any plane, dot(n, c) + w + dot(|n|, e) < -0.01
+ * (the center/extent form of the positive-vertex test). Every variant evaluates
+ * that expression with the same unfused operation order, and frustum_cull.cpp is
+ * compiled without floating-point contraction (see CMakeLists.txt), so the SIMD
+ * paths produce exactly the same visible set as the scalar one. IntersectsBox,
+ * the positive-vertex form, rounds differently and can only disagree for boxes
+ * within rounding distance of a plane.
+ */
+class FrustumCullKernel
+{
+  public:
+	enum class Isa : uint32_t
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+		AVX512,
+		NEON
+	};
+
+	struct BenchmarkResult
+	{
+		struct Path
+		{
+			Isa      isa        = Isa::Scalar;
+			double   ms         = 0.0;        // one Cull call, averaged over the plane sets
+			uint32_t mismatches = 0;          // visible lists that differ from the scalar path's
+		};
+
+		std::vector<Path> paths;                    // every supported instruction set, scalar first
+		uint32_t          lists             = 0;    // visible lists compared per path
+		uint32_t          boxTestMismatches = 0;    // scalar path against IntersectsBox, away from plane boundaries
+	};
+
+	/**
+	 * @brief Pick the widest instruction set supported by the CPU and OS.
+	 */
+	static Isa DetectBestIsa();
+
+	static bool IsSupported(Isa isa);
+
+	static const char *GetIsaName(Isa isa);
+
+	/**
+	 * @brief Test every box against six planes and write the indices of the visible ones.
+	 * @param isa Instruction set to use; must be supported (see DetectBestIsa).
+	 * @param boxes The boxes to test.
+	 * @param planes Plane equations (n, w), inside when dot(n, p) + w >= 0.
+	 * @param outIndices Receives the visible slot indices in ascending order; resized as needed.
+	 * @return The number of visible boxes.
+	 */
+	static uint32_t Cull(Isa isa, const AABBSoA &boxes, const glm::vec4 (&planes)[6], std::vector<uint32_t> &outIndices);
+
+	/**
+	 * @brief Test one box with the positive-vertex form of the same test.
+	 * @return False if the box is outside any plane.
+	 */
+	static bool IntersectsBox(const glm::vec3 &min, const glm::vec3 &max, const glm::vec4 (&planes)[6]);
+
+	/**
+	 * @brief Time every supported path on random boxes and planes and compare their visible lists.
+	 * @param boxCount Number of boxes in the timed set; smaller sets cover the vector tails.
+	 * @param planeSets Number of random plane sets.
+	 */
+	static BenchmarkResult Benchmark(uint32_t boxCount, uint32_t planeSets);
+};
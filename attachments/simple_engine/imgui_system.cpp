@@ -16,6 +16,7 @@
  */
 #include "imgui_system.h"
 #include "audio_system.h"
+#include "physics_system.h"
 #include "renderer.h"
 
 // Include ImGui headers
@@ -203,6 +204,14 @@ void ImGuiSystem::NewFrame() {
           const uint32_t done = renderer->GetASBuildItemsDone();
           const uint32_t total = renderer->GetASBuildItemsTotal();
           ImGui::Text("%s (%u/%u, %.1fs)", renderer->GetASBuildStage(), done, total, renderer->GetASBuildElapsedSeconds());
+          const auto& blasStats = renderer->GetBLASBuildStats();
+          if (blasStats.blasCount > 0 && blasStats.totalMs > 0.0) {
+            ImGui::Text("BLAS memory: %.1f MB -> %.1f MB compacted (%u BLAS)",
+                        static_cast<double>(blasStats.buildBytes) / (1024.0 * 1024.0),
+                        static_cast<double>(blasStats.compactedBytes) / (1024.0 * 1024.0),
+                        blasStats.blasCount);
+            ImGui::Text("Build time: %.2fs (BLAS %.2fs)", blasStats.totalMs / 1000.0, blasStats.buildMs / 1000.0);
+          }
         }
         ImGui::EndGroup();
         ImGui::PopStyleVar();
@@ -458,6 +467,44 @@ void ImGuiSystem::NewFrame() {
     ImGui::Text("Camera: Manual control (WASD + mouse)");
   }
 
+  // GPU physics pipeline: fixed steps, results are applied one step after submission
+  if (physicsSystem) {
+    const PhysicsSystem::Stats physicsStats = physicsSystem->GetStats();
+    ImGui::Separator();
+    bool simulationThread = physicsSystem->IsSimulationThreadEnabled();
+    if (ImGui::Checkbox("Physics on simulation thread", &simulationThread)) {
+      physicsSystem->SetSimulationThreadEnabled(simulationThread);
+    }
+    ImGui::Text("Physics: %.2f ms step, %u substep(s), %llu fixed steps, %llu dropped",
+                physicsStats.stepMs,
+                physicsStats.substeps,
+                static_cast<unsigned long long>(physicsStats.fixedSteps),
+                static_cast<unsigned long long>(physicsStats.droppedSteps));
+    ImGui::Text("Physics: %.2f ms game thread, %u bodies uploaded", physicsStats.cpuMs, physicsStats.uploadedBodies);
+    ImGui::Text("Physics latency: %u step(s), %.2f ms", physicsStats.latencySteps, physicsStats.latencyMs);
+    ImGui::Text("Physics steps: %llu submitted, %llu deferred, %llu fence waits",
+                static_cast<unsigned long long>(physicsStats.submittedSteps),
+                static_cast<unsigned long long>(physicsStats.deferredSteps),
+                static_cast<unsigned long long>(physicsStats.fenceWaits));
+    ImGui::Text("Physics bodies: %u awake, %u sleeping", physicsStats.awakeBodies, physicsStats.sleepingBodies);
+
+    const PhysicsSystem::SleepBenchmarkResult sleepResult = physicsSystem->GetSleepBenchmarkResult();
+    if (sleepResult.running) {
+      ImGui::Text("Sleep benchmark running...");
+    } else if (ImGui::Button("Sleep benchmark (2000 bodies)")) {
+      physicsSystem->StartSleepBenchmark(2000);
+    }
+    if (!sleepResult.running && sleepResult.bodies > 0) {
+      ImGui::Text("Moving: %.2f ms step, %.2f ms latency", sleepResult.awakeStepMs, sleepResult.awakeLatencyMs);
+      ImGui::Text("Settled: %.2f ms step, %.2f ms latency (%u/%u asleep after %.1f s)",
+                  sleepResult.sleepingStepMs,
+                  sleepResult.sleepingLatencyMs,
+                  sleepResult.sleepingBodies,
+                  sleepResult.bodies,
+                  sleepResult.settleSeconds);
+    }
+  }
+
   // Texture loading progress
   if (renderer) {
     const uint32_t scheduled = renderer->GetTextureTasksScheduled();
@@ -27,6 +27,7 @@
 class Renderer;
 class AudioSystem;
 class AudioSource;
+class PhysicsSystem;
 struct ImGuiContext;
 
 /**
@@ -124,6 +125,14 @@ class ImGuiSystem {
 	 */
     void SetAudioSystem(AudioSystem* audioSystem);
 
+    /**
+	 * @brief Set the physics system reference for the simulation statistics.
+	 * @param physicsSystem Pointer to the physics system.
+	 */
+    void SetPhysicsSystem(PhysicsSystem* physicsSystem) {
+      this->physicsSystem = physicsSystem;
+    }
+
     /**
 	 * @brief Get the current PBR rendering state.
 	 * @return True if PBR rendering is enabled, false otherwise.
@@ -172,6 +181,9 @@ class ImGuiSystem {
     AudioSource* audioSource = nullptr;
     AudioSource* debugPingSource = nullptr;
 
+    // Physics system reference
+    PhysicsSystem* physicsSystem = nullptr;
+
     // Audio position tracking
     float audioSourceX = 1.0f;
     float audioSourceY = 0.0f;
@@ -0,0 +1,621 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "light_clusterer.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <future>
+#include <limits>
+#include <numeric>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define LIGHT_CLUSTER_SSE2 1
+#	include <emmintrin.h>
+#endif
+
+namespace
+{
+double MsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Run fn(begin, end) over [0, count), split into taskCount ranges on the pool when there is one.
+// The ranges reference fn, so all of them finish before the first exception is rethrown.
+template <typename Fn>
+void ForRanges(ThreadPool *pool, uint32_t taskCount, uint32_t count, Fn &&fn)
+{
+	if (!pool || taskCount <= 1 || count < 2)
+	{
+		fn(0u, count);
+		return;
+	}
+	const uint32_t                 chunk = (count + taskCount - 1) / taskCount;
+	std::vector<std::future<void>> futures;
+	futures.reserve(taskCount);
+	uint32_t queued = 0;        // ranges below this one are on the pool
+	try
+	{
+		for (; queued < count; queued += chunk)
+		{
+			futures.push_back(pool->enqueue([&fn, b = queued, e = std::min(count, queued + chunk)]() { fn(b, e); }));
+		}
+	}
+	catch (...)
+	{
+		// The pool is shutting down; the rest runs below
+	}
+
+	std::exception_ptr error;
+	if (queued < count)
+	{
+		try
+		{
+			fn(queued, count);
+		}
+		catch (...)
+		{
+			error = std::current_exception();
+		}
+	}
+	for (auto &f : futures)
+	{
+		try
+		{
+			f.get();
+		}
+		catch (...)
+		{
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+
+// Synthetic point lights in front of a camera at the origin looking down -Z, projected the way the renderer projects
+void MakeBenchmarkScene(uint32_t lightCount, uint32_t width, uint32_t height, uint32_t seed, LightClusterer::Params &params, std::vector<LightClusterer::Light> &lights)
+{
+	params              = {};
+	params.screenWidth  = static_cast<float>(width);
+	params.screenHeight = static_cast<float>(height);
+	params.tilesX       = (width + 15) / 16;
+	params.tilesY       = (height + 15) / 16;
+	params.slicesZ      = 16;
+	params.nearZ        = 0.1f;
+	params.farZ         = 100.0f;
+	const float aspect  = params.screenWidth / params.screenHeight;
+	const float f       = 1.0f / std::tan(glm::radians(60.0f) * 0.5f);
+	params.proj         = glm::mat4(0.0f);
+	params.proj[0][0]   = f / aspect;
+	params.proj[1][1]   = -f;
+	params.proj[2][2]   = params.farZ / (params.nearZ - params.farZ);
+	params.proj[2][3]   = -1.0f;
+	params.proj[3][2]   = -(params.farZ * params.nearZ) / (params.farZ - params.nearZ);
+
+	std::mt19937                          rng(seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	lights.assign(lightCount, {});
+	for (auto &L : lights)
+	{
+		const float depth = 1.0f + unit(rng) * 90.0f;
+		L.position        = glm::vec3((unit(rng) * 2.0f - 1.0f) * depth * 0.6f * aspect, (unit(rng) * 2.0f - 1.0f) * depth * 0.6f, -depth);
+		L.range           = 0.5f + unit(rng) * 2.5f;
+	}
+}
+
+// Squared distance from a point to the nearest point of a rectangle, in the shader's operation order.
+inline float RectDistance2(float x, float y, float minX, float minY, float maxX, float maxY)
+{
+	const float dx = std::min(std::max(x, minX), maxX) - x;
+	const float dy = std::min(std::max(y, minY), maxY) - y;
+	return dx * dx + dy * dy;
+}
+
+// Lights that pass a row's vertical test, compacted for the per-tile loop.
+// Arrays are padded to a multiple of four with entries that never pass.
+struct RowLights
+{
+	std::vector<uint32_t> index;
+	std::vector<float>    x, dy2, r2;
+
+	void Clear()
+	{
+		index.clear();
+		x.clear();
+		dy2.clear();
+		r2.clear();
+	}
+
+	void Pad()
+	{
+		while (x.size() % 4 != 0)
+		{
+			x.push_back(0.0f);
+			dy2.push_back(0.0f);
+			r2.push_back(-1.0f);
+		}
+	}
+};
+}        // namespace
+
+void LightClusterer::Setup(const Params &params, std::span<const Light> lights)
+{
+	const auto n = lights.size();
+	centerX.resize(n);
+	centerY.resize(n);
+	radius2.resize(n);
+	zMin.resize(n);
+	zMax.resize(n);
+	ids.resize(n);
+
+	const float projXX = params.proj[0][0];
+	const float projYY = params.proj[1][1];
+	for (size_t i = 0; i < n; ++i)
+	{
+		const Light &L = lights[i];
+		ids[i]         = L.id == Light::NoId ? static_cast<uint32_t>(i) : L.id;
+		if (L.directional)
+		{
+			// Treated as global by the shader: a huge circle at the origin and every depth
+			const float radius = 1e9f;
+			centerX[i]         = 0.0f;
+			centerY[i]         = 0.0f;
+			radius2[i]         = radius * radius;
+			zMin[i]            = 0.0f;
+			zMax[i]            = std::numeric_limits<float>::infinity();
+			continue;
+		}
+
+		const glm::vec4 posVS = params.view * glm::vec4(L.position, 1.0f);
+		const float     z     = std::max(1e-3f, std::abs(posVS.z));
+		zMin[i]               = std::max(0.0f, z - L.range);
+		zMax[i]               = z + L.range;
+
+		const glm::vec4 clip = params.proj * glm::vec4(glm::vec3(posVS), 1.0f);
+		const float     invW = (clip.w != 0.0f) ? 1.0f / clip.w : 0.0f;
+		centerX[i]           = (clip.x * invW * 0.5f + 0.5f) * params.screenWidth;
+		centerY[i]           = (clip.y * invW * 0.5f + 0.5f) * params.screenHeight;
+
+		const float rx     = std::abs(L.range * projXX / z) * (params.screenWidth * 0.5f);
+		const float ry     = std::abs(L.range * projYY / z) * (params.screenHeight * 0.5f);
+		const float radius = std::max(rx, ry);
+		radius2[i]         = radius * radius;
+	}
+}
+
+void LightClusterer::ComputeSlices(const Params &params, uint32_t slices)
+{
+	const float nearZ   = std::max(params.nearZ, 1e-3f);
+	const float farZ    = std::max(params.farZ, nearZ + 1e-3f);
+	const float logNear = std::log(nearZ);
+	const float logFar  = std::log(farZ);
+	sliceNear.resize(slices);
+	sliceFar.resize(slices);
+	for (uint32_t cz = 0; cz < slices; ++cz)
+	{
+		const float f0 = static_cast<float>(cz) / static_cast<float>(slices);
+		const float f1 = static_cast<float>(cz + 1) / static_cast<float>(slices);
+		sliceNear[cz]  = std::exp(logNear + f0 * (logFar - logNear));
+		sliceFar[cz]   = std::exp(logNear + f1 * (logFar - logNear));
+	}
+}
+
+void LightClusterer::Build(const Params &params, std::span<const Light> lights, TileHeader *headers, uint32_t *indices, ThreadPool *pool, uint32_t taskCount)
+{
+	auto start = std::chrono::steady_clock::now();
+
+	const uint32_t tilesX     = params.tilesX;
+	const uint32_t tilesY     = params.tilesY;
+	const uint32_t slices     = std::max(params.slicesZ, 1u);
+	const uint32_t maxPerTile = params.maxPerTile;
+	const auto     lightCount = static_cast<uint32_t>(lights.size());
+
+	Setup(params, lights);
+	ComputeSlices(params, slices);
+
+	// Depth test once per slice; later tests only see the lights of their slice, still in light order
+	sliceLights.resize(slices);
+	for (uint32_t cz = 0; cz < slices; ++cz)
+	{
+		auto &list = sliceLights[cz];
+		list.clear();
+		for (uint32_t li = 0; li < lightCount; ++li)
+		{
+			if (zMax[li] >= sliceNear[cz] && zMin[li] <= sliceFar[cz])
+			{
+				list.push_back(li);
+			}
+		}
+	}
+	stats.setupMs = MsSince(start);
+	start         = std::chrono::steady_clock::now();
+
+	std::atomic<uint32_t> assignments{0};
+	std::atomic<uint32_t> overflows{0};
+	auto assignRows = [&](uint32_t rowBegin, uint32_t rowEnd) {
+		RowLights row;
+		uint32_t  localAssignments = 0;
+		uint32_t  localOverflows   = 0;
+		for (uint32_t r = rowBegin; r < rowEnd; ++r)
+		{
+			const uint32_t cz   = r / tilesY;
+			const uint32_t cy   = r % tilesY;
+			const float    minY = static_cast<float>(cy) * params.tileSizeY;
+			const float    maxY = minY + params.tileSizeY;
+
+			// Vertical test: dx * dx >= 0, so a light failing dy * dy <= r^2 fails the full test too
+			row.Clear();
+			for (uint32_t li : sliceLights[cz])
+			{
+				const float dy  = std::min(std::max(centerY[li], minY), maxY) - centerY[li];
+				const float dy2 = dy * dy;
+				if (dy2 <= radius2[li])
+				{
+					row.index.push_back(ids[li]);
+					row.x.push_back(centerX[li]);
+					row.dy2.push_back(dy2);
+					row.r2.push_back(radius2[li]);
+				}
+			}
+			const auto rowCount = static_cast<uint32_t>(row.index.size());
+			row.Pad();
+
+			for (uint32_t cx = 0; cx < tilesX; ++cx)
+			{
+				const uint32_t tileId = (cz * tilesY + cy) * tilesX + cx;
+				const uint32_t base   = tileId * maxPerTile;
+				const float    minX   = static_cast<float>(cx) * params.tileSizeX;
+				const float    maxX   = minX + params.tileSizeX;
+				uint32_t       count  = 0;
+
+#if defined(LIGHT_CLUSTER_SSE2)
+				const __m128 vMinX = _mm_set1_ps(minX);
+				const __m128 vMaxX = _mm_set1_ps(maxX);
+				for (uint32_t j = 0; j < rowCount && count < maxPerTile; j += 4)
+				{
+					const __m128 x  = _mm_loadu_ps(row.x.data() + j);
+					const __m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(x, vMinX), vMaxX), x);
+					const __m128 d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_loadu_ps(row.dy2.data() + j));
+					int          m  = _mm_movemask_ps(_mm_cmple_ps(d2, _mm_loadu_ps(row.r2.data() + j)));
+					while (m != 0 && count < maxPerTile)
+					{
+						const int b             = std::countr_zero(static_cast<unsigned>(m));
+						indices[base + count++] = row.index[j + b];
+						m &= m - 1;
+					}
+				}
+#else
+				for (uint32_t j = 0; j < rowCount && count < maxPerTile; ++j)
+				{
+					const float dx = std::min(std::max(row.x[j], minX), maxX) - row.x[j];
+					if (dx * dx + row.dy2[j] <= row.r2[j])
+					{
+						indices[base + count++] = row.index[j];
+					}
+				}
+#endif
+				headers[tileId] = TileHeader{base, count, 0, 0};
+				localAssignments += count;
+				localOverflows += (count >= maxPerTile && maxPerTile > 0) ? 1u : 0u;
+			}
+		}
+		assignments.fetch_add(localAssignments, std::memory_order_relaxed);
+		overflows.fetch_add(localOverflows, std::memory_order_relaxed);
+	};
+	ForRanges(pool, taskCount, slices * tilesY, assignRows);
+
+	stats.lights           = lightCount;
+	stats.clusters         = tilesX * tilesY * slices;
+	stats.assignments      = assignments.load();
+	stats.overflowClusters = overflows.load();
+	stats.assignMs         = MsSince(start);
+}
+
+void LightClusterer::BuildZBins(const Params &params, std::span<const Light> lights, ZBins &out, ThreadPool *pool, uint32_t taskCount)
+{
+	const auto     start      = std::chrono::steady_clock::now();
+	const uint32_t bins       = std::max(params.slicesZ, 1u);
+	const auto     lightCount = static_cast<uint32_t>(lights.size());
+
+	Setup(params, lights);
+	ComputeSlices(params, bins);
+
+	out.tilesX       = params.tilesX;
+	out.tilesY       = params.tilesY;
+	out.binCount     = bins;
+	out.wordsPerTile = (lightCount + 31) / 32;
+
+	// Sort by nearest depth so the lights touching a bin form a short contiguous range
+	out.sortedLights.resize(lightCount);
+	std::iota(out.sortedLights.begin(), out.sortedLights.end(), 0u);
+	std::stable_sort(out.sortedLights.begin(), out.sortedLights.end(), [this](uint32_t a, uint32_t b) { return zMin[a] < zMin[b]; });
+
+	out.binRanges.assign(static_cast<size_t>(bins) * 2, 0);
+	for (uint32_t bin = 0; bin < bins; ++bin)
+	{
+		uint32_t first = lightCount;
+		uint32_t last  = 0;
+		for (uint32_t s = 0; s < lightCount; ++s)
+		{
+			const uint32_t li = out.sortedLights[s];
+			if (zMin[li] > sliceFar[bin])
+			{
+				break;        // sorted by zMin: nothing further can reach this bin
+			}
+			if (zMax[li] >= sliceNear[bin])
+			{
+				first = std::min(first, s);
+				last  = s + 1;
+			}
+		}
+		out.binRanges[bin * 2]     = first < last ? first : 0;
+		out.binRanges[bin * 2 + 1] = last;
+	}
+
+	out.tileMasks.assign(static_cast<size_t>(out.tilesX) * out.tilesY * out.wordsPerTile, 0u);
+	auto maskRows = [&](uint32_t rowBegin, uint32_t rowEnd) {
+		for (uint32_t cy = rowBegin; cy < rowEnd; ++cy)
+		{
+			const float minY = static_cast<float>(cy) * params.tileSizeY;
+			const float maxY = minY + params.tileSizeY;
+			for (uint32_t s = 0; s < lightCount; ++s)
+			{
+				const uint32_t li = out.sortedLights[s];
+				const float    dy = std::min(std::max(centerY[li], minY), maxY) - centerY[li];
+				if (dy * dy > radius2[li])
+				{
+					continue;
+				}
+				// Candidate tile columns from the circle's extent, confirmed with the exact rectangle test
+				const float radius = std::sqrt(radius2[li]);
+				const float lo     = std::clamp(std::floor((centerX[li] - radius) / params.tileSizeX) - 1.0f, 0.0f, static_cast<float>(out.tilesX));
+				const float hi     = std::clamp(std::floor((centerX[li] + radius) / params.tileSizeX) + 2.0f, 0.0f, static_cast<float>(out.tilesX));
+				for (auto cx = static_cast<uint32_t>(lo); cx < static_cast<uint32_t>(hi); ++cx)
+				{
+					const float minX = static_cast<float>(cx) * params.tileSizeX;
+					if (RectDistance2(centerX[li], centerY[li], minX, minY, minX + params.tileSizeX, maxY) <= radius2[li])
+					{
+						out.tileMasks[(static_cast<size_t>(cy) * out.tilesX + cx) * out.wordsPerTile + s / 32] |= 1u << (s % 32);
+					}
+				}
+			}
+		}
+	};
+	ForRanges(pool, taskCount, out.tilesY, maskRows);
+
+	stats.zbinMs = MsSince(start);
+}
+
+void LightClusterer::GatherZBinned(const ZBins &bins, uint32_t tileX, uint32_t tileY, uint32_t bin, std::vector<uint32_t> &out)
+{
+	out.clear();
+	if (tileX >= bins.tilesX || tileY >= bins.tilesY || bin >= bins.binCount)
+	{
+		return;
+	}
+	const uint32_t first = bins.binRanges[bin * 2];
+	const uint32_t last  = bins.binRanges[bin * 2 + 1];
+	if (first >= last)
+	{
+		return;
+	}
+
+	const uint32_t *mask = bins.tileMasks.data() + (static_cast<size_t>(tileY) * bins.tilesX + tileX) * bins.wordsPerTile;
+	for (uint32_t w = first / 32; w <= (last - 1) / 32; ++w)
+	{
+		uint32_t bits = mask[w];
+		if (w == first / 32)
+		{
+			bits &= ~0u << (first % 32);
+		}
+		if (w == (last - 1) / 32 && last % 32 != 0)
+		{
+			bits &= ~0u >> (32 - last % 32);
+		}
+		while (bits != 0)
+		{
+			out.push_back(bins.sortedLights[w * 32 + std::countr_zero(bits)]);
+			bits &= bits - 1;
+		}
+	}
+	std::sort(out.begin(), out.end());
+}
+
+void LightClusterer::BuildReference(const Params &params, std::span<const Light> lights, TileHeader *headers, uint32_t *indices)
+{
+	// A line-by-line port of forward_plus_cull.slang: one invocation per cluster, every light tested in order
+	const uint32_t tilesX     = params.tilesX;
+	const uint32_t tilesY     = params.tilesY;
+	const uint32_t slicesZ    = params.slicesZ;
+	const uint32_t maxPerTile = params.maxPerTile;
+	const float    projXX     = params.proj[0][0];
+	const float    projYY     = params.proj[1][1];
+	const float    nearZ      = std::max(params.nearZ, 1e-3f);
+	const float    farZ       = std::max(params.farZ, nearZ + 1e-3f);
+	for (uint32_t cz = 0; cz < std::max(slicesZ, 1u); ++cz)
+	{
+		const float fcz0      = (slicesZ > 0) ? (static_cast<float>(cz) / static_cast<float>(slicesZ)) : 0.0f;
+		const float fcz1      = (slicesZ > 0) ? (static_cast<float>(cz + 1) / static_cast<float>(slicesZ)) : 1.0f;
+		const float sliceNear = std::exp(std::log(nearZ) + fcz0 * (std::log(farZ) - std::log(nearZ)));
+		const float sliceFar  = std::exp(std::log(nearZ) + fcz1 * (std::log(farZ) - std::log(nearZ)));
+		for (uint32_t cy = 0; cy < tilesY; ++cy)
+		{
+			for (uint32_t cx = 0; cx < tilesX; ++cx)
+			{
+				const uint32_t tileId = (cz * tilesY + cy) * tilesX + cx;
+				const float    minX   = static_cast<float>(cx) * params.tileSizeX;
+				const float    minY   = static_cast<float>(cy) * params.tileSizeY;
+				const float    maxX   = minX + params.tileSizeX;
+				const float    maxY   = minY + params.tileSizeY;
+				const uint32_t base   = tileId * maxPerTile;
+				uint32_t       count  = 0;
+				for (uint32_t li = 0; li < lights.size(); ++li)
+				{
+					if (count >= maxPerTile)
+					{
+						break;
+					}
+					const Light &L        = lights[li];
+					float        centerX  = 0.0f;
+					float        centerY  = 0.0f;
+					float        radius   = 1e9f;
+					bool         zOverlap = true;
+					if (!L.directional)
+					{
+						const glm::vec4 posVS = params.view * glm::vec4(L.position, 1.0f);
+						const float     z     = std::max(1e-3f, std::abs(posVS.z));
+						const float     zMin  = std::max(0.0f, z - L.range);
+						const float     zMax  = z + L.range;
+						zOverlap              = (zMax >= sliceNear) && (zMin <= sliceFar);
+
+						const glm::vec4 clip = params.proj * glm::vec4(glm::vec3(posVS), 1.0f);
+						const float     invW = (clip.w != 0.0f) ? 1.0f / clip.w : 0.0f;
+						centerX              = (clip.x * invW * 0.5f + 0.5f) * params.screenWidth;
+						centerY              = (clip.y * invW * 0.5f + 0.5f) * params.screenHeight;
+
+						const float rx = std::abs(L.range * projXX / z) * (params.screenWidth * 0.5f);
+						const float ry = std::abs(L.range * projYY / z) * (params.screenHeight * 0.5f);
+						radius         = std::max(rx, ry);
+					}
+					if (zOverlap && RectDistance2(centerX, centerY, minX, minY, maxX, maxY) <= radius * radius)
+					{
+						indices[base + count++] = li;
+					}
+				}
+				headers[tileId] = TileHeader{base, count, 0, 0};
+			}
+		}
+	}
+}
+
+uint32_t LightClusterer::CheckAgainstReference(uint32_t lightCount, uint32_t width, uint32_t height, uint32_t maxPerTile, ThreadPool *pool, uint32_t taskCount)
+{
+	Params             params;
+	std::vector<Light> lights;
+	MakeBenchmarkScene(lightCount, width, height, 3, params, lights);
+	params.maxPerTile = maxPerTile;
+	// A few directional lights, which cover every cluster
+	for (size_t i = 0; i < lights.size(); i += 997)
+	{
+		lights[i].directional = true;
+	}
+
+	const size_t            clusters = static_cast<size_t>(params.tilesX) * params.tilesY * params.slicesZ;
+	std::vector<TileHeader> referenceHeaders(clusters);
+	std::vector<uint32_t>   referenceIndices(clusters * maxPerTile);
+	BuildReference(params, lights, referenceHeaders.data(), referenceIndices.data());
+
+	std::vector<TileHeader> headers(clusters);
+	std::vector<uint32_t>   indices(clusters * maxPerTile);
+	LightClusterer          clusterer;
+	clusterer.Build(params, lights, headers.data(), indices.data());
+	uint32_t mismatches = CountMismatches(params, referenceHeaders.data(), referenceIndices.data(), headers.data(), indices.data());
+	clusterer.Build(params, lights, headers.data(), indices.data(), pool, taskCount);
+	mismatches += CountMismatches(params, referenceHeaders.data(), referenceIndices.data(), headers.data(), indices.data());
+	return mismatches;
+}
+
+uint32_t LightClusterer::CountMismatches(const Params &params, const TileHeader *a, const uint32_t *aIndices, const TileHeader *b, const uint32_t *bIndices)
+{
+	const uint32_t clusters   = params.tilesX * params.tilesY * std::max(params.slicesZ, 1u);
+	uint32_t       mismatches = 0;
+	for (uint32_t c = 0; c < clusters; ++c)
+	{
+		const TileHeader &ha = a[c];
+		const TileHeader &hb = b[c];
+		bool              same = ha.offset == hb.offset && ha.count == hb.count && ha.pad0 == hb.pad0 && ha.pad1 == hb.pad1;
+		if (same && ha.count <= params.maxPerTile)
+		{
+			same = std::equal(aIndices + ha.offset, aIndices + ha.offset + ha.count, bIndices + hb.offset);
+		}
+		mismatches += same ? 0u : 1u;
+	}
+	return mismatches;
+}
+
+LightClusterer::BenchmarkResult LightClusterer::Benchmark(uint32_t lightCount, uint32_t width, uint32_t height, ThreadPool *pool, uint32_t taskCount)
+{
+	BenchmarkResult result;
+	if (width == 0 || height == 0)
+	{
+		return result;
+	}
+
+	Params             params;
+	std::vector<Light> lights;
+	MakeBenchmarkScene(lightCount, width, height, 7, params, lights);
+
+	const size_t            clusters = static_cast<size_t>(params.tilesX) * params.tilesY * params.slicesZ;
+	std::vector<TileHeader> headers(clusters);
+	std::vector<uint32_t>   indices(clusters * params.maxPerTile);
+	LightClusterer          clusterer;
+
+	auto start = std::chrono::steady_clock::now();
+	clusterer.Build(params, lights, headers.data(), indices.data());
+	result.clusterMs = MsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	clusterer.Build(params, lights, headers.data(), indices.data(), pool, taskCount);
+	result.clusterPoolMs = MsSince(start);
+
+	ZBins bins;
+	start = std::chrono::steady_clock::now();
+	clusterer.BuildZBins(params, lights, bins, pool, taskCount);
+	result.zbinMs = MsSince(start);
+
+	result.clusterBytes = clusters * (sizeof(TileHeader) + params.maxPerTile * sizeof(uint32_t));
+	result.zbinBytes    = bins.GetMemoryBytes();
+
+	// Every light of an uncapped cluster must be among the z-binned candidates of that cluster
+	std::vector<uint32_t> candidates;
+	for (uint32_t cz = 0; cz < params.slicesZ; ++cz)
+	{
+		for (uint32_t cy = 0; cy < params.tilesY; ++cy)
+		{
+			for (uint32_t cx = 0; cx < params.tilesX; ++cx)
+			{
+				const TileHeader &h = headers[(cz * params.tilesY + cy) * params.tilesX + cx];
+				if (h.count == 0 || h.count >= params.maxPerTile)
+				{
+					continue;
+				}
+				GatherZBinned(bins, cx, cy, cz, candidates);
+				for (uint32_t k = 0; k < h.count; ++k)
+				{
+					if (!std::binary_search(candidates.begin(), candidates.end(), indices[h.offset + k]))
+					{
+						++result.missing;
+					}
+				}
+			}
+		}
+	}
+	return result;
+}
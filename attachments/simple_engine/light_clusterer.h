@@ -0,0 +1,190 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+/**
+ * @brief CPU implementation of the Forward+ cluster light assignment.
+ *
+ * Build() reproduces forward_plus_cull.slang: the screen is split into
+ * tilesX x tilesY tiles and slicesZ log-spaced depth slices, each light is
+ * bounded by a screen-space circle and a view-depth interval, and every
+ * cluster receives the indices of the lights that overlap it, in light
+ * order and capped at maxPerTile. The output uses the shader's TileHeader
+ * and index buffer layout, so it can be written straight into the GPU
+ * buffers (a fallback when compute is unavailable) or compared with what
+ * the compute pass produced.
+ *
+ * BuildZBins() produces the z-binned form of the same data: lights sorted by
+ * depth, one light bitmask per 2D tile and one sorted-index range per depth
+ * bin. Its memory grows with tiles + bins instead of tiles x slices.
+ */
+class LightClusterer
+{
+  public:
+	// Mirrors FPParams in forward_plus_cull.slang (see Renderer::updateForwardPlusParams)
+	struct Params
+	{
+		glm::mat4 view{1.0f};
+		glm::mat4 proj{1.0f};
+		float     screenWidth  = 0.0f;
+		float     screenHeight = 0.0f;
+		float     tileSizeX    = 16.0f;
+		float     tileSizeY    = 16.0f;
+		uint32_t  tilesX       = 0;
+		uint32_t  tilesY       = 0;
+		uint32_t  slicesZ      = 1;
+		uint32_t  maxPerTile   = 256;
+		float     nearZ        = 0.1f;
+		float     farZ         = 100.0f;
+	};
+
+	struct Light
+	{
+		static constexpr uint32_t NoId = UINT32_MAX;
+
+		glm::vec3 position{0.0f};
+		float     range       = 0.0f;
+		bool      directional = false;        // covers every cluster
+		uint32_t  id          = NoId;         // written to the lists by Build; NoId writes the light's position in the span
+	};
+
+	// Same layout as TileHeader in common_types.slang
+	struct TileHeader
+	{
+		uint32_t offset = 0;
+		uint32_t count  = 0;
+		uint32_t pad0   = 0;
+		uint32_t pad1   = 0;
+	};
+
+	struct ZBins
+	{
+		uint32_t              tilesX       = 0;
+		uint32_t              tilesY       = 0;
+		uint32_t              binCount     = 0;
+		uint32_t              wordsPerTile = 0;
+		std::vector<uint32_t> tileMasks;           // wordsPerTile words per tile, bit i = sorted light i
+		std::vector<uint32_t> binRanges;           // per bin: first and one-past-last sorted light
+		std::vector<uint32_t> sortedLights;        // sorted position -> light index
+
+		size_t GetMemoryBytes() const
+		{
+			return (tileMasks.size() + binRanges.size() + sortedLights.size()) * sizeof(uint32_t);
+		}
+	};
+
+	struct Stats
+	{
+		uint32_t lights           = 0;
+		uint32_t clusters         = 0;
+		uint32_t assignments      = 0;        // indices written by the last Build
+		uint32_t overflowClusters = 0;        // clusters that hit maxPerTile
+		double   setupMs          = 0.0;
+		double   assignMs         = 0.0;
+		double   zbinMs           = 0.0;
+	};
+
+	struct BenchmarkResult
+	{
+		double   clusterMs     = 0.0;        // Build, serial
+		double   clusterPoolMs = 0.0;        // Build, split across the pool
+		double   zbinMs        = 0.0;        // BuildZBins, split across the pool
+		size_t   clusterBytes  = 0;
+		size_t   zbinBytes     = 0;
+		uint32_t missing       = 0;        // cluster assignments the z-binned lists failed to cover (should be 0)
+	};
+
+	/**
+	 * @brief Assign lights to clusters.
+	 * @param params Grid and camera parameters.
+	 * @param lights The lights, in the order the lists keep them; each list entry is a light's id.
+	 * @param headers Receives tilesX * tilesY * slicesZ headers.
+	 * @param indices Receives maxPerTile indices per cluster; only the first count of each are written.
+	 * @param pool Optional pool; rows of clusters are split into taskCount groups.
+	 * @param taskCount Number of groups.
+	 */
+	void Build(const Params &params, std::span<const Light> lights, TileHeader *headers, uint32_t *indices, ThreadPool *pool = nullptr, uint32_t taskCount = 1);
+
+	/**
+	 * @brief Build z-binned light lists for the same grid.
+	 * @param params Grid and camera parameters; slicesZ is the bin count.
+	 * @param lights The lights.
+	 * @param out Receives the lists.
+	 * @param pool Optional pool; tile rows are split into taskCount groups.
+	 * @param taskCount Number of groups.
+	 */
+	void BuildZBins(const Params &params, std::span<const Light> lights, ZBins &out, ThreadPool *pool = nullptr, uint32_t taskCount = 1);
+
+	/**
+	 * @brief Collect the candidate lights of one cluster from z-binned lists, as a shader would.
+	 * @param bins The lists.
+	 * @param tileX Tile column.
+	 * @param tileY Tile row.
+	 * @param bin Depth bin.
+	 * @param out Receives light indices in ascending order (a superset of the cluster's lights).
+	 */
+	static void GatherZBinned(const ZBins &bins, uint32_t tileX, uint32_t tileY, uint32_t bin, std::vector<uint32_t> &out);
+
+	/**
+	 * @brief Assign lights to clusters one cluster at a time, exactly as the compute shader does.
+	 *
+	 * Slow; it is the reference Build is checked against.
+	 */
+	static void BuildReference(const Params &params, std::span<const Light> lights, TileHeader *headers, uint32_t *indices);
+
+	/**
+	 * @brief Compare Build, serial and on the pool, with BuildReference on synthetic lights.
+	 * @return The number of mismatching clusters over both builds (0 when they agree).
+	 */
+	static uint32_t CheckAgainstReference(uint32_t lightCount, uint32_t width, uint32_t height, uint32_t maxPerTile, ThreadPool *pool, uint32_t taskCount);
+
+	/**
+	 * @brief Count the clusters whose header or index list differs between two outputs of the same grid.
+	 */
+	static uint32_t CountMismatches(const Params &params, const TileHeader *a, const uint32_t *aIndices, const TileHeader *b, const uint32_t *bIndices);
+
+	const Stats &GetStats() const
+	{
+		return stats;
+	}
+
+	/**
+	 * @brief Time both layouts on lightCount synthetic point lights in front of the camera.
+	 * @return Timings, memory use and a cross-check of the z-binned lists against the clusters.
+	 */
+	static BenchmarkResult Benchmark(uint32_t lightCount, uint32_t width, uint32_t height, ThreadPool *pool, uint32_t taskCount);
+
+  private:
+	// Per-light bounds, computed once per build exactly as the shader does per cluster
+	std::vector<float>                 centerX, centerY, radius2, zMin, zMax;
+	std::vector<uint32_t>              ids;
+	std::vector<float>                 sliceNear, sliceFar;
+	std::vector<std::vector<uint32_t>> sliceLights;        // lights overlapping each depth slice, in order
+	Stats                              stats;
+
+	void Setup(const Params &params, std::span<const Light> lights);
+	void ComputeSlices(const Params &params, uint32_t slices);
+};
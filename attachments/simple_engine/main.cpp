@@ -15,13 +15,18 @@
  * limitations under the License.
  */
 #include "camera_component.h"
+#include "cpu_benchmarks.h"
 #include "crash_reporter.h"
 #include "engine.h"
+#include "perf_run.h"
 #include "scene_loading.h"
 #include "transform_component.h"
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <stdexcept>
+#include <string>
 #include <thread>
 
 // Constants
@@ -32,12 +37,15 @@ constexpr bool ENABLE_VALIDATION_LAYERS = false;
 #else
 constexpr bool ENABLE_VALIDATION_LAYERS = true;
 #endif
+constexpr const char *DEFAULT_SCENE = "../Assets/bistro/bistro.gltf";
 
 /**
  * @brief Set up a simple scene with a camera and some objects.
  * @param engine The engine to set up the scene in.
+ * @param scenePath The glTF model to load.
+ * @param aspectRatio The aspect ratio of the camera.
  */
-void SetupScene(Engine *engine)
+void SetupScene(Engine *engine, const std::string &scenePath = DEFAULT_SCENE, float aspectRatio = static_cast<float>(WINDOW_WIDTH) / static_cast<float>(WINDOW_HEIGHT))
 {
 	// Create a camera entity
 	Entity *cameraEntity = engine->CreateEntity("Camera");
@@ -52,7 +60,7 @@ void SetupScene(Engine *engine)
 
 	// Add a camera component to the camera entity
 	auto *camera = cameraEntity->AddComponent<CameraComponent>();
-	camera->SetAspectRatio(static_cast<float>(WINDOW_WIDTH) / static_cast<float>(WINDOW_HEIGHT));
+	camera->SetAspectRatio(aspectRatio);
 
 	// Set the camera as the active camera
 	engine->SetActiveCamera(camera);
@@ -66,8 +74,14 @@ void SetupScene(Engine *engine)
 		renderer->SetLoading(true);
 		renderer->SetLoadingPhase(Renderer::LoadingPhase::Textures);
 	}
-	std::thread([engine] {
-		LoadGLTFModel(engine, "../Assets/bistro/bistro.gltf");
+	std::thread([engine, scenePath] {
+		if (!LoadGLTFModel(engine, scenePath))
+		{
+			if (auto *renderer = engine->GetRenderer())
+			{
+				renderer->SetLoadFailed();
+			}
+		}
 	}).detach();
 }
 
@@ -101,12 +115,157 @@ void android_main(android_app *app)
 	}
 }
 #else
+/**
+ * @brief Desktop command line options.
+ */
+struct CommandLineOptions
+{
+	bool          headless         = false;        // scripted performance run without a window
+	bool          releaseCpuMeshes = false;        // free CPU mesh copies once they are on the GPU
+	bool          packedVertices   = false;        // quantized 24-byte vertex buffers
+	bool          meshLods         = true;         // build reduced-detail index buffers while loading
+	bool          meshlets         = true;         // split meshes into culled clusters while loading
+	int           width            = WINDOW_WIDTH;
+	int           height           = WINDOW_HEIGHT;
+	std::string   scene            = DEFAULT_SCENE;
+	std::string   benchmarks;                      // CPU benchmarks to run instead of the engine
+	PerfRunConfig perf;
+};
+
+/**
+ * @brief Parse the desktop command line.
+ * @param argc The argument count.
+ * @param argv The arguments.
+ * @param options Receives the parsed options.
+ * @return False if an argument is unknown or misses its value.
+ */
+bool ParseCommandLine(int argc, char *argv[], CommandLineOptions &options)
+{
+	for (int i = 1; i < argc; ++i)
+	{
+		const char *arg      = argv[i];
+		const bool  hasValue = i + 1 < argc;
+		if (std::strcmp(arg, "--headless") == 0)
+		{
+			options.headless = true;
+		}
+		else if (std::strcmp(arg, "--release-cpu-meshes") == 0)
+		{
+			options.releaseCpuMeshes = true;
+		}
+		else if (std::strcmp(arg, "--packed-vertices") == 0)
+		{
+			options.packedVertices = true;
+		}
+		else if (std::strcmp(arg, "--no-mesh-lods") == 0)
+		{
+			options.meshLods = false;
+		}
+		else if (std::strcmp(arg, "--no-meshlets") == 0)
+		{
+			options.meshlets = false;
+		}
+		else if (std::strcmp(arg, "--frames") == 0 && hasValue)
+		{
+			options.perf.frames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(arg, "--warmup") == 0 && hasValue)
+		{
+			options.perf.warmupFrames = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(arg, "--width") == 0 && hasValue)
+		{
+			options.width = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(arg, "--height") == 0 && hasValue)
+		{
+			options.height = std::atoi(argv[++i]);
+		}
+		else if (std::strcmp(arg, "--scene") == 0 && hasValue)
+		{
+			options.scene = argv[++i];
+		}
+		else if (std::strcmp(arg, "--camera-path") == 0 && hasValue)
+		{
+			options.perf.cameraPathFile = argv[++i];
+		}
+		else if (std::strcmp(arg, "--report") == 0 && hasValue)
+		{
+			options.perf.reportPath = argv[++i];
+		}
+		else if (std::strcmp(arg, "--load-timeout") == 0 && hasValue)
+		{
+			options.perf.loadTimeoutSeconds = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(arg, "--benchmark") == 0 && hasValue)
+		{
+			options.benchmarks = argv[++i];
+		}
+		else if (std::strcmp(arg, "--synthetic-lights") == 0 && hasValue)
+		{
+			options.perf.syntheticLights = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else if (std::strcmp(arg, "--sleep-benchmark") == 0 && hasValue)
+		{
+			options.perf.sleepBenchmarkBodies = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		}
+		else
+		{
+			return false;
+		}
+	}
+	options.perf.scene = options.scene;
+	return options.width > 0 && options.height > 0;
+}
+
 /**
  * @brief Desktop entry point.
  * @return The exit code.
  */
-int main(int, char *[])
+int main(int argc, char *argv[])
 {
+	CommandLineOptions options;
+	if (!ParseCommandLine(argc, argv, options))
+	{
+		std::cerr << "Usage: " << argv[0] << " [--scene model.gltf] [--width W] [--height H] [--release-cpu-meshes] [--packed-vertices] [--no-mesh-lods] [--no-meshlets]\n"
+		          << "       [--headless [--frames N] [--warmup N] [--camera-path file] [--report out.json] [--load-timeout seconds] [--synthetic-lights N]\n"
+		          << "                   [--sleep-benchmark bodies]]\n"
+		          << "       [--benchmark all|name[,name...] [--report out.json]]\n"
+		          << "Benchmarks:";
+		for (const auto &name : CpuBenchmarks::GetNames())
+		{
+			std::cerr << ' ' << name;
+		}
+		std::cerr << std::endl;
+		return 1;
+	}
+
+	// CPU benchmarks run without a window or a GPU
+	if (!options.benchmarks.empty())
+	{
+		try
+		{
+			BenchmarkReport report;
+			if (!CpuBenchmarks::Run(options.benchmarks, report))
+			{
+				std::cerr << "Unknown benchmark in: " << options.benchmarks << std::endl;
+				return 1;
+			}
+			if (!report.WriteJson(options.perf.reportPath))
+			{
+				std::cerr << "Failed to write benchmark report: " << options.perf.reportPath << std::endl;
+				return 1;
+			}
+			std::cout << "Benchmark report written to " << options.perf.reportPath << std::endl;
+			return report.HasFailures() ? 1 : 0;
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << "Exception: " << e.what() << std::endl;
+			return 1;
+		}
+	}
+
 	try
 	{
 		// Enable minidump generation for Release-only crashes (e.g., stack cookie failures / fast-fail).
@@ -116,21 +275,43 @@ int main(int, char *[])
 		// Create the engine
 		Engine engine;
 
-		// Initialize the engine
-		if (!engine.Initialize("Simple Engine", WINDOW_WIDTH, WINDOW_HEIGHT, ENABLE_VALIDATION_LAYERS))
+		// Initialize the engine (validation layers would distort the timings of a headless run)
+		if (!engine.Initialize("Simple Engine", options.width, options.height, ENABLE_VALIDATION_LAYERS && !options.headless, options.headless))
 		{
 			throw std::runtime_error("Failed to initialize engine");
 		}
+		engine.GetRenderer()->SetReleaseCpuMeshData(options.releaseCpuMeshes);
+		if (!engine.GetRenderer()->SetPackedVertices(options.packedVertices))
+		{
+			throw std::runtime_error("Failed to switch the vertex layout");
+		}
+		engine.GetModelLoader()->SetGenerateMeshLods(options.meshLods);
+		engine.GetModelLoader()->SetGenerateMeshlets(options.meshlets);
 
 		// Set up the scene
-		SetupScene(&engine);
+		SetupScene(&engine, options.scene, static_cast<float>(options.width) / static_cast<float>(options.height));
 
 		// Run the engine
-		engine.Run();
+		bool succeeded = true;
+		if (options.headless)
+		{
+			succeeded = engine.RunPerformanceTest(options.perf);
+			// A timed-out load may still be running on the loader thread, which uses the engine: exit without tearing it down
+			if (!succeeded && engine.GetRenderer()->IsSceneLoaderActive())
+			{
+				std::cout.flush();
+				std::cerr.flush();
+				std::_Exit(1);
+			}
+		}
+		else
+		{
+			engine.Run();
+		}
 
 		CrashReporter::GetInstance().Cleanup();
 
-		return 0;
+		return succeeded ? 0 : 1;
 	}
 	catch (const std::exception &e)
 	{
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "memory_pool.h"
+#include "debug_system.h"
 #include <algorithm>
 #include <iostream>
 #include <numeric>
@@ -281,8 +282,7 @@ std::pair<MemoryPool::MemoryBlock *, size_t> MemoryPool::findSuitableBlock(PoolT
   try {
     auto newBlock = createMemoryBlock(poolType, alignedSize);
     poolBlocks.push_back(std::move(newBlock));
-    std::cout << "Created new memory block (pool type: "
-        << static_cast<int>(poolType) << ")" << std::endl;
+    LOG_INFO("MemoryPool", "Created new memory block (pool type: " + std::to_string(static_cast<int>(poolType)) + ")");
     return {poolBlocks.back().get(), 0};
   } catch (const std::exception& e) {
     std::cerr << "Failed to create new memory block: " << e.what() << std::endl;
@@ -351,7 +351,7 @@ void MemoryPool::deallocate(std::unique_ptr<Allocation> allocation) {
     }
   }
 
-  std::cerr << "Warning: Could not find memory block for deallocation" << std::endl;
+  LOG_WARNING("MemoryPool", "Could not find memory block for deallocation");
 }
 
 std::pair<vk::raii::Buffer, std::unique_ptr<MemoryPool::Allocation>> MemoryPool::createBuffer(
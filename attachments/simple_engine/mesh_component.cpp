@@ -19,6 +19,17 @@
 #include <cmath>
 #include <limits>
 
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#	define INSTANCE_BUILD_X86 1
+#	include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#	define INSTANCE_BUILD_NEON 1
+#	include <arm_neon.h>
+#endif
+
+// Relative tolerance of InstanceData::IsUniformScale, in squared column length
+static constexpr float UniformScaleTolerance = 1e-4f;
+
 // Helper to transform an AABB by a matrix
 static void transformAABBLocal(const glm::mat4 &M,
                                const glm::vec3 &localMin,
@@ -38,27 +49,137 @@ static void transformAABBLocal(const glm::mat4 &M,
 	outMax = worldCenter + worldExtents;
 }
 
+bool InstanceData::IsUniformScale(const glm::vec4 (&rows)[3])
+{
+	// Squared column lengths and the dot products of column pairs (xy, yz, zx), accumulated
+	// row by row in the same order as the SSE2 path of AppendInstances
+	glm::vec3 lengths2 = glm::vec3(rows[0]) * glm::vec3(rows[0]);
+	glm::vec3 dots     = glm::vec3(rows[0]) * glm::vec3(rows[0].y, rows[0].z, rows[0].x);
+	for (int i = 1; i < 3; ++i)
+	{
+		const glm::vec3 r(rows[i]);
+		lengths2 = lengths2 + r * r;
+		dots     = dots + r * glm::vec3(r.y, r.z, r.x);
+	}
+	const float tolerance = lengths2.x * UniformScaleTolerance;
+	return lengths2.x > 0.0f &&
+	       std::abs(lengths2.y - lengths2.x) <= tolerance && std::abs(lengths2.z - lengths2.x) <= tolerance &&
+	       std::abs(dots.x) <= tolerance && std::abs(dots.y) <= tolerance && std::abs(dots.z) <= tolerance;
+}
+
+void InstanceData::AppendInstances(std::span<const glm::mat4> transforms, uint32_t matIndex, std::vector<InstanceData> &out)
+{
+	const size_t   base     = out.size();
+	const uint32_t material = matIndex & MaterialIndexMask;
+	out.resize(base + transforms.size());
+	InstanceData *dst = out.data() + base;
+
+#if defined(INSTANCE_BUILD_X86)
+	const __m128 absMask        = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+	const __m128 toleranceScale = _mm_set1_ps(UniformScaleTolerance);
+	for (size_t i = 0; i < transforms.size(); ++i)
+	{
+		// Columns in, rows out
+		const float *m  = &transforms[i][0][0];
+		__m128       r0 = _mm_loadu_ps(m);
+		__m128       r1 = _mm_loadu_ps(m + 4);
+		__m128       r2 = _mm_loadu_ps(m + 8);
+		__m128       r3 = _mm_loadu_ps(m + 12);
+		_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+		_mm_storeu_ps(&dst[i].modelRows[0].x, r0);
+		_mm_storeu_ps(&dst[i].modelRows[1].x, r1);
+		_mm_storeu_ps(&dst[i].modelRows[2].x, r2);
+
+		// IsUniformScale for lanes xyz; lane w holds translation terms and is ignored
+		__m128 lengths2 = _mm_mul_ps(r0, r0);
+		__m128 dots     = _mm_mul_ps(r0, _mm_shuffle_ps(r0, r0, _MM_SHUFFLE(3, 0, 2, 1)));
+		lengths2        = _mm_add_ps(lengths2, _mm_mul_ps(r1, r1));
+		dots            = _mm_add_ps(dots, _mm_mul_ps(r1, _mm_shuffle_ps(r1, r1, _MM_SHUFFLE(3, 0, 2, 1))));
+		lengths2        = _mm_add_ps(lengths2, _mm_mul_ps(r2, r2));
+		dots            = _mm_add_ps(dots, _mm_mul_ps(r2, _mm_shuffle_ps(r2, r2, _MM_SHUFFLE(3, 0, 2, 1))));
+
+		const __m128 lengthX   = _mm_shuffle_ps(lengths2, lengths2, _MM_SHUFFLE(0, 0, 0, 0));
+		const __m128 tolerance = _mm_mul_ps(lengthX, toleranceScale);
+		const __m128 ok        = _mm_and_ps(_mm_cmple_ps(_mm_and_ps(_mm_sub_ps(lengths2, lengthX), absMask), tolerance),
+		                                    _mm_cmple_ps(_mm_and_ps(dots, absMask), tolerance));
+		const bool   uniform   = (_mm_movemask_ps(ok) & 0x7) == 0x7 && _mm_cvtss_f32(lengths2) > 0.0f;
+		dst[i].materialAndFlags = material | (uniform ? UniformScaleFlag : 0u);
+	}
+#else
+	for (size_t i = 0; i < transforms.size(); ++i)
+	{
+		const float *m = &transforms[i][0][0];
+#	if defined(INSTANCE_BUILD_NEON)
+		// De-interleaving load: lane j of val[k] is element k of column j, i.e. row k
+		const float32x4x4_t rows = vld4q_f32(m);
+		vst1q_f32(&dst[i].modelRows[0].x, rows.val[0]);
+		vst1q_f32(&dst[i].modelRows[1].x, rows.val[1]);
+		vst1q_f32(&dst[i].modelRows[2].x, rows.val[2]);
+#	else
+		for (int row = 0; row < 3; ++row)
+		{
+			dst[i].modelRows[row] = glm::vec4(m[row], m[4 + row], m[8 + row], m[12 + row]);
+		}
+#	endif
+		dst[i].materialAndFlags = material | (IsUniformScale(dst[i].modelRows) ? UniformScaleFlag : 0u);
+	}
+#endif
+}
+
+std::shared_ptr<const MeshGeometry> MeshGeometry::Create(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                                                         std::vector<uint32_t> lodIndices, std::vector<MeshLod> lods,
+                                                         std::vector<Meshlet> meshlets, ContentHash::Digest contentHash)
+{
+	auto geometry         = std::make_shared<MeshGeometry>();
+	geometry->vertices    = std::move(vertices);
+	geometry->indices     = std::move(indices);
+	geometry->lodIndices  = std::move(lodIndices);
+	geometry->lods        = std::move(lods);
+	geometry->meshlets    = std::move(meshlets);
+	geometry->contentHash = contentHash;
+	geometry->vertices.shrink_to_fit();
+	geometry->indices.shrink_to_fit();
+	geometry->lodIndices.shrink_to_fit();
+	geometry->lods.shrink_to_fit();
+	geometry->meshlets.shrink_to_fit();
+
+	if (!geometry->vertices.empty())
+	{
+		geometry->aabbMin = geometry->aabbMax = geometry->vertices[0].position;
+		for (const auto &v : geometry->vertices)
+		{
+			geometry->aabbMin = glm::min(geometry->aabbMin, v.position);
+			geometry->aabbMax = glm::max(geometry->aabbMax, v.position);
+		}
+	}
+	residentBytes.fetch_add(geometry->GetCpuBytes(), std::memory_order_relaxed);
+	return geometry;
+}
+
+void MeshComponent::SetGeometry(MeshGeometryPtr newGeometry)
+{
+	geometry       = std::move(newGeometry);
+	vertexCount    = geometry ? static_cast<uint32_t>(geometry->vertices.size()) : 0;
+	indexCount     = geometry ? static_cast<uint32_t>(geometry->indices.size()) : 0;
+	meshAABBValid  = false;
+	localAABBValid = false;
+	RecomputeLocalAABB();
+}
+
 void MeshComponent::RecomputeMeshAABB()
 {
 	if (meshAABBValid)
 		return;
 
-	if (vertices.empty())
+	if (!geometry || geometry->vertices.empty())
 	{
 		meshAABBMin   = glm::vec3(0.0f);
 		meshAABBMax   = glm::vec3(0.0f);
 		meshAABBValid = false;
 		return;
 	}
-	glm::vec3 minB = vertices[0].position;
-	glm::vec3 maxB = vertices[0].position;
-	for (const auto &v : vertices)
-	{
-		minB = glm::min(minB, v.position);
-		maxB = glm::max(maxB, v.position);
-	}
-	meshAABBMin   = minB;
-	meshAABBMax   = maxB;
+	meshAABBMin   = geometry->aabbMin;
+	meshAABBMax   = geometry->aabbMax;
 	meshAABBValid = true;
 }
 
@@ -91,7 +212,7 @@ void MeshComponent::RecomputeLocalAABB()
 		for (const auto &inst : instances)
 		{
 			glm::vec3 instMin, instMax;
-			transformAABBLocal(inst.modelMatrix, meshAABBMin, meshAABBMax, instMin, instMax);
+			transformAABBLocal(inst.getModelMatrix(), meshAABBMin, meshAABBMax, instMin, instMax);
 			fullMin = glm::min(fullMin, instMin);
 			fullMax = glm::max(fullMax, instMax);
 		}
@@ -107,8 +228,8 @@ void MeshComponent::RecomputeLocalAABB()
 
 void MeshComponent::CreateSphere(float radius, const glm::vec3 &color, int segments)
 {
-	vertices.clear();
-	indices.clear();
+	std::vector<Vertex>   vertices;
+	std::vector<uint32_t> indices;
 
 	// Generate sphere vertices using parametric equations
 	for (int lat = 0; lat <= segments; ++lat)
@@ -184,7 +305,7 @@ void MeshComponent::CreateSphere(float radius, const glm::vec3 &color, int segme
 		}
 	}
 
-	RecomputeLocalAABB();
+	SetGeometry(MeshGeometry::Create(std::move(vertices), std::move(indices)));
 }
 
 void MeshComponent::LoadFromModel(const Model *model)
@@ -194,9 +315,18 @@ void MeshComponent::LoadFromModel(const Model *model)
 		return;
 	}
 
-	// Copy vertex and index data from the model
-	vertices = model->GetVertices();
-	indices  = model->GetIndices();
+	// Combine the model's geometry into one mesh
+	std::vector<Vertex>   vertices;
+	std::vector<uint32_t> indices;
+	for (const MeshGeometryPtr &part : model->GetGeometryParts())
+	{
+		const auto vertexOffset = static_cast<uint32_t>(vertices.size());
+		vertices.insert(vertices.end(), part->vertices.begin(), part->vertices.end());
+		for (uint32_t index : part->indices)
+		{
+			indices.push_back(index + vertexOffset);
+		}
+	}
 
-	RecomputeLocalAABB();
+	SetGeometry(MeshGeometry::Create(std::move(vertices), std::move(indices)));
 }
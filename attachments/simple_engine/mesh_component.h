@@ -17,75 +17,97 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <cassert>
 #include <glm/glm.hpp>
 #include <limits>
+#include <memory>
+#include <span>
 #include <string>
 #include <vector>
 
 #include <vulkan/vulkan.hpp>
 
 #include "component.h"
+#include "content_hash.h"
 
 /**
  * @brief Structure representing per-instance data for instanced rendering.
- * Using explicit float vectors instead of matrices for better control over GPU data layout.
+ *
+ * This is also the GPU layout of the instance buffer (52 bytes): the affine model
+ * matrix as three rows and the material index with flags. The vertex shaders derive
+ * the normal matrix; instances flagged as uniformly scaled use the model matrix
+ * itself, the others its cofactor matrix (see instance_data.slang).
  */
 struct InstanceData {
-  // Model matrix as glm::mat4 (4x4)
-  glm::mat4 modelMatrix{};
-
-  // Normal matrix as glm::mat3x4 (3 columns of vec4: xyz = normal matrix columns, w unused)
-  glm::mat3x4 normalMatrix{};
-
-  // Material index for this instance
-  uint32_t materialIndex{0};
-
-  InstanceData() {
-    // Initialize as identity matrices
-    modelMatrix = glm::mat4(1.0f);
-    normalMatrix[0] = glm::vec4(1.0f, 0.0f, 0.0f, 0.0f);
-    normalMatrix[1] = glm::vec4(0.0f, 1.0f, 0.0f, 0.0f);
-    normalMatrix[2] = glm::vec4(0.0f, 0.0f, 1.0f, 0.0f);
-    materialIndex = 0;
-  }
+  // Model matrix rows (xyz = upper 3x3 row, w = translation); the fourth row is (0, 0, 0, 1)
+  glm::vec4 modelRows[3]{
+    glm::vec4(1.0f, 0.0f, 0.0f, 0.0f),
+    glm::vec4(0.0f, 1.0f, 0.0f, 0.0f),
+    glm::vec4(0.0f, 0.0f, 1.0f, 0.0f)
+  };
 
-  explicit InstanceData(const glm::mat4& transform, uint32_t matIndex = 0) {
-    // Store model matrix directly
-    modelMatrix = transform;
+  // Material index (low 24 bits) and flags
+  uint32_t materialAndFlags{UniformScaleFlag};
+
+  static constexpr uint32_t MaterialIndexMask = 0x00FFFFFFu;
+  // Set when the upper 3x3 is a rotation times a uniform scale, so it transforms normals as well
+  static constexpr uint32_t UniformScaleFlag = 1u << 31;
 
-    // Calculate normal matrix (inverse transpose of upper-left 3x3)
-    glm::mat3 normalMat3 = glm::transpose(glm::inverse(glm::mat3(transform)));
-    normalMatrix[0] = glm::vec4(normalMat3[0], 0.0f);
-    normalMatrix[1] = glm::vec4(normalMat3[1], 0.0f);
-    normalMatrix[2] = glm::vec4(normalMat3[2], 0.0f);
+  InstanceData() = default;
 
-    materialIndex = matIndex;
+  explicit InstanceData(const glm::mat4& transform, uint32_t matIndex = 0) {
+    setModelMatrix(transform);
+    setMaterialIndex(matIndex);
   }
 
-  // Helper methods for backward compatibility
   [[nodiscard]] glm::mat4 getModelMatrix() const {
-    return modelMatrix;
+    // glm::mat4 is column-major: transpose the rows back into columns
+    return glm::transpose(glm::mat4(modelRows[0], modelRows[1], modelRows[2], glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)));
   }
 
   void setModelMatrix(const glm::mat4& matrix) {
-    modelMatrix = matrix;
-
-    // Also update normal matrix when model matrix changes
-    glm::mat3 normalMat3 = glm::transpose(glm::inverse(glm::mat3(matrix)));
-    normalMatrix[0] = glm::vec4(normalMat3[0], 0.0f);
-    normalMatrix[1] = glm::vec4(normalMat3[1], 0.0f);
-    normalMatrix[2] = glm::vec4(normalMat3[2], 0.0f);
+    const glm::mat4 rows = glm::transpose(matrix);
+    modelRows[0] = rows[0];
+    modelRows[1] = rows[1];
+    modelRows[2] = rows[2];
+    materialAndFlags = (materialAndFlags & ~UniformScaleFlag) | (IsUniformScale(modelRows) ? UniformScaleFlag : 0u);
   }
 
+  // Inverse transpose of the upper 3x3, computed on demand (the GPU derives its own)
   [[nodiscard]] glm::mat3 getNormalMatrix() const {
-    return {
-      glm::vec3(normalMatrix[0]),
-      glm::vec3(normalMatrix[1]),
-      glm::vec3(normalMatrix[2])
-    };
+    const glm::mat3 m(getModelMatrix());
+    return hasUniformScale() ? m : glm::transpose(glm::inverse(m));
   }
 
+  [[nodiscard]] uint32_t getMaterialIndex() const {
+    return materialAndFlags & MaterialIndexMask;
+  }
+
+  void setMaterialIndex(uint32_t matIndex) {
+    assert(matIndex <= MaterialIndexMask && "InstanceData: material index exceeds 24 bits");
+    materialAndFlags = (materialAndFlags & ~MaterialIndexMask) | (matIndex & MaterialIndexMask);
+  }
+
+  [[nodiscard]] bool hasUniformScale() const {
+    return (materialAndFlags & UniformScaleFlag) != 0;
+  }
+
+  /**
+	 * @brief Test whether the upper 3x3 of three model rows is a rotation times a uniform scale.
+	 * Its columns must have equal lengths and be orthogonal, within a relative tolerance.
+	 */
+  static bool IsUniformScale(const glm::vec4 (&rows)[3]);
+
+  /**
+	 * @brief Append instances for many transforms sharing a material.
+	 * Uses SSE2 or NEON when available; produces the same data as the constructor.
+	 * @param transforms Model matrices.
+	 * @param matIndex Material index of every new instance.
+	 * @param out Receives the instances, appended.
+	 */
+  static void AppendInstances(std::span<const glm::mat4> transforms, uint32_t matIndex, std::vector<InstanceData>& out);
+
   static vk::VertexInputBindingDescription getBindingDescription() {
     constexpr vk::VertexInputBindingDescription bindingDescription(
       1,
@@ -97,120 +119,43 @@ struct InstanceData {
     return bindingDescription;
   }
 
-  static std::array<vk::VertexInputAttributeDescription, 7> getAttributeDescriptions() {
-    constexpr uint32_t modelBase = offsetof(InstanceData, modelMatrix);
-    constexpr uint32_t normalBase = offsetof(InstanceData, normalMatrix);
-    constexpr uint32_t vec4Size = sizeof(glm::vec4);
-    constexpr std::array<vk::VertexInputAttributeDescription, 7> attributeDescriptions = {
-      // Model matrix columns (locations 4-7)
-      vk::VertexInputAttributeDescription{
-        .location = 4,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 0u * vec4Size
-      },
-      vk::VertexInputAttributeDescription{
-        .location = 5,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 1u * vec4Size
-      },
-      vk::VertexInputAttributeDescription{
-        .location = 6,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 2u * vec4Size
-      },
-      vk::VertexInputAttributeDescription{
-        .location = 7,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 3u * vec4Size
-      },
-      // Normal matrix columns (locations 8-10)
-      vk::VertexInputAttributeDescription{
-        .location = 8,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = normalBase + 0u * vec4Size
-      },
-      vk::VertexInputAttributeDescription{
-        .location = 9,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = normalBase + 1u * vec4Size
-      },
-      vk::VertexInputAttributeDescription{
-        .location = 10,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = normalBase + 2u * vec4Size
-      }
-    };
-    return attributeDescriptions;
-  }
-
-  // Get all attribute descriptions for model matrix (4 vec4s)
-  static std::array<vk::VertexInputAttributeDescription, 4> getModelMatrixAttributeDescriptions() {
-    constexpr uint32_t modelBase = offsetof(InstanceData, modelMatrix);
+  static std::array<vk::VertexInputAttributeDescription, 4> getAttributeDescriptions() {
+    constexpr uint32_t rowBase = offsetof(InstanceData, modelRows);
     constexpr uint32_t vec4Size = sizeof(glm::vec4);
     constexpr std::array<vk::VertexInputAttributeDescription, 4> attributeDescriptions = {
+      // Model matrix rows (locations 4-6)
       vk::VertexInputAttributeDescription{
         .location = 4,
         .binding = 1,
         .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 0u * vec4Size
+        .offset = rowBase + 0u * vec4Size
       },
       vk::VertexInputAttributeDescription{
         .location = 5,
         .binding = 1,
         .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 1u * vec4Size
+        .offset = rowBase + 1u * vec4Size
       },
       vk::VertexInputAttributeDescription{
         .location = 6,
         .binding = 1,
         .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 2u * vec4Size
+        .offset = rowBase + 2u * vec4Size
       },
+      // Material index and flags (location 7)
       vk::VertexInputAttributeDescription{
         .location = 7,
         .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = modelBase + 3u * vec4Size
-      }
-    };
-    return attributeDescriptions;
-  }
-
-  // Get all attribute descriptions for normal matrix (3 vec4s)
-  static std::array<vk::VertexInputAttributeDescription, 3> getNormalMatrixAttributeDescriptions() {
-    constexpr uint32_t normalBase = offsetof(InstanceData, normalMatrix);
-    constexpr uint32_t vec4Size = sizeof(glm::vec4);
-    constexpr std::array<vk::VertexInputAttributeDescription, 3> attributeDescriptions = {
-      vk::VertexInputAttributeDescription{
-        .location = 8,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = normalBase + 0u * vec4Size
-      },
-      vk::VertexInputAttributeDescription{
-        .location = 9,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = normalBase + 1u * vec4Size
-      },
-      vk::VertexInputAttributeDescription{
-        .location = 10,
-        .binding = 1,
-        .format = vk::Format::eR32G32B32A32Sfloat,
-        .offset = normalBase + 2u * vec4Size
+        .format = vk::Format::eR32Uint,
+        .offset = offsetof(InstanceData, materialAndFlags)
       }
     };
     return attributeDescriptions;
   }
 };
 
+static_assert(sizeof(InstanceData) == 52, "InstanceData must match the instance layout read by the shaders");
+
 /**
  * @brief Structure representing a vertex in a mesh.
  */
@@ -269,13 +214,101 @@ struct Vertex {
   }
 };
 
+// Full detail plus up to three reduced-detail levels
+constexpr uint32_t MaxMeshLodLevels = 4;
+
+/**
+ * @brief A reduced-detail level of a mesh, drawn from the same vertex buffer.
+ */
+struct MeshLod {
+  uint32_t firstIndex = 0; // offset in the index buffer, which holds the full-detail indices first
+  uint32_t indexCount = 0;
+  float error = 0.0f; // simplification error relative to the mesh's bounding radius
+};
+
+/**
+ * @brief A cluster of up to 124 full-detail triangles, contiguous in the index buffer (see Meshlets::Build).
+ * The normal cone contains every triangle normal of the meshlet; coneCutoff is
+ * the sine of its half angle, or 1 when the cone is too wide to ever cull.
+ */
+struct Meshlet {
+  glm::vec3 center{0.0f}; // bounding sphere, in object space
+  float radius = 0.0f;
+  glm::vec3 coneAxis{0.0f, 0.0f, 1.0f};
+  float coneCutoff = 1.0f;
+  uint32_t firstIndex = 0;
+  uint32_t triangleCount = 0;
+};
+
+/**
+ * @brief Immutable vertex and index data of a mesh, shared by reference.
+ *
+ * The model loader creates one per glTF mesh and material; the MeshComponents
+ * showing it hold the same instance, so its CPU data exists once however many
+ * entities use it. The bounds are computed once, at creation.
+ */
+struct MeshGeometry {
+  std::vector<Vertex> vertices;
+  std::vector<uint32_t> indices;
+  // Indices of the reduced levels, uploaded after `indices`; `lods` is ordered by increasing error
+  std::vector<uint32_t> lodIndices;
+  std::vector<MeshLod> lods;
+  // Clusters of the full-detail level, in index order; empty if the mesh was not split
+  std::vector<Meshlet> meshlets;
+  glm::vec3 aabbMin{0.0f};
+  glm::vec3 aabbMax{0.0f};
+  // Digest of the source vertices and indices, zero if not hashed; equal digests mean interchangeable geometry
+  ContentHash::Digest contentHash;
+
+  /**
+	 * @brief Create shared geometry, taking over the vertex and index data.
+	 * @param vertices The vertices.
+	 * @param indices The indices.
+	 * @param lodIndices The indices of the reduced-detail levels (see MeshSimplifier::BuildLodChain).
+	 * @param lods The reduced-detail levels.
+	 * @param meshlets The clusters of the full-detail indices.
+	 * @param contentHash The digest identifying the geometry's content (see ModelLoader).
+	 * @return The geometry.
+	 */
+  static std::shared_ptr<const MeshGeometry> Create(std::vector<Vertex> vertices, std::vector<uint32_t> indices,
+                                                    std::vector<uint32_t> lodIndices = {}, std::vector<MeshLod> lods = {},
+                                                    std::vector<Meshlet> meshlets = {}, ContentHash::Digest contentHash = {});
+
+  MeshGeometry() = default;
+  MeshGeometry(const MeshGeometry&) = delete;
+  MeshGeometry& operator=(const MeshGeometry&) = delete;
+  ~MeshGeometry() {
+    residentBytes.fetch_sub(GetCpuBytes(), std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] size_t GetCpuBytes() const {
+    return vertices.capacity() * sizeof(Vertex) + (indices.capacity() + lodIndices.capacity()) * sizeof(uint32_t) + lods.capacity() * sizeof(MeshLod) +
+           meshlets.capacity() * sizeof(Meshlet);
+  }
+
+  /**
+	 * @brief Get the CPU memory held by all live geometry.
+	 * @return The size in bytes.
+	 */
+  static size_t GetResidentBytes() {
+    return residentBytes.load(std::memory_order_relaxed);
+  }
+
+  private:
+    static inline std::atomic<size_t> residentBytes{0};
+};
+using MeshGeometryPtr = std::shared_ptr<const MeshGeometry>;
+
 /**
  * @brief Component that handles the mesh data for rendering.
  */
 class MeshComponent final : public Component {
   private:
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+    // Shared geometry; null once the CPU copy was released after the GPU upload
+    MeshGeometryPtr geometry;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    bool keepCpuGeometry = false; // e.g. needed by a physics mesh collider
 
     // Cached local-space AABB (encompassing all instances)
     glm::vec3 localAABBMin{0.0f};
@@ -329,38 +362,82 @@ class MeshComponent final : public Component {
     }
 
     /**
-	 * @brief Set the vertices of the mesh.
+	 * @brief Reference shared geometry without copying it.
+	 * @param newGeometry The geometry.
+	 */
+    void SetGeometry(MeshGeometryPtr newGeometry);
+
+    /**
+	 * @brief Get the shared geometry.
+	 * @return The geometry, or null if the CPU copy was released.
+	 */
+    [[nodiscard]] const MeshGeometryPtr& GetGeometry() const {
+      return geometry;
+    }
+
+    /**
+	 * @brief Set the vertices of the mesh (copies; prefer SetGeometry for loaded meshes).
 	 * @param newVertices The new vertices.
 	 */
     void SetVertices(const std::vector<Vertex>& newVertices) {
-      vertices = newVertices;
-      meshAABBValid = false;
-      localAABBValid = false;
-      RecomputeLocalAABB();
+      SetGeometry(MeshGeometry::Create(newVertices, GetIndices()));
     }
 
     /**
 	 * @brief Get the vertices of the mesh.
-	 * @return The vertices.
+	 * @return The vertices; empty if the CPU copy was released.
 	 */
     [[nodiscard]] const std::vector<Vertex>& GetVertices() const {
-      return vertices;
+      static const std::vector<Vertex> noVertices;
+      return geometry ? geometry->vertices : noVertices;
     }
 
     /**
-	 * @brief Set the indices of the mesh.
+	 * @brief Set the indices of the mesh (copies; prefer SetGeometry for loaded meshes).
 	 * @param newIndices The new indices.
 	 */
     void SetIndices(const std::vector<uint32_t>& newIndices) {
-      indices = newIndices;
+      SetGeometry(MeshGeometry::Create(GetVertices(), newIndices));
     }
 
     /**
 	 * @brief Get the indices of the mesh.
-	 * @return The indices.
+	 * @return The indices; empty if the CPU copy was released.
 	 */
     [[nodiscard]] const std::vector<uint32_t>& GetIndices() const {
-      return indices;
+      static const std::vector<uint32_t> noIndices;
+      return geometry ? geometry->indices : noIndices;
+    }
+
+    // Counts and bounds survive ReleaseCpuGeometry()
+    [[nodiscard]] uint32_t GetVertexCount() const {
+      return vertexCount;
+    }
+    [[nodiscard]] uint32_t GetIndexCount() const {
+      return indexCount;
+    }
+
+    /**
+	 * @brief Drop this component's reference to its CPU geometry once the GPU copy exists.
+	 * Does nothing while the geometry is marked as needed on the CPU.
+	 * @return True if the reference was dropped.
+	 */
+    bool ReleaseCpuGeometry() {
+      if (keepCpuGeometry || !geometry)
+        return false;
+      geometry.reset();
+      return true;
+    }
+
+    /**
+	 * @brief Mark the CPU geometry as needed after upload (physics mesh colliders).
+	 * @param keep True to keep it.
+	 */
+    void SetKeepCpuGeometry(bool keep) {
+      keepCpuGeometry = keep;
+    }
+    [[nodiscard]] bool KeepsCpuGeometry() const {
+      return keepCpuGeometry;
     }
 
     /**
@@ -0,0 +1,410 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "mesh_simplifier.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace
+{
+/**
+ * Sum of squared distances to a set of planes, weighted by triangle area:
+ * E(p) = p^T A p + 2 b.p + c. Kept in double precision, since the terms cancel
+ * for points close to the planes.
+ */
+struct Quadric
+{
+	double a00 = 0.0, a11 = 0.0, a22 = 0.0, a01 = 0.0, a02 = 0.0, a12 = 0.0;
+	double b0 = 0.0, b1 = 0.0, b2 = 0.0;
+	double c      = 0.0;
+	double weight = 0.0;
+
+	void AddPlane(const glm::dvec3 &n, double d, double w)
+	{
+		a00 += w * n.x * n.x;
+		a11 += w * n.y * n.y;
+		a22 += w * n.z * n.z;
+		a01 += w * n.x * n.y;
+		a02 += w * n.x * n.z;
+		a12 += w * n.y * n.z;
+		b0 += w * n.x * d;
+		b1 += w * n.y * d;
+		b2 += w * n.z * d;
+		c += w * d * d;
+		weight += w;
+	}
+
+	void Add(const Quadric &o)
+	{
+		a00 += o.a00;
+		a11 += o.a11;
+		a22 += o.a22;
+		a01 += o.a01;
+		a02 += o.a02;
+		a12 += o.a12;
+		b0 += o.b0;
+		b1 += o.b1;
+		b2 += o.b2;
+		c += o.c;
+		weight += o.weight;
+	}
+
+	// Mean squared distance of a point to the planes
+	double Error(const glm::vec3 &p) const
+	{
+		if (weight <= 0.0)
+		{
+			return 0.0;
+		}
+		const double x = p.x, y = p.y, z = p.z;
+		const double e = a00 * x * x + a11 * y * y + a22 * z * z + 2.0 * (a01 * x * y + a02 * x * z + a12 * y * z) +
+		                 2.0 * (b0 * x + b1 * y + b2 * z) + c;
+		return std::max(e / weight, 0.0);
+	}
+};
+
+struct PositionHash
+{
+	size_t operator()(const glm::vec3 &p) const
+	{
+		// Adding zero turns -0 into +0, which compares equal and must hash equal
+		const glm::vec3 q = p + glm::vec3(0.0f);
+		uint32_t        bits[3];
+		std::memcpy(bits, &q, sizeof(bits));
+		return (static_cast<size_t>(bits[0]) * 73856093u) ^ (static_cast<size_t>(bits[1]) * 19349663u) ^ (static_cast<size_t>(bits[2]) * 83492791u);
+	}
+};
+
+struct Collapse
+{
+	double   cost;
+	uint32_t from;
+	uint32_t to;
+};
+
+glm::vec3 TriangleNormal(const glm::vec3 &p0, const glm::vec3 &p1, const glm::vec3 &p2)
+{
+	return glm::cross(p1 - p0, p2 - p0);
+}
+
+/**
+ * Map every vertex to the first vertex at the same position and lock the vertices
+ * that must not move: attribute seams, open borders and non-manifold edges.
+ */
+void ClassifyVertices(const std::vector<Vertex> &vertices, std::span<const uint32_t> indices, std::vector<uint32_t> &canonical, std::vector<uint8_t> &locked)
+{
+	const size_t vertexCount = vertices.size();
+	canonical.resize(vertexCount);
+	locked.assign(vertexCount, 0);
+
+	std::vector<uint8_t> referenced(vertexCount, 0);
+	for (uint32_t index : indices)
+	{
+		referenced[index] = 1;
+	}
+
+	// Several referenced vertices at one position form a seam
+	std::unordered_map<glm::vec3, uint32_t, PositionHash> firstAtPosition;
+	firstAtPosition.reserve(vertexCount);
+	std::vector<uint32_t> groupSize(vertexCount, 0);
+	for (uint32_t v = 0; v < vertexCount; ++v)
+	{
+		canonical[v] = firstAtPosition.try_emplace(vertices[v].position, v).first->second;
+		if (referenced[v])
+		{
+			groupSize[canonical[v]]++;
+		}
+	}
+
+	// Edge use counts on welded positions: 1 is an open border, more than 2 non-manifold
+	std::unordered_map<uint64_t, uint32_t> edgeUses;
+	edgeUses.reserve(indices.size());
+	for (size_t t = 0; t + 2 < indices.size(); t += 3)
+	{
+		for (int k = 0; k < 3; ++k)
+		{
+			const uint32_t a = canonical[indices[t + k]];
+			const uint32_t b = canonical[indices[t + (k + 1) % 3]];
+			edgeUses[(static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b)]++;
+		}
+	}
+	std::vector<uint8_t> lockedPosition(vertexCount, 0);
+	for (const auto &[key, uses] : edgeUses)
+	{
+		if (uses != 2)
+		{
+			lockedPosition[static_cast<uint32_t>(key >> 32)]   = 1;
+			lockedPosition[static_cast<uint32_t>(key & 0xFFFFFFFFu)] = 1;
+		}
+	}
+
+	for (uint32_t v = 0; v < vertexCount; ++v)
+	{
+		locked[v] = (groupSize[canonical[v]] > 1 || lockedPosition[canonical[v]]) ? 1 : 0;
+	}
+}
+}        // namespace
+
+namespace MeshSimplifier
+{
+std::vector<uint32_t> Simplify(const std::vector<Vertex> &vertices, std::span<const uint32_t> indices, size_t targetIndexCount,
+                               float maxError, float &outError)
+{
+	outError = 0.0f;
+	std::vector<uint32_t> result(indices.begin(), indices.end() - static_cast<ptrdiff_t>(indices.size() % 3));
+	targetIndexCount -= targetIndexCount % 3;
+	if (vertices.empty() || result.size() <= targetIndexCount)
+	{
+		return result;
+	}
+	const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+	std::vector<uint32_t> canonical;
+	std::vector<uint8_t>  locked;
+	ClassifyVertices(vertices, result, canonical, locked);
+
+	std::vector<Quadric> quadrics(vertexCount);
+	for (size_t t = 0; t < result.size(); t += 3)
+	{
+		const glm::dvec3 p0(vertices[result[t]].position);
+		const glm::dvec3 p1(vertices[result[t + 1]].position);
+		const glm::dvec3 p2(vertices[result[t + 2]].position);
+		const glm::dvec3 n      = glm::cross(p1 - p0, p2 - p0);
+		const double     length = glm::length(n);
+		if (length <= 0.0)
+		{
+			continue;
+		}
+		const glm::dvec3 unit = n / length;
+		const double     d    = -glm::dot(unit, p0);
+		for (int k = 0; k < 3; ++k)
+		{
+			quadrics[result[t + k]].AddPlane(unit, d, length * 0.5);
+		}
+	}
+
+	const double          maxErrorSq = static_cast<double>(maxError) * static_cast<double>(maxError);
+	double                worstCost  = 0.0;
+	std::vector<uint32_t> remap(vertexCount);
+	std::vector<uint32_t> touched(vertexCount, 0);
+	std::vector<uint32_t> adjacencyOffsets;
+	std::vector<uint32_t> adjacency;
+	std::vector<Collapse> candidates;
+	for (uint32_t v = 0; v < vertexCount; ++v)
+	{
+		remap[v] = v;
+	}
+
+	// Each pass collapses a set of edges whose one-rings do not overlap, cheapest first
+	for (uint32_t pass = 1; result.size() > targetIndexCount; ++pass)
+	{
+		// Triangles around each vertex
+		adjacencyOffsets.assign(vertexCount + 1, 0);
+		for (uint32_t index : result)
+		{
+			adjacencyOffsets[index + 1]++;
+		}
+		for (uint32_t v = 0; v < vertexCount; ++v)
+		{
+			adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+		}
+		adjacency.resize(result.size());
+		{
+			std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (size_t i = 0; i < result.size(); ++i)
+			{
+				adjacency[cursor[result[i]]++] = static_cast<uint32_t>(i / 3);
+			}
+		}
+
+		// Every directed edge of a manifold mesh appears in exactly one triangle
+		candidates.clear();
+		for (size_t t = 0; t < result.size(); t += 3)
+		{
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t from = result[t + k];
+				const uint32_t to   = result[t + (k + 1) % 3];
+				if (locked[from])
+				{
+					continue;
+				}
+				const double cost = quadrics[from].Error(vertices[to].position);
+				if (cost <= maxErrorSq)
+				{
+					candidates.push_back({cost, from, to});
+				}
+			}
+		}
+		std::ranges::sort(candidates, {}, &Collapse::cost);
+
+		const size_t trianglesToRemove = (result.size() - targetIndexCount) / 3;
+		size_t       removed           = 0;
+		uint32_t     collapses         = 0;
+		for (const Collapse &candidate : candidates)
+		{
+			if (removed >= trianglesToRemove)
+			{
+				break;
+			}
+			if (touched[candidate.from] == pass || touched[candidate.to] == pass)
+			{
+				continue;
+			}
+
+			// Moving `from` onto `to` must not flip any remaining triangle around `from`
+			const glm::vec3 &target   = vertices[candidate.to].position;
+			uint32_t         removing = 0;
+			bool             flips    = false;
+			for (uint32_t a = adjacencyOffsets[candidate.from]; a < adjacencyOffsets[candidate.from + 1] && !flips; ++a)
+			{
+				const uint32_t *tri = &result[static_cast<size_t>(adjacency[a]) * 3];
+				if (tri[0] == candidate.to || tri[1] == candidate.to || tri[2] == candidate.to)
+				{
+					removing++;
+					continue;
+				}
+				glm::vec3 p[3] = {vertices[tri[0]].position, vertices[tri[1]].position, vertices[tri[2]].position};
+				const glm::vec3 before = TriangleNormal(p[0], p[1], p[2]);
+				for (int k = 0; k < 3; ++k)
+				{
+					if (tri[k] == candidate.from)
+					{
+						p[k] = target;
+					}
+				}
+				flips = glm::dot(before, TriangleNormal(p[0], p[1], p[2])) <= 0.0f;
+			}
+			if (flips || removing == 0)
+			{
+				continue;
+			}
+
+			// Freeze the one-ring for the rest of the pass, so the flip test above stays valid
+			for (uint32_t a = adjacencyOffsets[candidate.from]; a < adjacencyOffsets[candidate.from + 1]; ++a)
+			{
+				const uint32_t *tri = &result[static_cast<size_t>(adjacency[a]) * 3];
+				touched[tri[0]] = touched[tri[1]] = touched[tri[2]] = pass;
+			}
+			remap[candidate.from] = candidate.to;
+			quadrics[candidate.to].Add(quadrics[candidate.from]);
+			worstCost = std::max(worstCost, candidate.cost);
+			removed += removing;
+			collapses++;
+		}
+		if (collapses == 0)
+		{
+			break;
+		}
+
+		// Apply the collapses and drop the triangles that became degenerate
+		size_t write = 0;
+		for (size_t t = 0; t < result.size(); t += 3)
+		{
+			const uint32_t i0 = remap[result[t]];
+			const uint32_t i1 = remap[result[t + 1]];
+			const uint32_t i2 = remap[result[t + 2]];
+			if (canonical[i0] == canonical[i1] || canonical[i1] == canonical[i2] || canonical[i0] == canonical[i2])
+			{
+				continue;
+			}
+			result[write++] = i0;
+			result[write++] = i1;
+			result[write++] = i2;
+		}
+		result.resize(write);
+	}
+
+	outError = static_cast<float>(std::sqrt(worstCost));
+	return result;
+}
+
+void BuildLodChain(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices, const Settings &settings,
+                   std::vector<uint32_t> &lodIndices, std::vector<MeshLod> &lods)
+{
+	lodIndices.clear();
+	lods.clear();
+	if (vertices.empty() || indices.size() / 3 < settings.minTriangles)
+	{
+		return;
+	}
+
+	glm::vec3 aabbMin = vertices[0].position;
+	glm::vec3 aabbMax = vertices[0].position;
+	for (const Vertex &v : vertices)
+	{
+		aabbMin = glm::min(aabbMin, v.position);
+		aabbMax = glm::max(aabbMax, v.position);
+	}
+	const float radius = 0.5f * glm::length(aabbMax - aabbMin);
+	if (radius <= 0.0f)
+	{
+		return;
+	}
+
+	const uint32_t            baseCount = static_cast<uint32_t>(indices.size());
+	std::span<const uint32_t> source(indices);
+	float                     error = 0.0f;
+	for (uint32_t level = 0; level < std::min(settings.maxLevels, MaxMeshLodLevels - 1); ++level)
+	{
+		if (source.size() / 3 < settings.minTriangles)
+		{
+			break;
+		}
+		const size_t target    = static_cast<size_t>(static_cast<float>(source.size() / 3) * settings.reduction) * 3;
+		float        stepError = 0.0f;
+		std::vector<uint32_t> reduced = Simplify(vertices, source, target, settings.maxError * radius, stepError);
+		if (reduced.empty() || reduced.size() * 10 > source.size() * 9)
+		{
+			break;
+		}
+
+		error += stepError / radius;
+		const uint32_t offset = static_cast<uint32_t>(lodIndices.size());
+		lodIndices.insert(lodIndices.end(), reduced.begin(), reduced.end());
+		lods.push_back({.firstIndex = baseCount + offset, .indexCount = static_cast<uint32_t>(reduced.size()), .error = error});
+		source = std::span<const uint32_t>(lodIndices.data() + offset, reduced.size());
+	}
+}
+
+void ChainStats::Add(size_t baseIndexCount, std::span<const MeshLod> lods)
+{
+	meshes++;
+	if (!lods.empty())
+	{
+		reducedMeshes++;
+	}
+
+	uint64_t triangleCount = baseIndexCount / 3;
+	triangles[0] += triangleCount;
+	levelMeshes[0]++;
+	for (uint32_t level = 1; level < MaxMeshLodLevels; ++level)
+	{
+		if (level <= lods.size())
+		{
+			const MeshLod &lod = lods[level - 1];
+			triangleCount      = lod.indexCount / 3;
+			levelMeshes[level]++;
+			maxError[level] = std::max(maxError[level], static_cast<double>(lod.error));
+			meanError[level] += (static_cast<double>(lod.error) - meanError[level]) / static_cast<double>(levelMeshes[level]);
+		}
+		triangles[level] += triangleCount;
+	}
+}
+}        // namespace MeshSimplifier
@@ -0,0 +1,93 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "mesh_component.h"
+
+/**
+ * @brief Quadric-error mesh simplification for LOD chains.
+ *
+ * Simplification only rewrites index buffers: every collapse moves a vertex onto
+ * one of its neighbours, so all levels of a mesh draw from its original vertex
+ * buffer. Vertices on open borders, on attribute seams (several vertices at one
+ * position) and on non-manifold edges never move, which keeps silhouettes and
+ * texture seams intact at the price of a smaller reduction on heavily split meshes.
+ */
+namespace MeshSimplifier
+{
+struct Settings
+{
+	uint32_t maxLevels    = MaxMeshLodLevels - 1;        // reduced levels to build
+	float    reduction    = 0.5f;                        // target triangle ratio between levels
+	float    maxError     = 0.05f;                       // largest error per level, relative to the mesh radius
+	uint32_t minTriangles = 128;                         // meshes and levels below this are not reduced further
+};
+
+/**
+ * @brief Reduce a triangle list by edge collapses in order of increasing quadric error.
+ * @param vertices The vertex buffer the indices refer to.
+ * @param indices The triangle list to reduce.
+ * @param targetIndexCount Stop once the list is this short.
+ * @param maxError Do not collapse edges whose error exceeds this distance, in mesh units.
+ * @param outError Receives the largest error of the collapses made, in mesh units.
+ * @return The reduced triangle list; longer than the target if the error limit was reached first.
+ */
+std::vector<uint32_t> Simplify(const std::vector<Vertex> &vertices, std::span<const uint32_t> indices, size_t targetIndexCount,
+                               float maxError, float &outError);
+
+/**
+ * @brief Build the reduced-detail levels of a mesh.
+ * Each level is simplified from the previous one; its error is the sum of the
+ * errors of the steps, so it bounds the deviation from the full-detail mesh.
+ * The chain ends early once a step cannot remove at least a tenth of the triangles.
+ * @param vertices The vertices.
+ * @param indices The full-detail triangle list.
+ * @param settings Chain parameters.
+ * @param lodIndices Receives the indices of all reduced levels.
+ * @param lods Receives the levels, whose firstIndex counts from the end of `indices`.
+ */
+void BuildLodChain(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices, const Settings &settings,
+                   std::vector<uint32_t> &lodIndices, std::vector<MeshLod> &lods);
+
+/**
+ * @brief Offline metrics of the LOD chains of a set of meshes.
+ */
+struct ChainStats
+{
+	uint32_t meshes        = 0;
+	uint32_t reducedMeshes = 0;        // meshes with at least one reduced level
+	// Triangles at each level; a mesh without a level counts at its coarsest one
+	uint64_t triangles[MaxMeshLodLevels]{};
+	// Error of each level over the meshes that have it, relative to the mesh radius
+	double   maxError[MaxMeshLodLevels]{};
+	double   meanError[MaxMeshLodLevels]{};
+	uint32_t levelMeshes[MaxMeshLodLevels]{};
+	double   buildMs = 0.0;
+
+	/**
+	 * @brief Add a mesh.
+	 * @param baseIndexCount Index count of the full-detail level.
+	 * @param lods The reduced levels of the mesh.
+	 */
+	void Add(size_t baseIndexCount, std::span<const MeshLod> lods);
+};
+}        // namespace MeshSimplifier
@@ -0,0 +1,248 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "meshlets.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+// Smallest cosine between the cone axis and a triangle normal that still gives a usable cone
+constexpr float MinConeDot = 0.1f;
+
+constexpr size_t NoCandidate = std::numeric_limits<size_t>::max();
+
+/**
+ * Compute the bounding sphere and normal cone of the triangles in [first, first + count).
+ */
+void ComputeBounds(const std::vector<Vertex> &vertices, const std::vector<uint32_t> &indices, Meshlet &meshlet)
+{
+	const size_t first = meshlet.firstIndex;
+	const size_t end   = first + static_cast<size_t>(meshlet.triangleCount) * 3;
+
+	glm::vec3 aabbMin = vertices[indices[first]].position;
+	glm::vec3 aabbMax = aabbMin;
+	for (size_t i = first; i < end; ++i)
+	{
+		aabbMin = glm::min(aabbMin, vertices[indices[i]].position);
+		aabbMax = glm::max(aabbMax, vertices[indices[i]].position);
+	}
+	meshlet.center = 0.5f * (aabbMin + aabbMax);
+	float radius2  = 0.0f;
+	for (size_t i = first; i < end; ++i)
+	{
+		const glm::vec3 d = vertices[indices[i]].position - meshlet.center;
+		radius2           = std::max(radius2, glm::dot(d, d));
+	}
+	meshlet.radius = std::sqrt(radius2);
+
+	// Cone around the mean of the unit triangle normals; degenerate triangles have no facing
+	glm::vec3              axis(0.0f);
+	std::vector<glm::vec3> normals;
+	normals.reserve(meshlet.triangleCount);
+	for (size_t i = first; i < end; i += 3)
+	{
+		const glm::vec3 &p0 = vertices[indices[i]].position;
+		const glm::vec3  n  = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+		const float      l  = glm::length(n);
+		if (l > 0.0f)
+		{
+			normals.push_back(n / l);
+			axis = axis + n / l;
+		}
+	}
+	meshlet.coneCutoff = 1.0f;
+	const float axisLength = glm::length(axis);
+	if (normals.empty() || axisLength <= 0.0f)
+	{
+		return;
+	}
+	meshlet.coneAxis = axis / axisLength;
+	float minDot     = 1.0f;
+	for (const glm::vec3 &n : normals)
+	{
+		minDot = std::min(minDot, glm::dot(n, meshlet.coneAxis));
+	}
+	if (minDot > MinConeDot)
+	{
+		meshlet.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+	}
+}
+}        // namespace
+
+namespace Meshlets
+{
+void Build(const std::vector<Vertex> &vertices, std::vector<uint32_t> &indices, std::vector<Meshlet> &meshlets)
+{
+	meshlets.clear();
+	const size_t triangleCount = indices.size() / 3;
+	if (triangleCount == 0 || vertices.empty())
+	{
+		return;
+	}
+	const uint32_t vertexCount = static_cast<uint32_t>(vertices.size());
+
+	// Triangles around each vertex
+	std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+	for (size_t i = 0; i < triangleCount * 3; ++i)
+	{
+		adjacencyOffsets[indices[i] + 1]++;
+	}
+	for (uint32_t v = 0; v < vertexCount; ++v)
+	{
+		adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+	}
+	std::vector<uint32_t> adjacency(triangleCount * 3);
+	{
+		std::vector<uint32_t> cursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+		for (size_t i = 0; i < triangleCount * 3; ++i)
+		{
+			adjacency[cursor[indices[i]]++] = static_cast<uint32_t>(i / 3);
+		}
+	}
+
+	std::vector<uint32_t> reordered;
+	reordered.reserve(triangleCount * 3);
+	std::vector<uint8_t>  emitted(triangleCount, 0);
+	std::vector<uint32_t> vertexMeshlet(vertexCount, 0);        // meshlet number + 1 of the last meshlet using the vertex
+	std::vector<uint32_t> candidates;
+	size_t                nextSeed = 0;
+
+	while (reordered.size() < triangleCount * 3)
+	{
+		// Seed with the first remaining triangle: source order usually has some locality
+		while (emitted[nextSeed])
+		{
+			nextSeed++;
+		}
+		const uint32_t tag = static_cast<uint32_t>(meshlets.size()) + 1;
+		Meshlet        meshlet;
+		meshlet.firstIndex = static_cast<uint32_t>(reordered.size());
+		uint32_t meshletVertices = 0;
+		candidates.clear();
+		candidates.push_back(static_cast<uint32_t>(nextSeed));
+
+		while (meshlet.triangleCount < MaxTriangles)
+		{
+			// Pick the candidate adding the fewest new vertices, dropping emitted ones on the way
+			size_t   best      = NoCandidate;
+			uint32_t bestAdded = 4;
+			size_t   write     = 0;
+			for (size_t c = 0; c < candidates.size(); ++c)
+			{
+				const uint32_t t = candidates[c];
+				if (emitted[t])
+				{
+					continue;
+				}
+				candidates[write] = t;
+				uint32_t added    = 0;
+				for (int k = 0; k < 3; ++k)
+				{
+					added += vertexMeshlet[indices[t * 3 + k]] != tag ? 1u : 0u;
+				}
+				if (added < bestAdded && meshletVertices + added <= MaxVertices)
+				{
+					best      = write;
+					bestAdded = added;
+				}
+				write++;
+			}
+			candidates.resize(write);
+			if (best == NoCandidate)
+			{
+				break;
+			}
+
+			const uint32_t t = candidates[best];
+			emitted[t]       = 1;
+			meshlet.triangleCount++;
+			for (int k = 0; k < 3; ++k)
+			{
+				const uint32_t v = indices[t * 3 + k];
+				reordered.push_back(v);
+				if (vertexMeshlet[v] != tag)
+				{
+					vertexMeshlet[v] = tag;
+					meshletVertices++;
+					for (uint32_t a = adjacencyOffsets[v]; a < adjacencyOffsets[v + 1]; ++a)
+					{
+						if (!emitted[adjacency[a]])
+						{
+							candidates.push_back(adjacency[a]);
+						}
+					}
+				}
+			}
+		}
+		meshlets.push_back(meshlet);
+	}
+
+	// A trailing partial triangle, if any, is dropped like the rasterizer would
+	indices = std::move(reordered);
+	for (Meshlet &meshlet : meshlets)
+	{
+		ComputeBounds(vertices, indices, meshlet);
+	}
+}
+
+void Cull(std::span<const Meshlet> meshlets, const glm::mat4 &model, const glm::vec4 (&worldPlanes)[6], const glm::vec3 &cameraPosition,
+          bool coneCulling, std::vector<DrawRange> &out, CullStats &stats)
+{
+	// Planes move into object space with the transposed model matrix: p . (M x) = (M^T p) . x
+	const glm::mat4 modelTransposed = glm::transpose(model);
+	glm::vec4       planes[6];
+	float           planeLengths[6];
+	for (int i = 0; i < 6; ++i)
+	{
+		planes[i]       = modelTransposed * worldPlanes[i];
+		planeLengths[i] = glm::length(glm::vec3(planes[i]));
+	}
+
+	// Facing is preserved by affine maps, except mirroring ones, which flip the winding
+	const bool      cone          = coneCulling && glm::determinant(glm::mat3(model)) > 0.0f;
+	const glm::vec3 localCamera   = cone ? glm::vec3(glm::inverse(model) * glm::vec4(cameraPosition, 1.0f)) : glm::vec3(0.0f);
+	const size_t    firstOutRange = out.size();
+	for (const Meshlet &meshlet : meshlets)
+	{
+		stats.tested++;
+		stats.triangles += meshlet.triangleCount;
+		if (IsOutside(meshlet, planes, planeLengths))
+		{
+			stats.frustumCulled++;
+			continue;
+		}
+		if (cone && IsBackFacing(meshlet, localCamera))
+		{
+			stats.coneCulled++;
+			continue;
+		}
+		stats.visibleTriangles += meshlet.triangleCount;
+
+		const uint32_t indexCount = meshlet.triangleCount * 3;
+		if (out.size() > firstOutRange && out.back().firstIndex + out.back().indexCount == meshlet.firstIndex)
+		{
+			out.back().indexCount += indexCount;
+		}
+		else
+		{
+			out.push_back({meshlet.firstIndex, indexCount});
+		}
+	}
+}
+}        // namespace Meshlets
@@ -0,0 +1,117 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "mesh_component.h"
+
+/**
+ * @brief Meshlets (triangle clusters) and their visibility tests.
+ *
+ * A mesh's index buffer is reordered so that each meshlet is a contiguous range
+ * of triangles. Culling a mesh then reduces to a list of index ranges, which the
+ * renderer draws with indirect draws. All tests run in the mesh's object space:
+ * the frustum planes and camera position are moved into it instead of moving
+ * every meshlet bound out of it.
+ */
+namespace Meshlets
+{
+constexpr uint32_t MaxVertices  = 64;
+constexpr uint32_t MaxTriangles = 124;
+
+/**
+ * @brief Split a triangle list into meshlets, reordering it so each meshlet is contiguous.
+ * Meshlets grow over shared vertices, preferring triangles that add the fewest
+ * new vertices, until they reach MaxVertices or MaxTriangles.
+ * @param vertices The vertices the indices refer to.
+ * @param indices The triangle list; reordered in place.
+ * @param meshlets Receives the meshlets, in index buffer order.
+ */
+void Build(const std::vector<Vertex> &vertices, std::vector<uint32_t> &indices, std::vector<Meshlet> &meshlets);
+
+/**
+ * @brief Check whether every triangle of a meshlet faces away from a point.
+ * @param meshlet The meshlet.
+ * @param cameraPosition The camera position, in the meshlet's object space.
+ */
+inline bool IsBackFacing(const Meshlet &meshlet, const glm::vec3 &cameraPosition)
+{
+	const glm::vec3 toCenter = meshlet.center - cameraPosition;
+	return glm::dot(toCenter, meshlet.coneAxis) >= meshlet.coneCutoff * glm::length(toCenter) + meshlet.radius;
+}
+
+/**
+ * @brief Check whether a meshlet's bounding sphere is outside a plane set.
+ * @param meshlet The meshlet.
+ * @param planes Object-space planes (ax + by + cz + d >= 0 inside); they need not be normalized.
+ * @param planeLengths Length of each plane's normal.
+ */
+inline bool IsOutside(const Meshlet &meshlet, const glm::vec4 (&planes)[6], const float (&planeLengths)[6])
+{
+	for (int i = 0; i < 6; ++i)
+	{
+		if (glm::dot(glm::vec3(planes[i]), meshlet.center) + planes[i].w < -meshlet.radius * planeLengths[i])
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+struct DrawRange
+{
+	uint32_t firstIndex;
+	uint32_t indexCount;
+};
+
+struct CullStats
+{
+	uint64_t tested           = 0;
+	uint64_t frustumCulled    = 0;
+	uint64_t coneCulled       = 0;
+	uint64_t triangles        = 0;        // in the tested meshlets
+	uint64_t visibleTriangles = 0;
+
+	void Merge(const CullStats &other)
+	{
+		tested += other.tested;
+		frustumCulled += other.frustumCulled;
+		coneCulled += other.coneCulled;
+		triangles += other.triangles;
+		visibleTriangles += other.visibleTriangles;
+	}
+};
+
+/**
+ * @brief Cull the meshlets of a mesh and collect the index ranges of the visible ones.
+ * Adjacent visible meshlets are merged into one range.
+ * @param meshlets The mesh's meshlets.
+ * @param model Object-to-world matrix of the mesh.
+ * @param worldPlanes World-space frustum planes (ax + by + cz + d >= 0 inside).
+ * @param cameraPosition World-space camera position.
+ * @param coneCulling Also cull back-facing meshlets; only valid when the mesh is drawn with back-face culling.
+ * @param out Receives the visible ranges (appended).
+ * @param stats Receives the counts (accumulated).
+ */
+void Cull(std::span<const Meshlet> meshlets, const glm::mat4 &model, const glm::vec4 (&worldPlanes)[6], const glm::vec3 &cameraPosition,
+          bool coneCulling, std::vector<DrawRange> &out, CullStats &stats);
+}        // namespace Meshlets
@@ -15,10 +15,14 @@
  * limitations under the License.
  */
 #include "model_loader.h"
+#include "debug_system.h"
 #include "mesh_component.h"
+#include "meshlets.h"
 #include "renderer.h"
 #include <algorithm>
+#include <bit>
 #include <cctype>
+#include <chrono>
 #include <filesystem>
 #include <iostream>
 #include <numeric>
@@ -138,7 +142,12 @@ Model* ModelLoader::LoadGLTF(const std::string& filename) {
   // Check if the model is already loaded
   auto it = models.find(filename);
   if (it != models.end()) {
-    return it->second.get();
+    // A model whose CPU geometry was released has to be parsed again
+    auto meshesIt = materialMeshes.find(filename);
+    const bool geometryReleased = meshesIt != materialMeshes.end() && !meshesIt->second.empty() && !meshesIt->second.front().geometry;
+    if (!geometryReleased) {
+      return it->second.get();
+    }
   }
 
   // Create a new model
@@ -1324,34 +1333,98 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
       }
 
       // Add all instances to this MaterialMesh (both new and existing geometry)
-      for (const glm::mat4& instanceTransform : instances) {
-        materialMesh.AddInstance(instanceTransform, static_cast<uint32_t>(materialIndex));
-      }
+      materialMesh.AddInstances(instances, static_cast<uint32_t>(materialIndex));
     }
   }
 
   // Convert geometry-based material mesh map to vector
   std::vector<MaterialMesh> modelMaterialMeshes;
   modelMaterialMeshes.reserve(geometryMaterialMeshMap.size());
+  MeshSimplifier::ChainStats lodStats;
+  size_t meshletCount = 0;
+  double meshletMs = 0.0;
+  // The build settings seed the digest: geometry built differently from the same data is not interchangeable
+  const uint32_t buildKey[] = {generateMeshlets, generateMeshLods, meshLodSettings.maxLevels, std::bit_cast<uint32_t>(meshLodSettings.reduction),
+                               std::bit_cast<uint32_t>(meshLodSettings.maxError), meshLodSettings.minTriangles};
+  const uint64_t buildSeed = ContentHash::Compute(buildKey, sizeof(buildKey)).low;
+  std::erase_if(geometryByContent, [](const auto& entry) { return entry.second.expired(); });
+  GeometryDedupStats dedupStats;
   for (auto& kv : geometryMaterialMeshMap) {
-    modelMaterialMeshes.push_back(std::move(kv.second));
+    MaterialMesh& materialMesh = kv.second;
+    ++dedupStats.meshes;
+    // Identical data under another node, material or file: reuse its geometry, skipping the builds below
+    const auto hashStart = std::chrono::steady_clock::now();
+    const ContentHash::Digest contentHash = ContentHash::Combine(ContentHash::Compute(std::span<const Vertex>(materialMesh.vertices), buildSeed),
+                                                                 ContentHash::Compute(std::span<const uint32_t>(materialMesh.indices), buildSeed));
+    dedupStats.hashMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - hashStart).count();
+    auto contentIt = geometryByContent.find(contentHash);
+    MeshGeometryPtr existing = contentIt != geometryByContent.end() ? contentIt->second.lock() : nullptr;
+    // The meshlet build reorders the stored indices, so only their count is comparable
+    if (existing && existing->vertices == materialMesh.vertices && existing->indices.size() == materialMesh.indices.size()) {
+      ++dedupStats.hits;
+      dedupStats.bytesSaved += existing->GetCpuBytes();
+      meshletCount += existing->meshlets.size();
+      if (generateMeshLods) {
+        lodStats.Add(existing->indices.size(), existing->lods);
+      }
+      materialMesh.geometry = std::move(existing);
+      materialMesh.vertices = {};
+      materialMesh.indices = {};
+      materialMesh.aabbMin = materialMesh.geometry->aabbMin;
+      materialMesh.aabbMax = materialMesh.geometry->aabbMax;
+      modelMaterialMeshes.push_back(std::move(materialMesh));
+      continue;
+    }
+    // Cluster the full-detail triangles for per-cluster culling; this reorders the indices, so it runs first
+    std::vector<Meshlet> meshlets;
+    if (generateMeshlets) {
+      const auto meshletStart = std::chrono::steady_clock::now();
+      Meshlets::Build(materialMesh.vertices, materialMesh.indices, meshlets);
+      meshletMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - meshletStart).count();
+      meshletCount += meshlets.size();
+    }
+    // Reduced-detail index buffers over the same vertices; the renderer picks one per frame by projected size
+    std::vector<uint32_t> lodIndices;
+    std::vector<MeshLod> lods;
+    if (generateMeshLods) {
+      const auto lodStart = std::chrono::steady_clock::now();
+      MeshSimplifier::BuildLodChain(materialMesh.vertices, materialMesh.indices, meshLodSettings, lodIndices, lods);
+      lodStats.buildMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - lodStart).count();
+      lodStats.Add(materialMesh.indices.size(), lods);
+    }
+    // The geometry is complete: freeze it so entities can share it without copies
+    materialMesh.geometry = MeshGeometry::Create(std::move(materialMesh.vertices), std::move(materialMesh.indices),
+                                                 std::move(lodIndices), std::move(lods), std::move(meshlets), contentHash);
+    geometryByContent[contentHash] = materialMesh.geometry;
+    materialMesh.vertices = {};
+    materialMesh.indices = {};
+    materialMesh.aabbMin = materialMesh.geometry->aabbMin;
+    materialMesh.aabbMax = materialMesh.geometry->aabbMax;
+    modelMaterialMeshes.push_back(std::move(materialMesh));
   }
+  if (generateMeshlets) {
+    LOG_INFO("Loading", "Built " + std::to_string(meshletCount) + " meshlets for " + std::to_string(modelMaterialMeshes.size()) + " meshes in " +
+        std::to_string(meshletMs) + " ms");
+  }
+  if (generateMeshLods) {
+    meshLodStats[filename] = lodStats;
+    LOG_INFO("Loading", "Built mesh LODs for " + std::to_string(lodStats.reducedMeshes) + " of " + std::to_string(lodStats.meshes) + " meshes in " +
+        std::to_string(lodStats.buildMs) + " ms");
+  }
+  geometryDedupStats[filename] = dedupStats;
+  LOG_INFO("Loading", "Geometry dedup: " + std::to_string(dedupStats.hits) + " of " + std::to_string(dedupStats.meshes) +
+      " meshes reused loaded geometry, " + std::to_string(dedupStats.bytesSaved / 1024) + " KB saved, hashed in " +
+      std::to_string(dedupStats.hashMs) + " ms");
 
-  // Process texture loading for each MaterialMesh
-  std::vector<Vertex> combinedVertices;
-  std::vector<uint32_t> combinedIndices;
-
-  // Reserve space for combined mesh data to avoid reallocations
+  // Combined mesh size, for the summary below
   size_t totalVertices = 0;
   size_t totalIndices = 0;
   for (const auto& materialMesh : modelMaterialMeshes) {
     if (!materialMesh.instances.empty()) {
-      totalVertices += materialMesh.vertices.size();
-      totalIndices += materialMesh.indices.size();
+      totalVertices += materialMesh.geometry->vertices.size();
+      totalIndices += materialMesh.geometry->indices.size();
     }
   }
-  combinedVertices.reserve(totalVertices);
-  combinedIndices.reserve(totalIndices);
 
   // Process texture loading for each MaterialMesh
   for (auto& materialMesh : modelMaterialMeshes) {
@@ -1614,28 +1687,15 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
       }
     }
 
-    // Add to combined mesh for backward compatibility (keep vertices in an original coordinate system)
+    // Add to the combined mesh for backward compatibility (keep vertices in an original coordinate system).
+    // The model shares the geometry; MeshComponent::LoadFromModel() concatenates it on demand.
     if (!materialMesh.instances.empty()) {
-      size_t vertexOffset = combinedVertices.size();
-
-      // Instance transforms should be handled by the instancing system, not applied to vertex data
-      for (const auto& vertex : materialMesh.vertices) {
-        // Use vertices as-is without any transformation
-        combinedVertices.push_back(vertex);
-      }
-
-      for (uint32_t index : materialMesh.indices) {
-        combinedIndices.push_back(index + static_cast<uint32_t>(vertexOffset));
-      }
+      model->AddGeometryPart(materialMesh.geometry);
     }
   }
 
   // Store material meshes for this model
-  materialMeshes[filename] = modelMaterialMeshes;
-
-  // Set the combined mesh data in the model for backward compatibility
-  model->SetVertices(combinedVertices);
-  model->SetIndices(combinedIndices);
+  materialMeshes[filename] = std::move(modelMaterialMeshes);
 
   // Extract lights from the GLTF model
   std::cout << "Extracting lights from GLTF model..." << std::endl;
@@ -1645,7 +1705,7 @@ bool ModelLoader::ParseGLTF(const std::string& filename, Model* model) {
     std::cerr << "Warning: Failed to extract punctual lights from " << filename << std::endl;
   }
 
-  std::cout << "GLTF model loaded successfully with " << combinedVertices.size() << " vertices and " << combinedIndices.size() << " indices" << std::endl;
+  std::cout << "GLTF model loaded successfully with " << totalVertices << " vertices and " << totalIndices << " indices" << std::endl;
   return true;
 }
 
@@ -1672,31 +1732,31 @@ std::vector<ExtractedLight> ModelLoader::GetExtractedLights(const std::string& m
         float emissiveIntensity = glm::length(material->emissive) * material->emissiveStrength;
         if (emissiveIntensity >= 0.1f) {
           // Calculate the center position and an approximate size of the emissive surface
+          static const std::vector<Vertex> noVertices;
+          const std::vector<Vertex>& vertices = materialMesh.geometry ? materialMesh.geometry->vertices : noVertices;
           glm::vec3 center(0.0f);
-          glm::vec3 minB(std::numeric_limits<float>::max());
-          glm::vec3 maxB(-std::numeric_limits<float>::max());
-          if (!materialMesh.vertices.empty()) {
-            for (const auto& vertex : materialMesh.vertices) {
+          if (!vertices.empty()) {
+            for (const auto& vertex : vertices) {
               center += vertex.position;
-              minB = glm::min(minB, vertex.position);
-              maxB = glm::max(maxB, vertex.position);
             }
-            center /= static_cast<float>(materialMesh.vertices.size());
+            center /= static_cast<float>(vertices.size());
+          } else {
+            center = 0.5f * (materialMesh.aabbMin + materialMesh.aabbMax);
           }
-          glm::vec3 extent = glm::max(maxB - minB, glm::vec3(0.0f));
+          glm::vec3 extent = glm::max(materialMesh.aabbMax - materialMesh.aabbMin, glm::vec3(0.0f));
           float diag = glm::length(extent);
           float baseRange = std::max(0.5f * diag, 0.25f); // base range in local units
 
           // Calculate a reasonable direction (average normal of the surface)
           glm::vec3 avgNormal(0.0f);
-          if (!materialMesh.vertices.empty()) {
+          if (!vertices.empty()) {
             avgNormal = std::accumulate(
-              materialMesh.vertices.begin(),
-              materialMesh.vertices.end(),
+              vertices.begin(),
+              vertices.end(),
               glm::vec3(0.0f),
               [](const glm::vec3& acc, const Vertex& vertex) { return acc + vertex.normal; }
             );
-            avgNormal = glm::normalize(avgNormal / static_cast<float>(materialMesh.vertices.size()));
+            avgNormal = glm::normalize(avgNormal / static_cast<float>(vertices.size()));
           } else {
             avgNormal = glm::vec3(0.0f, -1.0f, 0.0f); // Default downward direction
           }
@@ -1785,6 +1845,47 @@ const std::vector<MaterialMesh>& ModelLoader::GetMaterialMeshes(const std::strin
   return emptyVector;
 }
 
+void ModelLoader::ReleaseCpuGeometry(const std::string& modelName) {
+  auto it = materialMeshes.find(modelName);
+  if (it != materialMeshes.end()) {
+    for (auto& materialMesh : it->second) {
+      materialMesh.geometry.reset();
+    }
+  }
+  auto modelIt = models.find(modelName);
+  if (modelIt != models.end() && modelIt->second) {
+    modelIt->second->ClearGeometryParts();
+  }
+}
+
+std::vector<std::pair<std::string, VertexPacking::ErrorStats>> ModelLoader::MeasureVertexPackingError() const {
+  std::vector<std::pair<std::string, VertexPacking::ErrorStats>> results;
+  results.reserve(materialMeshes.size());
+  for (const auto& [modelName, meshes] : materialMeshes) {
+    VertexPacking::ErrorStats modelStats;
+    for (const auto& materialMesh : meshes) {
+      if (materialMesh.geometry) {
+        modelStats.Merge(VertexPacking::MeasureError(materialMesh.geometry->vertices));
+      }
+    }
+    results.emplace_back(modelName, modelStats);
+  }
+  std::ranges::sort(results, {}, &std::pair<std::string, VertexPacking::ErrorStats>::first);
+  return results;
+}
+
+std::vector<std::pair<std::string, MeshSimplifier::ChainStats>> ModelLoader::GetMeshLodStats() const {
+  std::vector<std::pair<std::string, MeshSimplifier::ChainStats>> results(meshLodStats.begin(), meshLodStats.end());
+  std::ranges::sort(results, {}, &std::pair<std::string, MeshSimplifier::ChainStats>::first);
+  return results;
+}
+
+std::vector<std::pair<std::string, GeometryDedupStats>> ModelLoader::GetGeometryDedupStats() const {
+  std::vector<std::pair<std::string, GeometryDedupStats>> results(geometryDedupStats.begin(), geometryDedupStats.end());
+  std::ranges::sort(results, {}, &std::pair<std::string, GeometryDedupStats>::first);
+  return results;
+}
+
 const Material* ModelLoader::GetMaterial(const std::string& materialName) const {
   auto it = materials.find(materialName);
   if (it != materials.end()) {
@@ -16,11 +16,15 @@
  */
 #pragma once
 
+#include "content_hash.h"
 #include "mesh_component.h"
+#include "mesh_simplifier.h"
+#include "vertex_packing.h"
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
 #include <memory>
 #include <set>
+#include <span>
 #include <stdexcept>
 #include <string>
 #include <unordered_map>
@@ -201,8 +205,14 @@ struct Animation {
 struct MaterialMesh {
   int materialIndex;
   std::string materialName;
+  // Filled while the glTF is parsed, then moved into `geometry`
   std::vector<Vertex> vertices;
   std::vector<uint32_t> indices;
+  // Immutable geometry, referenced (not copied) by the MeshComponents created from this mesh.
+  // Null after ModelLoader::ReleaseCpuGeometry(); the bounds stay available.
+  MeshGeometryPtr geometry;
+  glm::vec3 aabbMin{0.0f};
+  glm::vec3 aabbMax{0.0f};
 
   // Track which glTF mesh index this MaterialMesh came from (for animation targeting)
   int sourceMeshIndex = -1;
@@ -231,6 +241,18 @@ struct MaterialMesh {
     isInstanced = instances.size() > 1;
   }
 
+  /**
+	 * @brief Add instances for many transforms at once (see InstanceData::AppendInstances).
+	 * @param transforms The transform matrices.
+	 * @param matIndex The material index of the instances (default: use materialIndex).
+	 */
+  void AddInstances(std::span<const glm::mat4> transforms, uint32_t matIndex = 0) {
+    if (matIndex == 0)
+      matIndex = static_cast<uint32_t>(materialIndex);
+    InstanceData::AppendInstances(transforms, matIndex, instances);
+    isInstanced = instances.size() > 1;
+  }
+
   /**
 	 * @brief Get the number of instances.
 	 * @return Number of instances (0 if not instanced, >= 1 if instanced).
@@ -261,20 +283,17 @@ class Model {
       return name;
     }
 
-    // Mesh data access methods
-    [[nodiscard]] const std::vector<Vertex>& GetVertices() const {
-      return vertices;
-    }
-    [[nodiscard]] const std::vector<uint32_t>& GetIndices() const {
-      return indices;
+    // Mesh data access methods: the model's instanced geometry, shared with its material meshes
+    [[nodiscard]] const std::vector<MeshGeometryPtr>& GetGeometryParts() const {
+      return geometryParts;
     }
 
     // Methods to set mesh data (used by parser)
-    void SetVertices(const std::vector<Vertex>& newVertices) {
-      vertices = newVertices;
+    void AddGeometryPart(MeshGeometryPtr part) {
+      geometryParts.push_back(std::move(part));
     }
-    void SetIndices(const std::vector<uint32_t>& newIndices) {
-      indices = newIndices;
+    void ClearGeometryParts() {
+      geometryParts.clear();
     }
 
     // Camera data access methods
@@ -315,8 +334,17 @@ class Model {
 
   private:
     std::string name;
-    std::vector<Vertex> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<MeshGeometryPtr> geometryParts;
+};
+
+/**
+ * @brief Metrics of the content-addressed geometry store over the meshes of a model.
+ */
+struct GeometryDedupStats {
+  uint32_t meshes = 0;
+  uint32_t hits = 0; // meshes whose content matched geometry already loaded, from this or another model
+  size_t bytesSaved = 0; // CPU bytes of geometry not duplicated; the renderer also shares its buffers
+  double hashMs = 0.0;
 };
 
 /**
@@ -368,6 +396,49 @@ class ModelLoader {
 	 */
     const std::vector<MaterialMesh>& GetMaterialMeshes(const std::string& modelName) const;
 
+    /**
+	 * @brief Drop the loader's references to a model's CPU geometry.
+	 * The memory is freed once the MeshComponents using it release theirs as well.
+	 * @param modelName The name of the model.
+	 */
+    void ReleaseCpuGeometry(const std::string& modelName);
+
+    /**
+	 * @brief Measure the error of converting each loaded model to the packed vertex format.
+	 * Models whose CPU geometry was released report zero vertices.
+	 * @return Per model name, in name order, the statistics over all of its material meshes.
+	 */
+    std::vector<std::pair<std::string, VertexPacking::ErrorStats>> MeasureVertexPackingError() const;
+
+    /**
+	 * @brief Enable or disable building mesh LOD chains for models loaded afterwards.
+	 * @param enable True to build the reduced-detail levels (the default).
+	 */
+    void SetGenerateMeshLods(bool enable) {
+      generateMeshLods = enable;
+    }
+
+    /**
+	 * @brief Enable or disable splitting meshes into meshlets for models loaded afterwards.
+	 * Meshes without meshlets are drawn whole, without cluster culling.
+	 * @param enable True to build the meshlets (the default).
+	 */
+    void SetGenerateMeshlets(bool enable) {
+      generateMeshlets = enable;
+    }
+
+    /**
+	 * @brief Get the LOD chain metrics recorded while loading each model.
+	 * @return Per model name, in name order, the statistics over all of its material meshes.
+	 */
+    std::vector<std::pair<std::string, MeshSimplifier::ChainStats>> GetMeshLodStats() const;
+
+    /**
+	 * @brief Get the geometry deduplication metrics recorded while loading each model.
+	 * @return Per model name, in name order, how many of its meshes reused loaded geometry.
+	 */
+    std::vector<std::pair<std::string, GeometryDedupStats>> GetGeometryDedupStats() const;
+
     /**
 	 * @brief Get a material by name.
 	 * @param materialName The name of the material.
@@ -457,6 +528,18 @@ class ModelLoader {
     // Material meshes per model
     std::unordered_map<std::string, std::vector<MaterialMesh>> materialMeshes;
 
+    // Mesh LOD chains built at load time, and their metrics per model
+    bool generateMeshLods = true;
+    MeshSimplifier::Settings meshLodSettings;
+    std::unordered_map<std::string, MeshSimplifier::ChainStats> meshLodStats;
+
+    // Meshlets of the full-detail levels, built at load time
+    bool generateMeshlets = true;
+
+    // Geometry by the digest of its source data and build settings, so identical meshes of any model share one
+    std::unordered_map<ContentHash::Digest, std::weak_ptr<const MeshGeometry>, ContentHash::DigestHasher> geometryByContent;
+    std::unordered_map<std::string, GeometryDedupStats> geometryDedupStats;
+
     bool hasEmissiveStrengthExtension = false;
 
     float light_scale = 1.0f;
@@ -0,0 +1,624 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "occlusion_culler.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <unordered_map>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define OCCLUSION_SSE2 1
+#	include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#	define OCCLUSION_NEON 1
+#	include <arm_neon.h>
+#endif
+
+namespace
+{
+constexpr float EmptyDepth = std::numeric_limits<float>::max();
+// Triangles are clipped against w >= NearW before the perspective divide
+constexpr float NearW = 1e-3f;
+
+double MsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Run fn(task) for task in [0, count), on the pool when available, and wait for all of them.
+// Queued tasks reference fn, so every one is waited for before the first exception is rethrown.
+template <typename Fn>
+void RunTasks(ThreadPool *pool, uint32_t count, Fn &&fn)
+{
+	if (!pool || count <= 1)
+	{
+		for (uint32_t t = 0; t < count; ++t)
+		{
+			fn(t);
+		}
+		return;
+	}
+	std::vector<std::future<void>> futures;
+	futures.reserve(count);
+	std::exception_ptr error;
+	for (uint32_t t = 0; t < count && !error; ++t)
+	{
+		try
+		{
+			futures.push_back(pool->enqueue([&fn, t]() { fn(t); }));
+		}
+		catch (...)
+		{
+			// The pool is shutting down: run the remaining tasks here
+			for (; t < count && !error; ++t)
+			{
+				try
+				{
+					fn(t);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+			}
+		}
+	}
+	for (auto &f : futures)
+	{
+		try
+		{
+			f.get();
+		}
+		catch (...)
+		{
+			if (!error)
+			{
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error)
+	{
+		std::rethrow_exception(error);
+	}
+}
+}        // namespace
+
+void OcclusionCuller::Resize(uint32_t newWidth, uint32_t newHeight)
+{
+	width  = std::max(1u, newWidth);
+	height = std::max(1u, newHeight);
+	// Padding lets the 4-wide row loop load/store past the last texel without bounds checks
+	pitch = ((width + 3u) & ~3u) + 4u;
+	depth.assign(static_cast<size_t>(pitch) * height, EmptyDepth);
+
+	pyramid.clear();
+	pyramidSizes.clear();
+	pyramidSizes.emplace_back(width, height);
+	glm::uvec2 size(width, height);
+	while (size.x > 1 || size.y > 1)
+	{
+		size = glm::uvec2((size.x + 1u) / 2u, (size.y + 1u) / 2u);
+		pyramidSizes.push_back(size);
+		pyramid.emplace_back(static_cast<size_t>(size.x) * size.y, EmptyDepth);
+	}
+	ready = false;
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4 &vp)
+{
+	viewProj = vp;
+	occluders.clear();
+	std::fill(depth.begin(), depth.end(), EmptyDepth);
+	stats = {};
+	ready = false;
+}
+
+void OcclusionCuller::AddOccluder(const OccluderMesh &mesh)
+{
+	if (mesh.positions && mesh.indices && mesh.indexCount >= 3)
+	{
+		occluders.push_back(mesh);
+	}
+}
+
+void OcclusionCuller::BuildAdjacency(const uint32_t *indices, uint32_t indexCount, std::vector<int32_t> &adjacency)
+{
+	adjacency.assign(indexCount, -1);
+	std::unordered_map<uint64_t, uint32_t> edges;        // directed edge -> index of its first vertex
+	edges.reserve(indexCount);
+	const auto key = [](uint32_t a, uint32_t b) { return (static_cast<uint64_t>(a) << 32) | b; };
+	for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		for (uint32_t e = 0; e < 3; ++e)
+		{
+			const uint32_t a = indices[i + e];
+			const uint32_t b = indices[i + (e + 1) % 3];
+			// A directed edge seen twice means the mesh is non-manifold or inconsistently wound there
+			if (!edges.emplace(key(a, b), i + e).second)
+			{
+				edges[key(a, b)] = UINT32_MAX;
+			}
+		}
+	}
+	for (uint32_t i = 0; i + 2 < indexCount; i += 3)
+	{
+		for (uint32_t e = 0; e < 3; ++e)
+		{
+			const auto it = edges.find(key(indices[i + (e + 1) % 3], indices[i + e]));
+			if (it != edges.end() && it->second != UINT32_MAX && edges[key(indices[i + e], indices[i + (e + 1) % 3])] != UINT32_MAX)
+			{
+				adjacency[i + e] = static_cast<int32_t>(it->second / 3u);
+			}
+		}
+	}
+}
+
+void OcclusionCuller::SetupOccluders(size_t begin, size_t end, std::vector<ScreenTriangle> &out) const
+{
+	out.clear();
+	const float fw = static_cast<float>(width);
+	const float fh = static_cast<float>(height);
+
+	struct Projected
+	{
+		glm::vec3 v[3];
+		int       sign;        // screen-space winding: +1, -1, or 0 when clipped or degenerate
+	};
+	std::vector<Projected> projected;
+
+	const auto toScreen = [fw, fh](const glm::vec4 &clip) {
+		const float invW = 1.0f / clip.w;
+		return glm::vec3((clip.x * invW * 0.5f + 0.5f) * fw, (clip.y * invW * 0.5f + 0.5f) * fh, clip.z * invW);
+	};
+
+	const auto emit = [&](glm::vec3 v0, glm::vec3 v1, glm::vec3 v2, bool conservative[3]) {
+		float area = (v1.x - v0.x) * (v2.y - v0.y) - (v2.x - v0.x) * (v1.y - v0.y);
+		if (std::fabs(area) < 1e-6f)
+		{
+			return;
+		}
+		bool cons[3] = {conservative[0], conservative[1], conservative[2]};
+		if (area < 0.0f)
+		{
+			// Occluders are rasterized double-sided: flip to counter-clockwise, remapping edge flags
+			std::swap(v1, v2);
+			std::swap(cons[0], cons[2]);
+			area = -area;
+		}
+
+		ScreenTriangle tri{};
+		tri.minX = std::max(0, static_cast<int>(std::floor(std::min({v0.x, v1.x, v2.x}))));
+		tri.maxX = std::min(static_cast<int>(width) - 1, static_cast<int>(std::ceil(std::max({v0.x, v1.x, v2.x}))) - 1);
+		tri.minY = std::max(0, static_cast<int>(std::floor(std::min({v0.y, v1.y, v2.y}))));
+		tri.maxY = std::min(static_cast<int>(height) - 1, static_cast<int>(std::ceil(std::max({v0.y, v1.y, v2.y}))) - 1);
+		if (tri.minX > tri.maxX || tri.minY > tri.maxY)
+		{
+			return;
+		}
+
+		// Edge functions E = A*x + B*y + C, positive inside. Conservative edges subtract half the
+		// texel's extent along the edge normal so they only accept texels they cover entirely.
+		const glm::vec3 v[3] = {v0, v1, v2};
+		for (int e = 0; e < 3; ++e)
+		{
+			const glm::vec3 &a = v[e];
+			const glm::vec3 &b = v[(e + 1) % 3];
+			tri.A[e]           = a.y - b.y;
+			tri.B[e]           = b.x - a.x;
+			tri.C[e]           = -(tri.A[e] * a.x + tri.B[e] * a.y);
+			const float halfExtent = 0.5f * (std::fabs(tri.A[e]) + std::fabs(tri.B[e]));
+			// Shared edges are widened by a hair so texel centers exactly on them are claimed by
+			// both triangles rather than neither
+			tri.C[e] += cons[e] ? -halfExtent : 1e-4f * halfExtent;
+		}
+
+		// Depth plane at texel centers, biased to the farthest value over a texel, capped at the farthest vertex
+		tri.dzdx    = ((v1.z - v0.z) * (v2.y - v0.y) - (v2.z - v0.z) * (v1.y - v0.y)) / area;
+		tri.dzdy    = ((v2.z - v0.z) * (v1.x - v0.x) - (v1.z - v0.z) * (v2.x - v0.x)) / area;
+		tri.zOrigin = v0.z + tri.dzdx * (0.5f - v0.x) + tri.dzdy * (0.5f - v0.y) + 0.5f * (std::fabs(tri.dzdx) + std::fabs(tri.dzdy));
+		tri.zCap    = std::max({v0.z, v1.z, v2.z});
+		out.push_back(tri);
+	};
+
+	for (size_t o = begin; o < end; ++o)
+	{
+		const OccluderMesh &mesh          = occluders[o];
+		const glm::mat4     mvp           = viewProj * mesh.model;
+		const auto         *base          = reinterpret_cast<const uint8_t *>(mesh.positions);
+		const uint32_t      triangleCount = mesh.indexCount / 3u;
+
+		// Pass 1: project every triangle and record its screen winding for the adjacency test
+		projected.resize(triangleCount);
+		std::vector<glm::vec4> clipStore(static_cast<size_t>(triangleCount) * 3u);
+		for (uint32_t t = 0; t < triangleCount; ++t)
+		{
+			bool crossesNear = false;
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				const float *p            = reinterpret_cast<const float *>(base + static_cast<size_t>(mesh.indices[t * 3u + k]) * mesh.strideBytes);
+				clipStore[t * 3u + k]     = mvp * glm::vec4(p[0], p[1], p[2], 1.0f);
+				crossesNear              |= clipStore[t * 3u + k].w < NearW;
+			}
+			Projected &pr = projected[t];
+			pr.sign       = 0;
+			if (!crossesNear)
+			{
+				for (uint32_t k = 0; k < 3; ++k)
+				{
+					pr.v[k] = toScreen(clipStore[t * 3u + k]);
+				}
+				const float area = (pr.v[1].x - pr.v[0].x) * (pr.v[2].y - pr.v[0].y) - (pr.v[2].x - pr.v[0].x) * (pr.v[1].y - pr.v[0].y);
+				pr.sign          = area > 1e-6f ? 1 : (area < -1e-6f ? -1 : 0);
+			}
+		}
+
+		// Pass 2: set up triangles; an edge is sampled at texel centers only when its neighbour lies on
+		// the other side of it on screen (same winding), otherwise it is a silhouette or boundary.
+		for (uint32_t t = 0; t < triangleCount; ++t)
+		{
+			const Projected &pr = projected[t];
+			if (pr.sign != 0)
+			{
+				bool conservative[3];
+				for (uint32_t e = 0; e < 3; ++e)
+				{
+					const int32_t n = mesh.adjacency ? mesh.adjacency[t * 3u + e] : -1;
+					conservative[e] = n < 0 || static_cast<uint32_t>(n) >= triangleCount || projected[n].sign != pr.sign;
+				}
+				emit(pr.v[0], pr.v[1], pr.v[2], conservative);
+				continue;
+			}
+
+			// Clip against the near plane (w >= NearW); yields up to four vertices, all edges conservative
+			glm::vec4 poly[4];
+			int       count = 0;
+			for (uint32_t k = 0; k < 3; ++k)
+			{
+				const glm::vec4 &a   = clipStore[t * 3u + k];
+				const glm::vec4 &b   = clipStore[t * 3u + (k + 1) % 3];
+				const bool       aIn = a.w >= NearW;
+				const bool       bIn = b.w >= NearW;
+				if (aIn)
+				{
+					poly[count++] = a;
+				}
+				if (aIn != bIn)
+				{
+					const float s = (NearW - a.w) / (b.w - a.w);
+					poly[count++] = a + s * (b - a);
+				}
+			}
+			bool allConservative[3] = {true, true, true};
+			for (int k = 1; k + 1 < count; ++k)
+			{
+				emit(toScreen(poly[0]), toScreen(poly[k]), toScreen(poly[k + 1]), allConservative);
+			}
+		}
+	}
+}
+
+void OcclusionCuller::RasterizeBand(uint32_t bandY0, uint32_t bandY1)
+{
+	for (const auto &bin : triangleBins)
+	{
+		for (const ScreenTriangle &tri : bin)
+		{
+			const int minY = std::max(static_cast<int>(bandY0), tri.minY);
+			const int maxY = std::min(static_cast<int>(bandY1) - 1, tri.maxY);
+			const int minX = tri.minX;
+			const int maxX = tri.maxX;
+			const float *A = tri.A;
+
+			for (int py = minY; py <= maxY; ++py)
+			{
+				const float cy   = static_cast<float>(py) + 0.5f;
+				const float row0 = tri.B[0] * cy + tri.C[0];
+				const float row1 = tri.B[1] * cy + tri.C[1];
+				const float row2 = tri.B[2] * cy + tri.C[2];
+				const float zRow = tri.zOrigin + tri.dzdy * static_cast<float>(py);
+				float      *dst  = depth.data() + static_cast<size_t>(py) * pitch;
+				int         px   = minX;
+
+#if defined(OCCLUSION_SSE2)
+				const __m128 laneOffsets = _mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f);
+				const __m128 zero        = _mm_setzero_ps();
+				const __m128 cap         = _mm_set1_ps(tri.zCap);
+				const __m128 lastX       = _mm_set1_ps(static_cast<float>(maxX));
+				for (; px <= maxX; px += 4)
+				{
+					const __m128 xs     = _mm_add_ps(_mm_set1_ps(static_cast<float>(px)), laneOffsets);
+					const __m128 xc     = _mm_add_ps(xs, _mm_set1_ps(0.5f));
+					const __m128 e0     = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[0]), xc), _mm_set1_ps(row0));
+					const __m128 e1     = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[1]), xc), _mm_set1_ps(row1));
+					const __m128 e2     = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(A[2]), xc), _mm_set1_ps(row2));
+					__m128       inside = _mm_and_ps(_mm_cmpgt_ps(e0, zero), _mm_cmpgt_ps(e1, zero));
+					inside              = _mm_and_ps(inside, _mm_cmpgt_ps(e2, zero));
+					inside              = _mm_and_ps(inside, _mm_cmple_ps(xs, lastX));
+					const __m128 zs     = _mm_min_ps(_mm_add_ps(_mm_set1_ps(zRow), _mm_mul_ps(_mm_set1_ps(tri.dzdx), xs)), cap);
+					const __m128 old    = _mm_loadu_ps(dst + px);
+					const __m128 merged = _mm_min_ps(old, zs);
+					_mm_storeu_ps(dst + px, _mm_or_ps(_mm_and_ps(inside, merged), _mm_andnot_ps(inside, old)));
+				}
+#elif defined(OCCLUSION_NEON)
+				const float       offs[4]     = {0.0f, 1.0f, 2.0f, 3.0f};
+				const float32x4_t laneOffsets = vld1q_f32(offs);
+				const float32x4_t zero        = vdupq_n_f32(0.0f);
+				const float32x4_t cap         = vdupq_n_f32(tri.zCap);
+				const float32x4_t lastX       = vdupq_n_f32(static_cast<float>(maxX));
+				for (; px <= maxX; px += 4)
+				{
+					const float32x4_t xs  = vaddq_f32(vdupq_n_f32(static_cast<float>(px)), laneOffsets);
+					const float32x4_t xc  = vaddq_f32(xs, vdupq_n_f32(0.5f));
+					const float32x4_t e0  = vaddq_f32(vmulq_n_f32(xc, A[0]), vdupq_n_f32(row0));
+					const float32x4_t e1  = vaddq_f32(vmulq_n_f32(xc, A[1]), vdupq_n_f32(row1));
+					const float32x4_t e2  = vaddq_f32(vmulq_n_f32(xc, A[2]), vdupq_n_f32(row2));
+					uint32x4_t        in  = vandq_u32(vcgtq_f32(e0, zero), vcgtq_f32(e1, zero));
+					in                    = vandq_u32(in, vcgtq_f32(e2, zero));
+					in                    = vandq_u32(in, vcleq_f32(xs, lastX));
+					const float32x4_t zs  = vminq_f32(vaddq_f32(vdupq_n_f32(zRow), vmulq_n_f32(xs, tri.dzdx)), cap);
+					const float32x4_t old = vld1q_f32(dst + px);
+					vst1q_f32(dst + px, vbslq_f32(in, vminq_f32(old, zs), old));
+				}
+#endif
+				for (; px <= maxX; ++px)
+				{
+					const float cx = static_cast<float>(px) + 0.5f;
+					if (A[0] * cx + row0 > 0.0f && A[1] * cx + row1 > 0.0f && A[2] * cx + row2 > 0.0f)
+					{
+						const float zs = std::min(zRow + tri.dzdx * static_cast<float>(px), tri.zCap);
+						dst[px]        = std::min(dst[px], zs);
+					}
+				}
+			}
+		}
+	}
+}
+
+void OcclusionCuller::BuildPyramid()
+{
+	for (size_t level = 1; level < pyramidSizes.size(); ++level)
+	{
+		const glm::uvec2 src     = pyramidSizes[level - 1];
+		const glm::uvec2 dstSize = pyramidSizes[level];
+		const float     *srcData = level == 1 ? depth.data() : pyramid[level - 2].data();
+		const size_t     srcPitch = level == 1 ? pitch : src.x;
+		float           *dst      = pyramid[level - 1].data();
+		for (uint32_t y = 0; y < dstSize.y; ++y)
+		{
+			const uint32_t y0 = y * 2u;
+			const uint32_t y1 = std::min(y0 + 1u, src.y - 1u);
+			for (uint32_t x = 0; x < dstSize.x; ++x)
+			{
+				const uint32_t x0 = x * 2u;
+				const uint32_t x1 = std::min(x0 + 1u, src.x - 1u);
+				dst[y * dstSize.x + x] = std::max(std::max(srcData[y0 * srcPitch + x0], srcData[y0 * srcPitch + x1]),
+				                                  std::max(srcData[y1 * srcPitch + x0], srcData[y1 * srcPitch + x1]));
+			}
+		}
+	}
+}
+
+void OcclusionCuller::Rasterize(ThreadPool *pool, uint32_t taskCount)
+{
+	if (width == 0 || height == 0)
+	{
+		return;
+	}
+	taskCount = std::max(1u, taskCount);
+	stats.occluders = static_cast<uint32_t>(occluders.size());
+
+	auto start = std::chrono::steady_clock::now();
+	const uint32_t setupTasks = std::min<uint32_t>(taskCount, std::max<uint32_t>(1u, static_cast<uint32_t>(occluders.size())));
+	triangleBins.resize(setupTasks);
+	RunTasks(pool, setupTasks, [this, setupTasks](uint32_t t) {
+		const size_t begin = occluders.size() * t / setupTasks;
+		const size_t end   = occluders.size() * (t + 1) / setupTasks;
+		SetupOccluders(begin, end, triangleBins[t]);
+	});
+	stats.setupMs = MsSince(start);
+	for (const auto &bin : triangleBins)
+	{
+		stats.trianglesRasterized += static_cast<uint32_t>(bin.size());
+	}
+
+	// Horizontal bands: each task owns a disjoint set of rows, so no synchronization is needed
+	start = std::chrono::steady_clock::now();
+	const uint32_t bands = std::min(taskCount, height);
+	RunTasks(pool, bands, [this, bands](uint32_t t) {
+		RasterizeBand(height * t / bands, height * (t + 1) / bands);
+	});
+	stats.rasterMs = MsSince(start);
+
+	start = std::chrono::steady_clock::now();
+	BuildPyramid();
+	stats.pyramidMs = MsSince(start);
+	ready           = true;
+}
+
+bool OcclusionCuller::IsVisible(const glm::vec3 &worldMin, const glm::vec3 &worldMax) const
+{
+	if (!ready)
+	{
+		return true;
+	}
+
+	float minX = std::numeric_limits<float>::max(), minY = minX, minZ = minX;
+	float maxX = -minX, maxY = -minX;
+	for (int i = 0; i < 8; ++i)
+	{
+		const glm::vec4 corner((i & 1) ? worldMax.x : worldMin.x, (i & 2) ? worldMax.y : worldMin.y, (i & 4) ? worldMax.z : worldMin.z, 1.0f);
+		const glm::vec4 clip = viewProj * corner;
+		if (clip.w < NearW)
+		{
+			return true;        // crosses the near plane: cannot be hidden
+		}
+		const float invW = 1.0f / clip.w;
+		const float sx   = (clip.x * invW * 0.5f + 0.5f) * static_cast<float>(width);
+		const float sy   = (clip.y * invW * 0.5f + 0.5f) * static_cast<float>(height);
+		minX             = std::min(minX, sx);
+		maxX             = std::max(maxX, sx);
+		minY             = std::min(minY, sy);
+		maxY             = std::max(maxY, sy);
+		minZ             = std::min(minZ, clip.z * invW);
+	}
+	if (maxX < 0.0f || maxY < 0.0f || minX >= static_cast<float>(width) || minY >= static_cast<float>(height))
+	{
+		return true;        // off-screen here; frustum culling is responsible for it
+	}
+
+	int x0 = std::max(0, static_cast<int>(std::floor(minX)));
+	int y0 = std::max(0, static_cast<int>(std::floor(minY)));
+	int x1 = std::min(static_cast<int>(width) - 1, static_cast<int>(std::floor(maxX)));
+	int y1 = std::min(static_cast<int>(height) - 1, static_cast<int>(std::floor(maxY)));
+
+	// Coarsest level at which the rectangle spans at most 4x4 texels
+	size_t level = 0;
+	while (level + 1 < pyramidSizes.size() && ((x1 - x0) > 3 || (y1 - y0) > 3))
+	{
+		++level;
+		x0 >>= 1;
+		y0 >>= 1;
+		x1 >>= 1;
+		y1 >>= 1;
+	}
+
+	const float *data     = level == 0 ? depth.data() : pyramid[level - 1].data();
+	const size_t rowPitch = level == 0 ? pitch : pyramidSizes[level].x;
+	for (int y = y0; y <= y1; ++y)
+	{
+		for (int x = x0; x <= x1; ++x)
+		{
+			if (data[static_cast<size_t>(y) * rowPitch + x] >= minZ)
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool OcclusionCuller::DumpDepthImage(const std::string &path) const
+{
+	if (width == 0 || height == 0)
+	{
+		return false;
+	}
+	float nearest = std::numeric_limits<float>::max();
+	float farthest = -nearest;
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			const float d = depth[static_cast<size_t>(y) * pitch + x];
+			if (d != EmptyDepth)
+			{
+				nearest  = std::min(nearest, d);
+				farthest = std::max(farthest, d);
+			}
+		}
+	}
+	const float range = farthest > nearest ? farthest - nearest : 1.0f;
+
+	std::ofstream file(path, std::ios::binary);
+	if (!file)
+	{
+		return false;
+	}
+	file << "P5\n" << width << " " << height << "\n255\n";
+	std::vector<uint8_t> row(width);
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		for (uint32_t x = 0; x < width; ++x)
+		{
+			const float d = depth[static_cast<size_t>(y) * pitch + x];
+			row[x]        = d == EmptyDepth ? 255 : static_cast<uint8_t>(std::clamp((d - nearest) / range, 0.0f, 1.0f) * 254.0f);
+		}
+		file.write(reinterpret_cast<const char *>(row.data()), static_cast<std::streamsize>(row.size()));
+	}
+	return static_cast<bool>(file);
+}
+
+OcclusionCuller::BenchmarkResult OcclusionCuller::Benchmark(uint32_t width, uint32_t height, uint32_t occluderCount, uint32_t boxCount, ThreadPool *pool, uint32_t taskCount)
+{
+	BenchmarkResult result;
+
+	// A unit cube, wound counter-clockwise from outside
+	const float cube[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0}, {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+	const uint32_t cubeIndices[36] = {0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7, 0, 1, 5, 0, 5, 4,
+	                                  3, 7, 6, 3, 6, 2, 0, 4, 7, 0, 7, 3, 1, 2, 6, 1, 6, 5};
+	std::vector<int32_t> adjacency;
+	BuildAdjacency(cubeIndices, 36, adjacency);
+
+	// Camera at the origin looking down -Z; wall-like occluders between 10 and 40 m, test boxes up to 80 m
+	const glm::mat4 viewProj = glm::perspective(glm::radians(60.0f), static_cast<float>(width) / static_cast<float>(std::max(height, 1u)), 0.1f, 200.0f) *
+	                           glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	std::mt19937                          rng(11);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+
+	std::vector<glm::mat4> models(occluderCount);
+	for (auto &model : models)
+	{
+		const float     z = 10.0f + unit(rng) * 30.0f;
+		const glm::vec3 position((unit(rng) * 2.0f - 1.0f) * z * 0.6f, (unit(rng) * 2.0f - 1.0f) * z * 0.4f, -z);
+		model = glm::scale(glm::translate(glm::mat4(1.0f), position), glm::vec3(2.0f + unit(rng) * 6.0f, 2.0f + unit(rng) * 4.0f, 0.5f));
+	}
+	std::vector<glm::vec3> boxes(static_cast<size_t>(boxCount) * 2);
+	for (uint32_t i = 0; i < boxCount; ++i)
+	{
+		const float     z = 5.0f + unit(rng) * 75.0f;
+		const glm::vec3 center((unit(rng) * 2.0f - 1.0f) * z * 0.6f, (unit(rng) * 2.0f - 1.0f) * z * 0.4f, -z);
+		const glm::vec3 half(0.1f + unit(rng) * 0.9f);
+		boxes[2 * i]     = center - half;
+		boxes[2 * i + 1] = center + half;
+	}
+
+	OcclusionCuller culler;
+	culler.Resize(width, height);
+	const auto rasterize = [&](ThreadPool *rasterPool, uint32_t tasks) {
+		culler.BeginFrame(viewProj);
+		for (const auto &model : models)
+		{
+			culler.AddOccluder({.positions = &cube[0][0], .strideBytes = sizeof(cube[0]), .indices = cubeIndices, .indexCount = 36, .adjacency = adjacency.data(), .model = model});
+		}
+		const auto start = std::chrono::steady_clock::now();
+		culler.Rasterize(rasterPool, tasks);
+		return MsSince(start);
+	};
+	result.rasterMs     = rasterize(nullptr, 1);
+	result.rasterPoolMs = rasterize(pool, taskCount);
+	result.triangles    = culler.GetStats().trianglesRasterized;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < boxCount; ++i)
+	{
+		result.hidden += culler.IsVisible(boxes[2 * i], boxes[2 * i + 1]) ? 0u : 1u;
+	}
+	result.testMs = MsSince(start);
+	result.tested = boxCount;
+	return result;
+}
@@ -0,0 +1,180 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+class ThreadPool;
+
+/**
+ * @brief CPU software occlusion culler.
+ *
+ * Large occluder meshes are rasterized into a low-resolution depth buffer
+ * (nearest depth per texel), then reduced into a max-depth pyramid. A box is
+ * occluded when its nearest projected depth lies behind every pyramid texel
+ * its screen rectangle touches.
+ *
+ * Rasterization is conservative in the safe direction: along silhouette and
+ * boundary edges a texel is only written when the triangle covers all of it,
+ * and the farthest depth over the texel is stored, so partial coverage never
+ * hides geometry that is visible at full resolution. Edges shared by two
+ * triangles facing the same way on screen are sampled at texel centers so the
+ * interior of a mesh stays solid.
+ *
+ * Usage per frame: BeginFrame, AddOccluder for each occluder, Rasterize, then
+ * IsVisible for each candidate. Everything runs on the CPU.
+ */
+class OcclusionCuller
+{
+  public:
+	struct OccluderMesh
+	{
+		const float    *positions   = nullptr;        // xyz of the first vertex
+		size_t          strideBytes = 0;              // distance between consecutive vertices
+		const uint32_t *indices     = nullptr;
+		uint32_t        indexCount  = 0;
+		// Optional, from BuildAdjacency: lets edges between adjacent triangles be sampled at
+		// texel centers instead of conservatively, so meshes do not leave cracks along them.
+		const int32_t *adjacency = nullptr;
+		glm::mat4      model{1.0f};
+	};
+
+	struct Stats
+	{
+		uint32_t occluders            = 0;
+		uint32_t trianglesRasterized  = 0;
+		double   setupMs              = 0.0;
+		double   rasterMs             = 0.0;
+		double   pyramidMs            = 0.0;
+	};
+
+	struct BenchmarkResult
+	{
+		double   rasterMs     = 0.0;        // setup, rasterization and pyramid, inline
+		double   rasterPoolMs = 0.0;        // the same on the pool
+		double   testMs       = 0.0;        // IsVisible on every test box
+		uint32_t triangles    = 0;
+		uint32_t tested       = 0;
+		uint32_t hidden       = 0;
+	};
+
+	/**
+	 * @brief Find, for each triangle edge, the triangle that shares it with opposite winding.
+	 * @param indices Triangle list indices.
+	 * @param indexCount Number of indices.
+	 * @param adjacency Receives one entry per index: the neighbouring triangle across edge
+	 *        (i, i+1), or -1 for boundary and non-manifold edges.
+	 */
+	static void BuildAdjacency(const uint32_t *indices, uint32_t indexCount, std::vector<int32_t> &adjacency);
+
+	/**
+	 * @brief Set the depth buffer resolution (texels). Clears the buffer.
+	 */
+	void Resize(uint32_t width, uint32_t height);
+
+	uint32_t GetWidth() const
+	{
+		return width;
+	}
+
+	uint32_t GetHeight() const
+	{
+		return height;
+	}
+
+	/**
+	 * @brief Start a new frame with the given view-projection matrix.
+	 */
+	void BeginFrame(const glm::mat4 &viewProj);
+
+	/**
+	 * @brief Queue a mesh to be rasterized as an occluder. The data must stay valid until Rasterize returns.
+	 */
+	void AddOccluder(const OccluderMesh &mesh);
+
+	/**
+	 * @brief Rasterize all queued occluders and build the depth pyramid.
+	 * @param pool Worker pool used for triangle setup and horizontal bands; null runs inline.
+	 * @param taskCount Number of tasks to split each stage into.
+	 */
+	void Rasterize(ThreadPool *pool, uint32_t taskCount);
+
+	/**
+	 * @brief Test a world-space box against the occlusion buffer.
+	 * @return False only if the box is certainly hidden behind the rasterized occluders.
+	 */
+	bool IsVisible(const glm::vec3 &worldMin, const glm::vec3 &worldMax) const;
+
+	/**
+	 * @brief Write the full-resolution depth buffer as a binary PGM image (near = dark, empty = white).
+	 * @return True on success.
+	 */
+	bool DumpDepthImage(const std::string &path) const;
+
+	const Stats &GetStats() const
+	{
+		return stats;
+	}
+
+	bool IsReady() const
+	{
+		return ready;
+	}
+
+	/**
+	 * @brief Time the culler on synthetic wall-like occluders and random boxes in front of the camera.
+	 * @param width Buffer width in texels.
+	 * @param height Buffer height in texels.
+	 * @param occluderCount Number of occluder boxes.
+	 * @param boxCount Number of boxes tested against the buffer.
+	 * @param pool Pool for the second, parallel rasterization.
+	 * @param taskCount Number of tasks for that rasterization.
+	 */
+	static BenchmarkResult Benchmark(uint32_t width, uint32_t height, uint32_t occluderCount, uint32_t boxCount, ThreadPool *pool, uint32_t taskCount);
+
+  private:
+	// Fully set-up triangle: counter-clockwise edge equations (already offset for conservative
+	// edges), a depth plane biased to the farthest value over a texel, and a clamped texel rectangle.
+	struct ScreenTriangle
+	{
+		float A[3], B[3], C[3];
+		float dzdx, dzdy, zOrigin, zCap;
+		int   minX, maxX, minY, maxY;
+	};
+
+	void SetupOccluders(size_t begin, size_t end, std::vector<ScreenTriangle> &out) const;
+	void RasterizeBand(uint32_t y0, uint32_t y1);
+	void BuildPyramid();
+
+	uint32_t  width  = 0;
+	uint32_t  height = 0;
+	uint32_t  pitch  = 0;        // row stride in floats, padded to a multiple of 4
+	glm::mat4 viewProj{1.0f};
+	bool      ready = false;
+
+	std::vector<OccluderMesh>                occluders;
+	std::vector<std::vector<ScreenTriangle>> triangleBins;        // one per setup task
+	std::vector<float>                       depth;               // level 0, pitch * height
+	std::vector<std::vector<float>>          pyramid;             // levels 1..N, max-reduced
+	std::vector<glm::uvec2>                  pyramidSizes;        // including level 0
+	Stats                                    stats;
+};
@@ -0,0 +1,316 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "perf_run.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace
+{
+void WriteJsonString(std::ofstream &out, const std::string &text)
+{
+	out << '"';
+	for (char c : text)
+	{
+		if (c == '"' || c == '\\')
+		{
+			out << '\\';
+		}
+		if (static_cast<unsigned char>(c) >= 0x20)
+		{
+			out << c;
+		}
+	}
+	out << '"';
+}
+
+struct Summary
+{
+	double mean = 0.0;
+	double min  = 0.0;
+	double max  = 0.0;
+};
+
+template <typename Getter>
+Summary Summarize(const std::vector<PerfRunReport::Frame> &frames, Getter get)
+{
+	Summary summary;
+	if (frames.empty())
+	{
+		return summary;
+	}
+	summary.min = summary.max = static_cast<double>(get(frames.front()));
+	for (const auto &frame : frames)
+	{
+		const double value = static_cast<double>(get(frame));
+		summary.mean += value;
+		summary.min = std::min(summary.min, value);
+		summary.max = std::max(summary.max, value);
+	}
+	summary.mean /= static_cast<double>(frames.size());
+	return summary;
+}
+
+void WriteSummary(std::ofstream &out, const Summary &summary)
+{
+	out << "{\"mean\": " << summary.mean << ", \"min\": " << summary.min << ", \"max\": " << summary.max << '}';
+}
+}        // namespace
+
+CameraPath CameraPath::Orbit(const glm::vec3 &center, float radius, float seconds)
+{
+	constexpr uint32_t Segments = 64;
+	constexpr float    TwoPi    = 6.28318530718f;
+
+	CameraPath path;
+	path.keyframes.reserve(Segments + 1);
+	for (uint32_t i = 0; i <= Segments; ++i)
+	{
+		const float angle = TwoPi * static_cast<float>(i) / static_cast<float>(Segments);
+		const glm::vec3 offset(std::cos(angle) * radius, 0.0f, std::sin(angle) * radius);
+		path.keyframes.push_back({seconds * static_cast<float>(i) / static_cast<float>(Segments), center + offset, center});
+	}
+	return path;
+}
+
+bool CameraPath::LoadFromFile(const std::string &path)
+{
+	std::ifstream in(path);
+	if (!in.is_open())
+	{
+		return false;
+	}
+
+	std::vector<Keyframe> loaded;
+	std::string           line;
+	while (std::getline(in, line))
+	{
+		const size_t first = line.find_first_not_of(" \t\r");
+		if (first == std::string::npos || line[first] == '#')
+		{
+			continue;
+		}
+		std::istringstream fields(line);
+		Keyframe           key;
+		if (!(fields >> key.time >> key.position.x >> key.position.y >> key.position.z >> key.target.x >> key.target.y >> key.target.z))
+		{
+			return false;
+		}
+		if (!loaded.empty() && key.time <= loaded.back().time)
+		{
+			return false;
+		}
+		loaded.push_back(key);
+	}
+	if (loaded.empty())
+	{
+		return false;
+	}
+	keyframes = std::move(loaded);
+	return true;
+}
+
+void CameraPath::Sample(float time, glm::vec3 &position, glm::vec3 &target) const
+{
+	if (keyframes.empty())
+	{
+		return;
+	}
+	const Keyframe &front = keyframes.front();
+	const Keyframe &back  = keyframes.back();
+	if (keyframes.size() == 1 || back.time <= front.time)
+	{
+		position = front.position;
+		target   = front.target;
+		return;
+	}
+
+	// Loop over the path's duration
+	const float duration = back.time - front.time;
+	const float t        = front.time + std::fmod(std::max(time, 0.0f), duration);
+
+	auto next = std::upper_bound(keyframes.begin(), keyframes.end(), t, [](float value, const Keyframe &key) {
+		return value < key.time;
+	});
+	if (next == keyframes.begin())
+	{
+		next = keyframes.begin() + 1;
+	}
+	else if (next == keyframes.end())
+	{
+		next = keyframes.end() - 1;
+	}
+	const Keyframe &a      = *(next - 1);
+	const Keyframe &b      = *next;
+	const float     weight = std::clamp((t - a.time) / (b.time - a.time), 0.0f, 1.0f);
+	position               = a.position + (b.position - a.position) * weight;
+	target                 = a.target + (b.target - a.target) * weight;
+}
+
+double PerfRunReport::GetFrameMsPercentile(double percentile) const
+{
+	if (frames.empty())
+	{
+		return 0.0;
+	}
+	std::vector<double> sorted;
+	sorted.reserve(frames.size());
+	for (const auto &frame : frames)
+	{
+		sorted.push_back(frame.cpuMs);
+	}
+	std::sort(sorted.begin(), sorted.end());
+
+	const double rank  = std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(sorted.size()));
+	const size_t index = static_cast<size_t>(std::max(rank, 1.0)) - 1;
+	return sorted[std::min(index, sorted.size() - 1)];
+}
+
+bool PerfRunReport::WriteJson(const std::string &path) const
+{
+	std::ofstream out(path, std::ios::out | std::ios::trunc);
+	if (!out.is_open())
+	{
+		return false;
+	}
+
+	const Summary frameMs = Summarize(frames, [](const Frame &f) { return f.cpuMs; });
+	const Summary draws   = Summarize(frames, [](const Frame &f) { return f.draws; });
+	const Summary visible = Summarize(frames, [](const Frame &f) { return f.visible; });
+	const Summary culled  = Summarize(frames, [](const Frame &f) { return f.culled; });
+	const Summary triangles  = Summarize(frames, [](const Frame &f) { return f.triangles; });
+	const Summary fullDetail = Summarize(frames, [](const Frame &f) { return f.fullDetailTriangles; });
+	const Summary clusters       = Summarize(frames, [](const Frame &f) { return f.clusters; });
+	const Summary clustersCulled = Summarize(frames, [](const Frame &f) { return f.clustersCulled; });
+	const Summary lights         = Summarize(frames, [](const Frame &f) { return f.lights; });
+	const Summary lightUpdateMs  = Summarize(frames, [](const Frame &f) { return f.lightUpdateMs; });
+	const double  uploadMBps = wallSeconds > 0.0 ? static_cast<double>(uploadBytes) / (1024.0 * 1024.0) / wallSeconds : 0.0;
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\n";
+	out << "  \"device\": ";
+	WriteJsonString(out, deviceName);
+	out << ",\n  \"scene\": ";
+	WriteJsonString(out, scene);
+	out << ",\n  \"cameraPath\": ";
+	WriteJsonString(out, cameraPath);
+	out << ",\n  \"width\": " << width << ",\n  \"height\": " << height;
+	out << ",\n  \"frames\": " << frames.size() << ",\n  \"warmupFrames\": " << warmupFrames << ",\n  \"frameDeltaMs\": " << frameDeltaMs;
+	if (!error.empty())
+	{
+		out << ",\n  \"error\": ";
+		WriteJsonString(out, error);
+	}
+	out << ",\n  \"loadSeconds\": " << loadSeconds;
+	out << ",\n  \"wallSeconds\": " << wallSeconds;
+	out << ",\n  \"cpuFrameMs\": {\"mean\": " << frameMs.mean << ", \"min\": " << frameMs.min << ", \"p50\": " << GetFrameMsPercentile(50.0)
+	    << ", \"p90\": " << GetFrameMsPercentile(90.0) << ", \"p99\": " << GetFrameMsPercentile(99.0) << ", \"max\": " << frameMs.max << '}';
+	out << ",\n  \"draws\": ";
+	WriteSummary(out, draws);
+	out << ",\n  \"culling\": {\"visible\": ";
+	WriteSummary(out, visible);
+	out << ", \"culled\": ";
+	WriteSummary(out, culled);
+	out << '}';
+	out << ",\n  \"triangles\": {\"drawn\": ";
+	WriteSummary(out, triangles);
+	out << ", \"fullDetail\": ";
+	WriteSummary(out, fullDetail);
+	out << '}';
+	out << ",\n  \"clusters\": {\"tested\": ";
+	WriteSummary(out, clusters);
+	out << ", \"culled\": ";
+	WriteSummary(out, clustersCulled);
+	out << '}';
+	out << ",\n  \"lights\": {\"count\": ";
+	WriteSummary(out, lights);
+	out << ", \"updateMs\": ";
+	WriteSummary(out, lightUpdateMs);
+	out << '}';
+	out << ",\n  \"uploads\": {\"bytes\": " << uploadBytes << ", \"mbPerSecond\": " << uploadMBps << ", \"averageUploadMs\": " << averageUploadMs << '}';
+	out << ",\n  \"cpuMeshBytes\": " << cpuMeshBytes;
+	out << ",\n  \"vertexStride\": " << vertexStride;
+	if (sleepBenchmark)
+	{
+		out << ",\n  \"sleepBenchmark\": {\"bodies\": " << sleepBenchmark->bodies << ", \"sleepingBodies\": " << sleepBenchmark->sleepingBodies
+		    << ", \"settleSeconds\": " << sleepBenchmark->settleSeconds << ", \"awakeStepMs\": " << sleepBenchmark->awakeStepMs
+		    << ", \"awakeLatencyMs\": " << sleepBenchmark->awakeLatencyMs << ", \"sleepingStepMs\": " << sleepBenchmark->sleepingStepMs
+		    << ", \"sleepingLatencyMs\": " << sleepBenchmark->sleepingLatencyMs << '}';
+	}
+	out << "\n}\n";
+	return out.good();
+}
+
+void BenchmarkReport::Add(const std::string &benchmark, const std::string &metric, double value)
+{
+	auto it = std::find_if(benchmarks.begin(), benchmarks.end(), [&benchmark](const Benchmark &b) { return b.name == benchmark; });
+	if (it == benchmarks.end())
+	{
+		it = benchmarks.insert(benchmarks.end(), Benchmark{benchmark, {}});
+	}
+	it->metrics.emplace_back(metric, value);
+}
+
+void BenchmarkReport::AddFailure(const std::string &benchmark, const std::string &message)
+{
+	failures.push_back(benchmark + ": " + message);
+}
+
+bool BenchmarkReport::WriteJson(const std::string &path) const
+{
+	std::ofstream out(path, std::ios::out | std::ios::trunc);
+	if (!out.is_open())
+	{
+		return false;
+	}
+
+	out << std::fixed << std::setprecision(4);
+	out << "{\n  \"benchmarks\": {";
+	for (size_t b = 0; b < benchmarks.size(); ++b)
+	{
+		out << (b == 0 ? "\n    " : ",\n    ");
+		WriteJsonString(out, benchmarks[b].name);
+		out << ": {";
+		for (size_t m = 0; m < benchmarks[b].metrics.size(); ++m)
+		{
+			out << (m == 0 ? "" : ", ");
+			WriteJsonString(out, benchmarks[b].metrics[m].first);
+			const double value = benchmarks[b].metrics[m].second;
+			// Counts are written without a fraction
+			if (value == std::floor(value) && std::fabs(value) < 1e15)
+			{
+				out << ": " << static_cast<int64_t>(value);
+			}
+			else
+			{
+				out << ": " << value;
+			}
+		}
+		out << '}';
+	}
+	out << "\n  },\n  \"failures\": [";
+	for (size_t f = 0; f < failures.size(); ++f)
+	{
+		out << (f == 0 ? "" : ", ");
+		WriteJsonString(out, failures[f]);
+	}
+	out << "]\n}\n";
+	return out.good();
+}
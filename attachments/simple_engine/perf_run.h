@@ -0,0 +1,208 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Settings of an automated (headless) performance run.
+ */
+struct PerfRunConfig
+{
+	uint32_t    frames       = 600;          // measured frames
+	uint32_t    warmupFrames = 60;           // frames rendered after loading, before measuring
+	uint32_t    frameDeltaMs = 16;           // fixed simulation step, so every run sees the same camera poses
+	std::string cameraPathFile;              // keyframe file; empty for the default orbit
+	glm::vec3   orbitCenter{0.0f, 1.5f, 0.0f};
+	float       orbitRadius  = 8.0f;
+	float       orbitSeconds = 20.0f;        // one revolution
+	std::string scene;                       // reported only
+	std::string reportPath = "perf_report.json";
+	uint32_t    loadTimeoutSeconds = 600;    // the run fails if the scene is not loaded by then
+	uint32_t    syntheticLights    = 0;      // pseudo-random dynamic lights added to the scene, 1% moving per frame
+	uint32_t    sleepBenchmarkBodies = 0;    // bodies of the island sleeping scenario run after warmup; 0 skips it
+};
+
+/**
+ * @brief Camera path for scripted runs, linearly interpolated between keyframes.
+ *
+ * A path file has one keyframe per line, "t px py pz tx ty tz": the time in seconds,
+ * the camera position and the point it looks at. Empty lines and lines starting with
+ * '#' are skipped. Keyframes must be in increasing time order. The path loops, so a
+ * run longer than the path starts over from the first keyframe.
+ */
+class CameraPath
+{
+  public:
+	struct Keyframe
+	{
+		float     time = 0.0f;
+		glm::vec3 position{0.0f};
+		glm::vec3 target{0.0f};
+	};
+
+	/**
+	 * @brief Build a horizontal circle around a point, looking at it.
+	 * @param center Orbit center; the camera stays at its height.
+	 * @param radius Orbit radius.
+	 * @param seconds Duration of one revolution.
+	 * @return The path.
+	 */
+	static CameraPath Orbit(const glm::vec3 &center, float radius, float seconds);
+
+	/**
+	 * @brief Replace the keyframes with those of a path file.
+	 * @param path The file to read.
+	 * @return False if the file cannot be read or holds no valid keyframe.
+	 */
+	bool LoadFromFile(const std::string &path);
+
+	/**
+	 * @brief Get the camera pose at a time.
+	 * @param time Seconds since the start of the run.
+	 * @param position Receives the camera position.
+	 * @param target Receives the point the camera looks at.
+	 */
+	void Sample(float time, glm::vec3 &position, glm::vec3 &target) const;
+
+	size_t GetKeyframeCount() const
+	{
+		return keyframes.size();
+	}
+
+  private:
+	std::vector<Keyframe> keyframes;
+};
+
+/**
+ * @brief Per-frame measurements of a performance run, written as a JSON report.
+ */
+class PerfRunReport
+{
+  public:
+	struct Frame
+	{
+		double   cpuMs               = 0.0;
+		uint32_t draws               = 0;
+		uint32_t visible             = 0;        // objects that passed culling
+		uint32_t culled              = 0;
+		uint64_t triangles           = 0;        // main view, at the selected mesh LOD levels
+		uint64_t fullDetailTriangles = 0;        // the same objects at full detail
+		uint32_t clusters            = 0;        // meshlets tested by cluster culling
+		uint32_t clustersCulled      = 0;        // of those, outside the frustum or back-facing
+		uint32_t lights              = 0;        // uploaded to the light buffer
+		double   lightUpdateMs       = 0.0;      // CPU time of the light buffer update
+	};
+
+	// The physics island sleeping scenario: tick time and step latency while the bodies move, then once they sleep
+	struct SleepBenchmark
+	{
+		uint32_t bodies            = 0;
+		uint32_t sleepingBodies    = 0;          // asleep when the settled phase was measured
+		double   awakeStepMs       = 0.0;
+		double   awakeLatencyMs    = 0.0;
+		double   sleepingStepMs    = 0.0;
+		double   sleepingLatencyMs = 0.0;
+		double   settleSeconds     = 0.0;        // simulated time until the bodies settled
+	};
+
+	std::string deviceName;
+	std::string scene;
+	std::string cameraPath;
+	uint32_t    width           = 0;
+	uint32_t    height          = 0;
+	uint32_t    warmupFrames    = 0;
+	uint32_t    frameDeltaMs    = 0;
+	double      wallSeconds     = 0.0;        // duration of the measured frames
+	uint64_t    uploadBytes     = 0;          // uploaded during the measured frames
+	double      averageUploadMs = 0.0;
+	uint64_t    cpuMeshBytes    = 0;          // CPU mesh geometry resident at the end of the run
+	uint32_t    vertexStride    = 0;          // bytes per vertex in the GPU vertex buffers
+	double      loadSeconds     = 0.0;        // from the start of the run until the scene finished loading
+	std::string error;                        // why the run failed; empty if it completed
+	std::optional<SleepBenchmark> sleepBenchmark;        // set when the run included the sleeping scenario
+
+	void AddFrame(const Frame &frame)
+	{
+		frames.push_back(frame);
+	}
+
+	/**
+	 * @brief Get a percentile of the CPU frame times (nearest rank).
+	 * @param percentile Percentile in [0, 100].
+	 * @return The frame time in milliseconds, or 0 without frames.
+	 */
+	double GetFrameMsPercentile(double percentile) const;
+
+	/**
+	 * @brief Write the report.
+	 * @param path Output file.
+	 * @return True if the file was written.
+	 */
+	bool WriteJson(const std::string &path) const;
+
+  private:
+	std::vector<Frame> frames;
+};
+
+/**
+ * @brief Results of the CPU benchmarks run with --benchmark, written as a JSON report.
+ *
+ * Each benchmark records named metrics. Correctness checks record a failure when
+ * their output disagrees with the reference, which fails the run.
+ */
+class BenchmarkReport
+{
+  public:
+	/**
+	 * @brief Record a metric; benchmarks appear in the order of their first metric.
+	 */
+	void Add(const std::string &benchmark, const std::string &metric, double value);
+
+	/**
+	 * @brief Record a failed check.
+	 */
+	void AddFailure(const std::string &benchmark, const std::string &message);
+
+	bool HasFailures() const
+	{
+		return !failures.empty();
+	}
+
+	/**
+	 * @brief Write the report.
+	 * @param path Output file.
+	 * @return True if the file was written.
+	 */
+	bool WriteJson(const std::string &path) const;
+
+  private:
+	struct Benchmark
+	{
+		std::string                                 name;
+		std::vector<std::pair<std::string, double>> metrics;
+	};
+
+	std::vector<Benchmark>   benchmarks;
+	std::vector<std::string> failures;        // "benchmark: message"
+};
@@ -17,6 +17,7 @@
 #include "physics_system.h"
 #include "entity.h"
 #include "mesh_component.h"
+#include "profiler.h"
 #include "renderer.h"
 #include "transform_component.h"
 #include <iostream>
@@ -25,13 +26,20 @@
 #include <chrono>
 #include <cstring>
 #include <fstream>
+#include <numeric>
 #include <glm/gtc/quaternion.hpp>
 #include <unordered_map>
 
 // Physics constants
 constexpr float TENNIS_BALL_RADIUS = 0.0335f; // meters
-
-// Concrete implementation of RigidBody
+// An island goes to sleep once all its bodies stayed below these speeds for SLEEP_DELAY seconds
+constexpr float SLEEP_LINEAR_VELOCITY = 0.01f; // m/s
+constexpr float SLEEP_ANGULAR_VELOCITY = 0.05f; // rad/s
+constexpr float SLEEP_DELAY = 0.5f; // seconds
+
+// Concrete implementation of RigidBody.
+// The game thread changes bodies through the public interface while the simulation thread uploads
+// and applies results, so all state is guarded by the body's own mutex.
 class ConcreteRigidBody final : public RigidBody {
   public:
     ConcreteRigidBody(Entity* entity, CollisionShape shape, float mass) : entity(entity), shape(shape), mass(mass) {
@@ -49,12 +57,16 @@ class ConcreteRigidBody final : public RigidBody {
           scale = glm::vec3(1.0f);
         }
       }
+      UpdateColliderData();
     }
 
     ~ConcreteRigidBody() override = default;
 
     void SetPosition(const glm::vec3& _position) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       position = _position;
+      gpuDirty = true;
+      WakeUp();
 
       // Update entity transform component for visual representation
       if (entity) {
@@ -62,10 +74,14 @@ class ConcreteRigidBody final : public RigidBody {
           transform->SetPosition(_position);
         }
       }
+      UpdateColliderData();
     }
 
     void SetRotation(const glm::quat& _rotation) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       rotation = _rotation;
+      gpuDirty = true;
+      WakeUp();
 
       // Update entity transform component for visual representation
       if (entity) {
@@ -75,55 +91,83 @@ class ConcreteRigidBody final : public RigidBody {
           transform->SetRotation(eulerAngles);
         }
       }
+      UpdateColliderData();
     }
 
     void SetScale(const glm::vec3& _scale) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       scale = _scale;
+      gpuDirty = true;
+      WakeUp();
+      UpdateColliderData();
     }
 
     void SetMass(float _mass) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       mass = _mass;
+      gpuDirty = true;
+      WakeUp();
     }
 
     void SetRestitution(float _restitution) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       restitution = _restitution;
+      gpuDirty = true;
     }
 
     void SetFriction(float _friction) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       friction = _friction;
+      gpuDirty = true;
     }
 
     void ApplyForce(const glm::vec3& force, const glm::vec3& localPosition) override {
       // In a real implementation, this would apply the force to the rigid body
+      std::lock_guard<std::mutex> lock(stateMutex);
       linearVelocity += force / mass;
+      gpuDirty = true;
+      WakeUp();
     }
 
     void ApplyImpulse(const glm::vec3& impulse, const glm::vec3& localPosition) override {
       // In a real implementation, this would apply the impulse to the rigid body
+      std::lock_guard<std::mutex> lock(stateMutex);
       linearVelocity += impulse / mass;
+      gpuDirty = true;
+      WakeUp();
     }
 
     void SetLinearVelocity(const glm::vec3& velocity) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       linearVelocity = velocity;
+      gpuDirty = true;
+      WakeUp();
     }
 
     void SetAngularVelocity(const glm::vec3& velocity) override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       angularVelocity = velocity;
+      gpuDirty = true;
+      WakeUp();
     }
 
     [[nodiscard]] glm::vec3 GetPosition() const override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return position;
     }
 
     [[nodiscard]] glm::quat GetRotation() const override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return rotation;
     }
 
     [[nodiscard]] glm::vec3 GetLinearVelocity() const override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return linearVelocity;
     }
 
     [[nodiscard]] glm::vec3 GetAngularVelocity() const override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return angularVelocity;
     }
 
@@ -133,10 +177,14 @@ class ConcreteRigidBody final : public RigidBody {
         return;
       }
 
+      std::lock_guard<std::mutex> lock(stateMutex);
       kinematic = _kinematic;
+      gpuDirty = true;
+      WakeUp();
     }
 
     [[nodiscard]] bool IsKinematic() const override {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return kinematic;
     }
 
@@ -149,18 +197,22 @@ class ConcreteRigidBody final : public RigidBody {
     }
 
     [[nodiscard]] float GetMass() const {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return mass;
     }
 
     [[nodiscard]] float GetInverseMass() const {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return mass > 0.0f ? 1.0f / mass : 0.0f;
     }
 
     [[nodiscard]] float GetRestitution() const {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return restitution;
     }
 
     [[nodiscard]] float GetFriction() const {
+      std::lock_guard<std::mutex> lock(stateMutex);
       return friction;
     }
 
@@ -182,11 +234,161 @@ class ConcreteRigidBody final : public RigidBody {
     bool kinematic = false;
     bool markedForRemoval = false; // Flag to mark physics body for removal
 
+    // Collider in the layout of GPUPhysicsData, computed on the thread that changes the body
+    glm::vec4 colliderData = glm::vec4(0.0f);
+    glm::vec4 colliderData2 = glm::vec4(0.0f);
+
+    // CPU-side changes that the GPU copy of this body has not seen yet
+    bool gpuDirty = true;
+    // Sleeping bodies are neither integrated nor read back until something wakes them
+    bool sleeping = false;
+    float calmTime = 0.0f; // seconds spent below the sleep velocities
+    // Step that last uploaded this body; results of earlier steps are stale for it
+    uint64_t uploadStep = 0;
+
+    mutable std::mutex stateMutex;
+
+    // Set collider data based on a collider type; called with stateMutex held (or from the constructor)
+    void UpdateColliderData() {
+      switch (shape) {
+        case CollisionShape::Sphere:
+          // Use tennis ball radius instead of hardcoded 0.5f
+          colliderData = glm::vec4(TENNIS_BALL_RADIUS, 0.0f, 0.0f, static_cast<float>(0)); // 0 = Sphere
+          colliderData2 = glm::vec4(0.0f);
+          break;
+        case CollisionShape::Box:
+          colliderData = glm::vec4(0.5f, 0.5f, 0.5f, static_cast<float>(1)); // 1 = Box
+          colliderData2 = glm::vec4(0.0f);
+          break;
+        case CollisionShape::Mesh: {
+          // Compute an axis-aligned bounding box from the entity's mesh in WORLD space
+          // and pass half-extents and local offset to the GPU. This enables sphere-geometry
+          // collisions against actual imported GLTF geometry rather than a constant box.
+          glm::vec3 halfExtents(5.0f);
+          glm::vec3 localOffset(0.0f);
+
+          if (entity) {
+            auto* meshComp = entity->GetComponent<MeshComponent>();
+            auto* xform = entity->GetComponent<TransformComponent>();
+            if (meshComp && xform && meshComp->HasLocalAABB()) {
+              glm::vec3 localMin = meshComp->GetLocalAABBMin();
+              glm::vec3 localMax = meshComp->GetLocalAABBMax();
+              glm::vec3 localCenter = 0.5f * (localMin + localMax);
+              glm::vec3 localHalfExtents = 0.5f * (localMax - localMin);
+
+              glm::mat4 model = (meshComp->GetInstanceCount() > 0) ? meshComp->GetInstance(0).getModelMatrix() : xform->GetModelMatrix();
+              glm::vec3 centerWS = glm::vec3(model * glm::vec4(localCenter, 1.0f));
+
+              glm::mat3 RS = glm::mat3(model);
+              glm::mat3 absRS;
+              absRS[0] = glm::abs(RS[0]);
+              absRS[1] = glm::abs(RS[1]);
+              absRS[2] = glm::abs(RS[2]);
+
+              glm::vec3 worldHalfExtents = absRS * localHalfExtents;
+              halfExtents = glm::max(worldHalfExtents, glm::vec3(0.01f));
+
+              // Offset relative to rigid body position
+              localOffset = centerWS - position;
+            }
+          }
+
+          // Encode Mesh collider as Mesh (type=2) for GPU narrowphase handling (sphere vs mesh)
+          colliderData = glm::vec4(halfExtents, static_cast<float>(2)); // 2 = Mesh (represented as world AABB)
+          colliderData2 = glm::vec4(localOffset, 0.0f);
+        }
+        break;
+        default:
+          colliderData = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f); // Invalid
+          colliderData2 = glm::vec4(0.0f);
+          break;
+      }
+    }
+
+    // Called with stateMutex held by anything that moves the body
+    void WakeUp() {
+      sleeping = false;
+      calmTime = 0.0f;
+    }
+
+    // Pack the body into the layout the physics shaders use and mark it as uploaded by the given step.
+    // Unchanged bodies are skipped unless force is set; returns whether the body was written.
+    // simulated is set when the step has to integrate the body.
+    bool WriteGPUData(GPUPhysicsData& out, uint64_t step, bool force, bool& simulated) {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      simulated = !kinematic && !sleeping;
+      if (!gpuDirty && !force) {
+        return false;
+      }
+      out.position = glm::vec4(position, mass > 0.0f ? 1.0f / mass : 0.0f);
+      out.rotation = glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+      out.linearVelocity = glm::vec4(linearVelocity, restitution);
+      out.angularVelocity = glm::vec4(angularVelocity, friction);
+      // Forces start at zero; the shader adds gravity each step and clears them again after integrating
+      out.force = glm::vec4(glm::vec3(0.0f), kinematic ? 1.0f : 0.0f);
+      // Use gravity only for dynamic bodies
+      out.torque = glm::vec4(glm::vec3(0.0f), kinematic ? 0.0f : 1.0f);
+      out.colliderData = colliderData;
+      out.colliderData2 = glm::vec4(glm::vec3(colliderData2), sleeping ? 1.0f : 0.0f);
+
+      gpuDirty = false;
+      uploadStep = step;
+      return true;
+    }
+
+    // Apply a simulation result without marking the body for upload. Results are dropped for kinematic
+    // and sleeping bodies and for bodies changed on the CPU after the step was recorded.
+    bool ApplySimulatedState(uint64_t step, const GPUPhysicsData& data, float stepDuration) {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      if (kinematic || sleeping || gpuDirty || uploadStep > step) {
+        return false;
+      }
+      position = glm::vec3(data.position);
+      rotation = glm::quat(data.rotation.w, data.rotation.x, data.rotation.y, data.rotation.z);
+      linearVelocity = glm::vec3(data.linearVelocity);
+      angularVelocity = glm::vec3(data.angularVelocity);
+
+      const bool calm = glm::dot(linearVelocity, linearVelocity) < SLEEP_LINEAR_VELOCITY * SLEEP_LINEAR_VELOCITY &&
+                        glm::dot(angularVelocity, angularVelocity) < SLEEP_ANGULAR_VELOCITY * SLEEP_ANGULAR_VELOCITY;
+      calmTime = calm ? calmTime + stepDuration : 0.0f;
+      return true;
+    }
+
+    // Island transitions. Sleeping bodies are uploaded once with zero velocity so the GPU skips them.
+    void PutToSleep() {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      sleeping = true;
+      linearVelocity = glm::vec3(0.0f);
+      angularVelocity = glm::vec3(0.0f);
+      gpuDirty = true;
+    }
+
+    void Wake() {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      if (sleeping) {
+        WakeUp();
+        gpuDirty = true;
+      }
+    }
+
+    // Snapshot of the values the island pass needs
+    struct SleepState {
+      bool kinematic;
+      bool sleeping;
+      float calmTime;
+    };
+    [[nodiscard]] SleepState GetSleepState() const {
+      std::lock_guard<std::mutex> lock(stateMutex);
+      return {kinematic, sleeping, calmTime};
+    }
+
     friend class PhysicsSystem;
 };
 
 PhysicsSystem::~PhysicsSystem() {
-  // Destructor implementation
+  // Stop the simulation thread before its Vulkan resources go away
+  SetSimulationThreadEnabled(false);
+
   if (initialized && gpuAccelerationEnabled) {
     CleanupVulkanResources();
   }
@@ -197,7 +399,8 @@ void PhysicsSystem::CreateMappedBuffer(vk::DeviceSize size,
                                        vk::BufferUsageFlags usage,
                                        vk::raii::Buffer& buffer,
                                        vk::raii::DeviceMemory& memory,
-                                       const std::string& errorPrefix) {
+                                       const std::string& errorPrefix,
+                                       vk::MemoryPropertyFlags properties) {
   const vk::raii::Device& raiiDevice = renderer->GetRaiiDevice();
   vk::BufferCreateInfo bufferInfo{
     .size = size,
@@ -214,7 +417,7 @@ void PhysicsSystem::CreateMappedBuffer(vk::DeviceSize size,
       .allocationSize = memRequirements.size,
       .memoryTypeIndex = renderer->FindMemoryType(
         memRequirements.memoryTypeBits,
-        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent)
+        properties)
     };
 
     memory = vk::raii::DeviceMemory(raiiDevice, allocInfo);
@@ -243,10 +446,15 @@ bool PhysicsSystem::Initialize() {
   }
 
   initialized = true;
+
+  // Simulate on a dedicated thread when there is a core to spare for it
+  SetSimulationThreadEnabled(std::thread::hardware_concurrency() > 1);
   return true;
 }
 
 void PhysicsSystem::Update(std::chrono::milliseconds deltaTime) {
+  const auto updateStart = std::chrono::steady_clock::now();
+
   // Drain any pending rigid body creations queued from background threads
   std::vector<PendingCreation> toCreate; {
     std::lock_guard<std::mutex> lk(pendingMutex);
@@ -273,33 +481,277 @@ void PhysicsSystem::Update(std::chrono::milliseconds deltaTime) {
     }
   }
 
+  // Clean up rigid bodies marked for removal
+  {
+    std::lock_guard<std::mutex> lock(rigidBodiesMutex);
+    CleanupMarkedBodies();
+  }
+
+  // Without a simulation thread the game thread drives the fixed-step clock itself
+  if (!simulationThread.joinable()) {
+    AdvanceSimulation(deltaTime);
+  }
+
+  ApplyInterpolatedTransforms();
+
+  updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - updateStart).count();
+}
+
+void PhysicsSystem::SetSimulationThreadEnabled(bool enabled) {
+  if (enabled == simulationThread.joinable()) {
+    return;
+  }
+
+  if (enabled) {
+    if (!initialized) {
+      return;
+    }
+    simulationRunning.store(true, std::memory_order_release);
+    simulationThread = std::thread(&PhysicsSystem::SimulationThreadMain, this);
+  } else {
+    {
+      std::lock_guard<std::mutex> lock(simulationWakeMutex);
+      simulationRunning.store(false, std::memory_order_release);
+    }
+    simulationWake.notify_all();
+    simulationThread.join();
+  }
+}
+
+void PhysicsSystem::SimulationThreadMain() {
+  Profiler::GetInstance().SetThreadName("Physics");
+  auto lastTick = std::chrono::steady_clock::now();
+  while (simulationRunning.load(std::memory_order_acquire)) {
+    const auto now = std::chrono::steady_clock::now();
+    AdvanceSimulation(now - lastTick);
+    lastTick = now;
+
+    // Sleep until the next step is due. If steps are still pending because the GPU is behind,
+    // back off briefly instead of spinning; the next tick collects the finished step.
+    const auto sleepTime = std::max(FIXED_TIME_STEP - stepAccumulator, FIXED_TIME_STEP / 8);
+    std::unique_lock<std::mutex> lock(simulationWakeMutex);
+    simulationWake.wait_for(lock, sleepTime, [this] {
+      return !simulationRunning.load(std::memory_order_acquire);
+    });
+  }
+}
+
+void PhysicsSystem::AdvanceSimulation(std::chrono::nanoseconds elapsed) {
   // GPU-ONLY physics - NO CPU fallback available
+  if (!initialized || !gpuAccelerationEnabled || !renderer) {
+    return;
+  }
+
+  PROFILE_SCOPE("Physics tick");
+  const auto tickStart = std::chrono::steady_clock::now();
+
+  // Work out how many fixed steps are due; a long hitch is clamped instead of being simulated in one huge step
+  stepAccumulator += elapsed;
+  uint64_t dueSteps = static_cast<uint64_t>(stepAccumulator / FIXED_TIME_STEP);
+  if (dueSteps > MAX_SUBSTEPS) {
+    stats.droppedSteps += dueSteps - MAX_SUBSTEPS;
+    stepAccumulator -= FIXED_TIME_STEP * static_cast<int64_t>(dueSteps - MAX_SUBSTEPS);
+    dueSteps = MAX_SUBSTEPS;
+  }
 
-  // Check if GPU physics is properly initialized and available
-  bool canUseGPUPhysics = false; {
+  {
     std::lock_guard<std::mutex> lock(rigidBodiesMutex);
-    canUseGPUPhysics = (rigidBodies.size() <= maxGPUObjects);
+
+    // Apply whatever earlier steps have finished without waiting for the GPU
+    ReadbackGPUPhysicsData(false);
+
+    if (dueSteps > 0) {
+      const auto substeps = static_cast<uint32_t>(dueSteps);
+      if (rigidBodies.size() > maxGPUObjects) {
+        // Too many bodies for the GPU buffers: physics is paused, the time is discarded
+        stepAccumulator -= FIXED_TIME_STEP * substeps;
+      } else if (SimulatePhysicsOnGPU(FIXED_TIME_STEP, substeps)) {
+        stepAccumulator -= FIXED_TIME_STEP * substeps;
+        stats.fixedSteps += substeps;
+        stats.substeps = substeps;
+      }
+    }
+  }
+
+  stats.stepMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - tickStart).count();
+  {
+    std::lock_guard<std::mutex> lock(statsMutex);
+    publishedStats = stats;
+  }
+
+  AdvanceSleepBenchmark();
+}
+
+void PhysicsSystem::StartSleepBenchmark(uint32_t bodyCount) {
+  std::lock_guard<std::mutex> lock(sleepBenchmarkMutex);
+  if (sleepBenchmark.phase != SleepBenchmark::Phase::Idle) {
+    return;
+  }
+  sleepBenchmark.phase = SleepBenchmark::Phase::Starting;
+  sleepBenchmark.requestedBodies = bodyCount;
+  sleepBenchmark.result = SleepBenchmarkResult{.running = true};
+}
+
+PhysicsSystem::SleepBenchmarkResult PhysicsSystem::GetSleepBenchmarkResult() const {
+  std::lock_guard<std::mutex> lock(sleepBenchmarkMutex);
+  return sleepBenchmark.result;
+}
+
+void PhysicsSystem::AdvanceSleepBenchmark() {
+  std::lock_guard<std::mutex> lock(sleepBenchmarkMutex);
+  auto& bench = sleepBenchmark;
+  if (bench.phase == SleepBenchmark::Phase::Idle) {
+    return;
   }
 
-  if (initialized&& gpuAccelerationEnabled && renderer && canUseGPUPhysics) {
-    // Debug: Log that we're using GPU physics
-    static bool gpuPhysicsLogged = false;
-    if (!gpuPhysicsLogged) {
-      gpuPhysicsLogged = true;
+  // Each phase averages the tick time and the step latency over one simulated second
+  constexpr double measureSeconds = 1.0;
+  constexpr double settleTimeout = 10.0;
+  const double elapsed = simulationTime - bench.startTime;
+
+  switch (bench.phase) {
+    case SleepBenchmark::Phase::Starting: {
+      // Spheres in a grid just above a kinematic box far away from the scene. The bodies have no
+      // entity, so they are simulated but never drawn.
+      uint32_t freeBodies = 0; {
+        std::lock_guard<std::mutex> bodiesLock(rigidBodiesMutex);
+        freeBodies = maxGPUObjects > rigidBodies.size() + 1 ? maxGPUObjects - static_cast<uint32_t>(rigidBodies.size()) - 1 : 0;
+      }
+      const uint32_t count = std::min(bench.requestedBodies, freeBodies);
+      if (count == 0) {
+        bench.result.running = false;
+        bench.phase = SleepBenchmark::Phase::Idle;
+        return;
+      }
+
+      const glm::vec3 origin(1000.0f, 0.0f, 1000.0f);
+      bench.bodies.clear();
+      RigidBody* floor = CreateRigidBody(nullptr, CollisionShape::Mesh, 0.0f);
+      if (floor) {
+        floor->SetKinematic(true);
+        floor->SetPosition(origin - glm::vec3(0.0f, 5.0f, 0.0f)); // default 10 m box, top face at origin.y
+        bench.bodies.push_back(floor);
+      }
+
+      const auto side = static_cast<uint32_t>(std::ceil(std::sqrt(static_cast<float>(count))));
+      const float spacing = std::min(0.2f, 9.0f / static_cast<float>(side));
+      for (uint32_t i = 0; i < count; i++) {
+        RigidBody* body = CreateRigidBody(nullptr, CollisionShape::Sphere, 1.0f);
+        if (!body) {
+          break;
+        }
+        const float x = (static_cast<float>(i % side) - 0.5f * static_cast<float>(side - 1)) * spacing;
+        const float z = (static_cast<float>(i / side) - 0.5f * static_cast<float>(side - 1)) * spacing;
+        body->SetPosition(origin + glm::vec3(x, 0.1f + 0.002f * static_cast<float>(i % 7), z));
+        body->SetRestitution(0.3f);
+        bench.bodies.push_back(body);
+      }
+
+      bench.result.bodies = static_cast<uint32_t>(bench.bodies.size()) - (floor ? 1 : 0);
+      bench.startTime = simulationTime;
+      bench.stepMsSum = 0.0;
+      bench.latencyMsSum = 0.0;
+      bench.samples = 0;
+      bench.phase = SleepBenchmark::Phase::Moving;
+      break;
     }
-    SimulatePhysicsOnGPU(deltaTime);
-  } else {
-    // NO CPU FALLBACK - GPU physics must work, or physics is disabled
-    static bool noFallbackLogged = false;
-    if (!noFallbackLogged) {
-      noFallbackLogged = true;
+    case SleepBenchmark::Phase::Moving:
+      bench.stepMsSum += stats.stepMs;
+      bench.latencyMsSum += stats.latencyMs;
+      bench.samples++;
+      if (elapsed >= measureSeconds) {
+        bench.result.awakeStepMs = bench.stepMsSum / bench.samples;
+        bench.result.awakeLatencyMs = bench.latencyMsSum / bench.samples;
+        bench.phase = SleepBenchmark::Phase::Settling;
+      }
+      break;
+    case SleepBenchmark::Phase::Settling: {
+      uint32_t sleeping = 0;
+      for (RigidBody* body : bench.bodies) {
+        const auto state = static_cast<ConcreteRigidBody *>(body)->GetSleepState();
+        sleeping += state.sleeping ? 1 : 0;
+      }
+      if (sleeping >= bench.result.bodies || elapsed >= settleTimeout) {
+        bench.result.settleSeconds = elapsed;
+        bench.result.sleepingBodies = sleeping;
+        bench.startTime = simulationTime;
+        bench.stepMsSum = 0.0;
+        bench.latencyMsSum = 0.0;
+        bench.samples = 0;
+        bench.phase = SleepBenchmark::Phase::Settled;
+      }
+      break;
+    }
+    case SleepBenchmark::Phase::Settled:
+      bench.stepMsSum += stats.stepMs;
+      bench.latencyMsSum += stats.latencyMs;
+      bench.samples++;
+      if (elapsed >= measureSeconds) {
+        bench.result.sleepingStepMs = bench.stepMsSum / bench.samples;
+        bench.result.sleepingLatencyMs = bench.latencyMsSum / bench.samples;
+        bench.result.running = false;
+
+        // Remove the scenario bodies on the next Update
+        std::lock_guard<std::mutex> bodiesLock(rigidBodiesMutex);
+        for (RigidBody* body : bench.bodies) {
+          static_cast<ConcreteRigidBody *>(body)->markedForRemoval = true;
+        }
+        bench.bodies.clear();
+        bench.phase = SleepBenchmark::Phase::Idle;
+      }
+      break;
+    case SleepBenchmark::Phase::Idle:
+      break;
+  }
+}
+
+void PhysicsSystem::ApplyInterpolatedTransforms() {
+  const auto now = std::chrono::steady_clock::now();
+
+  // Take the newest state if the simulation published one since the last frame
+  if (handoffMiddle.load(std::memory_order_acquire) & HANDOFF_FRESH) {
+    handoffFront = handoffMiddle.exchange(handoffFront, std::memory_order_acq_rel) & ~HANDOFF_FRESH;
+    std::swap(previousState, currentState);
+    currentState = handoffBuffers[handoffFront];
+    currentStateArrival = now;
+  }
+
+  // Render one step behind the simulation: move from the previous to the current state
+  // over the simulated time between them
+  float alpha = 1.0f;
+  const double span = currentState.time - previousState.time;
+  if (span > 0.0) {
+    alpha = static_cast<float>(std::clamp(std::chrono::duration<double>(now - currentStateArrival).count() / span, 0.0, 1.0));
+  }
+
+  for (size_t i = 0; i < currentState.bodies.size(); i++) {
+    const auto& body = currentState.bodies[i];
+    if (!body.entity) {
+      continue;
+    }
+
+    glm::vec3 position = body.position;
+    glm::quat rotation = body.rotation;
+    if (alpha < 1.0f && i < previousState.bodies.size() && previousState.bodies[i].entity == body.entity) {
+      position = glm::mix(previousState.bodies[i].position, body.position, alpha);
+      rotation = glm::slerp(previousState.bodies[i].rotation, body.rotation, alpha);
+    }
+
+    if (auto* transform = body.entity->GetComponent<TransformComponent>()) {
+      transform->SetPosition(position);
+      transform->SetRotationQuaternion(rotation);
     }
   }
+}
 
-  // Clean up rigid bodies marked for removal (happens regardless of GPU/CPU physics path)
-  CleanupMarkedBodies();
+PhysicsSystem::Stats PhysicsSystem::GetStats() const {
+  std::lock_guard<std::mutex> lock(statsMutex);
+  Stats result = publishedStats;
+  result.cpuMs = updateMs;
+  return result;
 }
 
+
 void PhysicsSystem::EnqueueRigidBodyCreation(Entity* entity,
                                              CollisionShape shape,
                                              float mass,
@@ -333,8 +785,10 @@ bool PhysicsSystem::DestroyRigidBody(RigidBody* rigidBody) {
                                  });
 
   if (it != rigidBodies.end()) {
-    // Remove the rigid body
+    // Remove the rigid body; later bodies move down, so the GPU copy has to be rewritten
+    ForgetInFlightBody(it->get());
     rigidBodies.erase(it);
+    fullUploadRequired = true;
 
     return true;
   }
@@ -344,10 +798,19 @@ bool PhysicsSystem::DestroyRigidBody(RigidBody* rigidBody) {
 }
 
 void PhysicsSystem::SetGravity(const glm::vec3& _gravity) {
+  std::lock_guard<std::mutex> lock(rigidBodiesMutex);
   gravity = _gravity;
+
+  // Resting bodies have to react to the new gravity
+  for (const auto& rigidBody : rigidBodies) {
+    if (auto* concreteRigidBody = dynamic_cast<ConcreteRigidBody *>(rigidBody.get())) {
+      concreteRigidBody->Wake();
+    }
+  }
 }
 
 glm::vec3 PhysicsSystem::GetGravity() const {
+  std::lock_guard<std::mutex> lock(rigidBodiesMutex);
   return gravity;
 }
 
@@ -666,7 +1129,7 @@ bool PhysicsSystem::InitializeVulkanResources() {
     vulkanResources.resolveShaderModule = createShaderModule(raiiDevice, physicsShaderCode);
 
     // Create a descriptor set layout
-    std::array<vk::DescriptorSetLayoutBinding, 5> bindings = {
+    std::array<vk::DescriptorSetLayoutBinding, 6> bindings = {
       // Physics data buffer
       vk::DescriptorSetLayoutBinding(
         0,
@@ -726,6 +1189,18 @@ bool PhysicsSystem::InitializeVulkanResources() {
         vk::ShaderStageFlagBits::eCompute,
         // stageFlags
         nullptr // pImmutableSamplers
+      ),
+      // Active body indices
+      vk::DescriptorSetLayoutBinding(
+        5,
+        // binding
+        vk::DescriptorType::eStorageBuffer,
+        // descriptorType
+        1,
+        // descriptorCount
+        vk::ShaderStageFlagBits::eCompute,
+        // stageFlags
+        nullptr // pImmutableSamplers
       )
     };
 
@@ -784,83 +1259,112 @@ bool PhysicsSystem::InitializeVulkanResources() {
     vk::DeviceSize pairBufferSize = sizeof(uint32_t) * 2 * maxGPUCollisions;
     vk::DeviceSize counterBufferSize = sizeof(uint32_t) * 2;
     vk::DeviceSize paramsBufferSize = ((sizeof(PhysicsParams) + 63) / 64) * 64;
+    vk::DeviceSize activeBufferSize = sizeof(uint32_t) * maxGPUObjects;
+    vk::DeviceSize contactBufferSize = CONTACT_PAIRS_OFFSET + pairBufferSize;
 
-    // Create a physics buffer
+    // Create the physics buffer. It holds the simulated state between steps, so it lives in device memory
+    // and is filled from the upload buffers and copied out to the readback buffers of the step slots.
     CreateMappedBuffer(physicsBufferSize,
-                       vk::BufferUsageFlagBits::eStorageBuffer,
+                       vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
                        vulkanResources.physicsBuffer,
                        vulkanResources.physicsBufferMemory,
-                       "Failed to create physics buffer: ");
+                       "Failed to create physics buffer: ",
+                       vk::MemoryPropertyFlagBits::eDeviceLocal);
 
     // Create a collision buffer
     CreateMappedBuffer(collisionBufferSize,
                        vk::BufferUsageFlagBits::eStorageBuffer,
                        vulkanResources.collisionBuffer,
                        vulkanResources.collisionBufferMemory,
-                       "Failed to create collision buffer: ");
+                       "Failed to create collision buffer: ",
+                       vk::MemoryPropertyFlagBits::eDeviceLocal);
 
-    // Create a pair buffer
+    // Create a pair buffer; the broad-phase pairs are copied out as the contact graph for island detection
     CreateMappedBuffer(pairBufferSize,
-                       vk::BufferUsageFlagBits::eStorageBuffer,
+                       vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc,
                        vulkanResources.pairBuffer,
                        vulkanResources.pairBufferMemory,
-                       "Failed to create pair buffer: ");
+                       "Failed to create pair buffer: ",
+                       vk::MemoryPropertyFlagBits::eDeviceLocal);
 
-    // Create the counter-buffer
+    // Create the counter-buffer; it is cleared on the GPU at the start of every step
     CreateMappedBuffer(counterBufferSize,
-                       vk::BufferUsageFlagBits::eStorageBuffer,
+                       vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eTransferSrc | vk::BufferUsageFlagBits::eTransferDst,
                        vulkanResources.counterBuffer,
                        vulkanResources.counterBufferMemory,
-                       "Failed to create counter buffer: ");
-
-    // Create a params buffer
-    CreateMappedBuffer(paramsBufferSize,
-                       vk::BufferUsageFlagBits::eUniformBuffer,
-                       vulkanResources.paramsBuffer,
-                       vulkanResources.paramsBufferMemory,
-                       "Failed to create params buffer: ");
-
-    // Create persistent mapped memory pointers for improved performance
-    try {
-      // Map entire memory objects persistently to satisfy VK_WHOLE_SIZE flush alignment requirements
-      vulkanResources.persistentPhysicsMemory = vulkanResources.physicsBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
-      vulkanResources.persistentCounterMemory = vulkanResources.counterBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
-      vulkanResources.persistentParamsMemory = vulkanResources.paramsBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
-    } catch (const std::exception& e) {
-      throw std::runtime_error("Failed to create persistent mapped memory: " + std::string(e.what()));
+                       "Failed to create counter buffer: ",
+                       vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+    // Create the per-step buffers and keep them mapped
+    for (auto& slot : stepSlots) {
+      CreateMappedBuffer(paramsBufferSize,
+                         vk::BufferUsageFlagBits::eUniformBuffer,
+                         slot.paramsBuffer,
+                         slot.paramsBufferMemory,
+                         "Failed to create params buffer: ");
+      CreateMappedBuffer(physicsBufferSize,
+                         vk::BufferUsageFlagBits::eTransferSrc,
+                         slot.uploadBuffer,
+                         slot.uploadBufferMemory,
+                         "Failed to create physics upload buffer: ");
+      CreateMappedBuffer(physicsBufferSize,
+                         vk::BufferUsageFlagBits::eTransferDst,
+                         slot.readbackBuffer,
+                         slot.readbackBufferMemory,
+                         "Failed to create physics readback buffer: ");
+      CreateMappedBuffer(activeBufferSize,
+                         vk::BufferUsageFlagBits::eStorageBuffer,
+                         slot.activeBuffer,
+                         slot.activeBufferMemory,
+                         "Failed to create active body buffer: ");
+      CreateMappedBuffer(contactBufferSize,
+                         vk::BufferUsageFlagBits::eTransferDst,
+                         slot.contactBuffer,
+                         slot.contactBufferMemory,
+                         "Failed to create contact readback buffer: ");
+
+      try {
+        slot.paramsMapped = slot.paramsBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
+        slot.uploadMapped = slot.uploadBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
+        slot.readbackMapped = slot.readbackBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
+        slot.activeMapped = slot.activeBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
+        slot.contactMapped = slot.contactBufferMemory.mapMemory(0, VK_WHOLE_SIZE);
+      } catch (const std::exception& e) {
+        throw std::runtime_error("Failed to create persistent mapped memory: " + std::string(e.what()));
+      }
     }
 
-    // Initialize counter-buffer using persistent memory
-    uint32_t initialCounters[2] = {0, 0}; // [0] = pair count, [1] = collision count
-    memcpy(vulkanResources.persistentCounterMemory, initialCounters, sizeof(initialCounters));
-
-    // Create a descriptor pool with capacity for 4 physics stages
+    // Create a descriptor pool with one set per step slot
     std::array poolSizes = {
-      vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, 16), // 4 storage buffers × 4 stages
-      vk::DescriptorPoolSize(vk::DescriptorType::eUniformBuffer, 4) // 1 uniform buffer × 4 stages
+      vk::DescriptorPoolSize(vk::DescriptorType::eStorageBuffer, 5 * STEP_SLOTS), // 5 storage buffers per slot
+      vk::DescriptorPoolSize(vk::DescriptorType::eUniformBuffer, STEP_SLOTS) // 1 uniform buffer per slot
     };
 
     vk::DescriptorPoolCreateInfo poolInfo;
     poolInfo.flags = vk::DescriptorPoolCreateFlagBits::eFreeDescriptorSet;
     poolInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
     poolInfo.pPoolSizes = poolSizes.data();
-    poolInfo.maxSets = 4; // Support 4 descriptor sets for 4 physics stages
+    poolInfo.maxSets = STEP_SLOTS;
     vulkanResources.descriptorPool = vk::raii::DescriptorPool(raiiDevice, poolInfo);
 
     // Allocate descriptor sets
+    std::array<vk::DescriptorSetLayout, STEP_SLOTS> descriptorSetLayouts;
+    descriptorSetLayouts.fill(*vulkanResources.descriptorSetLayout);
     vk::DescriptorSetAllocateInfo descriptorSetAllocInfo;
     descriptorSetAllocInfo.descriptorPool = *vulkanResources.descriptorPool;
-    descriptorSetAllocInfo.descriptorSetCount = 1;
-    vk::DescriptorSetLayout descriptorSetLayoutRef = *vulkanResources.descriptorSetLayout;
-    descriptorSetAllocInfo.pSetLayouts = &descriptorSetLayoutRef;
+    descriptorSetAllocInfo.descriptorSetCount = STEP_SLOTS;
+    descriptorSetAllocInfo.pSetLayouts = descriptorSetLayouts.data();
 
     try {
-      vulkanResources.descriptorSets = raiiDevice.allocateDescriptorSets(descriptorSetAllocInfo);
+      std::vector<vk::raii::DescriptorSet> descriptorSets = raiiDevice.allocateDescriptorSets(descriptorSetAllocInfo);
+      for (uint32_t i = 0; i < STEP_SLOTS; ++i) {
+        stepSlots[i].descriptorSet = std::move(descriptorSets[i]);
+      }
     } catch (const std::exception& e) {
       throw std::runtime_error("Failed to allocate descriptor sets: " + std::string(e.what()));
     }
 
-    // Update descriptor sets
+    // Update descriptor sets; the slots share everything except the params and active body buffers
     vk::DescriptorBufferInfo physicsBufferInfo;
     physicsBufferInfo.buffer = *vulkanResources.physicsBuffer;
     physicsBufferInfo.offset = 0;
@@ -881,29 +1385,39 @@ bool PhysicsSystem::InitializeVulkanResources() {
     counterBufferInfo.offset = 0;
     counterBufferInfo.range = counterBufferSize;
 
-    vk::DescriptorBufferInfo paramsBufferInfo;
-    paramsBufferInfo.buffer = *vulkanResources.paramsBuffer;
-    paramsBufferInfo.offset = 0;
-    paramsBufferInfo.range = VK_WHOLE_SIZE; // Use VK_WHOLE_SIZE to ensure the entire buffer is accessible
+    for (auto& slot : stepSlots) {
+      vk::DescriptorBufferInfo paramsBufferInfo;
+      paramsBufferInfo.buffer = *slot.paramsBuffer;
+      paramsBufferInfo.offset = 0;
+      paramsBufferInfo.range = VK_WHOLE_SIZE; // Use VK_WHOLE_SIZE to ensure the entire buffer is accessible
+
+      vk::DescriptorBufferInfo activeBufferInfo;
+      activeBufferInfo.buffer = *slot.activeBuffer;
+      activeBufferInfo.offset = 0;
+      activeBufferInfo.range = activeBufferSize;
+
+      std::array<vk::WriteDescriptorSet, 6> descriptorWrites;
 
-    std::array<vk::WriteDescriptorSet, 5> descriptorWrites;
+      // Physics buffer
+      descriptorWrites[0].setDstSet(*slot.descriptorSet).setDstBinding(0).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&physicsBufferInfo);
 
-    // Physics buffer
-    descriptorWrites[0].setDstSet(*vulkanResources.descriptorSets[0]).setDstBinding(0).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&physicsBufferInfo);
+      // Collision buffer
+      descriptorWrites[1].setDstSet(*slot.descriptorSet).setDstBinding(1).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&collisionBufferInfo);
 
-    // Collision buffer
-    descriptorWrites[1].setDstSet(*vulkanResources.descriptorSets[0]).setDstBinding(1).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&collisionBufferInfo);
+      // Pair buffer
+      descriptorWrites[2].setDstSet(*slot.descriptorSet).setDstBinding(2).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&pairBufferInfo);
 
-    // Pair buffer
-    descriptorWrites[2].setDstSet(*vulkanResources.descriptorSets[0]).setDstBinding(2).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&pairBufferInfo);
+      // Counter buffer
+      descriptorWrites[3].setDstSet(*slot.descriptorSet).setDstBinding(3).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&counterBufferInfo);
 
-    // Counter buffer
-    descriptorWrites[3].setDstSet(*vulkanResources.descriptorSets[0]).setDstBinding(3).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&counterBufferInfo);
+      // Params buffer
+      descriptorWrites[4].setDstSet(*slot.descriptorSet).setDstBinding(4).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eUniformBuffer).setPBufferInfo(&paramsBufferInfo);
 
-    // Params buffer
-    descriptorWrites[4].setDstSet(*vulkanResources.descriptorSets[0]).setDstBinding(4).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eUniformBuffer).setPBufferInfo(&paramsBufferInfo);
+      // Active body buffer
+      descriptorWrites[5].setDstSet(*slot.descriptorSet).setDstBinding(5).setDstArrayElement(0).setDescriptorCount(1).setDescriptorType(vk::DescriptorType::eStorageBuffer).setPBufferInfo(&activeBufferInfo);
 
-    raiiDevice.updateDescriptorSets(descriptorWrites, nullptr);
+      raiiDevice.updateDescriptorSets(descriptorWrites, nullptr);
+    }
 
     // Create a command pool bound to the compute queue family used by the renderer
     vk::CommandPoolCreateInfo commandPoolInfo;
@@ -911,22 +1425,29 @@ bool PhysicsSystem::InitializeVulkanResources() {
     commandPoolInfo.queueFamilyIndex = renderer->GetComputeQueueFamilyIndex();
     vulkanResources.commandPool = vk::raii::CommandPool(raiiDevice, commandPoolInfo);
 
-    // Allocate command buffer
+    // Allocate one command buffer per step slot
     vk::CommandBufferAllocateInfo commandBufferInfo;
     commandBufferInfo.commandPool = *vulkanResources.commandPool;
     commandBufferInfo.level = vk::CommandBufferLevel::ePrimary;
-    commandBufferInfo.commandBufferCount = 1;
+    commandBufferInfo.commandBufferCount = STEP_SLOTS;
 
     try {
       std::vector<vk::raii::CommandBuffer> commandBuffers = raiiDevice.allocateCommandBuffers(commandBufferInfo);
-      vulkanResources.commandBuffer = std::move(commandBuffers.front());
+      for (uint32_t i = 0; i < STEP_SLOTS; ++i) {
+        stepSlots[i].commandBuffer = std::move(commandBuffers[i]);
+      }
     } catch (const std::exception& e) {
       throw std::runtime_error("Failed to allocate command buffer: " + std::string(e.what()));
     }
 
-    // Create a dedicated fence for compute synchronization
+    // Create a fence per slot; a slot is only reused after its fence has signaled
     vk::FenceCreateInfo fenceInfo{};
-    vulkanResources.computeFence = vk::raii::Fence(raiiDevice, fenceInfo);
+    for (auto& slot : stepSlots) {
+      slot.fence = vk::raii::Fence(raiiDevice, fenceInfo);
+      slot.submitted = false;
+    }
+    nextSlot = 0;
+    fullUploadRequired = true;
 
     return true;
   } catch (const std::exception& e) {
@@ -946,7 +1467,9 @@ void PhysicsSystem::CleanupVulkanResources() {
 
   // Cleanup in proper order to avoid validation errors
   // 1. Clear descriptor sets BEFORE destroying the descriptor pool
-  vulkanResources.descriptorSets.clear();
+  for (auto& slot : stepSlots) {
+    slot.descriptorSet = nullptr;
+  }
 
   // 2. Destroy pipelines before pipeline layout
   vulkanResources.resolvePipeline = nullptr;
@@ -967,32 +1490,50 @@ void PhysicsSystem::CleanupVulkanResources() {
   // 5. Destroy the descriptor pool after descriptor sets are cleared
   vulkanResources.descriptorPool = nullptr;
 
-  // 6. Destroy the command buffer before the command pool
-  vulkanResources.commandBuffer = nullptr;
-  vulkanResources.commandPool = nullptr;
-
-  // 7. Destroy compute fence
-  vulkanResources.computeFence = nullptr;
-
-  // 8. Unmap persistent memory pointers before destroying buffer memory
-  if (vulkanResources.persistentPhysicsMemory && *vulkanResources.physicsBufferMemory) {
-    vulkanResources.physicsBufferMemory.unmapMemory();
-    vulkanResources.persistentPhysicsMemory = nullptr;
-  }
-
-  if (vulkanResources.persistentCounterMemory && *vulkanResources.counterBufferMemory) {
-    vulkanResources.counterBufferMemory.unmapMemory();
-    vulkanResources.persistentCounterMemory = nullptr;
-  }
-
-  if (vulkanResources.persistentParamsMemory && *vulkanResources.paramsBufferMemory) {
-    vulkanResources.paramsBufferMemory.unmapMemory();
-    vulkanResources.persistentParamsMemory = nullptr;
+  for (auto& slot : stepSlots) {
+    // 6. Destroy the command buffers before the command pool, and the fences
+    slot.commandBuffer = nullptr;
+    slot.fence = nullptr;
+    slot.submitted = false;
+    slot.bodies.clear();
+    slot.active.clear();
+
+    // 7. Unmap persistent memory pointers before destroying buffer memory
+    if (slot.paramsMapped && *slot.paramsBufferMemory) {
+      slot.paramsBufferMemory.unmapMemory();
+    }
+    if (slot.uploadMapped && *slot.uploadBufferMemory) {
+      slot.uploadBufferMemory.unmapMemory();
+    }
+    if (slot.readbackMapped && *slot.readbackBufferMemory) {
+      slot.readbackBufferMemory.unmapMemory();
+    }
+    if (slot.activeMapped && *slot.activeBufferMemory) {
+      slot.activeBufferMemory.unmapMemory();
+    }
+    if (slot.contactMapped && *slot.contactBufferMemory) {
+      slot.contactBufferMemory.unmapMemory();
+    }
+    slot.paramsMapped = nullptr;
+    slot.uploadMapped = nullptr;
+    slot.readbackMapped = nullptr;
+    slot.activeMapped = nullptr;
+    slot.contactMapped = nullptr;
+
+    slot.paramsBuffer = nullptr;
+    slot.paramsBufferMemory = nullptr;
+    slot.uploadBuffer = nullptr;
+    slot.uploadBufferMemory = nullptr;
+    slot.readbackBuffer = nullptr;
+    slot.readbackBufferMemory = nullptr;
+    slot.activeBuffer = nullptr;
+    slot.activeBufferMemory = nullptr;
+    slot.contactBuffer = nullptr;
+    slot.contactBufferMemory = nullptr;
   }
+  vulkanResources.commandPool = nullptr;
 
   // 8. Destroy buffers and their memory
-  vulkanResources.paramsBuffer = nullptr;
-  vulkanResources.paramsBufferMemory = nullptr;
   vulkanResources.counterBuffer = nullptr;
   vulkanResources.counterBufferMemory = nullptr;
   vulkanResources.pairBuffer = nullptr;
@@ -1003,345 +1544,463 @@ void PhysicsSystem::CleanupVulkanResources() {
   vulkanResources.physicsBufferMemory = nullptr;
 }
 
-void PhysicsSystem::UpdateGPUPhysicsData(std::chrono::milliseconds deltaTime) const {
-  if (!renderer) {
-    return;
-  }
-
-  // Validate Vulkan resources and persistent memory pointers before using them
-  if (!*vulkanResources.physicsBuffer || !*vulkanResources.physicsBufferMemory ||
-    !*vulkanResources.counterBuffer || !*vulkanResources.counterBufferMemory ||
-    !*vulkanResources.paramsBuffer || !*vulkanResources.paramsBufferMemory ||
-    !vulkanResources.persistentPhysicsMemory || !vulkanResources.persistentCounterMemory || !vulkanResources.persistentParamsMemory) {
-    std::cerr << "PhysicsSystem::UpdateGPUPhysicsData: Invalid Vulkan resources or persistent memory pointers" << std::endl;
-    return;
-  }
-
-  // Skip physics buffer operations if no rigid bodies exist
-  if (!rigidBodies.empty()) {
-    // Use persistent mapped memory for physics buffer
-    auto* gpuData = static_cast<GPUPhysicsData *>(vulkanResources.persistentPhysicsMemory);
-    const size_t count = std::min(rigidBodies.size(), static_cast<size_t>(maxGPUObjects));
-    for (size_t i = 0; i < count; i++) {
-      const auto concreteRigidBody = dynamic_cast<ConcreteRigidBody *>(rigidBodies[i].get());
-      if (!concreteRigidBody) {
-        continue;
-      }
-
-      gpuData[i].position = glm::vec4(concreteRigidBody->GetPosition(), concreteRigidBody->GetInverseMass());
-      gpuData[i].rotation = glm::vec4(concreteRigidBody->GetRotation().x,
-                                      concreteRigidBody->GetRotation().y,
-                                      concreteRigidBody->GetRotation().z,
-                                      concreteRigidBody->GetRotation().w);
-      gpuData[i].linearVelocity = glm::vec4(concreteRigidBody->GetLinearVelocity(), concreteRigidBody->GetRestitution());
-      gpuData[i].angularVelocity = glm::vec4(concreteRigidBody->GetAngularVelocity(), concreteRigidBody->GetFriction());
-      // CRITICAL FIX: Initialize forces properly instead of always resetting to zero
-      // For balls, we want to start with zero force and let the shader apply gravity
-      // For static geometry, forces should remain zero
-      auto initialForce = glm::vec3(0.0f);
-      auto initialTorque = glm::vec3(0.0f);
-
-      // For dynamic bodies (balls), allow forces to be applied by
-      // The shader will add gravity and other forces each frame
-      bool isKinematic = concreteRigidBody->IsKinematic();
-      gpuData[i].force = glm::vec4(initialForce, isKinematic ? 1.0f : 0.0f);
-      // Use gravity only for dynamic bodies
-      gpuData[i].torque = glm::vec4(initialTorque, isKinematic ? 0.0f : 1.0f);
-
-      // Set collider data based on a collider type
-      switch (concreteRigidBody->GetShape()) {
-        case CollisionShape::Sphere:
-          // Use tennis ball radius instead of hardcoded 0.5f
-          gpuData[i].colliderData = glm::vec4(TENNIS_BALL_RADIUS, 0.0f, 0.0f, static_cast<float>(0)); // 0 = Sphere
-          gpuData[i].colliderData2 = glm::vec4(0.0f);
-          break;
-        case CollisionShape::Box:
-          gpuData[i].colliderData = glm::vec4(0.5f, 0.5f, 0.5f, static_cast<float>(1)); // 1 = Box
-          gpuData[i].colliderData2 = glm::vec4(0.0f);
-          break;
-        case CollisionShape::Mesh: {
-          // Compute an axis-aligned bounding box from the entity's mesh in WORLD space
-          // and pass half-extents and local offset to the GPU. This enables sphere-geometry
-          // collisions against actual imported GLTF geometry rather than a constant box.
-          glm::vec3 halfExtents(5.0f);
-          glm::vec3 localOffset(0.0f);
-
-          if (auto* entity = concreteRigidBody->GetEntity()) {
-            auto* meshComp = entity->GetComponent<MeshComponent>();
-            auto* xform = entity->GetComponent<TransformComponent>();
-            if (meshComp && xform && meshComp->HasLocalAABB()) {
-              glm::vec3 localMin = meshComp->GetLocalAABBMin();
-              glm::vec3 localMax = meshComp->GetLocalAABBMax();
-              glm::vec3 localCenter = 0.5f * (localMin + localMax);
-              glm::vec3 localHalfExtents = 0.5f * (localMax - localMin);
-
-              glm::mat4 model = (meshComp->GetInstanceCount() > 0) ? meshComp->GetInstance(0).getModelMatrix() : xform->GetModelMatrix();
-              glm::vec3 centerWS = glm::vec3(model * glm::vec4(localCenter, 1.0f));
-
-              glm::mat3 RS = glm::mat3(model);
-              glm::mat3 absRS;
-              absRS[0] = glm::abs(RS[0]);
-              absRS[1] = glm::abs(RS[1]);
-              absRS[2] = glm::abs(RS[2]);
-
-              glm::vec3 worldHalfExtents = absRS * localHalfExtents;
-              halfExtents = glm::max(worldHalfExtents, glm::vec3(0.01f));
-
-              // Offset relative to rigid body position
-              localOffset = centerWS - concreteRigidBody->GetPosition();
-            }
-          }
+uint32_t PhysicsSystem::UpdateGPUPhysicsData(StepSlot& slot, std::chrono::nanoseconds deltaTime, std::vector<vk::BufferCopy>& uploadRegions) {
+  const uint32_t count = static_cast<uint32_t>(std::min(rigidBodies.size(), static_cast<size_t>(maxGPUObjects)));
+  auto* gpuData = static_cast<GPUPhysicsData *>(slot.uploadMapped);
+
+  // Write only the bodies the GPU copy does not know about yet; indices match the resident state,
+  // and neighbouring changed bodies are merged into a single copy region. Awake dynamic bodies
+  // go into the active list, which is all the step integrates and reads back.
+  slot.bodies.resize(count);
+  slot.active.clear();
+  uploadRegions.clear();
+  for (uint32_t i = 0; i < count; i++) {
+    slot.bodies[i] = rigidBodies[i].get();
+    const auto concreteRigidBody = dynamic_cast<ConcreteRigidBody *>(rigidBodies[i].get());
+    bool simulated = false;
+    const bool written = concreteRigidBody && concreteRigidBody->WriteGPUData(gpuData[i], slot.step, fullUploadRequired, simulated);
+    if (simulated) {
+      slot.active.push_back(i);
+    }
+    if (!written) {
+      continue;
+    }
 
-          // Encode Mesh collider as Mesh (type=2) for GPU narrowphase handling (sphere vs mesh)
-          gpuData[i].colliderData = glm::vec4(halfExtents, static_cast<float>(2)); // 2 = Mesh (represented as world AABB)
-          gpuData[i].colliderData2 = glm::vec4(localOffset, 0.0f);
-        }
-        break;
-        default:
-          gpuData[i].colliderData = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f); // Invalid
-          gpuData[i].colliderData2 = glm::vec4(0.0f);
-          break;
-      }
+    const vk::DeviceSize offset = sizeof(GPUPhysicsData) * i;
+    if (!uploadRegions.empty() && uploadRegions.back().srcOffset + uploadRegions.back().size == offset) {
+      uploadRegions.back().size += sizeof(GPUPhysicsData);
+    } else {
+      uploadRegions.push_back(vk::BufferCopy{.srcOffset = offset, .dstOffset = offset, .size = sizeof(GPUPhysicsData)});
     }
   }
-
-  // Reset counters using persistent mapped memory
-  uint32_t initialCounters[2] = {0, 0}; // [0] = pair count, [1] = collision count
-  memcpy(vulkanResources.persistentCounterMemory, initialCounters, sizeof(initialCounters));
+  fullUploadRequired = false;
+  if (!slot.active.empty()) {
+    memcpy(slot.activeMapped, slot.active.data(), sizeof(uint32_t) * slot.active.size());
+  }
 
   // Update params buffer
   PhysicsParams params{};
-  params.deltaTime = deltaTime.count() * 0.001f; // Use actual deltaTime instead of fixed timestep
-  params.numBodies = static_cast<uint32_t>(std::min(rigidBodies.size(), static_cast<size_t>(maxGPUObjects)));
+  params.deltaTime = std::chrono::duration<float>(deltaTime).count(); // One fixed step; substeps repeat it
+  params.numBodies = count;
   params.maxCollisions = maxGPUCollisions;
-  params.padding = 0.0f; // Initialize padding to zero for proper std140 alignment
+  params.numActive = static_cast<uint32_t>(slot.active.size());
   params.gravity = glm::vec4(gravity, 0.0f); // Pack gravity into vec4 with padding
+  memcpy(slot.paramsMapped, &params, sizeof(PhysicsParams));
 
-  // Update params buffer using persistent mapped memory
-  memcpy(vulkanResources.persistentParamsMemory, &params, sizeof(PhysicsParams));
-
-  // CRITICAL FIX: Explicit memory flush to ensure HOST_COHERENT memory is fully visible to GPU
-  // Even with HOST_COHERENT flag, some systems may have cache coherency issues with partial writes
+  // Explicit flush so the writes are visible to the GPU even where HOST_COHERENT is not honored for partial writes
   // Use VK_WHOLE_SIZE to avoid nonCoherentAtomSize alignment validation errors
   try {
     const vk::raii::Device& device = renderer->GetRaiiDevice();
-    // Flush params buffer
     vk::MappedMemoryRange flushRangeParams;
-    flushRangeParams.memory = *vulkanResources.paramsBufferMemory;
+    flushRangeParams.memory = *slot.paramsBufferMemory;
     flushRangeParams.offset = 0;
     flushRangeParams.size = VK_WHOLE_SIZE;
-    device.flushMappedMemoryRanges(flushRangeParams);
-    // Flush physics buffer (object data)
-    vk::MappedMemoryRange flushRangePhysics;
-    flushRangePhysics.memory = *vulkanResources.physicsBufferMemory;
-    flushRangePhysics.offset = 0;
-    flushRangePhysics.size = VK_WHOLE_SIZE;
-    device.flushMappedMemoryRanges(flushRangePhysics);
-    // Flush counter buffer (pair and collision counters)
-    vk::MappedMemoryRange flushRangeCounter;
-    flushRangeCounter.memory = *vulkanResources.counterBufferMemory;
-    flushRangeCounter.offset = 0;
-    flushRangeCounter.size = VK_WHOLE_SIZE;
-    device.flushMappedMemoryRanges(flushRangeCounter);
+    vk::MappedMemoryRange flushRangeUpload;
+    flushRangeUpload.memory = *slot.uploadBufferMemory;
+    flushRangeUpload.offset = 0;
+    flushRangeUpload.size = VK_WHOLE_SIZE;
+    vk::MappedMemoryRange flushRangeActive;
+    flushRangeActive.memory = *slot.activeBufferMemory;
+    flushRangeActive.offset = 0;
+    flushRangeActive.size = VK_WHOLE_SIZE;
+    device.flushMappedMemoryRanges({flushRangeParams, flushRangeUpload, flushRangeActive});
   } catch (const std::exception& e) {
     fprintf(stderr, "WARNING: Failed to flush mapped physics memory: %s", e.what());
   }
+
+  return count;
 }
 
-void PhysicsSystem::ReadbackGPUPhysicsData() const {
+void PhysicsSystem::ReadbackGPUPhysicsData(bool wait) {
   if (!renderer) {
     return;
   }
 
-  // Validate Vulkan resources and persistent memory pointers before using them
-  if (!*vulkanResources.physicsBuffer || !*vulkanResources.physicsBufferMemory ||
-    !vulkanResources.persistentPhysicsMemory) {
-    return;
+  const vk::raii::Device& device = renderer->GetRaiiDevice();
+  while (true) {
+    // Collect the oldest outstanding step first so newer results always win
+    StepSlot* slot = nullptr;
+    for (auto& candidate : stepSlots) {
+      if (candidate.submitted && (!slot || candidate.step < slot->step)) {
+        slot = &candidate;
+      }
+    }
+    if (!slot) {
+      return;
+    }
+
+    // Poll the fence; block only when the caller needs this slot back
+    vk::Result result = device.waitForFences(*slot->fence, VK_TRUE, wait ? UINT64_MAX : 0);
+    if (result != vk::Result::eSuccess) {
+      return;
+    }
+    wait = false;
+    slot->submitted = false;
+
+    // Ensure GPU writes to HOST_VISIBLE memory are visible to the host before reading
+    try {
+      vk::MappedMemoryRange invalidateRange;
+      invalidateRange.memory = *slot->readbackBufferMemory;
+      invalidateRange.offset = 0;
+      invalidateRange.size = VK_WHOLE_SIZE;
+      vk::MappedMemoryRange invalidateContacts;
+      invalidateContacts.memory = *slot->contactBufferMemory;
+      invalidateContacts.offset = 0;
+      invalidateContacts.size = VK_WHOLE_SIZE;
+      device.invalidateMappedMemoryRanges({invalidateRange, invalidateContacts});
+    } catch (const std::exception&) {
+      // On HOST_COHERENT heaps this may not be required; ignore errors
+    }
+
+    // Apply the results of the bodies the step integrated and write their transforms for the game thread
+    // into the back buffer; sleeping bodies keep the transforms they already have
+    PublishedState& state = handoffBuffers[handoffBack];
+    state.step = slot->step;
+    state.time = slot->time;
+    state.bodies.assign(slot->bodies.size(), PublishedState::Body{});
+
+    const auto* gpuData = static_cast<const GPUPhysicsData *>(slot->readbackMapped);
+    for (const uint32_t i : slot->active) {
+      const auto concreteRigidBody = dynamic_cast<ConcreteRigidBody *>(slot->bodies[i]);
+      if (!concreteRigidBody || !concreteRigidBody->ApplySimulatedState(slot->step, gpuData[i], slot->duration)) {
+        continue;
+      }
+
+      state.bodies[i].entity = concreteRigidBody->GetEntity();
+      state.bodies[i].position = glm::vec3(gpuData[i].position);
+      state.bodies[i].rotation = glm::quat(gpuData[i].rotation.w, gpuData[i].rotation.x, gpuData[i].rotation.y, gpuData[i].rotation.z);
+    }
+    UpdateIslands(*slot);
+    slot->bodies.clear();
+    slot->active.clear();
+
+    // Publish: the back buffer becomes the fresh middle buffer and the old middle one is reused
+    handoffBack = handoffMiddle.exchange(handoffBack | HANDOFF_FRESH, std::memory_order_acq_rel) & ~HANDOFF_FRESH;
+
+    stats.collectedSteps++;
+    stats.latencySteps = static_cast<uint32_t>(nextStep - 1 - slot->step);
+    const auto collectTime = std::chrono::steady_clock::now();
+    stats.latencyMs = std::chrono::duration<double, std::milli>(collectTime - slot->submitTime).count();
+    // Submit-to-apply span of the step, on the physics thread's profiler track
+    if (Profiler::IsEnabled()) {
+      const auto toProfilerClock = [](std::chrono::steady_clock::time_point t) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+      };
+      Profiler::GetInstance().RecordScope("Physics step latency", toProfilerClock(slot->submitTime), toProfilerClock(collectTime));
+    }
   }
+}
 
-  // Wait for a dedicated compute fence to ensure GPU compute operations are complete before reading back data
-  const vk::raii::Device& device = renderer->GetRaiiDevice();
-  vk::Result result = device.waitForFences(*vulkanResources.computeFence, VK_TRUE, UINT64_MAX);
-  if (result != vk::Result::eSuccess) {
-    return;
+void PhysicsSystem::UpdateIslands(const StepSlot& slot) {
+  const auto count = static_cast<uint32_t>(slot.bodies.size());
+  std::vector<ConcreteRigidBody *> bodies(count, nullptr);
+  std::vector<ConcreteRigidBody::SleepState> states(count, ConcreteRigidBody::SleepState{.kinematic = true, .sleeping = false, .calmTime = 0.0f});
+  for (uint32_t i = 0; i < count; i++) {
+    bodies[i] = dynamic_cast<ConcreteRigidBody *>(slot.bodies[i]);
+    if (bodies[i]) {
+      states[i] = bodies[i]->GetSleepState();
+    }
   }
 
-  // Ensure GPU writes to HOST_VISIBLE memory are visible to the host before reading
-  try {
-    vk::MappedMemoryRange invalidateRangePhysics;
-    invalidateRangePhysics.memory = *vulkanResources.physicsBufferMemory;
-    invalidateRangePhysics.offset = 0;
-    invalidateRangePhysics.size = VK_WHOLE_SIZE;
-
-    vk::MappedMemoryRange invalidateRangeCounter;
-    invalidateRangeCounter.memory = *vulkanResources.counterBufferMemory;
-    invalidateRangeCounter.offset = 0;
-    invalidateRangeCounter.size = VK_WHOLE_SIZE;
-
-    device.invalidateMappedMemoryRanges({invalidateRangePhysics, invalidateRangeCounter});
-  } catch (const std::exception&) {
-    // On HOST_COHERENT heaps this may not be required; ignore errors
+  // Join bodies whose bounds overlapped in the last substep. Kinematic bodies do not link islands,
+  // otherwise everything resting on the same floor would be a single island.
+  std::vector<uint32_t> parent(count);
+  std::iota(parent.begin(), parent.end(), 0u);
+  auto find = [&parent](uint32_t i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  const auto* counters = static_cast<const uint32_t *>(slot.contactMapped);
+  const auto* pairs = reinterpret_cast<const uint32_t *>(static_cast<const char *>(slot.contactMapped) + CONTACT_PAIRS_OFFSET);
+  const uint32_t pairCount = std::min(counters[0], maxGPUCollisions);
+  for (uint32_t p = 0; p < pairCount; p++) {
+    const uint32_t a = pairs[2 * p];
+    const uint32_t b = pairs[2 * p + 1];
+    if (a >= count || b >= count || states[a].kinematic || states[b].kinematic) {
+      continue;
+    }
+    parent[find(a)] = find(b);
   }
 
-  // Optional debug: read and log pair/collision counters for a few frames
-  if (vulkanResources.persistentCounterMemory) {
-    static uint32_t lastPairCount = UINT32_MAX;
-    static uint32_t lastCollisionCount = UINT32_MAX;
-    const uint32_t* counters = static_cast<const uint32_t *>(vulkanResources.persistentCounterMemory);
-    uint32_t pairCount = counters[0];
-    uint32_t collisionCount = counters[1];
-    if (pairCount != lastPairCount || collisionCount != lastCollisionCount) {
-      // std::cout << "Physics GPU counters - pairs: " << pairCount << ", collisions: " << collisionCount << std::endl;
-      lastPairCount = pairCount;
-      lastCollisionCount = collisionCount;
+  // An island stays awake while any of its bodies has moved recently; that wakes the sleepers it touches.
+  // Otherwise the whole island goes to sleep together.
+  std::vector<uint8_t> restless(count, 0);
+  for (uint32_t i = 0; i < count; i++) {
+    if (!states[i].kinematic && !states[i].sleeping && states[i].calmTime < SLEEP_DELAY) {
+      restless[find(i)] = 1;
     }
   }
 
-  // Skip physics buffer operations if no rigid bodies exist
-  if (!rigidBodies.empty()) {
-    // Use persistent mapped memory for physics buffer readback
-    const auto* gpuData = static_cast<const GPUPhysicsData *>(vulkanResources.persistentPhysicsMemory);
-    const size_t count = std::min(rigidBodies.size(), static_cast<size_t>(maxGPUObjects));
-    for (size_t i = 0; i < count; i++) {
-      const auto concreteRigidBody = dynamic_cast<ConcreteRigidBody *>(rigidBodies[i].get());
-      if (!concreteRigidBody) {
-        continue;
+  stats.awakeBodies = 0;
+  stats.sleepingBodies = 0;
+  for (uint32_t i = 0; i < count; i++) {
+    if (states[i].kinematic) {
+      continue;
+    }
+    if (restless[find(i)]) {
+      if (states[i].sleeping) {
+        bodies[i]->Wake();
       }
-
-      // Skip kinematic bodies
-      if (concreteRigidBody->IsKinematic()) {
-        continue;
+      stats.awakeBodies++;
+    } else {
+      if (!states[i].sleeping) {
+        bodies[i]->PutToSleep();
       }
-
-      auto newPosition = glm::vec3(gpuData[i].position);
-      auto newVelocity = glm::vec3(gpuData[i].linearVelocity);
-
-      concreteRigidBody->SetPosition(newPosition);
-      concreteRigidBody->SetRotation(glm::quat(gpuData[i].rotation.w,
-                                               gpuData[i].rotation.x,
-                                               gpuData[i].rotation.y,
-                                               gpuData[i].rotation.z));
-      concreteRigidBody->SetLinearVelocity(newVelocity);
-      concreteRigidBody->SetAngularVelocity(glm::vec3(gpuData[i].angularVelocity));
+      stats.sleepingBodies++;
     }
   }
 }
 
-void PhysicsSystem::SimulatePhysicsOnGPU(const std::chrono::milliseconds deltaTime) const {
+void PhysicsSystem::ForgetInFlightBody(RigidBody* rigidBody) {
+  for (auto& slot : stepSlots) {
+    std::ranges::replace(slot.bodies, rigidBody, nullptr);
+  }
+}
+
+bool PhysicsSystem::SimulatePhysicsOnGPU(const std::chrono::nanoseconds deltaTime, const uint32_t substeps) {
   if (!renderer) {
     fprintf(stderr, "SimulatePhysicsOnGPU: No renderer available");
-    return;
+    return false;
   }
 
   // Validate Vulkan resources before using them
   if (!*vulkanResources.broadPhasePipeline || !*vulkanResources.narrowPhasePipeline ||
     !*vulkanResources.integratePipeline || !*vulkanResources.pipelineLayout ||
-    vulkanResources.descriptorSets.empty() || !*vulkanResources.physicsBuffer ||
-    !*vulkanResources.counterBuffer || !*vulkanResources.paramsBuffer) {
-    return;
+    !*vulkanResources.physicsBuffer || !*vulkanResources.counterBuffer) {
+    return false;
+  }
+
+  StepSlot& slot = stepSlots[nextSlot];
+  if (slot.submitted) {
+    // The GPU is more than a step behind. Leave the time in the accumulator so the next tick
+    // simulates it; only block if this keeps happening.
+    if (consecutiveDeferrals < MAX_DEFERRED_UPDATES) {
+      consecutiveDeferrals++;
+      stats.deferredSteps++;
+      return false;
+    }
+    stats.fenceWaits++;
+    ReadbackGPUPhysicsData(true);
   }
+  consecutiveDeferrals = 0;
 
   // Update physics data on the GPU
-  UpdateGPUPhysicsData(deltaTime);
+  slot.step = nextStep;
+  std::vector<vk::BufferCopy> uploadRegions;
+  const uint32_t bodyCount = UpdateGPUPhysicsData(slot, deltaTime, uploadRegions);
+  if (bodyCount == 0) {
+    return true;
+  }
+  const auto activeCount = static_cast<uint32_t>(slot.active.size());
+  slot.duration = std::chrono::duration<float>(deltaTime).count() * static_cast<float>(substeps);
+
+  stats.uploadedBodies = 0;
+  for (const auto& region : uploadRegions) {
+    stats.uploadedBodies += static_cast<uint32_t>(region.size / sizeof(GPUPhysicsData));
+  }
+
+  vk::raii::CommandBuffer& commandBuffer = slot.commandBuffer;
 
   // Reset the command buffer before beginning (required for reuse)
-  vulkanResources.commandBuffer.reset();
+  commandBuffer.reset();
 
   // Begin command buffer
   vk::CommandBufferBeginInfo beginInfo;
   beginInfo.flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit;
 
-  vulkanResources.commandBuffer.begin(beginInfo);
+  commandBuffer.begin(beginInfo);
 
-  vulkanResources.commandBuffer.bindDescriptorSets(
-    vk::PipelineBindPoint::eCompute,
-    *vulkanResources.pipelineLayout,
-    0,
-    **vulkanResources.descriptorSets.data(),
+  // The previous step (submitted earlier on the same queue) must be done with the shared buffers
+  // before its state is patched and the counters are cleared
+  vk::MemoryBarrier previousStepBarrier;
+  previousStepBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eTransferRead | vk::AccessFlagBits::eTransferWrite;
+  previousStepBarrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+
+  commandBuffer.pipelineBarrier(
+    vk::PipelineStageFlagBits::eComputeShader | vk::PipelineStageFlagBits::eTransfer,
+    vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader,
+    vk::DependencyFlags(),
+    previousStepBarrier,
+    nullptr,
     nullptr);
 
-  // Add a memory barrier to ensure all host-written buffer data (uniform + storage) is visible to compute shaders
-  // We use ShaderRead | ShaderWrite since compute will read and write storage buffers
-  vk::MemoryBarrier hostToDeviceBarrier;
-  hostToDeviceBarrier.srcAccessMask = vk::AccessFlagBits::eHostWrite;
-  hostToDeviceBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+  // Copy the bodies changed on the CPU into the resident state
+  if (!uploadRegions.empty()) {
+    commandBuffer.copyBuffer(*slot.uploadBuffer, *vulkanResources.physicsBuffer, uploadRegions);
+  }
 
-  vulkanResources.commandBuffer.pipelineBarrier(
-    vk::PipelineStageFlagBits::eHost,
+  // Make the copies and the host-written params visible to the compute shaders
+  vk::MemoryBarrier uploadBarrier;
+  uploadBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eHostWrite;
+  uploadBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite | vk::AccessFlagBits::eUniformRead;
+
+  commandBuffer.pipelineBarrier(
+    vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eHost,
     vk::PipelineStageFlagBits::eComputeShader,
     vk::DependencyFlags(),
-    hostToDeviceBarrier,
+    uploadBarrier,
     nullptr,
     nullptr);
 
-  // Step 1: Integrate forces and velocities
-  vulkanResources.commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.integratePipeline);
-  vulkanResources.commandBuffer.dispatch(static_cast<uint32_t>((rigidBodies.size() + 63) / 64), 1, 1);
+  commandBuffer.bindDescriptorSets(
+    vk::PipelineBindPoint::eCompute,
+    *vulkanResources.pipelineLayout,
+    0,
+    *slot.descriptorSet,
+    nullptr);
 
-  // Memory barrier to ensure integration is complete before collision detection
   vk::MemoryBarrier memoryBarrier;
   memoryBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
   memoryBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead;
 
-  vulkanResources.commandBuffer.pipelineBarrier(
-    vk::PipelineStageFlagBits::eComputeShader,
-    vk::PipelineStageFlagBits::eComputeShader,
-    vk::DependencyFlags(),
-    memoryBarrier,
-    nullptr,
-    nullptr);
-
-  // Step 2: Broad-phase collision detection
-  vulkanResources.commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.broadPhasePipeline);
-  uint32_t numPairs = static_cast<uint32_t>((rigidBodies.size() * (rigidBodies.size() - 1)) / 2);
-  // Dispatch number of workgroups matching [numthreads(64,1,1)] in BroadPhaseCS
-  // One workgroup has 64 threads, each processes one pair by index
-  uint32_t broadPhaseThreads = (numPairs + 63) / 64;
-  vulkanResources.commandBuffer.dispatch(std::max(1u, broadPhaseThreads), 1, 1);
+  // Each substep runs the full pipeline with the same fixed time step. When every body sleeps there
+  // is nothing to integrate and the step only carries the upload.
+  for (uint32_t substep = 0; activeCount > 0 && substep < substeps; ++substep) {
+    // Reset the pair and collision counters; the previous substep must be done with them and its
+    // results must be visible to this one
+    vk::MemoryBarrier counterResetBarrier;
+    counterResetBarrier.srcAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+    counterResetBarrier.dstAccessMask = vk::AccessFlagBits::eTransferWrite | vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eTransfer | vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      counterResetBarrier,
+      nullptr,
+      nullptr);
+    commandBuffer.fillBuffer(*vulkanResources.counterBuffer, 0, VK_WHOLE_SIZE, 0);
+
+    vk::MemoryBarrier counterReadyBarrier;
+    counterReadyBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+    counterReadyBarrier.dstAccessMask = vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      counterReadyBarrier,
+      nullptr,
+      nullptr);
+
+    // Step 1: Integrate forces and velocities
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.integratePipeline);
+    commandBuffer.dispatch((activeCount + 63) / 64, 1, 1);
+
+    // Memory barrier to ensure integration is complete before collision detection
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      memoryBarrier,
+      nullptr,
+      nullptr);
+
+    // Step 2: Broad-phase collision detection
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.broadPhasePipeline);
+    // Awake bodies are tested against all bodies; sleeping ones are never paired with each other.
+    // X covers the other body in groups of 64 ([numthreads(64,1,1)] in BroadPhaseCS), Y the awake body, so
+    // neither dimension exceeds the guaranteed workgroup count limit (see SetMaxGPUObjects).
+    commandBuffer.dispatch(std::max(1u, (bodyCount + 63) / 64), activeCount, 1);
+
+    // Memory barrier to ensure the broad phase is complete before the narrow phase
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      memoryBarrier,
+      nullptr,
+      nullptr);
+
+    // Step 3: Narrow-phase collision detection
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.narrowPhasePipeline);
+    // Dispatch enough threads to process all potential collision pairs found by broad-phase
+    // The shader will check counterBuffer[0] to determine the actual number of pairs to process
+    uint32_t narrowPhaseThreads = (maxGPUCollisions + 63) / 64;
+    commandBuffer.dispatch(narrowPhaseThreads, 1, 1);
+
+    // Memory barrier to ensure the narrow phase is complete before resolution
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::DependencyFlags(),
+      memoryBarrier,
+      nullptr,
+      nullptr);
+
+    // Step 4: Collision resolution
+    commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.resolvePipeline);
+    uint32_t resolveThreads = (maxGPUCollisions + 63) / 64;
+    commandBuffer.dispatch(resolveThreads, 1, 1);
+  }
 
-  // Memory barrier to ensure the broad phase is complete before the narrow phase
-  vulkanResources.commandBuffer.pipelineBarrier(
-    vk::PipelineStageFlagBits::eComputeShader,
-    vk::PipelineStageFlagBits::eComputeShader,
-    vk::DependencyFlags(),
-    memoryBarrier,
-    nullptr,
-    nullptr);
+  // Copy the results of the awake bodies and the contact pairs of the last substep into this slot's
+  // readback buffers; the host reads them once the fence has signaled
+  if (activeCount > 0) {
+    vk::MemoryBarrier resultBarrier;
+    resultBarrier.srcAccessMask = vk::AccessFlagBits::eShaderWrite;
+    resultBarrier.dstAccessMask = vk::AccessFlagBits::eTransferRead;
+
+    commandBuffer.pipelineBarrier(
+      vk::PipelineStageFlagBits::eComputeShader,
+      vk::PipelineStageFlagBits::eTransfer,
+      vk::DependencyFlags(),
+      resultBarrier,
+      nullptr,
+      nullptr);
+
+    std::vector<vk::BufferCopy> readbackRegions;
+    for (const uint32_t index : slot.active) {
+      const vk::DeviceSize offset = sizeof(GPUPhysicsData) * index;
+      if (!readbackRegions.empty() && readbackRegions.back().srcOffset + readbackRegions.back().size == offset) {
+        readbackRegions.back().size += sizeof(GPUPhysicsData);
+      } else {
+        readbackRegions.push_back(vk::BufferCopy{.srcOffset = offset, .dstOffset = offset, .size = sizeof(GPUPhysicsData)});
+      }
+    }
+    commandBuffer.copyBuffer(*vulkanResources.physicsBuffer, *slot.readbackBuffer, readbackRegions);
+    commandBuffer.copyBuffer(*vulkanResources.counterBuffer,
+                             *slot.contactBuffer,
+                             vk::BufferCopy{.srcOffset = 0, .dstOffset = 0, .size = sizeof(uint32_t) * 2});
+    commandBuffer.copyBuffer(*vulkanResources.pairBuffer,
+                             *slot.contactBuffer,
+                             vk::BufferCopy{.srcOffset = 0, .dstOffset = CONTACT_PAIRS_OFFSET, .size = sizeof(uint32_t) * 2 * maxGPUCollisions});
+  } else {
+    // No contacts were found; clear the pair count the island pass reads
+    commandBuffer.fillBuffer(*slot.contactBuffer, 0, sizeof(uint32_t) * 2, 0);
+  }
 
-  // Step 3: Narrow-phase collision detection
-  vulkanResources.commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.narrowPhasePipeline);
-  // Dispatch enough threads to process all potential collision pairs found by broad-phase
-  // The shader will check counterBuffer[0] to determine the actual number of pairs to process
-  uint32_t narrowPhaseThreads = (maxGPUCollisions + 63) / 64;
-  vulkanResources.commandBuffer.dispatch(narrowPhaseThreads, 1, 1);
+  vk::MemoryBarrier readbackBarrier;
+  readbackBarrier.srcAccessMask = vk::AccessFlagBits::eTransferWrite;
+  readbackBarrier.dstAccessMask = vk::AccessFlagBits::eHostRead;
 
-  // Memory barrier to ensure the narrow phase is complete before resolution
-  vulkanResources.commandBuffer.pipelineBarrier(
-    vk::PipelineStageFlagBits::eComputeShader,
-    vk::PipelineStageFlagBits::eComputeShader,
+  commandBuffer.pipelineBarrier(
+    vk::PipelineStageFlagBits::eTransfer,
+    vk::PipelineStageFlagBits::eHost,
     vk::DependencyFlags(),
-    memoryBarrier,
+    readbackBarrier,
     nullptr,
     nullptr);
 
-  // Step 4: Collision resolution
-  vulkanResources.commandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, *vulkanResources.resolvePipeline);
-  uint32_t resolveThreads = (maxGPUCollisions + 63) / 64;
-  vulkanResources.commandBuffer.dispatch(resolveThreads, 1, 1);
-
   // End command buffer
-  vulkanResources.commandBuffer.end();
+  commandBuffer.end();
 
   // Reset fence before submitting new work
   const vk::raii::Device& device = renderer->GetRaiiDevice();
-  device.resetFences(*vulkanResources.computeFence);
-
-  // Submit the command buffer with the dedicated fence for synchronization
-  vk::CommandBuffer cmdBuffer = *vulkanResources.commandBuffer;
-  renderer->SubmitToComputeQueue(cmdBuffer, *vulkanResources.computeFence);
-
-  // Read back physics data from the GPU (fence wait moved to ReadbackGPUPhysicsData)
-  ReadbackGPUPhysicsData();
+  device.resetFences(*slot.fence);
+
+  // Submit without waiting; the results are applied by a later update once the fence has signaled
+  renderer->SubmitToComputeQueue(*commandBuffer, *slot.fence);
+  simulationTime += std::chrono::duration<double>(deltaTime).count() * substeps;
+  slot.submitted = true;
+  slot.submitTime = std::chrono::steady_clock::now();
+  slot.time = simulationTime;
+  nextStep++;
+  nextSlot = (nextSlot + 1) % STEP_SLOTS;
+  stats.submittedSteps++;
+  return true;
 }
 
 void PhysicsSystem::CleanupMarkedBodies() {
@@ -1350,7 +2009,9 @@ void PhysicsSystem::CleanupMarkedBodies() {
   while (it != rigidBodies.end()) {
     auto concreteRigidBody = dynamic_cast<ConcreteRigidBody *>(it->get());
     if (concreteRigidBody && concreteRigidBody->markedForRemoval) {
+      ForgetInFlightBody(concreteRigidBody);
       it = rigidBodies.erase(it);
+      fullUploadRequired = true;
     } else {
       ++it;
     }
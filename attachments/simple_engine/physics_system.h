@@ -16,11 +16,17 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <memory>
 #include <mutex>
 #include <stdexcept>
+#include <thread>
 #include <vector>
 #include <vulkan/vulkan_raii.hpp>
 
@@ -162,7 +168,7 @@ struct GPUPhysicsData {
   glm::vec4 force; // xyz = force, w = is kinematic (0 or 1)
   glm::vec4 torque; // xyz = torque, w = use gravity (0 or 1)
   glm::vec4 colliderData; // type-specific data (e.g., radius for spheres)
-  glm::vec4 colliderData2; // additional collider data (e.g., box half extents)
+  glm::vec4 colliderData2; // xyz = collider offset, w = asleep (0 or 1)
 };
 
 /**
@@ -182,7 +188,7 @@ struct PhysicsParams {
   float deltaTime; // Time step - 4 bytes
   uint32_t numBodies; // Number of rigid bodies - 4 bytes
   uint32_t maxCollisions; // Maximum number of collisions - 4 bytes
-  float padding; // Explicit padding to align gravity to 16-byte boundary - 4 bytes
+  uint32_t numActive; // Number of awake dynamic bodies in the active list - 4 bytes
   glm::vec4 gravity; // Gravity vector (xyz) + padding (w) - 16 bytes
   // Total: 32 bytes (aligned to 16-byte boundaries for std140 layout)
 };
@@ -228,7 +234,9 @@ class PhysicsSystem {
     ~PhysicsSystem();
 
     /**
-	 * @brief Update the physics system.
+	 * @brief Update the physics system from the game thread.
+	 * Creates queued bodies and writes interpolated transforms of the simulated bodies to their entities.
+	 * The simulation itself runs at a fixed rate on the simulation thread, or here when that thread is disabled.
 	 * @param deltaTime The time elapsed since the last update.
 	 */
     void Update(std::chrono::milliseconds deltaTime);
@@ -298,10 +306,12 @@ class PhysicsSystem {
 
     /**
 	 * @brief Set the maximum number of objects that can be simulated on the GPU.
+	 * The broad phase dispatches one workgroup row per awake body, so this is capped at the
+	 * minimum maxComputeWorkGroupCount guaranteed by Vulkan (65535).
 	 * @param maxObjects The maximum number of objects.
 	 */
     void SetMaxGPUObjects(uint32_t maxObjects) {
-      maxGPUObjects = maxObjects;
+      maxGPUObjects = std::min(maxObjects, 65535u);
     }
 
     /**
@@ -320,6 +330,73 @@ class PhysicsSystem {
       cameraPosition = _cameraPosition;
     }
 
+    /**
+	 * @brief Run the fixed-step simulation on its own thread, or inline from Update when disabled.
+	 * @param enabled Whether the simulation thread should run.
+	 */
+    void SetSimulationThreadEnabled(bool enabled);
+
+    /**
+	 * @brief Check whether the simulation runs on its own thread.
+	 * @return True if the simulation thread is running.
+	 */
+    [[nodiscard]] bool IsSimulationThreadEnabled() const {
+      return simulationThread.joinable();
+    }
+
+    /**
+	 * @brief Statistics of the fixed-step GPU simulation.
+	 */
+    struct Stats {
+      uint64_t fixedSteps = 0; // fixed steps simulated
+      uint64_t droppedSteps = 0; // fixed steps skipped because the simulation fell too far behind
+      uint32_t substeps = 0; // fixed steps recorded by the last submission
+      double stepMs = 0.0; // simulation-thread CPU time of the last tick
+      uint64_t submittedSteps = 0;
+      uint64_t collectedSteps = 0;
+      uint32_t latencySteps = 0; // steps submitted after the one whose results were applied last
+      double latencyMs = 0.0; // submit-to-apply time of the last collected step
+      double cpuMs = 0.0; // game-thread time of the last Update
+      uint32_t uploadedBodies = 0; // bodies copied to the GPU by the last step
+      uint64_t deferredSteps = 0; // ticks that skipped a submit because both slots were busy
+      uint64_t fenceWaits = 0; // ticks that had to block on the physics fence
+      uint32_t awakeBodies = 0; // dynamic bodies awake after the last collected step
+      uint32_t sleepingBodies = 0;
+    };
+
+    /**
+	 * @brief Result of the sleeping-bodies scenario.
+	 */
+    struct SleepBenchmarkResult {
+      bool running = false;
+      uint32_t bodies = 0;
+      double awakeStepMs = 0.0; // average tick time while the bodies were still moving
+      double awakeLatencyMs = 0.0; // average submit-to-collect time while moving
+      double sleepingStepMs = 0.0; // average tick time once they had settled
+      double sleepingLatencyMs = 0.0;
+      uint32_t sleepingBodies = 0; // scenario bodies asleep when the settled phase was measured
+      double settleSeconds = 0.0; // simulated time until the settled phase started
+    };
+
+    /**
+	 * @brief Drop bodyCount spheres onto a hidden floor far from the scene, time the steps while they move
+	 * and again once they have settled and gone to sleep, then remove them.
+	 * @param bodyCount Number of spheres; limited by the free GPU body capacity.
+	 */
+    void StartSleepBenchmark(uint32_t bodyCount);
+
+    /**
+	 * @brief Get the state or result of the sleeping-bodies scenario.
+	 * @return The result.
+	 */
+    [[nodiscard]] SleepBenchmarkResult GetSleepBenchmarkResult() const;
+
+    /**
+	 * @brief Get statistics of the GPU simulation pipeline.
+	 * @return The statistics.
+	 */
+    [[nodiscard]] Stats GetStats() const;
+
     // Thread-safe enqueue for rigid body creation from any thread
     void EnqueueRigidBodyCreation(Entity* entity,
                                   CollisionShape shape,
@@ -347,12 +424,14 @@ class PhysicsSystem {
 	 * @param buffer Reference to the buffer RAII object.
 	 * @param memory Reference to the memory RAII object.
 	 * @param errorPrefix Prefix for error messages.
+	 * @param properties Memory properties of the allocation.
 	 */
     void CreateMappedBuffer(vk::DeviceSize size,
                             vk::BufferUsageFlags usage,
                             vk::raii::Buffer& buffer,
                             vk::raii::DeviceMemory& memory,
-                            const std::string& errorPrefix);
+                            const std::string& errorPrefix,
+                            vk::MemoryPropertyFlags properties = vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
 
     // Pending rigid body creations queued from background threads
     struct PendingCreation {
@@ -378,7 +457,7 @@ class PhysicsSystem {
 
     // GPU acceleration
     bool gpuAccelerationEnabled = false;
-    uint32_t maxGPUObjects = 1024;
+    uint32_t maxGPUObjects = 4096;
     uint32_t maxGPUCollisions = 4096;
     Renderer* renderer = nullptr;
 
@@ -401,11 +480,11 @@ class PhysicsSystem {
       vk::raii::Pipeline narrowPhasePipeline = nullptr;
       vk::raii::Pipeline resolvePipeline = nullptr;
 
-      // Descriptor pool and sets
+      // Descriptor pool; the sets belong to the step slots
       vk::raii::DescriptorPool descriptorPool = nullptr;
-      std::vector<vk::raii::DescriptorSet> descriptorSets;
 
-      // Buffers for physics data
+      // Buffers for physics data. The body state stays resident on the GPU between steps;
+      // collision, pair and counter buffers are per-step scratch.
       vk::raii::Buffer physicsBuffer = nullptr;
       vk::raii::DeviceMemory physicsBufferMemory = nullptr;
       vk::raii::Buffer collisionBuffer = nullptr;
@@ -414,34 +493,150 @@ class PhysicsSystem {
       vk::raii::DeviceMemory pairBufferMemory = nullptr;
       vk::raii::Buffer counterBuffer = nullptr;
       vk::raii::DeviceMemory counterBufferMemory = nullptr;
+
+      // Command pool for compute operations
+      vk::raii::CommandPool commandPool = nullptr;
+    };
+
+    // Everything one in-flight step owns. Two slots alternate, so step N can be recorded and
+    // submitted while step N-1 is still running and its results are read on a later update.
+    struct StepSlot {
+      // Parameters of this step
       vk::raii::Buffer paramsBuffer = nullptr;
       vk::raii::DeviceMemory paramsBufferMemory = nullptr;
+      void* paramsMapped = nullptr;
 
-      // Persistent mapped memory pointers for improved performance
-      void* persistentPhysicsMemory = nullptr;
-      void* persistentCounterMemory = nullptr;
-      void* persistentParamsMemory = nullptr;
+      // Changed bodies written by the CPU, copied into the resident state at the start of the step
+      vk::raii::Buffer uploadBuffer = nullptr;
+      vk::raii::DeviceMemory uploadBufferMemory = nullptr;
+      void* uploadMapped = nullptr;
 
-      // Command buffer for compute operations
-      vk::raii::CommandPool commandPool = nullptr;
-      vk::raii::CommandBuffer commandBuffer = nullptr;
+      // Copy of the resident state taken at the end of the step
+      vk::raii::Buffer readbackBuffer = nullptr;
+      vk::raii::DeviceMemory readbackBufferMemory = nullptr;
+      void* readbackMapped = nullptr;
+
+      // Indices of the awake dynamic bodies of this step
+      vk::raii::Buffer activeBuffer = nullptr;
+      vk::raii::DeviceMemory activeBufferMemory = nullptr;
+      void* activeMapped = nullptr;
 
-      // Dedicated fence for compute synchronization
-      vk::raii::Fence computeFence = nullptr;
+      // Pair counter and broad-phase pairs of the last substep; the contact graph for the islands
+      vk::raii::Buffer contactBuffer = nullptr;
+      vk::raii::DeviceMemory contactBufferMemory = nullptr;
+      void* contactMapped = nullptr;
+
+      vk::raii::DescriptorSet descriptorSet = nullptr;
+      vk::raii::CommandBuffer commandBuffer = nullptr;
+      vk::raii::Fence fence = nullptr;
+
+      bool submitted = false; // results not collected yet
+      uint64_t step = 0;
+      double time = 0.0; // simulated seconds at the end of the step
+      float duration = 0.0f; // simulated seconds covered by the step
+      std::vector<RigidBody*> bodies; // body at each GPU index when the step was submitted
+      std::vector<uint32_t> active; // GPU indices integrated by the step; only these are read back
+      std::chrono::steady_clock::time_point submitTime;
     };
+    static constexpr uint32_t STEP_SLOTS = 2;
+    // Consecutive ticks allowed to skip a submit before waiting on the oldest step
+    static constexpr uint32_t MAX_DEFERRED_UPDATES = 4;
+    // Offset of the pairs in a slot's contact buffer; the pair and collision counters come first
+    static constexpr vk::DeviceSize CONTACT_PAIRS_OFFSET = 16;
 
     VulkanResources vulkanResources;
+    std::array<StepSlot, STEP_SLOTS> stepSlots;
+    uint32_t nextSlot = 0;
+    uint64_t nextStep = 1;
+    bool fullUploadRequired = true; // GPU indices changed; upload every body on the next step
+    uint32_t consecutiveDeferrals = 0;
+
+    // Fixed-step clock. Frame time (or wall time on the simulation thread) accumulates and is consumed in
+    // whole steps; up to MAX_SUBSTEPS are recorded into one submission and anything beyond that is dropped.
+    static constexpr std::chrono::nanoseconds FIXED_TIME_STEP{1'000'000'000 / 120};
+    static constexpr uint32_t MAX_SUBSTEPS = 4;
+    std::chrono::nanoseconds stepAccumulator{0};
+    double simulationTime = 0.0; // simulated seconds submitted so far
+
+    // Body transforms of one collected step, handed from the simulation thread to the game thread
+    struct PublishedState {
+      struct Body {
+        Entity* entity = nullptr;
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::quat rotation = glm::quat(1.0f, 0.0f, 0.0f, 0.0f);
+      };
+      uint64_t step = 0;
+      double time = 0.0; // simulated seconds at the end of the step
+      std::vector<Body> bodies;
+    };
+
+    // Lock-free handoff of the latest state. The writer fills its back buffer and swaps it with the middle one;
+    // the reader swaps its front buffer with the middle one when the fresh bit is set. Neither side ever waits.
+    static constexpr uint32_t HANDOFF_FRESH = 4;
+    std::array<PublishedState, 3> handoffBuffers;
+    std::atomic<uint32_t> handoffMiddle{1};
+    uint32_t handoffBack = 0; // simulation side
+    uint32_t handoffFront = 2; // game side
+
+    // The two latest states seen by the game thread; rendered transforms are interpolated between them
+    PublishedState previousState;
+    PublishedState currentState;
+    std::chrono::steady_clock::time_point currentStateArrival;
+
+    // Simulation thread
+    std::thread simulationThread;
+    std::atomic<bool> simulationRunning{false};
+    std::mutex simulationWakeMutex;
+    std::condition_variable simulationWake;
+
+    // Statistics are written by the simulating thread and copied out under statsMutex
+    Stats stats;
+    Stats publishedStats;
+    double updateMs = 0.0;
+    mutable std::mutex statsMutex;
 
     // Initialize Vulkan resources for physics simulation
     bool InitializeVulkanResources();
     void CleanupVulkanResources();
 
-    // Update physics data on the GPU
-    void UpdateGPUPhysicsData(std::chrono::milliseconds deltaTime) const;
+    // Write changed bodies into a slot's upload buffer, the active list and the parameters; returns the body count
+    uint32_t UpdateGPUPhysicsData(StepSlot& slot, std::chrono::nanoseconds deltaTime, std::vector<vk::BufferCopy>& uploadRegions);
+
+    // Build islands from the contacts of a collected step; put calm islands to sleep and wake islands
+    // that a moving body ran into
+    void UpdateIslands(const StepSlot& slot);
+
+    // Sleeping-bodies scenario, advanced by the simulating thread after every tick
+    struct SleepBenchmark {
+      enum class Phase { Idle, Starting, Moving, Settling, Settled };
+      Phase phase = Phase::Idle;
+      uint32_t requestedBodies = 0;
+      std::vector<RigidBody*> bodies;
+      double startTime = 0.0;
+      double stepMsSum = 0.0;
+      double latencyMsSum = 0.0;
+      uint32_t samples = 0;
+      SleepBenchmarkResult result;
+    };
+    SleepBenchmark sleepBenchmark;
+    mutable std::mutex sleepBenchmarkMutex;
+    void AdvanceSleepBenchmark();
+
+    // Apply the results of completed steps, oldest first; waits only when wait is true
+    void ReadbackGPUPhysicsData(bool wait);
+
+    // Drop a body that is about to be destroyed from the snapshots of in-flight steps
+    void ForgetInFlightBody(RigidBody* rigidBody);
+
+    // Record and submit substeps fixed steps of GPU-accelerated physics; false if no step slot was free
+    bool SimulatePhysicsOnGPU(std::chrono::nanoseconds deltaTime, uint32_t substeps);
+
+    // Advance the fixed-step clock by elapsed time and run the steps that are due
+    void AdvanceSimulation(std::chrono::nanoseconds elapsed);
 
-    // Read back physics data from the GPU
-    void ReadbackGPUPhysicsData() const;
+    // Body of the simulation thread
+    void SimulationThreadMain();
 
-    // Perform GPU-accelerated physics simulation
-    void SimulatePhysicsOnGPU(std::chrono::milliseconds deltaTime) const;
+    // Write interpolated transforms of the latest published states to the entities (game thread)
+    void ApplyInterpolatedTransforms();
 };
\ No newline at end of file
@@ -344,12 +344,12 @@ bool Pipeline::createPBRPipeline() {
     // Define vertex and instance attribute descriptions
     auto vertexAttrArray = Vertex::getAttributeDescriptions();
     auto instanceAttrArray = InstanceData::getAttributeDescriptions();
-    std::array<vk::VertexInputAttributeDescription, 11> attributeDescriptions{};
+    std::array<vk::VertexInputAttributeDescription, 8> attributeDescriptions{};
     // Copy vertex attributes (0..3)
     for (size_t i = 0; i < vertexAttrArray.size(); ++i) {
       attributeDescriptions[i] = vertexAttrArray[i];
     }
-    // Copy instance attributes (4..10)
+    // Copy instance attributes (4..7)
     for (size_t i = 0; i < instanceAttrArray.size(); ++i) {
       attributeDescriptions[vertexAttrArray.size() + i] = instanceAttrArray[i];
     }
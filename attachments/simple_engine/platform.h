@@ -147,6 +147,82 @@ class Platform {
 	 * @param title The new window title.
 	 */
     virtual void SetWindowTitle(const std::string& title) = 0;
+
+    /**
+	 * @brief Check whether the platform has no window to present to.
+	 * @return True if rendering goes to offscreen images only.
+	 */
+    virtual bool IsHeadless() const {
+      return false;
+    }
+};
+
+/**
+ * @brief Windowless implementation of the Platform interface.
+ *
+ * Used for automated runs (e.g. performance regression tests on a software Vulkan
+ * implementation such as lavapipe). There is no surface; the renderer draws into
+ * offscreen images of the requested size instead of a swapchain.
+ */
+class HeadlessPlatform final : public Platform {
+  private:
+    int width = 0;
+    int height = 0;
+
+  public:
+    /**
+	 * @brief Default constructor.
+	 */
+    HeadlessPlatform() = default;
+
+    bool Initialize(const std::string& appName, int width, int height) override {
+      this->width = width;
+      this->height = height;
+      return width > 0 && height > 0;
+    }
+
+    void Cleanup() override {
+    }
+
+    bool ProcessEvents() override {
+      return true;
+    }
+
+    bool HasWindowResized() override {
+      return false;
+    }
+
+    int GetWindowWidth() const override {
+      return width;
+    }
+
+    int GetWindowHeight() const override {
+      return height;
+    }
+
+    bool CreateVulkanSurface(VkInstance instance, VkSurfaceKHR* surface) override {
+      return false;
+    }
+
+    // No input or window events are ever delivered
+    void SetResizeCallback(std::function<void(int, int)> callback) override {
+    }
+
+    void SetMouseCallback(std::function<void(float, float, uint32_t)> callback) override {
+    }
+
+    void SetKeyboardCallback(std::function<void(uint32_t, bool)> callback) override {
+    }
+
+    void SetCharCallback(std::function<void(uint32_t)> callback) override {
+    }
+
+    void SetWindowTitle(const std::string& title) override {
+    }
+
+    bool IsHeadless() const override {
+      return true;
+    }
 };
 
 #if defined(PLATFORM_ANDROID)
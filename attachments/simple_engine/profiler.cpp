@@ -0,0 +1,326 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "profiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+namespace
+{
+thread_local void *threadRing = nullptr;
+
+void WriteJsonString(std::ofstream &out, const char *text)
+{
+	out << '"';
+	for (const char *c = text ? text : "?"; *c; ++c)
+	{
+		if (*c == '"' || *c == '\\')
+		{
+			out << '\\';
+		}
+		if (static_cast<unsigned char>(*c) >= 0x20)
+		{
+			out << *c;
+		}
+	}
+	out << '"';
+}
+}        // namespace
+
+Profiler &Profiler::GetInstance()
+{
+	static Profiler instance;
+	return instance;
+}
+
+void Profiler::SetEnabled(bool enable)
+{
+	enabled.store(enable, std::memory_order_relaxed);
+}
+
+Profiler::ThreadRing &Profiler::GetThreadRing()
+{
+	if (!threadRing)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		auto                        ring = std::make_unique<ThreadRing>();
+		ring->threadId                   = static_cast<uint32_t>(rings.size());
+		threadRing                       = ring.get();
+		rings.push_back(std::move(ring));
+	}
+	return *static_cast<ThreadRing *>(threadRing);
+}
+
+void Profiler::RecordScope(const char *name, uint64_t beginNs, uint64_t endNs)
+{
+	ThreadRing    &ring  = GetThreadRing();
+	const uint64_t index = ring.head.load(std::memory_order_relaxed);
+	Event         &slot  = ring.events[index % ThreadRing::Capacity];
+
+	// Claim the slot before overwriting it, so a reader that sees any of the new values also
+	// sees that the slot was reused (see EndFrame), then publish the finished entry
+	ring.claimed.store(index + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	slot.name.store(name, std::memory_order_relaxed);
+	slot.begin.store(beginNs, std::memory_order_relaxed);
+	slot.end.store(endNs, std::memory_order_relaxed);
+	ring.head.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::RecordGpuPass(const char *name, uint64_t beginNs, uint64_t endNs)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	gpuPending.push_back({name, beginNs, endNs, GpuThreadId});
+}
+
+void Profiler::SetThreadName(const char *name)
+{
+	ThreadRing                 &ring = GetThreadRing();
+	std::lock_guard<std::mutex> lock(mutex);
+	ring.name = name;
+}
+
+void Profiler::Accumulate(const CapturedEvent &event, bool gpu)
+{
+	auto it = std::find_if(accumulators.begin(), accumulators.end(), [&](const Accumulator &a) {
+		return a.gpu == gpu && a.name == event.name;
+	});
+	if (it == accumulators.end())
+	{
+		// Equal names from different translation units may not share a pointer
+		it = std::find_if(accumulators.begin(), accumulators.end(), [&](const Accumulator &a) {
+			return a.gpu == gpu && std::strcmp(a.name, event.name) == 0;
+		});
+	}
+	if (it == accumulators.end())
+	{
+		accumulators.push_back({event.name, gpu});
+		it = accumulators.end() - 1;
+	}
+
+	const uint64_t duration = event.end > event.begin ? event.end - event.begin : 0;
+	it->calls++;
+	it->totalNs += duration;
+	it->maxNs = std::max(it->maxNs, duration);
+}
+
+void Profiler::PublishWindow(uint64_t now)
+{
+	const double frames = static_cast<double>(windowFrames);
+	frameMs             = static_cast<double>(now - windowStart) / 1e6 / frames;
+
+	frameStats.clear();
+	for (const auto &a : accumulators)
+	{
+		frameStats.push_back({a.name, a.gpu, static_cast<float>(a.calls / frames), static_cast<double>(a.totalNs) / 1e6 / frames, static_cast<double>(a.maxNs) / 1e6});
+	}
+	std::sort(frameStats.begin(), frameStats.end(), [](const ScopeStats &a, const ScopeStats &b) {
+		return a.gpu != b.gpu ? !a.gpu : a.totalMs > b.totalMs;
+	});
+
+	accumulators.clear();
+	windowFrames = 0;
+	windowStart  = now;
+}
+
+void Profiler::EndFrame()
+{
+	const uint64_t              now = Now();
+	std::lock_guard<std::mutex> lock(mutex);
+
+	const bool collect = IsEnabled() || capture.capturing;
+	for (auto &ring : rings)
+	{
+		const uint64_t head = ring->head.load(std::memory_order_acquire);
+		uint64_t       tail = ring->tail;
+		ring->tail          = head;
+		if (!collect)
+		{
+			continue;
+		}
+		if (head - tail > ThreadRing::Capacity)
+		{
+			dropped += head - tail - ThreadRing::Capacity;
+			tail = head - ThreadRing::Capacity;
+		}
+
+		const size_t first = captureEvents.size();
+		for (uint64_t i = tail; i < head; ++i)
+		{
+			const Event &slot = ring->events[i % ThreadRing::Capacity];
+			captureEvents.push_back({slot.name.load(std::memory_order_relaxed), slot.begin.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed), ring->threadId});
+		}
+
+		// The owner may have lapped the oldest entries while they were copied. It claims a
+		// slot before writing it, so every slot it may have touched is below the claim seen now.
+		std::atomic_thread_fence(std::memory_order_acquire);
+		const uint64_t claimed = ring->claimed.load(std::memory_order_relaxed);
+		size_t         valid   = first;
+		if (claimed > tail + ThreadRing::Capacity)
+		{
+			const uint64_t lapped = std::min(claimed - ThreadRing::Capacity - tail, head - tail);
+			dropped += lapped;
+			valid += static_cast<size_t>(lapped);
+		}
+		captureEvents.erase(captureEvents.begin() + static_cast<std::ptrdiff_t>(first), captureEvents.begin() + static_cast<std::ptrdiff_t>(valid));
+		for (size_t i = first; i < captureEvents.size(); ++i)
+		{
+			Accumulate(captureEvents[i], false);
+		}
+	}
+
+	if (!collect)
+	{
+		// Start a fresh window once profiling is enabled again
+		gpuPending.clear();
+		accumulators.clear();
+		windowFrames = 0;
+		windowStart  = 0;
+		return;
+	}
+
+	for (const auto &event : gpuPending)
+	{
+		Accumulate(event, true);
+	}
+	captureEvents.insert(captureEvents.end(), gpuPending.begin(), gpuPending.end());
+	gpuPending.clear();
+
+	if (windowStart == 0)
+	{
+		// The events of a partial first frame are not averaged
+		windowStart = now;
+		accumulators.clear();
+	}
+	else if (++windowFrames >= AverageFrames)
+	{
+		PublishWindow(now);
+	}
+
+	if (!capture.capturing)
+	{
+		// Events are only kept for export while a capture runs
+		captureEvents.clear();
+		return;
+	}
+
+	captureFrames.push_back(now);
+	capture.events = captureEvents.size();
+	if (--capture.framesLeft == 0)
+	{
+		capture.capturing = false;
+		capture.written   = WriteChromeTrace(capture.path);
+		captureEvents.clear();
+		captureFrames.clear();
+		enabled.store(enabledBeforeCapture, std::memory_order_relaxed);
+	}
+}
+
+std::vector<Profiler::ScopeStats> Profiler::GetFrameStats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return frameStats;
+}
+
+double Profiler::GetFrameMs() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return frameMs;
+}
+
+uint64_t Profiler::GetDroppedEvents() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return dropped;
+}
+
+bool Profiler::StartCapture(const std::string &path, uint32_t frames)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (capture.capturing || frames == 0)
+	{
+		return false;
+	}
+
+	capture              = CaptureStatus{.capturing = true, .framesLeft = frames, .path = path};
+	enabledBeforeCapture = IsEnabled();
+	enabled.store(true, std::memory_order_relaxed);
+
+	// Start from an empty capture; events already in the rings belong to the frame before it
+	captureEvents.clear();
+	captureFrames.assign(1, Now());
+	return true;
+}
+
+Profiler::CaptureStatus Profiler::GetCaptureStatus() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return capture;
+}
+
+bool Profiler::WriteChromeTrace(const std::string &path) const
+{
+	std::ofstream out(path, std::ios::out | std::ios::trunc);
+	if (!out.is_open())
+	{
+		return false;
+	}
+
+	// Timestamps are microseconds since the start of the capture
+	const uint64_t origin       = captureFrames.front();
+	const auto     microseconds = [origin](uint64_t ns) {
+        return (static_cast<double>(ns) - static_cast<double>(origin)) / 1000.0;
+	};
+
+	out << std::fixed << std::setprecision(3);
+	out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	out << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Simple Engine\"}}";
+
+	// Track names
+	for (const auto &ring : rings)
+	{
+		out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadId << ",\"args\":{\"name\":";
+		if (ring->name)
+		{
+			WriteJsonString(out, ring->name);
+		}
+		else
+		{
+			out << "\"Thread " << ring->threadId << '"';
+		}
+		out << "}}";
+	}
+	out << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << GpuThreadId << ",\"args\":{\"name\":\"GPU\"}}";
+
+	// Frame boundaries as global instant events
+	for (size_t i = 1; i < captureFrames.size(); ++i)
+	{
+		out << ",\n{\"name\":\"Frame " << i << "\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":" << microseconds(captureFrames[i]) << '}';
+	}
+
+	for (const auto &event : captureEvents)
+	{
+		out << ",\n{\"name\":";
+		WriteJsonString(out, event.name);
+		out << ",\"cat\":\"" << (event.threadId == GpuThreadId ? "gpu" : "cpu") << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.threadId
+		    << ",\"ts\":" << microseconds(event.begin) << ",\"dur\":" << static_cast<double>(event.end > event.begin ? event.end - event.begin : 0) / 1000.0 << '}';
+	}
+	out << "\n]}\n";
+	return out.good();
+}
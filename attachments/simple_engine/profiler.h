@@ -0,0 +1,240 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Engine-wide frame profiler for CPU scopes and GPU passes.
+ *
+ * CPU scopes are recorded with PROFILE_SCOPE("Name"). The name is used as a
+ * static ID: it must be a string literal (or other string with static storage
+ * duration) because only its pointer is stored. Every thread writes complete
+ * scope events into its own ring buffer without taking a lock. EndFrame(),
+ * called once per frame by the main loop, drains the rings, aggregates the
+ * events by name for the overlay and, while a capture runs, keeps them for
+ * export as Chrome trace JSON (chrome://tracing or ui.perfetto.dev).
+ *
+ * GPU passes are reported by the renderer from its timestamp queries once the
+ * frame that wrote them has finished, and appear on their own "GPU" track.
+ *
+ * While the profiler is disabled a scope costs a relaxed load of one flag and
+ * a predictable branch.
+ */
+class Profiler
+{
+  public:
+	struct ScopeStats
+	{
+		const char *name    = nullptr;
+		bool        gpu     = false;
+		float       calls   = 0.0f;        // per frame
+		double      totalMs = 0.0;         // per frame
+		double      maxMs   = 0.0;         // longest single call
+	};
+
+	struct CaptureStatus
+	{
+		bool        capturing  = false;
+		uint32_t    framesLeft = 0;
+		size_t      events     = 0;        // events in the capture (or the last written one)
+		std::string path;
+		bool        written = false;        // the last capture was written successfully
+	};
+
+	/**
+	 * @brief Get the profiler shared by all systems.
+	 * @return The profiler.
+	 */
+	static Profiler &GetInstance();
+
+	static bool IsEnabled()
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	void SetEnabled(bool enable);
+
+	/**
+	 * @brief Current time on the profiler clock (steady clock, nanoseconds).
+	 */
+	static uint64_t Now()
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+
+	/**
+	 * @brief Record a finished CPU scope on the calling thread. Lock-free.
+	 * @param name Static scope name.
+	 * @param beginNs Start on the profiler clock.
+	 * @param endNs End on the profiler clock.
+	 */
+	void RecordScope(const char *name, uint64_t beginNs, uint64_t endNs);
+
+	/**
+	 * @brief Record a GPU pass, already converted to the profiler clock.
+	 * @param name Static pass name.
+	 * @param beginNs Start on the profiler clock.
+	 * @param endNs End on the profiler clock.
+	 */
+	void RecordGpuPass(const char *name, uint64_t beginNs, uint64_t endNs);
+
+	/**
+	 * @brief Name the calling thread's track in exported traces.
+	 * @param name Static thread name.
+	 */
+	void SetThreadName(const char *name);
+
+	/**
+	 * @brief Collect the events of all threads. Call once per frame from the main loop.
+	 */
+	void EndFrame();
+
+	/**
+	 * @brief Get the per-frame averages of the last aggregation window, CPU scopes first,
+	 * each group ordered by total time.
+	 * @return The scope statistics.
+	 */
+	std::vector<ScopeStats> GetFrameStats() const;
+
+	/**
+	 * @brief Average frame time of the last aggregation window.
+	 */
+	double GetFrameMs() const;
+
+	/**
+	 * @brief Events lost because a thread's ring filled up before EndFrame drained it.
+	 */
+	uint64_t GetDroppedEvents() const;
+
+	/**
+	 * @brief Record the next frames and write them as Chrome trace JSON.
+	 * The profiler is enabled for the duration of the capture.
+	 * @param path Output file.
+	 * @param frames Number of frames to capture.
+	 * @return False if a capture is already running.
+	 */
+	bool StartCapture(const std::string &path, uint32_t frames);
+
+	CaptureStatus GetCaptureStatus() const;
+
+  private:
+	// Complete scope event. The fields are atomics so that EndFrame may read a slot
+	// the owner is overwriting; such entries are detected through ThreadRing::claimed
+	// and discarded.
+	struct Event
+	{
+		std::atomic<const char *> name{nullptr};
+		std::atomic<uint64_t>     begin{0};
+		std::atomic<uint64_t>     end{0};
+	};
+
+	struct ThreadRing
+	{
+		static constexpr uint32_t Capacity = 8192;
+
+		std::array<Event, Capacity> events;
+		std::atomic<uint64_t>       head{0};           // entries written; only the owning thread stores
+		std::atomic<uint64_t>       claimed{0};        // entries written or being written
+		uint64_t                    tail = 0;        // read position of EndFrame
+		uint32_t                    threadId = 0;
+		const char                 *name     = nullptr;
+	};
+
+	struct CapturedEvent
+	{
+		const char *name;
+		uint64_t    begin;
+		uint64_t    end;
+		uint32_t    threadId;
+	};
+
+	struct Accumulator
+	{
+		const char *name  = nullptr;
+		bool        gpu   = false;
+		uint32_t    calls = 0;
+		uint64_t    totalNs = 0;
+		uint64_t    maxNs   = 0;
+	};
+
+	static constexpr uint32_t AverageFrames = 30;
+	static constexpr uint32_t GpuThreadId   = 0xFFFFFFFFu;
+
+	static inline std::atomic<bool> enabled{false};
+
+	mutable std::mutex                       mutex;
+	std::vector<std::unique_ptr<ThreadRing>> rings;
+	std::vector<CapturedEvent>               gpuPending;
+
+	// Aggregation window
+	std::vector<Accumulator> accumulators;
+	uint32_t                 windowFrames = 0;
+	uint64_t                 windowStart  = 0;
+	std::vector<ScopeStats>  frameStats;
+	double                   frameMs = 0.0;
+	uint64_t                 dropped = 0;
+
+	// Capture
+	std::vector<CapturedEvent> captureEvents;
+	std::vector<uint64_t>      captureFrames;        // frame boundaries
+	CaptureStatus              capture;
+	bool                       enabledBeforeCapture = false;
+
+	ThreadRing &GetThreadRing();
+	void        Accumulate(const CapturedEvent &event, bool gpu);
+	void        PublishWindow(uint64_t now);
+	bool        WriteChromeTrace(const std::string &path) const;
+};
+
+/**
+ * @brief Records the enclosing scope when the profiler is enabled.
+ */
+class ProfileScope
+{
+  public:
+	explicit ProfileScope(const char *name) :
+	    name(name), begin(Profiler::IsEnabled() ? Profiler::Now() : 0)
+	{
+	}
+
+	~ProfileScope()
+	{
+		if (begin != 0)
+		{
+			Profiler::GetInstance().RecordScope(name, begin, Profiler::Now());
+		}
+	}
+
+	ProfileScope(const ProfileScope &)            = delete;
+	ProfileScope &operator=(const ProfileScope &) = delete;
+
+  private:
+	const char *name;
+	uint64_t    begin;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
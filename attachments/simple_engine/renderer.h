@@ -17,6 +17,7 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -28,6 +29,7 @@
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <span>
 #include <string>
 #include <thread>
 #include <unordered_map>
@@ -37,12 +39,22 @@
 #include <vulkan/vulkan_hpp_macros.hpp>
 #include <vulkan/vulkan_raii.hpp>
 
+#include "animation_system.h"
 #include "camera_component.h"
+#include "content_hash.h"
+#include "debug_system.h"
+#include "draw_sort.h"
 #include "entity.h"
+#include "frustum_cull.h"
+#include "light_clusterer.h"
 #include "memory_pool.h"
 #include "mesh_component.h"
+#include "meshlets.h"
 #include "model_loader.h"
+#include "occlusion_culler.h"
 #include "platform.h"
+#include "resource_manager.h"
+#include "spatial_index.h"
 #include "thread_pool.h"
 
 // Fallback defines for optional extension names (allow compiling against older headers)
@@ -515,6 +527,48 @@ class Renderer {
       return IsASBuildInProgress() && GetASBuildElapsedSeconds() >= 10.0;
     }
 
+    // Result of the last BLAS build (memory before/after compaction and build times)
+    struct BLASBuildStats {
+      uint32_t blasCount = 0; // BLAS built by the last update
+      uint32_t blasReused = 0; // BLAS kept from earlier updates
+      uint32_t blasRetired = 0; // BLAS released because their mesh is gone or changed
+      bool tlasRebuilt = false; // false when the instance set was unchanged (refit only)
+      uint32_t batches = 0; // buildAccelerationStructuresKHR calls
+      vk::DeviceSize scratchBytes = 0; // shared scratch arena
+      vk::DeviceSize buildBytes = 0; // BLAS storage as built
+      vk::DeviceSize compactedBytes = 0; // BLAS storage after compaction
+      double buildMs = 0.0; // BLAS builds and compaction
+      double totalMs = 0.0; // whole AS build including the TLAS
+    };
+    const BLASBuildStats& GetBLASBuildStats() const {
+      return lastBLASBuildStats;
+    }
+
+    // Opt-in: drop the CPU copy of mesh geometry once its GPU upload has completed.
+    // Meshes marked with MeshComponent::SetKeepCpuGeometry (physics colliders) keep theirs;
+    // released meshes no longer serve as software occluders.
+    void SetReleaseCpuMeshData(bool release) {
+      releaseCpuMeshData.store(release, std::memory_order_relaxed);
+    }
+    bool GetReleaseCpuMeshData() const {
+      return releaseCpuMeshData.load(std::memory_order_relaxed);
+    }
+
+    /**
+	 * @brief Select the vertex buffer layout of all meshes.
+	 * Packed vertices (see vertex_packing.h) take half the memory; the mesh pipelines are
+	 * rebuilt for the new layout. Call before the scene is loaded.
+	 * @param packed True for PackedVertex, false for Vertex.
+	 * @return False if meshes are already resident, which would keep the old layout.
+	 */
+    bool SetPackedVertices(bool packed);
+    bool UsesPackedVertices() const {
+      return packedVertices;
+    }
+    uint32_t GetVertexStride() const {
+      return getMeshVertexBindingDescription().stride;
+    }
+
     // Block until all currently-scheduled texture tasks have completed.
     // Intended for use during initial scene loading so that descriptor
     // creation sees the final textureResources instead of fallbacks.
@@ -603,9 +657,23 @@ class Renderer {
       if (v) {
         // New load cycle starting
         initialLoadComplete.store(false, std::memory_order_relaxed);
+        textureDedupHits.store(0, std::memory_order_relaxed);
+        textureDedupBytesSaved.store(0, std::memory_order_relaxed);
+        meshDedupHits.store(0, std::memory_order_relaxed);
+        meshDedupBytesSaved.store(0, std::memory_order_relaxed);
+        loadFailed.store(false, std::memory_order_relaxed);
+        // Materials of the previous scene may be freed and their addresses reused
+        materialSortIdsStale.store(true, std::memory_order_relaxed);
         SetLoadingPhase(LoadingPhase::Scene);
       }
     }
+    // Set by the scene loader when the scene could not be loaded; the loading overlay never completes then
+    void SetLoadFailed() {
+      loadFailed.store(true, std::memory_order_relaxed);
+    }
+    bool HasLoadFailed() const {
+      return loadFailed.load(std::memory_order_relaxed);
+    }
 
 	// Descriptor set deferred update machinery
 	void MarkEntityDescriptorsDirty(Entity *entity);
@@ -731,10 +799,28 @@ class Renderer {
 	 * @param lights The lights to store statically.
 	 */
     void SetStaticLights(const std::vector<ExtractedLight>& lights) {
-      staticLights = lights;
+      stampLightVersions(staticLights, lights, staticLightVersions);
       std::cout << "[Lights] staticLights set: " << staticLights.size() << " entries" << std::endl;
     }
 
+    /**
+	 * @brief Set lights that change at runtime. They follow the static lights in the light buffer.
+	 * Only entries that differ from the previous call are re-uploaded.
+	 * @param lights The current dynamic lights.
+	 */
+    void SetDynamicLights(const std::vector<ExtractedLight>& lights) {
+      stampLightVersions(dynamicLights, lights, dynamicLightVersions);
+    }
+
+    /**
+	 * @brief Add pseudo-random dynamic lights, 1% of which move every frame, to stress the light upload.
+	 * They replace the dynamic lights; 0 removes them.
+	 * @param count The number of lights.
+	 */
+    void SetSyntheticLightCount(uint32_t count) {
+      syntheticLightCount = std::min(count, MAX_ACTIVE_LIGHTS);
+    }
+
     /**
 	 * @brief Set the gamma correction value for PBR rendering.
 	 * @param _gamma The gamma correction value (typically 2.2).
@@ -827,7 +913,7 @@ class Renderer {
       }
       if (reason) {
         lastASBuildRequestReason = reason;
-        std::cout << "[AS] Requesting rebuild. Reason: " << reason << std::endl;
+        LOG_DEBUG("AS", std::string("Requesting rebuild. Reason: ") + reason);
       } else {
         lastASBuildRequestReason = "(no reason)";
       }
@@ -864,12 +950,15 @@ class Renderer {
     bool createOrResizeLightStorageBuffers(size_t lightCount);
 
     /**
-	 * @brief Update the light storage buffer with current light data.
+	 * @brief Update the light storage buffer of a frame with the static and dynamic lights.
+	 * Only entries whose version changed since this buffer was last written are rewritten;
+	 * directional entries additionally get a new shadow matrix when the camera moved.
 	 * @param frameIndex The current frame index.
-	 * @param lights The light data to upload.
-	 * @return True if successful, false otherwise.
+	 * @param lightCount Number of lights to upload (static first, then dynamic).
+	 * @param camera The camera that directional shadow matrices follow.
+	 * @return Number of entries valid in the buffer; fewer than lightCount while new lights are streaming in.
 	 */
-    bool updateLightStorageBuffer(uint32_t frameIndex, const std::vector<ExtractedLight>& lights, CameraComponent* camera = nullptr);
+    uint32_t updateLightStorageBuffer(uint32_t frameIndex, size_t lightCount, CameraComponent* camera = nullptr);
 
     /**
 	 * @brief Update all existing descriptor sets with new light storage buffer references.
@@ -1004,6 +1093,16 @@ class Renderer {
     // Tracked layouts for swapchain images (VVL requires correct oldLayout in barriers).
     // Initialized at swapchain creation and updated as we transition.
     std::vector<vk::ImageLayout> swapChainImageLayouts;
+    // Layout the final image is left in at the end of a frame: ePresentSrcKHR, or eTransferSrcOptimal
+    // when headless (ready for readback).
+    vk::ImageLayout presentImageLayout = vk::ImageLayout::ePresentSrcKHR;
+
+    // Headless mode: there is no surface or swapchain. swapChainImages refers to these offscreen
+    // images instead, which are used round-robin in place of acquire/present.
+    bool headless = false;
+    std::vector<vk::raii::Image> headlessImages;
+    std::vector<std::unique_ptr<MemoryPool::Allocation>> headlessImageAllocations;
+    uint32_t nextHeadlessImage = 0;
 
     // Dynamic rendering info
     vk::RenderingInfo renderingInfo;
@@ -1130,6 +1229,25 @@ class Renderer {
     std::vector<ForwardPlusPerFrame> forwardPlusPerFrame; // size MAX_FRAMES_IN_FLIGHT
     // Per-frame light count used by shaders (set once before main pass)
     uint32_t lastFrameLightCount = 0;
+    // CPU implementation of the Forward+ light assignment: used instead of the compute pass when
+    // requested or when the pipeline is unavailable, and optionally to validate the GPU output
+    LightClusterer lightClusterer;
+    bool forwardPlusOnCpu = false;
+    bool validateForwardPlusCpu = false;
+    uint32_t lastForwardPlusMismatches = 0;
+    std::vector<LightClusterer::Light> clusterLights;
+    // Light spheres by light buffer slot, so CPU assignment only clusters the lights that reach the view
+    SpatialIndex lightSpatialIndex;
+    std::vector<int32_t> lightProxies;
+    std::vector<uint32_t> visibleLightSlots;
+    struct ForwardPlusCpuReference {
+      LightClusterer::Params params;
+      std::vector<LightClusterer::TileHeader> headers;
+      std::vector<uint32_t> indices;
+      bool valid = false;
+    };
+    std::vector<ForwardPlusCpuReference> forwardPlusCpuReference; // per frame in flight, only while validating
+    LightClusterer::BenchmarkResult lightClusterBenchmark;
 
     // Forward+ compute resources
     vk::raii::PipelineLayout forwardPlusPipelineLayout = nullptr;
@@ -1173,6 +1291,17 @@ class Renderer {
     std::vector<AccelerationStructure> blasStructures; // Bottom-level AS (one per mesh)
     AccelerationStructure tlasStructure; // Top-level AS (scene)
 
+    // What each BLAS was built from (parallel to blasStructures). AS updates keep a BLAS while its
+    // mesh still has the same GPU buffers, so only new or re-uploaded meshes are built.
+    struct BLASSource {
+      MeshComponent* mesh = nullptr;
+      vk::Buffer vertexBuffer;
+      vk::Buffer indexBuffer;
+      uint32_t indexCount = 0;
+      bool compacted = false;
+    };
+    std::vector<BLASSource> blasSources;
+
     // Deferred deletion queue for old AS structures
     // Keeps old AS buffers alive until all frames in flight have finished using them
     struct PendingASDelete {
@@ -1182,6 +1311,16 @@ class Renderer {
     };
     std::vector<PendingASDelete> pendingASDeletions;
 
+    // BLAS builds are batched; the builds of a batch share one scratch arena of at most this size
+    static constexpr vk::DeviceSize BLAS_SCRATCH_ARENA_BUDGET = 64ull * 1024ull * 1024ull;
+    // Copy each BLAS into storage of its compacted size after building it
+    bool enableBLASCompaction = true;
+    // Read by the scene loader thread
+    std::atomic<bool> releaseCpuMeshData{false};
+    // Vertex buffer layout of every mesh: PackedVertex when set, otherwise Vertex
+    bool packedVertices = false;
+    BLASBuildStats lastBLASBuildStats{};
+
     // GPU data structures for ray query proper normal and material access
     struct GeometryInfo {
       uint64_t vertexBufferAddress; // Device address of vertex buffer
@@ -1189,7 +1328,7 @@ class Renderer {
       uint32_t vertexCount; // Number of vertices
       uint32_t materialIndex; // Index into material buffer
       uint32_t indexCount; // Number of indices (to bound primitiveIndex in shader)
-      uint32_t _pad0;
+      uint32_t vertexFormat; // VERTEX_FORMAT_* in vertex_packing.slang
       // Instance-space -> world-space normal transform (3 columns). Matches raster convention.
       // Stored as float4 columns (xyz used, w unused) for stable std430 layout.
       alignas(16) glm::vec4 normalMatrix0;
@@ -1334,14 +1473,58 @@ class Renderer {
     // Fallback sampler for the RQ composite if no other sampler is available at init time
     vk::raii::Sampler rqCompositeSampler{nullptr};
 
+    // Device-local buffer and its memory, shared by the meshes whose content is identical
+    class SharedDeviceBuffer {
+      public:
+        SharedDeviceBuffer(std::nullptr_t = nullptr) {}
+        SharedDeviceBuffer(vk::raii::Buffer buffer, std::unique_ptr<MemoryPool::Allocation> allocation)
+          : storage(std::make_shared<Storage>(Storage{std::move(allocation), std::move(buffer)})) {}
+
+        vk::Buffer operator*() const {
+          return storage ? *storage->buffer : vk::Buffer{};
+        }
+        vk::raii::Buffer& get() {
+          return storage->buffer;
+        }
+
+      private:
+        struct Storage {
+          std::unique_ptr<MemoryPool::Allocation> allocation; // declared first: the buffer is destroyed before its memory
+          vk::raii::Buffer buffer;
+        };
+        std::shared_ptr<Storage> storage;
+    };
+
     // Mesh resources
     struct MeshResources {
-      // Device-local vertex/index buffers used for rendering
-      vk::raii::Buffer vertexBuffer = nullptr;
-      std::unique_ptr<MemoryPool::Allocation> vertexBufferAllocation = nullptr;
-      vk::raii::Buffer indexBuffer = nullptr;
-      std::unique_ptr<MemoryPool::Allocation> indexBufferAllocation = nullptr;
+      // Device-local vertex/index buffers used for rendering; meshes with the same content hash share them
+      SharedDeviceBuffer vertexBuffer = nullptr;
+      SharedDeviceBuffer indexBuffer = nullptr;
+      // The mesh whose buffers these are, if shared; its upload may still be pending
+      MeshComponent* bufferOwner = nullptr;
+      // Full-detail index count; the reduced LOD levels follow it in the same index buffer
       uint32_t indexCount = 0;
+      std::vector<MeshLod> lods;
+      // Clusters of the full-detail level, culled per frame into indirect draws
+      std::vector<Meshlet> meshlets;
+
+      // Index range of a LOD level (0 = full detail, i = lods[i - 1])
+      MeshLod getLod(uint32_t level) const {
+        if (level == 0 || level > lods.size()) {
+          return MeshLod{.firstIndex = 0, .indexCount = indexCount, .error = 0.0f};
+        }
+        return lods[level - 1];
+      }
+
+      // Coarsest level whose error, projected onto a mesh of the given pixel radius, stays within the limit
+      uint32_t selectLod(float pixelRadius, float maxErrorPixels) const {
+        for (size_t i = lods.size(); i > 0; --i) {
+          if (lods[i - 1].error * pixelRadius <= maxErrorPixels) {
+            return static_cast<uint32_t>(i);
+          }
+        }
+        return 0;
+      }
 
       // Optional per-mesh staging buffers used when uploads are batched.
       // These are populated when createMeshResources(..., deferUpload=true) is used
@@ -1356,8 +1539,17 @@ class Renderer {
 
       // Material index for ray query (extracted from entity name or MaterialMesh)
       int32_t materialIndex = -1; // -1 = no material/default
+
+      // Small dense id used in draw sort keys (0 = not yet assigned)
+      uint32_t sortId = 0;
+
+      // Triangle adjacency for software occlusion rasterization (built the first time the mesh is an occluder)
+      std::vector<int32_t> occluderAdjacency;
+      bool occluderAdjacencyBuilt = false;
     };
     std::unordered_map<MeshComponent *, MeshResources> meshResources;
+    // The mesh owning the GPU buffers of each geometry content hash (see ModelLoader)
+    std::unordered_map<ContentHash::Digest, MeshComponent *, ContentHash::DigestHasher> meshBuffersByContent;
 
     // Texture resources
     struct TextureResources {
@@ -1436,6 +1628,14 @@ class Renderer {
 
     // Texture aliasing: maps alias (canonical) IDs to actual loaded keys
     std::unordered_map<std::string, std::string> textureAliases;
+    // Loaded texture ID by the content hash of its texels, so identical images under other IDs alias it
+    std::unordered_map<ContentHash::Digest, std::string, ContentHash::DigestHasher> textureByContent;
+
+    // Content-hash deduplication hits of the current load cycle (reset by SetLoading(true))
+    std::atomic<uint32_t> textureDedupHits{0};
+    std::atomic<uint64_t> textureDedupBytesSaved{0};
+    std::atomic<uint32_t> meshDedupHits{0};
+    std::atomic<uint64_t> meshDedupBytesSaved{0};
 
     // Per-texture load de-duplication (serialize loads of the same texture ID only)
     mutable std::mutex textureLoadStateMutex;
@@ -1454,6 +1654,7 @@ class Renderer {
     std::atomic<uint32_t> textureTasksScheduled{0};
     std::atomic<uint32_t> textureTasksCompleted{0};
     std::atomic<bool> loadingFlag{false};
+    std::atomic<bool> loadFailed{false};
 
     // Acceleration structure build UI progress (written on render thread).
     // Kept as atomics because ImGui can query at any point during the frame.
@@ -1468,10 +1669,19 @@ class Renderer {
     TextureResources defaultTextureResources;
 
     // Performance clamps (to reduce per-frame cost)
-    static constexpr uint32_t MAX_ACTIVE_LIGHTS = 1024; // Limit the number of lights processed per frame
+    static constexpr uint32_t MAX_ACTIVE_LIGHTS = 65536; // Limit the number of lights processed per frame
 
-    // Static lights loaded during model initialization
+    // Static lights loaded during model initialization, and lights updated at runtime.
+    // Each light carries a version stamp that changes whenever its contents change.
     std::vector<ExtractedLight> staticLights;
+    std::vector<uint32_t> staticLightVersions;
+    std::vector<ExtractedLight> dynamicLights;
+    std::vector<uint32_t> dynamicLightVersions;
+    uint32_t nextLightVersion = 1; // 0 marks a buffer entry that was never written
+    // Synthetic dynamic lights for stress runs (see SetSyntheticLightCount)
+    uint32_t syntheticLightCount = 0;
+    uint32_t syntheticLightFrame = 0;
+    std::vector<ExtractedLight> syntheticLights;
 
     // Dynamic lighting system using storage buffers
     struct LightStorageBuffer {
@@ -1479,10 +1689,41 @@ class Renderer {
       std::unique_ptr<MemoryPool::Allocation> allocation = nullptr;
       void* mapped = nullptr;
       size_t capacity = 0; // Current capacity in number of lights
-      size_t size = 0; // Current number of lights
+      size_t size = 0; // Current number of valid lights
+      std::vector<uint32_t> versions; // Light version last written to each entry
+      glm::vec3 shadowCameraPos{0.0f}; // Camera position directional shadow matrices were built for
+      bool hasShadowCamera = false;
     };
     std::vector<LightStorageBuffer> lightStorageBuffers; // One per frame in flight
 
+    struct LightSet {
+      const ExtractedLight* lights = nullptr;
+      const uint32_t* versions = nullptr;
+      size_t count = 0;
+    };
+    struct LightUpdateStats {
+      uint32_t lights = 0;
+      uint32_t written = 0; // entries rewritten because their light changed
+      uint32_t shadowRefreshed = 0; // directional entries whose shadow matrix followed the camera
+      uint32_t pending = 0; // new entries left for later frames by the stream budget
+      double updateMs = 0.0;
+    };
+    struct LightBenchmarkResult {
+      double initialMs = 0.0; // first upload of every light
+      double staticMs = 0.0; // per frame, nothing changed
+      double dynamicMs = 0.0; // per frame, 1% of lights changed and the camera moved
+    };
+    // New entries written per frame and buffer; larger light sets stream in over several frames
+    size_t lightStreamBudget = 4096;
+    LightUpdateStats lastLightUpdateStats{};
+    // Light upload timings for 1k, 10k and 50k synthetic lights
+    std::array<LightBenchmarkResult, 3> lightBenchmark{};
+
+    void stampLightVersions(std::vector<ExtractedLight>& current, const std::vector<ExtractedLight>& lights, std::vector<uint32_t>& versions);
+    static uint32_t writeLightEntries(LightStorageBuffer& buffer, std::span<const LightSet> sets, const glm::vec3* cameraPos, size_t streamBudget, LightUpdateStats& stats);
+    static LightBenchmarkResult BenchmarkLightUpload(uint32_t lightCount);
+    void updateSyntheticLights();
+
     // Entity resources (contains descriptor sets - must be declared before descriptor pool)
     struct EntityResources {
       std::vector<vk::raii::Buffer> uniformBuffers;
@@ -1528,6 +1769,23 @@ class Renderer {
 		bool cachedIsLiquid  = false;
 		// Material-derived push constants defaults (static per-entity unless material changes)
 		MaterialProperties cachedMaterialProps{};
+		// Dense material id used in draw sort keys (0 = no explicit material)
+		uint32_t materialSortId = 0;
+		// Cached world-space bounds and their leaf in the scene spatial index. Refreshed only when
+		// the transform version, transform component or mesh local bounds change.
+		bool                      hasWorldAABB              = false;
+		glm::vec3                 worldAABBMin{0.0f};
+		glm::vec3                 worldAABBMax{0.0f};
+		glm::vec3                 spatialLocalMin{0.0f};
+		glm::vec3                 spatialLocalMax{0.0f};
+		const TransformComponent *spatialTransform        = nullptr;
+		uint32_t                  spatialTransformVersion = 0;
+		int32_t                   spatialProxy            = SpatialIndex::InvalidProxy;
+		uint32_t                  cullBoundsSlot          = UINT32_MAX;        // index into Renderer::cullBounds
+		// Equals the tag of the most recent visibility query that accepted this entity
+		uint64_t cullVisibleTag = 0;
+		// Last frame in which the entity was drawn; occluders are picked from the previous frame's set
+		uint64_t lastVisibleFrame = 0;
 	};
 
 	// Cached job for rendering a single entity in a frame
@@ -1539,6 +1797,13 @@ class Renderer {
 		MeshComponent      *meshComp;
 		TransformComponent *transformComp;
 		bool                isAlphaMasked;
+		// Pass/pipeline/material/mesh/depth key (see DrawSortKey)
+		uint64_t sortKey = 0;
+		// Mesh LOD level drawn (see MeshResources::getLod)
+		uint32_t lodLevel = 0;
+		// Indirect draws of the visible clusters in clusterDrawCommands; none = draw the whole LOD level
+		uint32_t clusterDrawFirst = 0;
+		uint32_t clusterDrawCount = 0;
 	};
 	std::unordered_map<Entity *, EntityResources> entityResources;
 
@@ -1624,7 +1889,9 @@ class Renderer {
     // TLAS instance count (includes per-mesh instancing). Used for logging and shader bounds.
     size_t lastASBuiltTlasInstanceCount = 0;
 
-    // Freeze TLAS rebuilds after a full build to prevent regressions (e.g., animation-only TLAS)
+    // Freeze TLAS rebuilds after a full build to prevent regressions (e.g., animation-only TLAS).
+    // Requests with a reason still go through: AS updates reuse the BLAS of unchanged meshes, so
+    // they cost BLAS work only for new meshes plus a TLAS build (or nothing when only transforms moved).
     bool asFreezeAfterFullBuild = true; // enable freezing behavior
     bool asFrozen = false; // once frozen, ignore rebuilds unless explicitly overridden
     // Optional developer override to allow rebuild while frozen
@@ -1663,10 +1930,134 @@ class Renderer {
     bool enableFrustumCulling = true;
     uint32_t lastCullingVisibleCount = 0;
     uint32_t lastCullingCulledCount = 0;
+    // Persistent dynamic AABB tree over entity world bounds, used for hierarchical frustum queries
+    SpatialIndex sceneSpatialIndex;
+    bool enableSpatialCulling = true;
+    uint64_t nextCullQueryTag = 1;
+    std::vector<RenderJob> cullCandidates;
+    double lastCullQueryMs = 0.0;
+    SpatialIndex::QueryStats lastCullQueryStats{};
+    // Dense SoA copy of the same bounds for the flat SIMD cull path (cullBoundsOwners[i] owns slot i)
+    AABBSoA cullBounds;
+    std::vector<EntityResources*> cullBoundsOwners;
+    std::vector<uint32_t> cullVisibleIndices;
+    std::vector<uint32_t> cullReferenceIndices;
+    FrustumCullKernel::Isa cullKernelIsa = FrustumCullKernel::DetectBestIsa();
+    bool validateCullKernel = false; // re-run the scalar kernel and compare results
+    uint32_t lastCullKernelMismatches = 0;
+    // CPU software occlusion culling against the largest occluders drawn last frame
+    OcclusionCuller occlusionCuller;
+    bool enableOcclusionCulling = true;
+    uint32_t occlusionBufferWidth = 256; // height follows the swapchain aspect
+    uint32_t maxOccluders = 32;
+    uint32_t maxOccluderTriangles = 4096;
+    float occluderMinAngularSize = 0.1f; // bounding radius / distance
+    uint64_t cullFrameIndex = 0;
+    uint32_t lastOcclusionCulledCount = 0;
+    double lastOcclusionTestMs = 0.0;
+    bool occlusionDumpRequested = false;
+    std::vector<std::pair<float, const RenderJob*>> occluderScratch;
+
+    // Average TransformSystem::Update time on a synthetic 100k-node hierarchy (1% and 100% dirty)
+    double transformBenchmarkMs[2] = {0.0, 0.0};
+    // Per-frame sampling time of 10k synthetic animated nodes
+    AnimationSystem::BenchmarkResult animationBenchmark;
+    // Log calls per second from 8 threads (asynchronous backend vs. writing on the caller)
+    DebugSystem::LogBenchmarkResult logBenchmark;
+    // Resource lookups per second through handles vs. by ID (10k resources)
+    ResourceManager::HandleBenchmarkResult resourceHandleBenchmark;
+    // Models sharing textures loaded one at a time vs. asynchronously with dependencies
+    ResourceManager::AsyncLoadBenchmarkResult asyncLoadBenchmark;
+    // Draw ordering by 64-bit sort key (state grouping for opaque, back-to-front for transparent)
+    bool enableDrawSorting = true;
+    std::unordered_map<const Material *, uint32_t> materialSortIds;
+    std::atomic<bool> materialSortIdsStale{false}; // set by SetLoading(true); the render thread clears the map
+    uint32_t nextMeshSortId = 1;
+    DrawKeySorter drawKeySorter;
+    std::vector<DrawKeySorter::Entry> drawSortEntries;
+    std::vector<RenderJob> drawSortScratch;
+    // Per-frame command counters for the raster passes (redundant binds are skipped)
+    struct FrameBindStats {
+      uint32_t pipelineBinds = 0;
+      uint32_t descriptorBinds = 0;
+      uint32_t vertexBufferBinds = 0;
+      uint32_t indexBufferBinds = 0;
+      uint32_t pushConstants = 0;
+      uint32_t draws = 0;
+    };
+    FrameBindStats frameBindStats{};
+    FrameBindStats lastFrameBindStats{};
+
+    // --- Parallel raster recording ---
+    // Depth pre-pass, opaque and transparent draws are split into chunks that worker threads
+    // record into secondary command buffers; the primary only executes them. Each chunk owns a
+    // command pool per frame-in-flight (pools are externally synchronized and never shared).
+    enum class RasterPass : uint32_t {
+      DepthPrepass = 0,
+      Opaque,
+      Transparent,
+      Count
+    };
+    struct RasterPassContext {
+      bool useBasic = false;
+      bool didDepthPrepass = false;
+      vk::DescriptorSet set1{};
+      vk::Viewport viewport{};
+      vk::Rect2D scissor{};
+    };
+    struct RecordSlot {
+      vk::raii::CommandPool pool = nullptr;
+      vk::raii::CommandBuffer cmd = nullptr;
+    };
+    bool enableParallelRecording = true;
+    uint32_t parallelRecordMinJobsPerChunk = 128;
+    std::unique_ptr<ThreadPool> recordThreadPool;
+    uint32_t recordWorkerCount = 0;
+    std::vector<std::vector<RecordSlot>> recordSlots; // [frame][slot]
+    // Secondaries recorded this frame, per pass (empty when recorded inline)
+    std::array<std::vector<vk::CommandBuffer>, static_cast<size_t>(RasterPass::Count)> passSecondaries;
+    // CPU time spent recording each pass (summed over chunks) and wall time of the parallel batch
+    std::array<double, static_cast<size_t>(RasterPass::Count)> lastPassRecordMs{};
+    double lastParallelRecordWallMs = 0.0;
+    uint32_t lastRecordChunkCount = 0;
+    // GPU pass timestamps for the frame profiler (one query range per frame in flight).
+    // Results are read back after the frame's fence wait, MAX_FRAMES_IN_FLIGHT frames later.
+    static constexpr uint32_t MAX_GPU_PROFILE_PASSES = 16;
+    struct GpuProfileFrame {
+      std::array<const char*, MAX_GPU_PROFILE_PASSES> names{};
+      uint32_t passCount = 0;
+      uint64_t submitNs = 0; // profiler clock at submit, used to place the passes on the CPU timeline
+      bool recording = false; // queries were reset for the command buffer being recorded
+      bool pending = false;   // submitted, results not read yet
+    };
+    vk::raii::QueryPool gpuProfileQueryPool = nullptr;
+    float gpuTimestampPeriod = 0.0f; // ns per tick, 0 when timestamps are unsupported
+    uint64_t gpuTimestampMask = 0;   // low timestampValidBits of a raw timestamp; the rest are undefined
+    std::vector<GpuProfileFrame> gpuProfileFrames;
     // Distance-based LOD (projected-size skip in pixels)
     bool enableDistanceLOD = true;
     float lodPixelThresholdOpaque = 1.5f;
     float lodPixelThresholdTransparent = 2.5f;
+    // Mesh LOD selection from the same projected size: the coarsest level within this error, in pixels
+    bool enableMeshLods = true;
+    float lodErrorThresholdPixels = 1.0f;
+    // Main-view triangles of the last frame, as drawn and as they would be at full detail
+    uint64_t lastFrameTriangles = 0;
+    uint64_t lastFrameFullDetailTriangles = 0;
+    std::array<uint32_t, MaxMeshLodLevels> lastFrameLodDraws{};
+    // Per-cluster culling of full-detail meshes: visible meshlet ranges become indirect draws
+    bool enableClusterCulling = true;
+    bool enableClusterConeCulling = true;
+    bool multiDrawIndirectEnabled = false;
+    std::vector<Meshlets::DrawRange> clusterRanges; // scratch, one mesh at a time
+    std::vector<vk::DrawIndexedIndirectCommand> clusterDrawCommands;
+    struct ClusterDrawBuffer {
+      vk::raii::Buffer buffer = nullptr;
+      std::unique_ptr<MemoryPool::Allocation> allocation = nullptr;
+      size_t capacity = 0; // in commands
+    };
+    std::vector<ClusterDrawBuffer> clusterDrawBuffers; // one per frame in flight
+    Meshlets::CullStats lastClusterCullStats;
     // Sampler anisotropy preference (clamped to device limits)
     float samplerMaxAnisotropy = 8.0f;
     // Upper bound on auto-generated mip levels (to avoid excessive VRAM use on huge textures)
@@ -1738,6 +2129,7 @@ class Renderer {
     void addSupportedOptionalExtensions();
     bool createLogicalDevice(bool enableValidationLayers);
     bool createSwapChain();
+    bool createHeadlessImages();
     bool createImageViews();
     bool setupDynamicRendering();
     bool createDescriptorSetLayout();
@@ -1749,6 +2141,13 @@ class Renderer {
     bool createDepthPrepassPipeline();
     bool createForwardPlusPipelinesAndResources();
 
+    // Vertex input of the mesh pipelines for the active vertex layout
+    vk::VertexInputBindingDescription getMeshVertexBindingDescription() const;
+    std::array<vk::VertexInputAttributeDescription, 4> getMeshVertexAttributeDescriptions() const;
+    const char* getMeshVertexEntryPoint() const {
+      return packedVertices ? "VSMainPacked" : "VSMain";
+    }
+
     // Ray query pipeline creation
     bool createRayQueryDescriptorSetLayout();
     bool createRayQueryPipeline();
@@ -1760,6 +2159,17 @@ class Renderer {
     void dispatchForwardPlus(vk::raii::CommandBuffer& cmd, uint32_t tilesX, uint32_t tilesY, uint32_t slicesZ);
     // Ensure Forward+ compute descriptor set binding 0 (lights SSBO) is bound for a frame
     void refreshForwardPlusComputeLightsBindingForFrame(uint32_t frameIndex);
+    // Build the Forward+ tile lists on the CPU, either into the frame's tile buffers or into its validation copy
+    bool assignForwardPlusLightsCpu(uint32_t frameIndex, const glm::mat4& view, const glm::mat4& proj, uint32_t lightCount, uint32_t tilesX, uint32_t tilesY, uint32_t slicesZ, float nearZ, float farZ, bool writeToFrameBuffers);
+    // Compare the tile lists the compute pass last wrote for a frame with the CPU copy built for the same dispatch
+    void compareForwardPlusWithCpu(uint32_t frameIndex);
+    // Bring the light index up to date with the first lightCount entries of a frame's light buffer
+    void updateLightSpatialIndex(const LightData* lights, uint32_t lightCount);
+    // GPU pass timestamps for the frame profiler
+    void createGpuProfiler();
+    void collectGpuProfile(uint32_t frameIndex);
+    uint32_t beginGpuPass(vk::raii::CommandBuffer& cmd, const char* name);
+    void endGpuPass(vk::raii::CommandBuffer& cmd, uint32_t pass);
     bool createComputePipeline();
     void pushMaterialProperties(vk::CommandBuffer commandBuffer, const MaterialProperties& material) const;
     bool createCommandPool();
@@ -1768,6 +2178,8 @@ class Renderer {
     bool createComputeCommandPool();
     bool createDepthResources();
     bool createTextureImage(const std::string& texturePath, TextureResources& resources);
+    bool shareTextureByContent(const std::string& textureId, const ContentHash::Digest& contentHash, vk::DeviceSize bytes);
+    void registerTextureContent(const ContentHash::Digest& contentHash, const std::string& textureId);
     bool createTextureImageView(TextureResources& resources);
     bool createTextureSampler(TextureResources& resources);
     bool createDefaultTextureResources();
@@ -1815,6 +2227,24 @@ class Renderer {
     // and push-constant defaults). This avoids repeated per-frame string parsing and material lookups.
     void ensureEntityMaterialCache(Entity* entity, EntityResources &res);
 
+    // Reorder jobs by ascending RenderJob::sortKey (stable radix sort).
+    void sortRenderJobs(std::vector<RenderJob>& jobs);
+
+    // Draw recorders shared by the inline and secondary-command-buffer paths.
+    // Each one sets viewport/scissor and binds its own pipeline so it can start a fresh secondary.
+    void recordDepthPrepassDraws(vk::raii::CommandBuffer& cmd, std::span<const RenderJob> jobs, const RasterPassContext& ctx, FrameBindStats& stats);
+    void recordOpaqueDraws(vk::raii::CommandBuffer& cmd, std::span<const RenderJob> jobs, const RasterPassContext& ctx, FrameBindStats& stats);
+    void recordTransparentDraws(vk::raii::CommandBuffer& cmd, std::span<const RenderJob> jobs, const RasterPassContext& ctx, FrameBindStats& stats);
+    // Draw a job's visible clusters when it has cluster draws, else its whole LOD level
+    void recordJobDraw(vk::raii::CommandBuffer& cmd, const RenderJob& job, uint32_t instanceCount, FrameBindStats& stats);
+    // Cull a job's meshlets into clusterDrawCommands; returns false if none is visible
+    bool cullJobClusters(RenderJob& job, const FrustumPlanes& frustum, const glm::vec3& cameraPos, bool coneCulling);
+    // Copy this frame's cluster draws into the current frame's indirect buffer; returns false if that fails
+    bool uploadClusterDrawCommands();
+    // Record all raster passes into per-chunk secondaries on the record thread pool.
+    // Fills passSecondaries; returns false (and leaves them empty) when recording inline is preferable.
+    bool recordRasterPassesParallel(const std::vector<RenderJob>& opaque, const std::vector<RenderJob>& transparent, const RasterPassContext& ctx);
+
     // ===================== Culling helpers =====================
     struct FrustumPlanes {
       // Plane equation ax + by + cz + d >= 0 considered inside
@@ -1832,6 +2262,14 @@ class Renderer {
     static bool aabbIntersectsFrustum(const glm::vec3& worldMin,
                                       const glm::vec3& worldMax,
                                       const FrustumPlanes& frustum);
+
+    // Refresh the cached world AABB / spatial index leaf of an entity if its bounds changed.
+    void updateEntitySpatialBounds(EntityResources& res, MeshComponent* meshComponent, TransformComponent* tc);
+    // Mark every entity whose world AABB intersects the frustum (tree query or SIMD kernel); returns the query tag.
+    uint64_t markFrustumVisible(const FrustumPlanes& frustum, SpatialIndex::QueryStats* stats);
+    // Pick occluders from last frame's visible set and rasterize them; returns true if the buffer can be queried.
+    bool prepareOcclusionBuffer(const glm::mat4& viewProj, const glm::vec3& cameraPos, uint64_t frustumVisibleTag);
+
     void recreateSwapChain();
 
     void updateUniformBuffer(uint32_t currentImage, Entity* entity, EntityResources *entityRes, CameraComponent* camera, TransformComponent *tc = nullptr);
@@ -1910,4 +2348,39 @@ class Renderer {
       double mb = static_cast<double>(bytesUploadedTotal.load(std::memory_order_relaxed)) / (1024.0 * 1024.0);
       return seconds > 0.0 ? (mb / seconds) : 0.0;
     }
+
+    // Frame statistics of the most recently recorded frame (for automated performance runs)
+    bool IsHeadless() const {
+      return headless;
+    }
+    uint32_t GetLastCullingVisibleCount() const {
+      return lastCullingVisibleCount;
+    }
+    uint32_t GetLastCullingCulledCount() const {
+      return lastCullingCulledCount;
+    }
+    uint32_t GetLastFrameDrawCount() const {
+      return lastFrameBindStats.draws;
+    }
+    uint64_t GetLastFrameTriangleCount() const {
+      return lastFrameTriangles;
+    }
+    uint64_t GetLastFrameFullDetailTriangleCount() const {
+      return lastFrameFullDetailTriangles;
+    }
+    uint32_t GetLastFrameClusterCount() const {
+      return static_cast<uint32_t>(lastClusterCullStats.tested);
+    }
+    uint32_t GetLastFrameLightCount() const {
+      return lastFrameLightCount;
+    }
+    double GetLastLightUpdateMs() const {
+      return lastLightUpdateStats.updateMs;
+    }
+    uint32_t GetLastFrameClusterCulledCount() const {
+      return static_cast<uint32_t>(lastClusterCullStats.frustumCulled + lastClusterCullStats.coneCulled);
+    }
+    std::string GetDeviceName() const {
+      return *physicalDevice ? std::string(physicalDevice.getProperties().deviceName.data()) : std::string();
+    }
 };
\ No newline at end of file
@@ -405,6 +405,124 @@ void Renderer::refreshForwardPlusComputeLightsBindingForFrame(uint32_t frameInde
   }
 }
 
+bool Renderer::assignForwardPlusLightsCpu(uint32_t frameIndex, const glm::mat4& view, const glm::mat4& proj, uint32_t lightCount, uint32_t tilesX, uint32_t tilesY, uint32_t slicesZ, float nearZ, float farZ, bool writeToFrameBuffers) {
+  static_assert(sizeof(TileHeader) == sizeof(LightClusterer::TileHeader), "CPU and GPU tile headers must match");
+  if (frameIndex >= forwardPlusPerFrame.size() || frameIndex >= lightStorageBuffers.size())
+    return false;
+  const auto& lightBuffer = lightStorageBuffers[frameIndex];
+  if (!lightBuffer.mapped)
+    return false;
+
+  // Same inputs the compute pass reads: the frame's light SSBO and the values packed by updateForwardPlusParams
+  LightClusterer::Params params;
+  params.view = view;
+  params.proj = proj;
+  params.screenWidth = static_cast<float>(swapChainExtent.width);
+  params.screenHeight = static_cast<float>(swapChainExtent.height);
+  params.tileSizeX = static_cast<float>(forwardPlusTileSizeX);
+  params.tileSizeY = static_cast<float>(forwardPlusTileSizeY);
+  params.tilesX = tilesX;
+  params.tilesY = tilesY;
+  params.slicesZ = slicesZ;
+  params.maxPerTile = MAX_LIGHTS_PER_TILE;
+  params.nearZ = nearZ;
+  params.farZ = farZ;
+
+  const auto* lights = static_cast<const LightData *>(lightBuffer.mapped);
+  lightCount = static_cast<uint32_t>(std::min<size_t>(lightCount, lightBuffer.size));
+
+  const size_t clusters = static_cast<size_t>(tilesX) * tilesY * slicesZ;
+  if (writeToFrameBuffers) {
+    auto& f = forwardPlusPerFrame[frameIndex];
+    if (!f.tileHeadersAlloc || !f.tileHeadersAlloc->mappedPtr || !f.tileLightIndicesAlloc || !f.tileLightIndicesAlloc->mappedPtr)
+      return false;
+    if (f.tilesCapacity < clusters || f.indicesCapacity < clusters * MAX_LIGHTS_PER_TILE)
+      return false;
+
+    // A light whose sphere misses the view frustum reaches no cluster: only cluster the lights the index returns.
+    // They stay in buffer order so per-cluster capping keeps the same lights as the compute pass.
+    updateLightSpatialIndex(lights, lightCount);
+    const FrustumPlanes frustum = extractFrustumPlanes(proj * view);
+    visibleLightSlots.clear();
+    for (uint32_t i = 0; i < lightCount; ++i) {
+      if (lights[i].lightType == 1)
+        visibleLightSlots.push_back(i);
+    }
+    lightSpatialIndex.QueryPlanes(frustum.planes, [this](void* userData) {
+      visibleLightSlots.push_back(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData)));
+    });
+    std::ranges::sort(visibleLightSlots);
+    clusterLights.resize(visibleLightSlots.size());
+    for (size_t k = 0; k < visibleLightSlots.size(); ++k) {
+      const LightData& L = lights[visibleLightSlots[k]];
+      clusterLights[k] = LightClusterer::Light{glm::vec3(L.position), L.range, L.lightType == 1, visibleLightSlots[k]};
+    }
+    lightClusterer.Build(params, clusterLights, static_cast<LightClusterer::TileHeader *>(f.tileHeadersAlloc->mappedPtr), static_cast<uint32_t *>(f.tileLightIndicesAlloc->mappedPtr), recordThreadPool.get(), recordWorkerCount);
+    return true;
+  }
+
+  // The validation copy must match the compute pass exactly, which tests every light
+  clusterLights.resize(lightCount);
+  for (uint32_t i = 0; i < lightCount; ++i) {
+    clusterLights[i] = LightClusterer::Light{glm::vec3(lights[i].position), lights[i].range, lights[i].lightType == 1};
+  }
+
+  if (forwardPlusCpuReference.size() != forwardPlusPerFrame.size())
+    forwardPlusCpuReference.resize(forwardPlusPerFrame.size());
+  auto& ref = forwardPlusCpuReference[frameIndex];
+  ref.params = params;
+  ref.headers.resize(clusters);
+  ref.indices.resize(clusters * MAX_LIGHTS_PER_TILE);
+  lightClusterer.Build(params, clusterLights, ref.headers.data(), ref.indices.data(), recordThreadPool.get(), recordWorkerCount);
+  ref.valid = true;
+  return true;
+}
+
+void Renderer::updateLightSpatialIndex(const LightData* lights, uint32_t lightCount) {
+  for (size_t i = lightCount; i < lightProxies.size(); ++i) {
+    if (lightProxies[i] != SpatialIndex::InvalidProxy)
+      lightSpatialIndex.Remove(lightProxies[i]);
+  }
+  lightProxies.resize(lightCount, SpatialIndex::InvalidProxy);
+  for (uint32_t i = 0; i < lightCount; ++i) {
+    int32_t& proxy = lightProxies[i];
+    if (lights[i].lightType == 1) {
+      // Directional lights reach every cluster and are not indexed
+      if (proxy != SpatialIndex::InvalidProxy) {
+        lightSpatialIndex.Remove(proxy);
+        proxy = SpatialIndex::InvalidProxy;
+      }
+      continue;
+    }
+    const glm::vec3 center(lights[i].position);
+    const glm::vec3 extent(std::max(lights[i].range, 0.0f));
+    // Update only rewrites the leaf when the sphere leaves its fattened box
+    if (proxy == SpatialIndex::InvalidProxy)
+      proxy = lightSpatialIndex.Insert(center - extent, center + extent, reinterpret_cast<void*>(static_cast<uintptr_t>(i)));
+    else
+      lightSpatialIndex.Update(proxy, center - extent, center + extent);
+  }
+}
+
+void Renderer::compareForwardPlusWithCpu(uint32_t frameIndex) {
+  if (frameIndex >= forwardPlusCpuReference.size() || frameIndex >= forwardPlusPerFrame.size())
+    return;
+  auto& ref = forwardPlusCpuReference[frameIndex];
+  const auto& f = forwardPlusPerFrame[frameIndex];
+  if (!ref.valid || !f.tileHeadersAlloc || !f.tileHeadersAlloc->mappedPtr || !f.tileLightIndicesAlloc || !f.tileLightIndicesAlloc->mappedPtr)
+    return;
+  const size_t clusters = ref.headers.size();
+  if (f.tilesCapacity < clusters || f.indicesCapacity < ref.indices.size())
+    return;
+
+  // The fence for this frame slot has been waited on, so the buffers hold that dispatch's output
+  lastForwardPlusMismatches = LightClusterer::CountMismatches(ref.params,
+                                                              ref.headers.data(), ref.indices.data(),
+                                                              static_cast<const LightClusterer::TileHeader *>(f.tileHeadersAlloc->mappedPtr),
+                                                              static_cast<const uint32_t *>(f.tileLightIndicesAlloc->mappedPtr));
+  ref.valid = false;
+}
+
 // Create compute command pool
 bool Renderer::createComputeCommandPool() {
   try {
@@ -117,9 +117,15 @@ static void WatchdogThreadFunc(std::atomic<std::chrono::steady_clock::time_point
 
 // Renderer core implementation for the "Rendering Pipeline" chapter of the tutorial.
 Renderer::Renderer(Platform* platform) : platform(platform) {
-  // Initialize deviceExtensions with required extensions only
-  // Optional extensions will be added later after checking device support
-  deviceExtensions = requiredDeviceExtensions;
+  // Headless runs render into offscreen images: no surface, so no swapchain extension either
+  headless = platform && platform->IsHeadless();
+  if (headless) {
+    presentImageLayout = vk::ImageLayout::eTransferSrcOptimal;
+  } else {
+    // Initialize deviceExtensions with required extensions only
+    // Optional extensions will be added later after checking device support
+    deviceExtensions = requiredDeviceExtensions;
+  }
 }
 
 // Destructor
@@ -328,11 +334,17 @@ bool Renderer::Initialize(const std::string& appName, bool enableValidationLayer
     return false;
   }
 
+  // Timestamp queries for the frame profiler (optional; GPU passes are simply not reported without them)
+  createGpuProfiler();
+
   // Initialize background thread pool for async tasks (textures, etc.) AFTER all Vulkan resources are ready
   try {
     // Size the thread pool based on hardware concurrency, clamped to a sensible range
     unsigned int hw = std::max(2u, std::min(8u, std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4u));
     threadPool = std::make_unique<ThreadPool>(hw);
+    // Separate pool for per-frame command recording so it never queues behind texture decoding.
+    recordWorkerCount = std::max(1u, std::min(8u, (std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4u) - 1u));
+    recordThreadPool = std::make_unique<ThreadPool>(recordWorkerCount);
   } catch (const std::exception& e) {
     std::cerr << "Failed to create thread pool: " << e.what() << std::endl;
     return false;
@@ -396,6 +408,7 @@ void Renderer::Cleanup() {
     if (threadPool) {
       threadPool.reset();
     }
+    recordThreadPool.reset();
   }
 
   if (!initialized) {
@@ -426,6 +439,12 @@ void Renderer::Cleanup() {
     resources.instanceBufferMapped = nullptr;
   }
   entityResources.clear();
+  materialSortIds.clear();
+  sceneSpatialIndex.Clear();
+  lightSpatialIndex.Clear();
+  lightProxies.clear();
+  cullBounds.Clear();
+  cullBoundsOwners.clear();
 
   // 3) Clear any global descriptor sets that are allocated from pools to avoid dangling refs
   transparentDescriptorSets.clear();
@@ -485,6 +504,7 @@ void Renderer::Cleanup() {
     fp.computeSet = nullptr; // descriptor set allocated from compute/graphics pools
   }
   forwardPlusPerFrame.clear();
+  clusterDrawBuffers.clear();
 
   // 5) Destroy descriptor set layouts and pools (compute + graphics)
   descriptorSetLayout = nullptr;
@@ -504,6 +524,7 @@ void Renderer::Cleanup() {
     std::unique_lock<std::shared_mutex> lk(textureResourcesMutex);
     textureResources.clear();
     textureAliases.clear();
+    textureByContent.clear();
   }
   // Reset default texture resources
   defaultTextureResources.textureSampler = nullptr;
@@ -525,12 +546,17 @@ void Renderer::Cleanup() {
 
   // Clear acceleration structures (BLAS and TLAS buffers)
   blasStructures.clear();
+  blasSources.clear();
   tlasStructure = AccelerationStructure{};
 
   // 8) (moved above) Forward+ per-frame buffers cleared prior to pool destruction
 
   // 9) Command buffers/pools
   commandBuffers.clear();
+  recordSlots.clear();
+  for (auto& v : passSecondaries) {
+    v.clear();
+  }
   commandPool = nullptr;
   computeCommandPool = nullptr;
 
@@ -539,6 +565,8 @@ void Renderer::Cleanup() {
   renderFinishedSemaphores.clear();
   inFlightFences.clear();
   uploadsTimeline = nullptr;
+  gpuProfileFrames.clear();
+  gpuProfileQueryPool = nullptr;
 
   // 11) Queues and surface (RAII handles will release upon reset; keep device alive until the end)
   graphicsQueue = nullptr;
@@ -572,9 +600,11 @@ bool Renderer::createInstance(const std::string& appName, bool enableValidationL
 
     // Add required extensions for GLFW
 #if defined(PLATFORM_DESKTOP)
-    uint32_t glfwExtensionCount = 0;
-    const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
-    extensions.insert(extensions.end(), glfwExtensions, glfwExtensions + glfwExtensionCount);
+    if (!headless) {
+      uint32_t glfwExtensionCount = 0;
+      const char** glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtensionCount);
+      extensions.insert(extensions.end(), glfwExtensions, glfwExtensions + glfwExtensionCount);
+    }
 #endif
 
     // Add debug extension if validation layers are enabled
@@ -656,6 +686,9 @@ bool Renderer::setupDebugMessenger(bool enableValidationLayers) {
 
 // Create surface
 bool Renderer::createSurface() {
+  if (headless) {
+    return true;
+  }
   try {
     // Create surface
     VkSurfaceKHR _surface;
@@ -708,19 +741,20 @@ bool Renderer::pickPhysicalDevice() {
         continue;
       }
 
-      // Check device extensions
-      bool supportsAllRequiredExtensions = checkDeviceExtensionSupport(_device);
-      if (!supportsAllRequiredExtensions) {
-        std::cout << "  - Missing required extensions" << std::endl;
-        continue;
-      }
+      // Check device extensions and swap chain support (headless needs neither)
+      if (!headless) {
+        bool supportsAllRequiredExtensions = checkDeviceExtensionSupport(_device);
+        if (!supportsAllRequiredExtensions) {
+          std::cout << "  - Missing required extensions" << std::endl;
+          continue;
+        }
 
-      // Check swap chain support
-      SwapChainSupportDetails swapChainSupport = querySwapChainSupport(_device);
-      bool swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
-      if (!swapChainAdequate) {
-        std::cout << "  - Inadequate swap chain support" << std::endl;
-        continue;
+        SwapChainSupportDetails swapChainSupport = querySwapChainSupport(_device);
+        bool swapChainAdequate = !swapChainSupport.formats.empty() && !swapChainSupport.presentModes.empty();
+        if (!swapChainAdequate) {
+          std::cout << "  - Inadequate swap chain support" << std::endl;
+          continue;
+        }
       }
 
       // Check for required features
@@ -878,6 +912,9 @@ bool Renderer::createLogicalDevice(bool enableValidationLayers) {
     auto features = physicalDevice.getFeatures2();
     features.features.samplerAnisotropy = vk::True;
     features.features.depthBiasClamp = coreSupported.depthBiasClamp ? vk::True : vk::False;
+    // Optional: the visible clusters of a mesh go out in one indirect call
+    features.features.multiDrawIndirect = coreSupported.multiDrawIndirect ? vk::True : vk::False;
+    multiDrawIndirectEnabled = coreSupported.multiDrawIndirect == vk::True;
 
     // Explicitly configure device features to prevent validation layer warnings
     // These features are required by extensions or other features, so we enable them explicitly
@@ -16,6 +16,7 @@
  */
 #include "mesh_component.h"
 #include "renderer.h"
+#include "vertex_packing.h"
 #include <array>
 #include <fstream>
 #include <iostream>
@@ -255,7 +256,7 @@ bool Renderer::createGraphicsPipeline() {
     vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
       .stage = vk::ShaderStageFlagBits::eVertex,
       .module = *shaderModule,
-      .pName = "VSMain"
+      .pName = getMeshVertexEntryPoint()
     };
 
     vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
@@ -274,14 +275,14 @@ bool Renderer::createGraphicsPipeline() {
     vk::PipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
     // Create vertex input info with instancing support
-    auto vertexBindingDescription = Vertex::getBindingDescription();
+    auto vertexBindingDescription = getMeshVertexBindingDescription();
     auto instanceBindingDescription = InstanceData::getBindingDescription();
     std::array<vk::VertexInputBindingDescription, 2> bindingDescriptions = {
       vertexBindingDescription,
       instanceBindingDescription
     };
 
-    auto vertexAttributeDescriptions = Vertex::getAttributeDescriptions();
+    auto vertexAttributeDescriptions = getMeshVertexAttributeDescriptions();
     auto instanceAttributeDescriptions = InstanceData::getAttributeDescriptions();
 
     // Combine all attribute descriptions (no duplicates)
@@ -289,8 +290,6 @@ bool Renderer::createGraphicsPipeline() {
     allAttributeDescriptions.insert(allAttributeDescriptions.end(), vertexAttributeDescriptions.begin(), vertexAttributeDescriptions.end());
     allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceAttributeDescriptions.begin(), instanceAttributeDescriptions.end());
 
-    // Note: materialIndex attribute (Location 11) is not used by current shaders
-
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{
       .vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size()),
       .pVertexBindingDescriptions = bindingDescriptions.data(),
@@ -436,7 +435,7 @@ bool Renderer::createPBRPipeline() {
     vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
       .stage = vk::ShaderStageFlagBits::eVertex,
       .module = *shaderModule,
-      .pName = "VSMain"
+      .pName = getMeshVertexEntryPoint()
     };
 
     vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
@@ -455,7 +454,7 @@ bool Renderer::createPBRPipeline() {
     vk::PipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
     // Define vertex and instance binding descriptions
-    auto vertexBindingDescription = Vertex::getBindingDescription();
+    auto vertexBindingDescription = getMeshVertexBindingDescription();
     auto instanceBindingDescription = InstanceData::getBindingDescription();
     std::array<vk::VertexInputBindingDescription, 2> bindingDescriptions = {
       vertexBindingDescription,
@@ -463,15 +462,13 @@ bool Renderer::createPBRPipeline() {
     };
 
     // Define vertex and instance attribute descriptions
-    auto vertexAttributeDescriptions = Vertex::getAttributeDescriptions();
-    auto instanceModelMatrixAttributes = InstanceData::getModelMatrixAttributeDescriptions();
-    auto instanceNormalMatrixAttributes = InstanceData::getNormalMatrixAttributeDescriptions();
+    auto vertexAttributeDescriptions = getMeshVertexAttributeDescriptions();
+    auto instanceAttributeDescriptions = InstanceData::getAttributeDescriptions();
 
     // Combine all attribute descriptions
     std::vector<vk::VertexInputAttributeDescription> allAttributeDescriptions;
     allAttributeDescriptions.insert(allAttributeDescriptions.end(), vertexAttributeDescriptions.begin(), vertexAttributeDescriptions.end());
-    allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceModelMatrixAttributes.begin(), instanceModelMatrixAttributes.end());
-    allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceNormalMatrixAttributes.begin(), instanceNormalMatrixAttributes.end());
+    allAttributeDescriptions.insert(allAttributeDescriptions.end(), instanceAttributeDescriptions.begin(), instanceAttributeDescriptions.end());
 
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{
       .vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size()),
@@ -855,24 +852,22 @@ bool Renderer::createDepthPrepassPipeline() {
     vk::PipelineShaderStageCreateInfo vertStage{
       .stage = vk::ShaderStageFlagBits::eVertex,
       .module = *shaderModule,
-      .pName = "VSMain"
+      .pName = getMeshVertexEntryPoint()
     };
 
     // Vertex/instance bindings & attributes same as PBR
-    auto vertexBindingDescription = Vertex::getBindingDescription();
+    auto vertexBindingDescription = getMeshVertexBindingDescription();
     auto instanceBindingDescription = InstanceData::getBindingDescription();
     std::array<vk::VertexInputBindingDescription, 2> bindingDescriptions = {
       vertexBindingDescription,
       instanceBindingDescription
     };
 
-    auto vertexAttributeDescriptions = Vertex::getAttributeDescriptions();
-    auto instanceModelMatrixAttributes = InstanceData::getModelMatrixAttributeDescriptions();
-    auto instanceNormalMatrixAttributes = InstanceData::getNormalMatrixAttributeDescriptions();
+    auto vertexAttributeDescriptions = getMeshVertexAttributeDescriptions();
+    auto instanceAttributeDescriptions = InstanceData::getAttributeDescriptions();
     std::vector<vk::VertexInputAttributeDescription> allAttributes;
     allAttributes.insert(allAttributes.end(), vertexAttributeDescriptions.begin(), vertexAttributeDescriptions.end());
-    allAttributes.insert(allAttributes.end(), instanceModelMatrixAttributes.begin(), instanceModelMatrixAttributes.end());
-    allAttributes.insert(allAttributes.end(), instanceNormalMatrixAttributes.begin(), instanceNormalMatrixAttributes.end());
+    allAttributes.insert(allAttributes.end(), instanceAttributeDescriptions.begin(), instanceAttributeDescriptions.end());
 
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{
       .vertexBindingDescriptionCount = static_cast<uint32_t>(bindingDescriptions.size()),
@@ -970,7 +965,7 @@ bool Renderer::createLightingPipeline() {
     vk::PipelineShaderStageCreateInfo vertShaderStageInfo{
       .stage = vk::ShaderStageFlagBits::eVertex,
       .module = *shaderModule,
-      .pName = "VSMain"
+      .pName = getMeshVertexEntryPoint()
     };
 
     vk::PipelineShaderStageCreateInfo fragShaderStageInfo{
@@ -982,8 +977,8 @@ bool Renderer::createLightingPipeline() {
     vk::PipelineShaderStageCreateInfo shaderStages[] = {vertShaderStageInfo, fragShaderStageInfo};
 
     // Create vertex input info
-    auto bindingDescription = Vertex::getBindingDescription();
-    auto attributeDescriptions = Vertex::getAttributeDescriptions();
+    auto bindingDescription = getMeshVertexBindingDescription();
+    auto attributeDescriptions = getMeshVertexAttributeDescriptions();
 
     vk::PipelineVertexInputStateCreateInfo vertexInputInfo{
       .vertexBindingDescriptionCount = 1,
@@ -1123,6 +1118,35 @@ bool Renderer::createLightingPipeline() {
   }
 }
 
+vk::VertexInputBindingDescription Renderer::getMeshVertexBindingDescription() const {
+  return packedVertices ? PackedVertex::getBindingDescription() : Vertex::getBindingDescription();
+}
+
+std::array<vk::VertexInputAttributeDescription, 4> Renderer::getMeshVertexAttributeDescriptions() const {
+  return packedVertices ? PackedVertex::getAttributeDescriptions() : Vertex::getAttributeDescriptions();
+}
+
+bool Renderer::SetPackedVertices(bool packed) {
+  if (packed == packedVertices) {
+    return true;
+  }
+  if (!meshResources.empty()) {
+    std::cerr << "Cannot change the vertex layout while " << meshResources.size() << " meshes are resident" << std::endl;
+    return false;
+  }
+
+  // Rebuild every pipeline that reads mesh vertex buffers, as after a swap chain recreation
+  WaitIdle();
+  packedVertices = packed;
+  bool ok = createGraphicsPipeline() && createPBRPipeline() && createLightingPipeline();
+  if (ok && useForwardPlus) {
+    ok = createDepthPrepassPipeline();
+  }
+  LOG_INFO("Renderer", std::string("Vertex layout: ") + (packed ? "packed" : "standard") + " (" +
+      std::to_string(getMeshVertexBindingDescription().stride) + " bytes per vertex)");
+  return ok;
+}
+
 // Push material properties to the pipeline
 void Renderer::pushMaterialProperties(vk::CommandBuffer commandBuffer, const MaterialProperties& material) const {
   commandBuffer.pushConstants(*pbrPipelineLayout, vk::ShaderStageFlagBits::eFragment, 0, sizeof(MaterialProperties), &material);
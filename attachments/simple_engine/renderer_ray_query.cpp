@@ -23,6 +23,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <iostream>
 #include <map>
+#include <unordered_map>
 #include <unordered_set>
 
 // Helper function to get buffer device address
@@ -101,7 +102,7 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
     };
     kickWatchdog();
 
-    std::cout << "Building acceleration structures for " << entities.size() << " entities..." << std::endl;
+    LOG_INFO("AS", "Building acceleration structures for " + std::to_string(entities.size()) + " entities...");
 
     // PRECHECK: Determine how many renderable entities and unique meshes are READY right now.
     // If the counts would shrink compared to the last successful build (e.g., streaming not done),
@@ -152,27 +153,11 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
     }
 
     if (readyRenderableCount == 0 || readyUniqueMeshCount == 0) {
-      std::cout << "AS build skipped: no ready meshes yet (renderables=" << readyRenderableCount
-          << ", uniqueMeshes=" << readyUniqueMeshCount << ")\n";
+      LOG_INFO("AS", "Build skipped: no ready meshes yet (renderables=" + std::to_string(readyRenderableCount) +
+               ", uniqueMeshes=" + std::to_string(readyUniqueMeshCount) + ")");
       return false;
     }
 
-    // Move old AS structures to pending deletion queue
-    // They will be deleted after MAX_FRAMES_IN_FLIGHT frames to ensure all GPU work finishes
-    // This prevents "buffer destroyed while in use" errors without needing device.waitIdle()
-    // which would invalidate entity descriptor sets
-    if (!blasStructures.empty() || *tlasStructure.handle) {
-      PendingASDelete pendingDelete;
-      pendingDelete.blasStructures = std::move(blasStructures);
-      pendingDelete.tlasStructure = std::move(tlasStructure);
-      pendingDelete.framesSinceDestroy = 0;
-      pendingASDeletions.push_back(std::move(pendingDelete));
-    }
-
-    // Clear the moved-from containers (they're now empty)
-    blasStructures.clear();
-    tlasStructure = AccelerationStructure{};
-
     // Map mesh components to BLAS indices
     std::map<MeshComponent *, uint32_t> meshToBLAS;
     std::vector<MeshComponent *> uniqueMeshes;
@@ -257,16 +242,109 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
     }
 
     // One concise build summary (no per-entity spam)
-    std::cout << "Building AS: uniqueMeshes=" << uniqueMeshes.size()
-        << ", entities=" << renderableEntities.size()
-        << " (skipped inactive=" << skippedInactive
-        << ", noMesh=" << skippedNoMesh
-        << ", noRes=" << skippedNoRes
-        << ", pendingUploads=" << skippedPendingUploads
-        << ", nullBuffers=" << skippedNullBuffers
-        << ", zeroIndices=" << skippedZeroIndices
-        << ", exception=" << skippedException
-        << ")\n";
+    LOG_INFO("AS", "Building AS: uniqueMeshes=" + std::to_string(uniqueMeshes.size()) +
+        ", entities=" + std::to_string(renderableEntities.size()) +
+        " (skipped inactive=" + std::to_string(skippedInactive) +
+        ", noMesh=" + std::to_string(skippedNoMesh) +
+        ", noRes=" + std::to_string(skippedNoRes) +
+        ", pendingUploads=" + std::to_string(skippedPendingUploads) +
+        ", nullBuffers=" + std::to_string(skippedNullBuffers) +
+        ", zeroIndices=" + std::to_string(skippedZeroIndices) +
+        ", exception=" + std::to_string(skippedException) + ")");
+
+    // Keep the BLAS of meshes that an earlier update built from the same GPU buffers; only the
+    // remaining meshes are built below, so streaming costs BLAS work for the new meshes only.
+    // BLAS whose mesh left the scene (or was re-uploaded) are retired together with the old TLAS.
+    const bool compactBLAS = enableBLASCompaction;
+    if (blasSources.size() != blasStructures.size()) {
+      blasSources.assign(blasStructures.size(), BLASSource{}); // unknown origin: rebuild them all
+    }
+    std::unordered_map<MeshComponent *, uint32_t> cachedBLAS;
+    cachedBLAS.reserve(blasSources.size());
+    for (uint32_t i = 0; i < static_cast<uint32_t>(blasSources.size()); ++i) {
+      cachedBLAS[blasSources[i].mesh] = i;
+    }
+    std::vector<AccelerationStructure> nextBLAS(uniqueMeshes.size());
+    std::vector<BLASSource> nextSources(uniqueMeshes.size());
+    std::vector<uint32_t> blasToBuild; // indices into uniqueMeshes
+    std::vector<BLASSource> builtSources; // recorded once the BLAS exist
+    std::vector<bool> cachedKept(blasSources.size(), false);
+    for (uint32_t i = 0; i < static_cast<uint32_t>(uniqueMeshes.size()); ++i) {
+      MeshComponent* meshComp = uniqueMeshes[i];
+      const auto& meshRes = meshResources.at(meshComp);
+      const BLASSource source{
+        .mesh = meshComp,
+        .vertexBuffer = *meshRes.vertexBuffer,
+        .indexBuffer = *meshRes.indexBuffer,
+        .indexCount = meshRes.indexCount,
+        .compacted = compactBLAS
+      };
+      auto cached = cachedBLAS.find(meshComp);
+      if (cached != cachedBLAS.end() && !cachedKept[cached->second]) {
+        const BLASSource& built = blasSources[cached->second];
+        if (!!*blasStructures[cached->second].handle &&
+            built.vertexBuffer == source.vertexBuffer && built.indexBuffer == source.indexBuffer &&
+            built.indexCount == source.indexCount && built.compacted == source.compacted) {
+          nextBLAS[i] = std::move(blasStructures[cached->second]);
+          nextSources[i] = built;
+          cachedKept[cached->second] = true;
+          continue;
+        }
+      }
+      blasToBuild.push_back(i);
+      builtSources.push_back(source);
+    }
+    PendingASDelete retiredAS;
+    for (uint32_t i = 0; i < static_cast<uint32_t>(cachedKept.size()); ++i) {
+      if (!cachedKept[i] && !!*blasStructures[i].handle) {
+        retiredAS.blasStructures.push_back(std::move(blasStructures[i]));
+      }
+    }
+    const uint32_t reusedBLAS = static_cast<uint32_t>(uniqueMeshes.size() - blasToBuild.size());
+    const uint32_t retiredBLAS = static_cast<uint32_t>(retiredAS.blasStructures.size());
+    blasStructures = std::move(nextBLAS);
+    blasSources = std::move(nextSources);
+
+    // With every BLAS reused and the same TLAS instances, only transforms can have changed, and
+    // refitTopLevelAS keeps those current every frame. Keep the TLAS instead of rebuilding it.
+    if (blasToBuild.empty() && retiredBLAS == 0 && !!*tlasStructure.handle && !IsRayQueryStaticOnly() &&
+        tlasInstanceOrder.size() == tlasInstanceCount) {
+      bool sameInstances = true;
+      size_t refIndex = 0;
+      for (Entity* entity : renderableEntities) {
+        const size_t meshInstCount = entity->GetComponent<MeshComponent>()->GetInstanceCount();
+        const size_t instCount = std::max<size_t>(1, meshInstCount);
+        for (size_t iInst = 0; iInst < instCount && sameInstances; ++iInst, ++refIndex) {
+          sameInstances = refIndex < tlasInstanceOrder.size() &&
+                          tlasInstanceOrder[refIndex].entity == entity &&
+                          tlasInstanceOrder[refIndex].instanced == (meshInstCount > 0) &&
+                          tlasInstanceOrder[refIndex].instanceIndex == static_cast<uint32_t>(meshInstCount > 0 ? iInst : 0);
+        }
+        if (!sameInstances) {
+          break;
+        }
+      }
+      if (sameInstances && refIndex == tlasInstanceOrder.size()) {
+        lastBLASBuildStats = BLASBuildStats{};
+        lastBLASBuildStats.blasReused = reusedBLAS;
+        lastBLASBuildStats.totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - asStartCpu).count();
+        lastASBuiltBLASCount = blasStructures.size();
+        lastASBuiltInstanceCount = renderableEntities.size();
+        LOG_INFO("AS", "Update kept the TLAS: " + std::to_string(reusedBLAS) + " BLAS reused, instances unchanged (refit only)");
+        return true;
+      }
+    }
+
+    // Move the old TLAS and the retired BLAS to the pending deletion queue
+    // They will be deleted after MAX_FRAMES_IN_FLIGHT frames to ensure all GPU work finishes
+    // This prevents "buffer destroyed while in use" errors without needing device.waitIdle()
+    // which would invalidate entity descriptor sets
+    retiredAS.tlasStructure = std::move(tlasStructure);
+    tlasStructure = AccelerationStructure{};
+    if (!retiredAS.blasStructures.empty() || *retiredAS.tlasStructure.handle) {
+      retiredAS.framesSinceDestroy = 0;
+      pendingASDeletions.push_back(std::move(retiredAS));
+    }
 
     // Create a dedicated command pool for AS building to avoid threading issues
     // The main commandPool may be in use by the render thread
@@ -276,26 +354,34 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
 
     vk::raii::CommandPool asBuildCommandPool(device, poolInfo);
 
-    // Create command buffer for AS building
+    // Create command buffers for AS building: BLAS builds first, then (after their compacted
+    // sizes have been read back) the compaction copies and the TLAS build
     vk::CommandBufferAllocateInfo allocInfo{};
     allocInfo.commandPool = *asBuildCommandPool;
     allocInfo.level = vk::CommandBufferLevel::ePrimary;
-    allocInfo.commandBufferCount = 1;
+    allocInfo.commandBufferCount = 2;
 
     vk::raii::CommandBuffers cmdBuffers(device, allocInfo);
-    vk::raii::CommandBuffer& cmdBuffer = cmdBuffers[0];
+    vk::raii::CommandBuffer& blasCmdBuffer = cmdBuffers[0];
+    vk::raii::CommandBuffer& cmdBuffer = cmdBuffers[1];
 
-    cmdBuffer.begin(vk::CommandBufferBeginInfo{
+    blasCmdBuffer.begin(vk::CommandBufferBeginInfo{
       .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
     });
 
     // (Vespa-only debugging removed; keep logs quiet.)
 
-    // Build BLAS for each unique mesh
-    blasStructures.resize(uniqueMeshes.size());
-
-    // Progress model: BLAS phase dominates. Treat TLAS + post buffers as a few extra steps.
-    const uint32_t totalSteps = static_cast<uint32_t>(uniqueMeshes.size()) + 3u;
+    // Build BLAS for the meshes that have none yet
+    const uint32_t blasCount = static_cast<uint32_t>(blasToBuild.size());
+    lastBLASBuildStats = BLASBuildStats{};
+    lastBLASBuildStats.blasCount = blasCount;
+    lastBLASBuildStats.blasReused = reusedBLAS;
+    lastBLASBuildStats.blasRetired = retiredBLAS;
+    lastBLASBuildStats.tlasRebuilt = true;
+
+    // Progress model: BLAS builds (and compaction) dominate. Treat TLAS + post buffers as a few extra steps.
+    const uint32_t blasSteps = compactBLAS ? 2u * blasCount : blasCount;
+    const uint32_t totalSteps = blasSteps + 3u;
     setASUi(true, "AS: build BLAS", 0.0f, 0u, totalSteps);
 
     // Keep scratch buffers alive until GPU execution completes (after fence wait)
@@ -303,33 +389,51 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
     std::vector<vk::raii::Buffer> scratchBuffers;
     std::vector<std::unique_ptr<MemoryPool::Allocation>> scratchAllocations;
 
-    for (size_t i = 0; i < uniqueMeshes.size(); ++i) {
+    const vk::DeviceSize scratchAlignment = std::max<vk::DeviceSize>(
+      physicalDevice.getProperties2<vk::PhysicalDeviceProperties2, vk::PhysicalDeviceAccelerationStructurePropertiesKHR>()
+      .get<vk::PhysicalDeviceAccelerationStructurePropertiesKHR>()
+      .minAccelerationStructureScratchOffsetAlignment,
+      1);
+    auto alignUp = [](vk::DeviceSize value, vk::DeviceSize alignment) {
+      return (value + alignment - 1) / alignment * alignment;
+    };
+
+    // Describe every BLAS first, then split them into batches whose scratch fits the arena budget.
+    // A batch is recorded with a single buildAccelerationStructuresKHR call and its builds use
+    // disjoint ranges of one scratch arena, which is reused by the next batch after a barrier.
+    struct BLASBuild {
+      vk::AccelerationStructureGeometryKHR geometry{};
+      vk::AccelerationStructureBuildRangeInfoKHR range{};
+      vk::DeviceSize size = 0;
+      vk::DeviceSize scratchOffset = 0; // within the arena
+    };
+    std::vector<BLASBuild> blasBuilds(blasCount);
+    std::vector<std::pair<uint32_t, uint32_t>> blasBatches; // [first, end)
+
+    vk::BuildAccelerationStructureFlagsKHR blasFlags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
+    if (compactBLAS) {
+      blasFlags |= vk::BuildAccelerationStructureFlagBitsKHR::eAllowCompaction;
+    }
+
+    vk::DeviceSize arenaSize = 0;
+    vk::DeviceSize batchScratch = 0;
+    uint32_t batchFirst = 0;
+    for (uint32_t i = 0; i < blasCount; ++i) {
       kickWatchdog();
-      // Update UI progress (BLAS)
-      setASUi(true,
-              "AS: build BLAS",
-              totalSteps > 0 ? static_cast<float>(static_cast<uint32_t>(i)) / static_cast<float>(totalSteps) : 0.0f,
-              static_cast<uint32_t>(i),
-              totalSteps);
 
-      MeshComponent* meshComp = uniqueMeshes[i];
+      MeshComponent* meshComp = uniqueMeshes[blasToBuild[i]];
       auto& meshRes = meshResources.at(meshComp);
+      BLASBuild& build = blasBuilds[i];
 
       // Get buffer device addresses
       vk::DeviceAddress vertexAddress = getBufferDeviceAddress(device, *meshRes.vertexBuffer);
       vk::DeviceAddress indexAddress = getBufferDeviceAddress(device, *meshRes.indexBuffer);
 
-      // Compute vertex and index counts for this mesh
-      const uint32_t vertexCount = static_cast<uint32_t>(meshComp->GetVertices().size());
-      const auto& indicesCPU = meshComp->GetIndices();
-      uint32_t maxIndexValue = 0;
-      if (!indicesCPU.empty()) {
-        // Find the maximum index actually referenced by this mesh
-        maxIndexValue = *std::max_element(indicesCPU.begin(), indicesCPU.end());
-      }
+      // Compute vertex count for this mesh
+      const uint32_t vertexCount = meshComp->GetVertexCount();
 
       // Create geometry info
-      vk::AccelerationStructureGeometryKHR geometry{};
+      vk::AccelerationStructureGeometryKHR& geometry = build.geometry;
       geometry.geometryType = vk::GeometryTypeKHR::eTriangles;
       // Mark geometry as OPAQUE to ensure closest hits are committed reliably for primary rays
       // (we can re-introduce transparency later with any-hit/candidate handling)
@@ -337,7 +441,8 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
 
       geometry.geometry.triangles.vertexFormat = vk::Format::eR32G32B32Sfloat;
       geometry.geometry.triangles.vertexData = vertexAddress;
-      geometry.geometry.triangles.vertexStride = sizeof(Vertex);
+      // Both vertex layouts start with a float3 position
+      geometry.geometry.triangles.vertexStride = getMeshVertexBindingDescription().stride;
       // Set maxVertex to the total vertex count for this mesh. This is the most robust
       // setting across drivers and content, and avoids culling triangles that reference
       // high vertex indices (observed to hide unique, single-instance meshes).
@@ -345,88 +450,217 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
       geometry.geometry.triangles.indexType = vk::IndexType::eUint32;
       geometry.geometry.triangles.indexData = indexAddress;
 
-      // Build info
-      vk::AccelerationStructureBuildGeometryInfoKHR buildInfo{};
-      buildInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
-      buildInfo.flags = vk::BuildAccelerationStructureFlagBitsKHR::ePreferFastTrace;
-      buildInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
-      buildInfo.geometryCount = 1;
-      buildInfo.pGeometries = &geometry;
-
-      uint32_t primitiveCount = meshRes.indexCount / 3;
+      build.range.primitiveCount = meshRes.indexCount / 3;
+      build.range.primitiveOffset = 0;
+      build.range.firstVertex = 0;
+      build.range.transformOffset = 0;
 
       // Get size requirements
+      vk::AccelerationStructureBuildGeometryInfoKHR sizeQuery{};
+      sizeQuery.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+      sizeQuery.flags = blasFlags;
+      sizeQuery.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
+      sizeQuery.geometryCount = 1;
+      sizeQuery.pGeometries = &geometry;
       vk::AccelerationStructureBuildSizesInfoKHR sizeInfo = device.getAccelerationStructureBuildSizesKHR(
         vk::AccelerationStructureBuildTypeKHR::eDevice,
-        buildInfo,
-        primitiveCount);
+        sizeQuery,
+        build.range.primitiveCount);
+      build.size = sizeInfo.accelerationStructureSize;
+
+      // A BLAS larger than the budget gets a batch (and arena) of its own
+      const vk::DeviceSize scratch = alignUp(sizeInfo.buildScratchSize, scratchAlignment);
+      if (i > batchFirst && batchScratch + scratch > BLAS_SCRATCH_ARENA_BUDGET) {
+        blasBatches.emplace_back(batchFirst, i);
+        batchFirst = i;
+        batchScratch = 0;
+      }
+      build.scratchOffset = batchScratch;
+      batchScratch += scratch;
+      arenaSize = std::max(arenaSize, batchScratch);
 
       // Create BLAS buffer
       auto [blasBuffer, blasAlloc] = createBufferPooled(
-        sizeInfo.accelerationStructureSize,
+        build.size,
         vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
 
       // Create acceleration structure
       vk::AccelerationStructureCreateInfoKHR createInfo{};
       createInfo.buffer = *blasBuffer;
-      createInfo.size = sizeInfo.accelerationStructureSize;
+      createInfo.size = build.size;
       createInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
 
-      vk::raii::AccelerationStructureKHR blasHandle(device, createInfo);
+      // Store BLAS (move RAII handles to avoid copies)
+      AccelerationStructure& blas = blasStructures[blasToBuild[i]];
+      blas.handle = vk::raii::AccelerationStructureKHR(device, createInfo);
+      blas.buffer = std::move(blasBuffer);
+      blas.allocation = std::move(blasAlloc);
+      lastBLASBuildStats.buildBytes += build.size;
+    }
 
-      // Create scratch buffer
-      auto [scratchBuffer, scratchAlloc] = createBufferPooled(
-        sizeInfo.buildScratchSize,
+    // One scratch arena shared by all batches; over-allocate so its start can be aligned
+    vk::DeviceAddress arenaAddress = 0;
+    if (blasCount > 0) {
+      blasBatches.emplace_back(batchFirst, blasCount);
+      auto [scratchArena, scratchArenaAlloc] = createBufferPooled(
+        arenaSize + scratchAlignment,
         vk::BufferUsageFlagBits::eStorageBuffer | vk::BufferUsageFlagBits::eShaderDeviceAddress,
         vk::MemoryPropertyFlagBits::eDeviceLocal);
+      arenaAddress = alignUp(getBufferDeviceAddress(device, *scratchArena), scratchAlignment);
+      scratchBuffers.push_back(std::move(scratchArena));
+      scratchAllocations.push_back(std::move(scratchArenaAlloc));
+    }
+    lastBLASBuildStats.scratchBytes = arenaSize;
+    lastBLASBuildStats.batches = static_cast<uint32_t>(blasBatches.size());
+
+    // Compacted sizes are written into a query pool right after each batch
+    vk::raii::QueryPool compactedSizeQueries = nullptr;
+    if (compactBLAS && blasCount > 0) {
+      compactedSizeQueries = vk::raii::QueryPool(device, vk::QueryPoolCreateInfo{
+                                                   .queryType = vk::QueryType::eAccelerationStructureCompactedSizeKHR,
+                                                   .queryCount = blasCount
+                                                 });
+      blasCmdBuffer.resetQueryPool(*compactedSizeQueries, 0, blasCount);
+    }
 
-      vk::DeviceAddress scratchAddress = getBufferDeviceAddress(device, *scratchBuffer);
-
-      // Update build info with handles (dereference RAII handle)
-      buildInfo.dstAccelerationStructure = *blasHandle;
-      buildInfo.scratchData = scratchAddress;
+    // Orders each batch after the previous one (the scratch arena is reused) and makes the
+    // finished BLAS visible to the compacted size queries
+    vk::MemoryBarrier2 buildBarrier{};
+    buildBarrier.srcStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR;
+    buildBarrier.srcAccessMask = vk::AccessFlagBits2::eAccelerationStructureWriteKHR;
+    buildBarrier.dstStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR;
+    buildBarrier.dstAccessMask = vk::AccessFlagBits2::eAccelerationStructureReadKHR | vk::AccessFlagBits2::eAccelerationStructureWriteKHR;
+    vk::DependencyInfo buildDepInfo{};
+    buildDepInfo.memoryBarrierCount = 1;
+    buildDepInfo.pMemoryBarriers = &buildBarrier;
+
+    std::vector<vk::AccelerationStructureBuildGeometryInfoKHR> batchInfos;
+    std::vector<const vk::AccelerationStructureBuildRangeInfoKHR *> batchRanges;
+    std::vector<vk::AccelerationStructureKHR> batchHandles;
+    for (const auto& [first, end] : blasBatches) {
+      kickWatchdog();
+      batchInfos.clear();
+      batchRanges.clear();
+      batchHandles.clear();
+      for (uint32_t i = first; i < end; ++i) {
+        const vk::AccelerationStructureKHR blasHandle = *blasStructures[blasToBuild[i]].handle;
+        vk::AccelerationStructureBuildGeometryInfoKHR buildInfo{};
+        buildInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+        buildInfo.flags = blasFlags;
+        buildInfo.mode = vk::BuildAccelerationStructureModeKHR::eBuild;
+        buildInfo.dstAccelerationStructure = blasHandle;
+        buildInfo.geometryCount = 1;
+        buildInfo.pGeometries = &blasBuilds[i].geometry;
+        buildInfo.scratchData = arenaAddress + blasBuilds[i].scratchOffset;
+        batchInfos.push_back(buildInfo);
+        batchRanges.push_back(&blasBuilds[i].range);
+        batchHandles.push_back(blasHandle);
+      }
 
-      // Keep scratch buffer alive until after GPU execution (after fence wait)
-      scratchBuffers.push_back(std::move(scratchBuffer));
-      scratchAllocations.push_back(std::move(scratchAlloc));
+      // Record the whole batch - Vulkan-Hpp RAII takes array spans, not pointers
+      blasCmdBuffer.buildAccelerationStructuresKHR(batchInfos, batchRanges);
+      blasCmdBuffer.pipelineBarrier2(buildDepInfo);
+      if (compactBLAS) {
+        blasCmdBuffer.writeAccelerationStructuresPropertiesKHR(batchHandles, vk::QueryType::eAccelerationStructureCompactedSizeKHR, *compactedSizeQueries, first);
+      }
+    }
+    blasCmdBuffer.end();
 
-      // Build range info
-      vk::AccelerationStructureBuildRangeInfoKHR rangeInfo{};
-      rangeInfo.primitiveCount = primitiveCount;
-      rangeInfo.primitiveOffset = 0;
-      rangeInfo.firstVertex = 0;
-      rangeInfo.transformOffset = 0;
+    // Submit the BLAS builds and wait: compaction needs the sizes they report
+    if (blasCount > 0) {
+      vk::SubmitInfo blasSubmitInfo{};
+      blasSubmitInfo.commandBufferCount = 1;
+      blasSubmitInfo.pCommandBuffers = &(*blasCmdBuffer);
 
-      // Record build command - Vulkan-Hpp RAII takes array spans, not pointers
-      std::array<const vk::AccelerationStructureBuildRangeInfoKHR *, 1> rangeInfos = {&rangeInfo};
-      cmdBuffer.buildAccelerationStructuresKHR(buildInfo, rangeInfos);
+      vk::raii::Fence blasFence(device, vk::FenceCreateInfo{}); {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        graphicsQueue.submit(blasSubmitInfo, *blasFence);
+      }
+      (void) waitForFencesSafe(*blasFence, VK_TRUE);
+    }
+    setASUi(true,
+            compactBLAS ? "AS: compact BLAS" : "AS: build TLAS",
+            totalSteps > 0 ? static_cast<float>(blasCount) / static_cast<float>(totalSteps) : 0.0f,
+            blasCount,
+            totalSteps);
 
-      // Get device address (dereference RAII handle)
-      vk::AccelerationStructureDeviceAddressInfoKHR addressInfo{};
-      addressInfo.accelerationStructure = *blasHandle;
-      vk::DeviceAddress blasAddress = device.getAccelerationStructureAddressKHR(addressInfo);
+    cmdBuffer.begin(vk::CommandBufferBeginInfo{
+      .flags = vk::CommandBufferUsageFlagBits::eOneTimeSubmit
+    });
 
-      // Store BLAS (move RAII handle to avoid copy)
-      blasStructures[i].buffer = std::move(blasBuffer);
-      blasStructures[i].allocation = std::move(blasAlloc);
-      blasStructures[i].handle = std::move(blasHandle);
-      blasStructures[i].deviceAddress = blasAddress;
+    // Copy each BLAS into storage of its compacted size. The originals stay alive until the
+    // copies have executed and are then released through pendingASDeletions.
+    PendingASDelete uncompactedBLAS;
+    lastBLASBuildStats.compactedBytes = lastBLASBuildStats.buildBytes;
+    if (compactBLAS && blasCount > 0) {
+      auto [queryResult, compactedSizes] = compactedSizeQueries.getResults<vk::DeviceSize>(
+        0, blasCount, blasCount * sizeof(vk::DeviceSize), sizeof(vk::DeviceSize), vk::QueryResultFlagBits::e64 | vk::QueryResultFlagBits::eWait);
+      if (queryResult == vk::Result::eSuccess) {
+        for (uint32_t i = 0; i < blasCount; ++i) {
+          kickWatchdog();
+          const vk::DeviceSize compactedSize = compactedSizes[i];
+          if (compactedSize == 0 || compactedSize >= blasBuilds[i].size) {
+            continue;
+          }
 
-      // (Per-BLAS logging removed; keep logs quiet in production.)
+          auto [compactBuffer, compactAlloc] = createBufferPooled(
+            compactedSize,
+            vk::BufferUsageFlagBits::eAccelerationStructureStorageKHR | vk::BufferUsageFlagBits::eShaderDeviceAddress,
+            vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+          vk::AccelerationStructureCreateInfoKHR createInfo{};
+          createInfo.buffer = *compactBuffer;
+          createInfo.size = compactedSize;
+          createInfo.type = vk::AccelerationStructureTypeKHR::eBottomLevel;
+          vk::raii::AccelerationStructureKHR compactHandle(device, createInfo);
+
+          AccelerationStructure& blas = blasStructures[blasToBuild[i]];
+          cmdBuffer.copyAccelerationStructureKHR(vk::CopyAccelerationStructureInfoKHR{
+            .src = *blas.handle,
+            .dst = *compactHandle,
+            .mode = vk::CopyAccelerationStructureModeKHR::eCompact
+          });
+
+          uncompactedBLAS.blasStructures.push_back(std::move(blas));
+          blas = AccelerationStructure{};
+          blas.buffer = std::move(compactBuffer);
+          blas.allocation = std::move(compactAlloc);
+          blas.handle = std::move(compactHandle);
+          lastBLASBuildStats.compactedBytes -= blasBuilds[i].size - compactedSize;
+
+          if ((i & 63u) == 0) {
+            setASUi(true,
+                    "AS: compact BLAS",
+                    totalSteps > 0 ? static_cast<float>(blasCount + i) / static_cast<float>(totalSteps) : 0.0f,
+                    blasCount + i,
+                    totalSteps);
+          }
+        }
+      } else {
+        LOG_WARNING("AS", "Compacted BLAS sizes unavailable (" + vk::to_string(queryResult) + "), keeping uncompacted BLAS");
+      }
+    }
+    // Get device addresses of the new BLAS (dereference RAII handles) and remember what they were built from
+    for (uint32_t i = 0; i < blasCount; ++i) {
+      AccelerationStructure& blas = blasStructures[blasToBuild[i]];
+      vk::AccelerationStructureDeviceAddressInfoKHR addressInfo{};
+      addressInfo.accelerationStructure = *blas.handle;
+      blas.deviceAddress = device.getAccelerationStructureAddressKHR(addressInfo);
+      blasSources[blasToBuild[i]] = builtSources[i];
     }
+    lastBLASBuildStats.buildMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - asStartCpu).count();
+
     // BLAS done
     setASUi(true,
             "AS: build TLAS",
-            totalSteps > 0 ? static_cast<float>(static_cast<uint32_t>(uniqueMeshes.size())) / static_cast<float>(totalSteps) : 0.0f,
-            static_cast<uint32_t>(uniqueMeshes.size()),
+            totalSteps > 0 ? static_cast<float>(blasSteps) / static_cast<float>(totalSteps) : 0.0f,
+            blasSteps,
             totalSteps);
 
-    // Barrier between BLAS and TLAS builds
-
-    // Barrier between BLAS and TLAS builds
+    // Barrier between the BLAS compaction copies and the TLAS build
     vk::MemoryBarrier2 barrier{};
-    barrier.srcStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR;
+    barrier.srcStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR; // copies run in the build stage too
     barrier.srcAccessMask = vk::AccessFlagBits2::eAccelerationStructureWriteKHR;
     barrier.dstStageMask = vk::PipelineStageFlagBits2::eAccelerationStructureBuildKHR;
     barrier.dstAccessMask = vk::AccessFlagBits2::eAccelerationStructureReadKHR;
@@ -579,7 +813,7 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
         // Extract material index early so we can set TLAS instance flags per-instance.
         uint32_t resolvedMaterialIndex = 0;
         if (hasInstance && iInst < meshInstCount) {
-          resolvedMaterialIndex = meshComp->GetInstance(iInst).materialIndex;
+          resolvedMaterialIndex = meshComp->GetInstance(iInst).getMaterialIndex();
         } else {
           // Special case: Ball entities (named "Ball_N") use a red material
           // Use strict prefix match to avoid turning other objects red
@@ -649,7 +883,7 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
              glm::vec3 scale = transform ? transform->GetScale() : glm::vec3(1.0f);
              if (scale.x > 400.0f || scale.y > 400.0f || scale.z > 400.0f) {
                  isEnvironment = true;
-                 std::cout << "Entity '" << entity->GetName() << "' auto-classified as ENVIRONMENT (scale > 400)" << std::endl;
+                 LOG_DEBUG("AS", "Entity '" + entity->GetName() + "' auto-classified as ENVIRONMENT (scale > 400)");
              }
           }
 
@@ -741,11 +975,11 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
         GeometryInfo gi{};
         gi.vertexBufferAddress = vertexAddr;
         gi.indexBufferAddress = indexAddr;
-        gi.vertexCount = static_cast<uint32_t>(meshComp->GetVertices().size());
+        gi.vertexCount = meshComp->GetVertexCount();
         gi.materialIndex = resolvedMaterialIndex;
         // Provide indexCount so shader can bound-check primitiveIndex safely
         gi.indexCount = meshRes.indexCount;
-        gi._pad0 = 0;
+        gi.vertexFormat = packedVertices ? 1u : 0u; // VERTEX_FORMAT_PACKED : VERTEX_FORMAT_STANDARD
         // Store normal transform for correct world-space normals and tangent-space normal mapping.
         // Use the full per-instance finalModel (entityModel * instanceModel) to match raster.
         {
@@ -893,10 +1127,15 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
     // Wait with periodic watchdog kicks to avoid false hang detection on large scenes.
     (void) waitForFencesSafe(*fence, VK_TRUE);
     // TLAS build completed on GPU
+
+    // The compaction copies have executed; retire the uncompacted BLAS like any replaced AS
+    if (!uncompactedBLAS.blasStructures.empty()) {
+      pendingASDeletions.push_back(std::move(uncompactedBLAS));
+    }
     setASUi(true,
             "AS: upload buffers",
-            totalSteps > 0 ? static_cast<float>(static_cast<uint32_t>(uniqueMeshes.size()) + 1u) / static_cast<float>(totalSteps) : 0.0f,
-            static_cast<uint32_t>(uniqueMeshes.size()) + 1u,
+            totalSteps > 0 ? static_cast<float>(blasSteps + 1u) / static_cast<float>(totalSteps) : 0.0f,
+            blasSteps + 1u,
             totalSteps);
 
     // (Verbose TLAS composition dumps removed; keep logs quiet.)
@@ -932,8 +1171,8 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
     // Post buffers done
     setASUi(true,
             "AS: finalize",
-            totalSteps > 0 ? static_cast<float>(static_cast<uint32_t>(uniqueMeshes.size()) + 2u) / static_cast<float>(totalSteps) : 1.0f,
-            static_cast<uint32_t>(uniqueMeshes.size()) + 2u,
+            totalSteps > 0 ? static_cast<float>(blasSteps + 2u) / static_cast<float>(totalSteps) : 1.0f,
+            blasSteps + 2u,
             totalSteps);
 
     // Build material buffer with real materials from ModelLoader
@@ -1249,10 +1488,14 @@ bool Renderer::buildAccelerationStructures(const std::vector<Entity *>& entities
 
     setASUi(true, "AS: done", 1.0f, totalSteps, totalSteps);
     const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - asStartCpu).count();
-    std::cout << "AS build completed in " << (static_cast<double>(elapsedMs) / 1000.0)
-        << "s (uniqueMeshes=" << uniqueMeshes.size()
-        << ", entities=" << renderableEntities.size()
-        << ", tlasInstances=" << instanceCount << ")\n";
+    lastBLASBuildStats.totalMs = static_cast<double>(elapsedMs);
+    LOG_INFO("AS", "Build completed in " + std::to_string(elapsedMs) +
+        " ms (uniqueMeshes=" + std::to_string(uniqueMeshes.size()) +
+        ", BLAS built=" + std::to_string(blasCount) + " reused=" + std::to_string(reusedBLAS) + " retired=" + std::to_string(retiredBLAS) +
+        ", entities=" + std::to_string(renderableEntities.size()) +
+        ", tlasInstances=" + std::to_string(instanceCount) +
+        ", BLAS " + std::to_string(lastBLASBuildStats.buildBytes >> 20) + " MB -> " + std::to_string(lastBLASBuildStats.compactedBytes >> 20) +
+        " MB in " + std::to_string(lastBLASBuildStats.batches) + " batches)");
     return true;
   } catch (const std::exception& e) {
     const uint64_t startNs = asBuildUiStartNs.load(std::memory_order_relaxed);
@@ -20,12 +20,16 @@
 #include "model_loader.h"
 #include "renderer.h"
 #include "transform_component.h"
+#include "transform_system.h"
+#include "animation_system.h"
+#include "profiler.h"
 #include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <glm/gtx/norm.hpp>
 #include <iomanip>
 #include <iostream>
@@ -86,30 +90,168 @@ void Renderer::transformAABB(const glm::mat4& M,
 bool Renderer::aabbIntersectsFrustum(const glm::vec3& worldMin,
                                      const glm::vec3& worldMax,
                                      const FrustumPlanes& frustum) {
-  // Use the p-vertex test against each plane; if outside any plane → culled
-  for (const auto& p : frustum.planes) {
-    const glm::vec3 n(p.x, p.y, p.z);
-    // Choose positive vertex (furthest in direction of normal)
-    glm::vec3 v{
-      n.x >= 0.0f ? worldMax.x : worldMin.x,
-      n.y >= 0.0f ? worldMax.y : worldMin.y,
-      n.z >= 0.0f ? worldMax.z : worldMin.z
-    };
+  // The p-vertex test, shared with the frustum-cull kernel's self-check
+  return FrustumCullKernel::IntersectsBox(worldMin, worldMax, frustum.planes);
+}
+
+bool Renderer::prepareOcclusionBuffer(const glm::mat4& viewProj, const glm::vec3& cameraPos, uint64_t frustumVisibleTag) {
+  const uint32_t bufferHeight = std::max(16u, swapChainExtent.width > 0 ? occlusionBufferWidth * swapChainExtent.height / swapChainExtent.width : occlusionBufferWidth / 2);
+  if (occlusionCuller.GetWidth() != occlusionBufferWidth || occlusionCuller.GetHeight() != bufferHeight) {
+    occlusionCuller.Resize(occlusionBufferWidth, bufferHeight);
+  }
 
-    // If the most positive vertex is still on the negative side of the plane,
-    // then the entire box is on the negative side.
-    // Use a small epsilon to avoid numerical issues.
-    if (glm::dot(n, v) + p.w < -0.01f) {
-      return false; // completely outside
+  // Rank last frame's opaque, non-instanced, reasonably small meshes by angular size
+  occluderScratch.clear();
+  const float minScore = occluderMinAngularSize * occluderMinAngularSize;
+  for (const RenderJob& c : cullCandidates) {
+    const EntityResources& res = *c.entityRes;
+    if (!res.hasWorldAABB || res.lastVisibleFrame + 1 != cullFrameIndex || res.cachedIsBlended)
+      continue;
+    if (frustumVisibleTag != 0 && res.cullVisibleTag != frustumVisibleTag)
+      continue;
+    if (res.materialCacheValid && res.cachedMaterialProps.alphaMask > 0.5f)
+      continue; // alpha-tested surfaces have holes
+    if (c.meshComp->GetInstanceCount() > 1 || c.meshComp->GetVertices().empty() ||
+        c.meshComp->GetIndices().size() / 3 > maxOccluderTriangles)
+      continue;
+    const glm::vec3 center = 0.5f * (res.worldAABBMin + res.worldAABBMax);
+    const float radius2 = glm::length2(0.5f * (res.worldAABBMax - res.worldAABBMin));
+    const float score = radius2 / std::max(glm::length2(center - cameraPos), 1e-4f);
+    if (score >= minScore) {
+      occluderScratch.emplace_back(score, &c);
     }
   }
-  return true;
+  if (occluderScratch.size() > maxOccluders) {
+    std::ranges::nth_element(occluderScratch, occluderScratch.begin() + maxOccluders, std::greater<>{}, &std::pair<float, const RenderJob*>::first);
+    occluderScratch.resize(maxOccluders);
+  }
+
+  occlusionCuller.BeginFrame(viewProj);
+  static_assert(offsetof(Vertex, position) == 0, "occluder positions are read from the start of each vertex");
+  for (const auto& [score, job] : occluderScratch) {
+    MeshResources& meshRes = *job->meshRes;
+    const auto& indices = job->meshComp->GetIndices();
+    if (!meshRes.occluderAdjacencyBuilt) {
+      OcclusionCuller::BuildAdjacency(indices.data(), static_cast<uint32_t>(indices.size()), meshRes.occluderAdjacency);
+      meshRes.occluderAdjacencyBuilt = true;
+    }
+    glm::mat4 model = job->transformComp ? job->transformComp->GetModelMatrix() : glm::mat4(1.0f);
+    if (job->meshComp->GetInstanceCount() == 1) {
+      model = model * job->meshComp->GetInstances()[0].getModelMatrix();
+    }
+    occlusionCuller.AddOccluder({
+      .positions = &job->meshComp->GetVertices()[0].position.x,
+      .strideBytes = sizeof(Vertex),
+      .indices = indices.data(),
+      .indexCount = static_cast<uint32_t>(indices.size()),
+      .adjacency = meshRes.occluderAdjacency.size() == indices.size() ? meshRes.occluderAdjacency.data() : nullptr,
+      .model = model
+    });
+  }
+  // The record pool is idle during the preparation pass
+  occlusionCuller.Rasterize(recordThreadPool.get(), std::max(1u, recordWorkerCount));
+
+  if (occlusionDumpRequested) {
+    occlusionDumpRequested = false;
+    const bool ok = occlusionCuller.DumpDepthImage("occlusion_buffer.pgm");
+    std::cout << (ok ? "Wrote occlusion_buffer.pgm" : "Failed to write occlusion_buffer.pgm") << std::endl;
+  }
+  return !occluderScratch.empty();
+}
+
+void Renderer::updateEntitySpatialBounds(EntityResources& res, MeshComponent* meshComponent, TransformComponent* tc) {
+  if (!meshComponent->HasLocalAABB()) {
+    if (res.spatialProxy != SpatialIndex::InvalidProxy) {
+      sceneSpatialIndex.Remove(res.spatialProxy);
+      res.spatialProxy = SpatialIndex::InvalidProxy;
+    }
+    if (res.cullBoundsSlot != UINT32_MAX) {
+      const uint32_t moved = cullBounds.Remove(res.cullBoundsSlot);
+      if (moved != res.cullBoundsSlot) {
+        cullBoundsOwners[res.cullBoundsSlot] = cullBoundsOwners[moved];
+        cullBoundsOwners[res.cullBoundsSlot]->cullBoundsSlot = res.cullBoundsSlot;
+      }
+      cullBoundsOwners.pop_back();
+      res.cullBoundsSlot = UINT32_MAX;
+    }
+    res.hasWorldAABB = false;
+    return;
+  }
+
+  const glm::vec3& localMin = meshComponent->GetLocalAABBMin();
+  const glm::vec3& localMax = meshComponent->GetLocalAABBMax();
+  const uint32_t version = tc ? tc->GetVersion() : 0;
+  if (res.hasWorldAABB && res.spatialTransform == tc && res.spatialTransformVersion == version &&
+      res.spatialLocalMin == localMin && res.spatialLocalMax == localMax) {
+    return;
+  }
+
+  const glm::mat4 model = tc ? tc->GetModelMatrix() : glm::mat4(1.0f);
+  transformAABB(model, localMin, localMax, res.worldAABBMin, res.worldAABBMax);
+  res.spatialLocalMin = localMin;
+  res.spatialLocalMax = localMax;
+  res.spatialTransform = tc;
+  res.spatialTransformVersion = version;
+  res.hasWorldAABB = true;
+
+  if (res.spatialProxy == SpatialIndex::InvalidProxy) {
+    res.spatialProxy = sceneSpatialIndex.Insert(res.worldAABBMin, res.worldAABBMax, &res);
+  } else {
+    sceneSpatialIndex.Update(res.spatialProxy, res.worldAABBMin, res.worldAABBMax);
+  }
+  if (res.cullBoundsSlot == UINT32_MAX) {
+    res.cullBoundsSlot = cullBounds.Add(res.worldAABBMin, res.worldAABBMax);
+    cullBoundsOwners.push_back(&res);
+  } else {
+    cullBounds.Set(res.cullBoundsSlot, res.worldAABBMin, res.worldAABBMax);
+  }
+}
+
+uint64_t Renderer::markFrustumVisible(const FrustumPlanes& frustum, SpatialIndex::QueryStats* stats) {
+  const uint64_t tag = nextCullQueryTag++;
+  if (enableSpatialCulling) {
+    // Hierarchical query: whole subtrees outside a plane are skipped, fully-inside ones accepted untested
+    sceneSpatialIndex.QueryPlanes(frustum.planes, [tag](void* userData) {
+      static_cast<EntityResources*>(userData)->cullVisibleTag = tag;
+    }, stats);
+  } else {
+    // Flat SoA test, several boxes per instruction, writing a compacted list of visible slots
+    FrustumCullKernel::Cull(cullKernelIsa, cullBounds, frustum.planes, cullVisibleIndices);
+    for (uint32_t slot : cullVisibleIndices) {
+      cullBoundsOwners[slot]->cullVisibleTag = tag;
+    }
+    if (validateCullKernel && stats) {
+      FrustumCullKernel::Cull(FrustumCullKernel::Isa::Scalar, cullBounds, frustum.planes, cullReferenceIndices);
+      // Both lists are ascending: count the symmetric difference
+      const auto& a = cullVisibleIndices;
+      const auto& b = cullReferenceIndices;
+      uint32_t mismatches = 0;
+      size_t ia = 0, ib = 0;
+      while (ia < a.size() || ib < b.size()) {
+        if (ib == b.size() || (ia < a.size() && a[ia] < b[ib])) {
+          ++mismatches;
+          ++ia;
+        } else if (ia == a.size() || b[ib] < a[ia]) {
+          ++mismatches;
+          ++ib;
+        } else {
+          ++ia;
+          ++ib;
+        }
+      }
+      lastCullKernelMismatches = mismatches;
+    }
+  }
+  return tag;
 }
 
 // This file contains rendering-related methods from the Renderer class
 
 // Create swap chain
 bool Renderer::createSwapChain() {
+  if (headless) {
+    return createHeadlessImages();
+  }
   try {
     // Query swap chain support
     SwapChainSupportDetails swapChainSupport = querySwapChainSupport(physicalDevice);
@@ -176,6 +318,43 @@ bool Renderer::createSwapChain() {
   }
 }
 
+// Create the offscreen images that stand in for swapchain images when headless
+bool Renderer::createHeadlessImages() {
+  try {
+    headlessImages.clear();
+    headlessImageAllocations.clear();
+    swapChainImages.clear();
+
+    int width = 0, height = 0;
+    platform->GetWindowSize(&width, &height);
+    swapChainExtent = vk::Extent2D{static_cast<uint32_t>(std::max(width, 1)), static_cast<uint32_t>(std::max(height, 1))};
+    swapChainImageFormat = vk::Format::eB8G8R8A8Srgb;
+
+    // One more image than frames in flight, like a typical swapchain, so recording never waits
+    // on the image the GPU is still writing
+    const uint32_t imageCount = MAX_FRAMES_IN_FLIGHT + 1;
+    for (uint32_t i = 0; i < imageCount; ++i) {
+      auto [image, allocation] = createImagePooled(
+        swapChainExtent.width,
+        swapChainExtent.height,
+        swapChainImageFormat,
+        vk::ImageTiling::eOptimal,
+        vk::ImageUsageFlagBits::eColorAttachment | vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst,
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+      swapChainImages.push_back(*image);
+      headlessImages.push_back(std::move(image));
+      headlessImageAllocations.push_back(std::move(allocation));
+    }
+    swapChainImageLayouts.assign(swapChainImages.size(), vk::ImageLayout::eUndefined);
+    nextHeadlessImage = 0;
+
+    return true;
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to create headless images: " << e.what() << std::endl;
+    return false;
+  }
+}
+
 // ===================== Planar reflections resources =====================
 bool Renderer::createReflectionResources(uint32_t width, uint32_t height) {
   try {
@@ -398,6 +577,7 @@ void Renderer::renderReflectionPass(vk::raii::CommandBuffer& cmd,
 
   // Prepare frustum for mirrored view to allow culling
   FrustumPlanes reflectFrustum = extractFrustumPlanes(currentReflectionVP);
+  const uint64_t reflectVisibleTag = markFrustumVisible(reflectFrustum, nullptr);
 
   // Render all jobs (skip transparency)
   for (const auto& job : jobs) {
@@ -409,14 +589,9 @@ void Renderer::renderReflectionPass(vk::raii::CommandBuffer& cmd,
     if (entityRes->cachedIsBlended)
       continue;
 
-    // Frustum culling for mirrored view
-    if (meshComponent->HasLocalAABB()) {
-      const glm::mat4 model = job.transformComp ? job.transformComp->GetModelMatrix() : glm::mat4(1.0f);
-      glm::vec3 wmin, wmax;
-      transformAABB(model, meshComponent->GetLocalAABBMin(), meshComponent->GetLocalAABBMax(), wmin, wmax);
-      if (!aabbIntersectsFrustum(wmin, wmax, reflectFrustum)) {
-        continue; // culled from reflection
-      }
+    // Frustum culling for mirrored view (world bounds were refreshed in the preparation pass)
+    if (entityRes->hasWorldAABB && entityRes->cullVisibleTag != reflectVisibleTag) {
+      continue; // culled from reflection
     }
 
     // Bind geometry
@@ -458,7 +633,8 @@ void Renderer::renderReflectionPass(vk::raii::CommandBuffer& cmd,
 
     // Issue draw
     uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(meshComponent->GetInstanceCount()));
-    cmd.drawIndexed(meshRes->indexCount, instanceCount, 0, 0, 0);
+    const MeshLod lod = meshRes->getLod(job.lodLevel);
+    cmd.drawIndexed(lod.indexCount, instanceCount, lod.firstIndex, 0, 0);
   }
 
   cmd.endRendering();
@@ -647,6 +823,97 @@ bool Renderer::createSyncObjects() {
   }
 }
 
+// Create the timestamp query pool used to report GPU passes to the frame profiler
+void Renderer::createGpuProfiler() {
+  gpuProfileFrames.assign(MAX_FRAMES_IN_FLIGHT, GpuProfileFrame{});
+  gpuProfileQueryPool = nullptr;
+  gpuTimestampPeriod = 0.0f;
+  gpuTimestampMask = 0;
+
+  const auto properties = physicalDevice.getProperties();
+  const auto queueFamilies = physicalDevice.getQueueFamilyProperties();
+  const uint32_t graphicsFamily = queueFamilyIndices.graphicsFamily.value();
+  if (properties.limits.timestampPeriod <= 0.0f ||
+      graphicsFamily >= queueFamilies.size() || queueFamilies[graphicsFamily].timestampValidBits == 0) {
+    LOG_INFO("Profiler", "GPU timestamps not supported on the graphics queue; the profiler will show CPU scopes only");
+    return;
+  }
+
+  try {
+    vk::QueryPoolCreateInfo poolInfo{
+      .queryType = vk::QueryType::eTimestamp,
+      .queryCount = 2 * MAX_GPU_PROFILE_PASSES * MAX_FRAMES_IN_FLIGHT
+    };
+    gpuProfileQueryPool = vk::raii::QueryPool(device, poolInfo);
+    gpuTimestampPeriod = properties.limits.timestampPeriod;
+    const uint32_t validBits = queueFamilies[graphicsFamily].timestampValidBits;
+    gpuTimestampMask = validBits >= 64 ? ~0ull : (1ull << validBits) - 1;
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to create GPU profiler query pool: " << e.what() << std::endl;
+    gpuProfileQueryPool = nullptr;
+  }
+}
+
+// Report the GPU passes of the frame that last used this slot. Called after its fence was waited on.
+void Renderer::collectGpuProfile(uint32_t frameIndex) {
+  if (frameIndex >= gpuProfileFrames.size()) {
+    return;
+  }
+  GpuProfileFrame& frame = gpuProfileFrames[frameIndex];
+  if (!frame.pending) {
+    return;
+  }
+  frame.pending = false;
+  if (frame.passCount == 0 || !*gpuProfileQueryPool) {
+    return;
+  }
+
+  const uint32_t firstQuery = frameIndex * 2 * MAX_GPU_PROFILE_PASSES;
+  const uint32_t queryCount = 2 * frame.passCount;
+  auto [result, timestamps] = gpuProfileQueryPool.getResults<uint64_t>(
+    firstQuery, queryCount, queryCount * sizeof(uint64_t), sizeof(uint64_t), vk::QueryResultFlagBits::e64);
+  if (result != vk::Result::eSuccess) {
+    return;
+  }
+
+  // Without calibrated timestamps the GPU clock cannot be mapped exactly onto the CPU clock.
+  // Place the first pass at the submit time; durations and gaps between passes are exact.
+  // Only the low timestampValidBits are defined, and the counter may wrap between two passes,
+  // so the difference is taken modulo the valid range.
+  const uint64_t origin = timestamps[0] & gpuTimestampMask;
+  auto toProfilerClock = [&](uint64_t ticks) {
+    const uint64_t delta = ((ticks & gpuTimestampMask) - origin) & gpuTimestampMask;
+    return frame.submitNs + static_cast<uint64_t>(static_cast<double>(delta) * gpuTimestampPeriod);
+  };
+  auto& profiler = Profiler::GetInstance();
+  for (uint32_t i = 0; i < frame.passCount; ++i) {
+    profiler.RecordGpuPass(frame.names[i], toProfilerClock(timestamps[2 * i]), toProfilerClock(timestamps[2 * i + 1]));
+  }
+}
+
+// Write the start timestamp of a profiled GPU pass. Returns UINT32_MAX when the pass is not profiled.
+uint32_t Renderer::beginGpuPass(vk::raii::CommandBuffer& cmd, const char* name) {
+  if (currentFrame >= gpuProfileFrames.size()) {
+    return UINT32_MAX;
+  }
+  GpuProfileFrame& frame = gpuProfileFrames[currentFrame];
+  if (!frame.recording || frame.passCount >= MAX_GPU_PROFILE_PASSES) {
+    return UINT32_MAX;
+  }
+  const uint32_t pass = frame.passCount++;
+  frame.names[pass] = name;
+  // All-commands waits for earlier work, so passes do not overlap on the GPU track
+  cmd.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, *gpuProfileQueryPool, (currentFrame * MAX_GPU_PROFILE_PASSES + pass) * 2);
+  return pass;
+}
+
+void Renderer::endGpuPass(vk::raii::CommandBuffer& cmd, uint32_t pass) {
+  if (pass == UINT32_MAX) {
+    return;
+  }
+  cmd.writeTimestamp2(vk::PipelineStageFlagBits2::eAllCommands, *gpuProfileQueryPool, (currentFrame * MAX_GPU_PROFILE_PASSES + pass) * 2 + 1);
+}
+
 // Clean up swap chain
 void Renderer::cleanupSwapChain() {
   // Clean up depth resources
@@ -680,6 +947,9 @@ void Renderer::cleanupSwapChain() {
 
   // Clean up swap chain
   swapChain = vk::raii::SwapchainKHR(nullptr);
+  swapChainImages.clear();
+  headlessImages.clear();
+  headlessImageAllocations.clear();
 }
 
 // Recreate swap chain
@@ -935,7 +1205,7 @@ void Renderer::updateUniformBufferInternal(uint32_t currentImage, Entity* entity
   // Copy to uniform buffer (guard against null mapped pointer)
   void* dst = entityRes->uniformBuffersMapped[currentImage];
   if (!dst) {
-    std::cerr << "Warning: UBO mapped ptr null for entity '" << (entity ? entity->GetName() : "unknown") << "' frame " << currentImage << std::endl;
+    LOG_WARNING("Renderer", "UBO mapped ptr null for entity '" + (entity ? entity->GetName() : std::string("unknown")) + "' frame " + std::to_string(currentImage));
     return;
   }
   std::memcpy(dst, &finalUbo, sizeof(UniformBufferObject));
@@ -950,6 +1220,7 @@ void Renderer::ensureEntityMaterialCache(Entity* entity, EntityResources& res) {
 
   res.materialCacheValid = true;
   res.cachedMaterial = nullptr;
+  res.materialSortId = 0;
   res.cachedIsBlended = false;
   res.cachedIsGlass = false;
   res.cachedIsLiquid = false;
@@ -1029,6 +1300,13 @@ void Renderer::ensureEntityMaterialCache(Entity* entity, EntityResources& res) {
             const bool alphaBlend = (material->alphaMode == "BLEND");
             const bool highTransmission = (material->transmissionFactor > 0.2f);
             res.cachedIsBlended = alphaBlend || highTransmission || res.cachedIsGlass || res.cachedIsLiquid;
+
+            // Dense id for draw sort keys (0 is reserved for "no material")
+            if (materialSortIdsStale.exchange(false, std::memory_order_relaxed)) {
+              materialSortIds.clear();
+            }
+            auto [idIt, inserted] = materialSortIds.try_emplace(material, static_cast<uint32_t>(materialSortIds.size() + 1));
+            res.materialSortId = idIt->second;
           }
         }
       }
@@ -1051,6 +1329,7 @@ void Renderer::Render(const std::vector<std::unique_ptr<Entity>>& entities, Came
 
 // Render the scene (raw pointer snapshot overload)
 void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* camera, ImGuiSystem* imguiSystem) {
+  PROFILE_SCOPE("Renderer::Render");
   // Update watchdog timestamp to prove frame is progressing
   lastFrameUpdateTime.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
   watchdogProgressLabel.store("Render: frame begin", std::memory_order_relaxed);
@@ -1070,21 +1349,13 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
   // Track if ray query rendered successfully this frame to skip rasterization code path
   bool rayQueryRenderedThisFrame = false;
 
-  // --- Extract lights for the frame ---
-  // Build a single light list once per frame (emissive lights only for this scene)
-  std::vector<ExtractedLight> lightsSubset;
-  if (!staticLights.empty()) {
-    lightsSubset.reserve(std::min(staticLights.size(), static_cast<size_t>(MAX_ACTIVE_LIGHTS)));
-    for (const auto& L : staticLights) {
-      // Include all lights (Directional, Point, Emissive) up to the limit
-      lightsSubset.push_back(L);
-      if (lightsSubset.size() >= MAX_ACTIVE_LIGHTS)
-        break;
-    }
-  }
-  lastFrameLightCount = static_cast<uint32_t>(lightsSubset.size());
-  if (!lightsSubset.empty()) {
-    updateLightStorageBuffer(currentFrame, lightsSubset, camera);
+  // --- Upload lights for the frame ---
+  // Static lights first, then dynamic ones, up to the limit. Only changed entries are rewritten.
+  updateSyntheticLights();
+  const size_t activeLightCount = std::min(staticLights.size() + dynamicLights.size(), static_cast<size_t>(MAX_ACTIVE_LIGHTS));
+  lastFrameLightCount = 0;
+  if (activeLightCount > 0) {
+    lastFrameLightCount = updateLightStorageBuffer(currentFrame, activeLightCount, camera);
   }
 
   // Pre-calculate frame-constant UBO data
@@ -1094,14 +1365,19 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
   // Use a finite timeout loop so we can keep the watchdog alive during long GPU work
   // (e.g., acceleration structure builds/refits can legitimately take seconds on large scenes).
   watchdogProgressLabel.store("Render: wait inFlightFence", std::memory_order_relaxed);
-  vk::Result fenceResult = waitForFencesSafe(*inFlightFences[currentFrame], VK_TRUE);
+  vk::Result fenceResult;
+  {
+    PROFILE_SCOPE("Wait for frame fence");
+    fenceResult = waitForFencesSafe(*inFlightFences[currentFrame], VK_TRUE);
+  }
   if (fenceResult != vk::Result::eSuccess) {
-    std::cerr << "Error: Failed to wait for in-flight fence: " << vk::to_string(fenceResult) << std::endl;
+    LOG_ERROR("Renderer", "Failed to wait for in-flight fence: " + vk::to_string(fenceResult));
   }
 
   // Reset the fence immediately after successful wait, before any new work
   watchdogProgressLabel.store("Render: reset inFlightFence", std::memory_order_relaxed);
   device.resetFences(*inFlightFences[currentFrame]);
+  collectGpuProfile(currentFrame);
 
   // Execute any pending GPU uploads (enqueued by worker/loading threads) on the render thread
   // at this safe point to ensure all Vulkan submits happen on a single thread.
@@ -1193,10 +1469,10 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
     // During scene loading/finalization, the TLAS may be built before all entities exist.
     // Allow rebuilds even if AS is "frozen" so the TLAS converges to the full scene across restarts.
     if ((!asFrozen || IsLoading()) && (readyRenderableCount > lastASBuiltInstanceCount || readyUniqueMeshCount > lastASBuiltBLASCount) && !asBuildRequested.load(std::memory_order_relaxed)) {
-      std::cout << "AS rebuild requested: counts increased (built instances=" << lastASBuiltInstanceCount
-          << ", ready instances=" << readyRenderableCount
-          << ", built meshes=" << lastASBuiltBLASCount
-          << ", ready meshes=" << readyUniqueMeshCount << ")\n";
+      LOG_INFO("AS", "Rebuild requested: counts increased (built instances=" + std::to_string(lastASBuiltInstanceCount) +
+               ", ready instances=" + std::to_string(readyRenderableCount) +
+               ", built meshes=" + std::to_string(lastASBuiltBLASCount) +
+               ", ready meshes=" + std::to_string(readyUniqueMeshCount) + ")");
       RequestAccelerationStructureBuild("counts increased");
     }
 
@@ -1206,8 +1482,8 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       const size_t targetInstances = readyRenderableCount;
       if (targetInstances > 0 && lastASBuiltInstanceCount < static_cast<size_t>(static_cast<double>(targetInstances) * 0.95)) {
         asDevOverrideAllowRebuild = true; // allow rebuild even if frozen
-        std::cout << "AS rebuild requested: post-load full build (built instances=" << lastASBuiltInstanceCount
-            << ", ready instances=" << targetInstances << ")\n";
+        LOG_INFO("AS", "Rebuild requested: post-load full build (built instances=" + std::to_string(lastASBuiltInstanceCount) +
+                 ", ready instances=" + std::to_string(targetInstances) + ")");
         RequestAccelerationStructureBuild("post-load full build");
       }
     }
@@ -1237,7 +1513,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       // Keep the request flag set; we'll build once the loader (and critical textures) finish.
     } else if (asFrozen && !asDevOverrideAllowRebuild && !IsLoading()) {
       // Ignore rebuilds while frozen to avoid wiping TLAS during animation playback
-      std::cout << "AS rebuild request ignored (frozen). Reason: " << lastASBuildRequestReason << "\n";
+      LOG_INFO("AS", "Rebuild request ignored (frozen). Reason: " + lastASBuildRequestReason);
       asBuildRequested.store(false, std::memory_order_release);
       asBuildRequestStartNs.store(0, std::memory_order_relaxed);
       watchdogSuppressed.store(false, std::memory_order_relaxed);
@@ -1321,9 +1597,9 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
         // Keep the request flag set; try again next frame
       } else {
         if (deferralTimedOut && readiness < buildThreshold && !asDevOverrideAllowRebuild) {
-          std::cout << "AS build forced after " << maxDeferralSeconds
-              << "s deferral (readiness " << readyRenderableCount << "/" << totalRenderableEntities
-              << ", uniqueMeshesReady=" << readyUniqueMeshCount << ")\n";
+          LOG_INFO("AS", "Build forced after " + std::to_string(static_cast<int>(maxDeferralSeconds)) +
+                   "s deferral (readiness " + std::to_string(readyRenderableCount) + "/" + std::to_string(totalRenderableEntities) +
+                   ", uniqueMeshesReady=" + std::to_string(readyUniqueMeshCount) + ")");
         }
         struct WatchdogSuppressGuard {
           std::atomic<bool>& flag;
@@ -1417,7 +1693,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
           } else {
             // If nothing is ready yet (e.g., mesh uploads still pending), don't spam logs.
             if (readyRenderableCount > 0 || readyUniqueMeshCount > 0) {
-              std::cout << "Failed to build acceleration structures, will retry next frame" << std::endl;
+              LOG_WARNING("AS", "Failed to build acceleration structures, will retry next frame");
             }
           }
         }
@@ -1441,20 +1717,36 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
   opaqueJobs.reserve(entities.size());
 
   {
+    PROFILE_SCOPE("Preparation pass");
     watchdogProgressLabel.store("Render: preparation pass", std::memory_order_relaxed);
 
     // Prepare frustum once per frame for culling
     FrustumPlanes frustum{};
     const bool doCulling = enableFrustumCulling && camera;
-    if (doCulling && camera) {
+    glm::mat4 cullViewProj(1.0f);
+    if (camera) {
       glm::mat4 proj = camera->GetProjectionMatrix();
       proj[1][1] *= -1.0f;
-      const glm::mat4 vp = proj * camera->GetViewMatrix();
-      frustum = extractFrustumPlanes(vp);
+      cullViewProj = proj * camera->GetViewMatrix();
     }
+    // Cluster culling tests meshlets against the same planes; only the opaque PBR pipelines cull back faces
+    const bool doClusterCulling = enableClusterCulling && camera;
+    const bool clusterConeCulling = enableClusterConeCulling && !(imguiSystem && !imguiSystem->IsPBREnabled());
+    if (doCulling || doClusterCulling) {
+      frustum = extractFrustumPlanes(cullViewProj);
+    }
+    clusterDrawCommands.clear();
+    lastClusterCullStats = {};
     lastCullingVisibleCount = 0;
     lastCullingCulledCount = 0;
-
+    lastOcclusionCulledCount = 0;
+    lastFrameTriangles = 0;
+    lastFrameFullDetailTriangles = 0;
+    lastFrameLodDraws.fill(0);
+    ++cullFrameIndex;
+    const glm::vec3 sortCameraPos = camera ? camera->GetPosition() : glm::vec3(0.0f);
+
+    cullCandidates.clear();
     uint32_t entityProcessCount = 0;
     for (Entity* entity : entities) {
       if (!entity || !entity->IsActive())
@@ -1511,22 +1803,54 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
         }
       }
 
-      // --- Culling & Classification ---
+      // Keep the cached world bounds and spatial index in sync with the transform
       auto* tc = entity->GetComponent<TransformComponent>();
+      updateEntitySpatialBounds(entityRes, meshComponent, tc);
+      cullCandidates.push_back(RenderJob{entity, &entityRes, &meshRes, meshComponent, tc, false});
+
+      // Update watchdog periodically
+      if (++entityProcessCount % 100 == 0) {
+        lastFrameUpdateTime.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+      }
+    }
+
+    // Frustum visibility for all candidates at once (hierarchical when the spatial index is enabled)
+    uint64_t visibleTag = 0;
+    if (doCulling) {
+      lastCullQueryStats = {};
+      const auto cullStart = std::chrono::steady_clock::now();
+      visibleTag = markFrustumVisible(frustum, &lastCullQueryStats);
+      lastCullQueryMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cullStart).count();
+    }
+
+    // Software occlusion buffer from last frame's largest visible occluders, re-rasterized with this frame's camera
+    const bool doOcclusion = enableOcclusionCulling && camera && prepareOcclusionBuffer(cullViewProj, sortCameraPos, visibleTag);
+    lastOcclusionTestMs = 0.0;
+
+    // --- Culling & Classification ---
+    for (const RenderJob& candidate : cullCandidates) {
+      Entity* entity = candidate.entity;
+      EntityResources& entityRes = *candidate.entityRes;
+      MeshResources& meshRes = *candidate.meshRes;
+      MeshComponent* meshComponent = candidate.meshComp;
+      TransformComponent* tc = candidate.transformComp;
       bool useBlended = entityRes.cachedIsBlended;
+      // Reference point for the depth part of the sort key (AABB center when available)
+      glm::vec3 sortCenter = tc ? tc->GetPosition() : glm::vec3(0.0f);
+      uint32_t lodLevel = 0;
 
-      if (meshComponent->HasLocalAABB()) {
-        const glm::mat4 model = tc ? tc->GetModelMatrix() : glm::mat4(1.0f);
-        glm::vec3 wmin, wmax;
-        transformAABB(model, meshComponent->GetLocalAABBMin(), meshComponent->GetLocalAABBMax(), wmin, wmax);
+      if (entityRes.hasWorldAABB) {
+        const glm::vec3& wmin = entityRes.worldAABBMin;
+        const glm::vec3& wmax = entityRes.worldAABBMax;
+        sortCenter = 0.5f * (wmin + wmax);
 
         // 1. Frustum Culling
-        if (doCulling && !aabbIntersectsFrustum(wmin, wmax, frustum)) {
+        if (doCulling && entityRes.cullVisibleTag != visibleTag) {
           lastCullingCulledCount++;
           continue;
         }
 
-        // 2. Distance-based LOD
+        // 2. Distance-based LOD: skip objects below a few pixels, pick a mesh LOD level for the rest
         if (enableDistanceLOD && camera) {
           glm::vec3 camPos = camera->GetPosition();
           bool cameraInside = (camPos.x >= wmin.x && camPos.x <= wmax.x &&
@@ -1546,11 +1870,58 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
               lastCullingCulledCount++;
               continue;
             }
+            if (enableMeshLods) {
+              // Level errors are relative to the mesh radius, so they scale with the projected radius
+              lodLevel = meshRes.selectLod(pixelDiameter * 0.5f, lodErrorThresholdPixels);
+            }
           }
         }
+
+        // 3. Occlusion against the software depth buffer
+        if (doOcclusion) {
+          const auto testStart = std::chrono::steady_clock::now();
+          const bool visible = occlusionCuller.IsVisible(wmin, wmax);
+          lastOcclusionTestMs += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - testStart).count();
+          if (!visible) {
+            lastCullingCulledCount++;
+            lastOcclusionCulledCount++;
+            continue;
+          }
+        }
+      }
+
+      // 4. Cluster culling: a full-detail mesh draws only its meshlets inside the frustum and facing the camera
+      uint32_t clusterDrawFirst = 0;
+      uint32_t clusterDrawCount = 0;
+      uint64_t clusterTriangles = 0;
+      if (doClusterCulling && lodLevel == 0 && !meshRes.meshlets.empty() && meshComponent->GetInstanceCount() <= 1) {
+        glm::mat4 model = tc ? tc->GetModelMatrix() : glm::mat4(1.0f);
+        if (meshComponent->GetInstanceCount() == 1) {
+          model = model * meshComponent->GetInstance(0).getModelMatrix();
+        }
+        const uint64_t visibleBefore = lastClusterCullStats.visibleTriangles;
+        clusterRanges.clear();
+        Meshlets::Cull(meshRes.meshlets, model, frustum.planes, sortCameraPos, clusterConeCulling && !useBlended, clusterRanges, lastClusterCullStats);
+        if (clusterRanges.empty()) {
+          lastCullingCulledCount++;
+          continue;
+        }
+        clusterTriangles = lastClusterCullStats.visibleTriangles - visibleBefore;
+        clusterDrawFirst = static_cast<uint32_t>(clusterDrawCommands.size());
+        clusterDrawCount = static_cast<uint32_t>(clusterRanges.size());
+        for (const Meshlets::DrawRange& range : clusterRanges) {
+          clusterDrawCommands.push_back(vk::DrawIndexedIndirectCommand{
+            .indexCount = range.indexCount,
+            .instanceCount = 1,
+            .firstIndex = range.firstIndex,
+            .vertexOffset = 0,
+            .firstInstance = 0
+          });
+        }
       }
 
       lastCullingVisibleCount++;
+      entityRes.lastVisibleFrame = cullFrameIndex;
       bool isAlphaMasked = false;
       if (entityRes.materialCacheValid) {
         isAlphaMasked = (entityRes.cachedMaterialProps.alphaMask > 0.5f);
@@ -1560,15 +1931,41 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       updateUniformBuffer(currentFrame, entity, &entityRes, camera, tc);
 
       RenderJob job{entity, &entityRes, &meshRes, meshComponent, tc, isAlphaMasked};
+      job.lodLevel = lodLevel;
+      job.clusterDrawFirst = clusterDrawFirst;
+      job.clusterDrawCount = clusterDrawCount;
+      {
+        const uint64_t instances = std::max<uint64_t>(1, meshComponent->GetInstanceCount());
+        lastFrameTriangles += clusterDrawCount > 0 ? clusterTriangles : meshRes.getLod(lodLevel).indexCount / 3 * instances;
+        lastFrameFullDetailTriangles += meshRes.indexCount / 3 * instances;
+        lastFrameLodDraws[std::min(lodLevel, MaxMeshLodLevels - 1)]++;
+      }
+      if (meshRes.sortId == 0) {
+        meshRes.sortId = nextMeshSortId++;
+      }
       if (useBlended) {
+        // Back-to-front by transform origin (matches the previous comparator), liquids before glass on ties
+        const glm::vec3 pos = tc ? tc->GetPosition() : glm::vec3(0.0f);
+        job.sortKey = DrawSortKey::MakeTransparent(glm::length2(pos - sortCameraPos), entityRes.cachedIsLiquid, entityRes.cachedIsGlass ? 1u : 0u);
         transparentJobs.push_back(job);
       } else {
+        // Pipeline id mirrors the opaque pass selection: masked geometry uses the depth-writing variant
+        job.sortKey = DrawSortKey::MakeOpaque(isAlphaMasked ? 1u : 0u, entityRes.materialSortId, meshRes.sortId, glm::length2(sortCenter - sortCameraPos));
         opaqueJobs.push_back(job);
       }
-
-      // Update watchdog periodically
-      if (++entityProcessCount % 100 == 0) {
-        lastFrameUpdateTime.store(std::chrono::steady_clock::now(), std::memory_order_relaxed);
+    }
+    // Group opaque draws by pipeline/material/mesh (front-to-back within a group) and order
+    // transparent draws back-to-front. Keys were computed once above; no comparator callbacks.
+    if (enableDrawSorting) {
+      sortRenderJobs(opaqueJobs);
+    }
+    sortRenderJobs(transparentJobs);
+    if (!uploadClusterDrawCommands()) {
+      // Without the indirect buffer every job draws its whole mesh, which is always correct
+      for (auto* jobs : {&opaqueJobs, &transparentJobs}) {
+        for (RenderJob& job : *jobs) {
+          job.clusterDrawCount = 0;
+        }
       }
     }
     watchdogProgressLabel.store("Render: after preparation pass", std::memory_order_relaxed);
@@ -1585,6 +1982,10 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
     const bool noDeferredDescOps = !descriptorRefreshPending.load(std::memory_order_relaxed);
     if (loaderDone && criticalDone && noASPending && noPreallocPending && noDirtyEntities && noDeferredDescOps) {
       MarkInitialLoadComplete();
+      LOG_INFO("Resources", "Content dedup this load: " + std::to_string(textureDedupHits.load(std::memory_order_relaxed)) + " textures (" +
+          std::to_string(textureDedupBytesSaved.load(std::memory_order_relaxed) / (1024 * 1024)) + " MB), " +
+          std::to_string(meshDedupHits.load(std::memory_order_relaxed)) + " mesh buffers (" +
+          std::to_string(meshDedupBytesSaved.load(std::memory_order_relaxed) / (1024 * 1024)) + " MB) shared");
     }
   }
 
@@ -1664,11 +2065,19 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
     }
   };
   try {
+    PROFILE_SCOPE("Acquire swapchain image");
     watchdogProgressLabel.store("Render: acquireNextImage", std::memory_order_relaxed);
-    auto acquireRet = swapChain.acquireNextImage(UINT64_MAX, *imageAvailableSemaphores[acquireSemaphoreIndex]);
-    // Vulkan-Hpp changed the return type of acquireNextImage for RAII swapchain across versions.
-    // Support both vk::ResultValue<uint32_t> (newer) and std::pair<vk::Result, uint32_t> (older).
-    extractAcquire(acquireRet, acquireResultCode, imageIndex);
+    if (headless) {
+      // Offscreen images are used round-robin. There is one more image than frames in flight,
+      // so the fence waited on above also covers the last frame that wrote this image.
+      imageIndex = nextHeadlessImage;
+      nextHeadlessImage = (nextHeadlessImage + 1) % static_cast<uint32_t>(swapChainImages.size());
+    } else {
+      auto acquireRet = swapChain.acquireNextImage(UINT64_MAX, *imageAvailableSemaphores[acquireSemaphoreIndex]);
+      // Vulkan-Hpp changed the return type of acquireNextImage for RAII swapchain across versions.
+      // Support both vk::ResultValue<uint32_t> (newer) and std::pair<vk::Result, uint32_t> (older).
+      extractAcquire(acquireRet, acquireResultCode, imageIndex);
+    }
   } catch (const vk::OutOfDateKHRError&) {
     watchdogProgressLabel.store("Render: acquireNextImage out-of-date", std::memory_order_relaxed);
     // Swapchain is out of date (e.g., window resized) before we could
@@ -1732,19 +2141,8 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
 
   // Ensure light buffers are sufficiently large before recording to avoid resizing while in use
   {
-    // Reserve capacity based on emissive lights only (punctual lights disabled for now)
-    size_t desiredLightCapacity = 0;
-    if (!staticLights.empty()) {
-      size_t emissiveCount = 0;
-      for (const auto& L : staticLights) {
-        if (L.type == ExtractedLight::Type::Emissive) {
-          ++emissiveCount;
-          if (emissiveCount >= MAX_ACTIVE_LIGHTS)
-            break;
-        }
-      }
-      desiredLightCapacity = emissiveCount;
-    }
+    // Reserve capacity for the lights uploaded at frame start
+    size_t desiredLightCapacity = lastFrameLightCount;
     if (desiredLightCapacity > 0) {
       createOrResizeLightStorageBuffers(desiredLightCapacity);
       // Ensure compute (binding 0) sees the current frame's lights buffer
@@ -1774,6 +2172,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
 
   commandBuffers[currentFrame].reset();
   // Begin command buffer recording for this frame
+  frameBindStats = FrameBindStats{};
   commandBuffers[currentFrame].begin(vk::CommandBufferBeginInfo());
   isRecordingCmd.store(true, std::memory_order_relaxed);
   if (framebufferResized.load(std::memory_order_relaxed)) {
@@ -1782,6 +2181,16 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
     return;
   }
 
+  // Reset this frame's timestamp queries when the profiler is on
+  if (currentFrame < gpuProfileFrames.size()) {
+    GpuProfileFrame& gpuProfile = gpuProfileFrames[currentFrame];
+    gpuProfile.passCount = 0;
+    gpuProfile.recording = Profiler::IsEnabled() && !!*gpuProfileQueryPool;
+    if (gpuProfile.recording) {
+      commandBuffers[currentFrame].resetQueryPool(*gpuProfileQueryPool, currentFrame * 2 * MAX_GPU_PROFILE_PASSES, 2 * MAX_GPU_PROFILE_PASSES);
+    }
+  }
+
   // Ray query rendering mode dispatch
   if (currentRenderMode == RenderMode::RayQuery && rayQueryEnabled && accelerationStructureEnabled) {
     // Check if TLAS handle is valid (dereference RAII handle)
@@ -1823,7 +2232,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
         swapchainBarrier.dstStageMask = vk::PipelineStageFlagBits2::eBottomOfPipe;
         swapchainBarrier.dstAccessMask = vk::AccessFlagBits2::eNone;
         swapchainBarrier.oldLayout = vk::ImageLayout::eTransferDstOptimal;
-        swapchainBarrier.newLayout = vk::ImageLayout::ePresentSrcKHR;
+        swapchainBarrier.newLayout = presentImageLayout;
         commandBuffers[currentFrame].pipelineBarrier2(depInfoSwap);
         if (imageIndex < swapChainImageLayouts.size())
           swapChainImageLayouts[imageIndex] = swapchainBarrier.newLayout;
@@ -1891,13 +2300,15 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
         std::memcpy(rayQueryUniformBuffersMapped[currentFrame], &ubo, sizeof(RayQueryUniformBufferObject));
       } else {
         // Keep concise error for visibility
-        std::cerr << "Ray Query UBO not mapped for frame " << currentFrame << "\n";
+        LOG_ERROR("Renderer", "Ray Query UBO not mapped for frame " + std::to_string(currentFrame));
       }
 
       // Dispatch compute shader (8x8 workgroups as defined in shader)
       uint32_t workgroupsX = (swapChainExtent.width + 7) / 8;
       uint32_t workgroupsY = (swapChainExtent.height + 7) / 8;
+      const uint32_t rayQueryGpuPass = beginGpuPass(commandBuffers[currentFrame], "Ray query");
       commandBuffers[currentFrame].dispatch(workgroupsX, workgroupsY, 1);
+      endGpuPass(commandBuffers[currentFrame], rayQueryGpuPass);
 
       // Barrier: wait for compute shader to finish writing to output image,
       // then make it readable by fragment shader for sampling in composite pass
@@ -1943,6 +2354,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       renderingInfo.renderArea = vk::Rect2D({0, 0}, swapChainExtent);
       auto savedDepthPtr2 = renderingInfo.pDepthAttachment;
       renderingInfo.pDepthAttachment = nullptr;
+      const uint32_t rqCompositeGpuPass = beginGpuPass(commandBuffers[currentFrame], "Composite");
       commandBuffers[currentFrame].beginRendering(renderingInfo);
 
       if (!!*compositePipeline) {
@@ -1977,6 +2389,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
 
       commandBuffers[currentFrame].draw(3, 1, 0, 0);
       commandBuffers[currentFrame].endRendering();
+      endGpuPass(commandBuffers[currentFrame], rqCompositeGpuPass);
       renderingInfo.pDepthAttachment = savedDepthPtr2;
 
       // Transition swapchain back to PRESENT and RQ image back to GENERAL for next frame
@@ -1986,7 +2399,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       swapchainToPresent.dstStageMask = vk::PipelineStageFlagBits2::eBottomOfPipe;
       swapchainToPresent.dstAccessMask = vk::AccessFlagBits2::eNone;
       swapchainToPresent.oldLayout = vk::ImageLayout::eColorAttachmentOptimal;
-      swapchainToPresent.newLayout = vk::ImageLayout::ePresentSrcKHR;
+      swapchainToPresent.newLayout = presentImageLayout;
       swapchainToPresent.image = swapChainImages[imageIndex];
       swapchainToPresent.subresourceRange.aspectMask = vk::ImageAspectFlagBits::eColor;
       swapchainToPresent.subresourceRange.levelCount = 1;
@@ -2017,9 +2430,6 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
 
   // Process texture streaming uploads (see Renderer::ProcessPendingTextureJobs)
 
-  vk::raii::Pipeline* currentPipeline = nullptr;
-  vk::raii::PipelineLayout* currentLayout = nullptr;
-
   // Incrementally process pending texture uploads on the main thread so that
   // all Vulkan submits happen from a single place while worker threads only
   // handle CPU-side decoding. While the loading screen is up, prioritize
@@ -2115,6 +2525,29 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
             createDepthPrepassPipeline();
           }
         }
+        if (useForwardPlus) {
+          ImGui::Checkbox("Assign lights on CPU", &forwardPlusOnCpu);
+          if (!forwardPlusOnCpu) {
+            if (ImGui::Checkbox("Validate compute against CPU", &validateForwardPlusCpu) && !validateForwardPlusCpu) {
+              forwardPlusCpuReference.clear();
+            }
+            if (validateForwardPlusCpu) {
+              ImGui::Text("Mismatching clusters: %u", lastForwardPlusMismatches);
+            }
+          }
+          if (forwardPlusOnCpu || validateForwardPlusCpu) {
+            const auto& cs = lightClusterer.GetStats();
+            ImGui::Text("CPU assignment: %u lights, %u indices, %u full clusters, %.3f ms", cs.lights, cs.assignments, cs.overflowClusters, cs.setupMs + cs.assignMs);
+          }
+          if (ImGui::Button("Benchmark light clustering (10k lights)")) {
+            lightClusterBenchmark = LightClusterer::Benchmark(10000, swapChainExtent.width, swapChainExtent.height, recordThreadPool.get(), recordWorkerCount);
+          }
+          if (lightClusterBenchmark.clusterMs > 0.0) {
+            const auto& lb = lightClusterBenchmark;
+            ImGui::Text("Clusters %.2f ms (%.2f ms pooled), %.1f MB", lb.clusterMs, lb.clusterPoolMs, static_cast<double>(lb.clusterBytes) / (1024.0 * 1024.0));
+            ImGui::Text("Z-bins %.2f ms, %.1f MB, %u missed", lb.zbinMs, static_cast<double>(lb.zbinBytes) / (1024.0 * 1024.0), lb.missing);
+          }
+        }
 
         // Raster shadows via ray queries (experimental)
         if (rayQueryEnabled && accelerationStructureEnabled) {
@@ -2158,10 +2591,23 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
         // Show acceleration structure status
         if (!!*tlasStructure.handle) {
           ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Acceleration Structures: Built (%zu meshes)", blasStructures.size());
+          ImGui::Text("BLAS: %.1f MB -> %.1f MB compacted, %u batches, %.1f MB scratch",
+                      static_cast<double>(lastBLASBuildStats.buildBytes) / (1024.0 * 1024.0),
+                      static_cast<double>(lastBLASBuildStats.compactedBytes) / (1024.0 * 1024.0),
+                      lastBLASBuildStats.batches,
+                      static_cast<double>(lastBLASBuildStats.scratchBytes) / (1024.0 * 1024.0));
+          ImGui::Text("Build time: %.1f ms (BLAS %.1f ms)", lastBLASBuildStats.totalMs, lastBLASBuildStats.buildMs);
+          ImGui::Text("Last update: %u BLAS built, %u reused, %u retired, TLAS %s",
+                      lastBLASBuildStats.blasCount,
+                      lastBLASBuildStats.blasReused,
+                      lastBLASBuildStats.blasRetired,
+                      lastBLASBuildStats.tlasRebuilt ? "rebuilt" : "refit only");
         } else {
           ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "Acceleration Structures: Not built");
         }
 
+        ImGui::Checkbox("Compact BLAS (rebuilds all BLAS on next update)", &enableBLASCompaction);
+
         ImGui::Spacing();
         ImGui::Text("Ray Query Features:");
         ImGui::Checkbox("Enable Hard Shadows", &enableRayQueryShadows);
@@ -2190,6 +2636,40 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       }
       ImGui::SliderFloat("LOD threshold opaque (px)", &lodPixelThresholdOpaque, 0.5f, 8.0f, "%.1f");
       ImGui::SliderFloat("LOD threshold transparent (px)", &lodPixelThresholdTransparent, 0.5f, 12.0f, "%.1f");
+      ImGui::Checkbox("Mesh LOD levels", &enableMeshLods);
+      ImGui::SliderFloat("LOD error threshold (px)", &lodErrorThresholdPixels, 0.25f, 8.0f, "%.2f");
+      if (lastFrameFullDetailTriangles > 0) {
+        ImGui::Text("Triangles: %llu drawn, %llu at full detail (%.0f%% saved)", static_cast<unsigned long long>(lastFrameTriangles),
+                    static_cast<unsigned long long>(lastFrameFullDetailTriangles),
+                    100.0 * (1.0 - static_cast<double>(lastFrameTriangles) / static_cast<double>(lastFrameFullDetailTriangles)));
+        ImGui::Text("Draws per LOD level: %u / %u / %u / %u", lastFrameLodDraws[0], lastFrameLodDraws[1], lastFrameLodDraws[2], lastFrameLodDraws[3]);
+      }
+      if (modelLoader && ImGui::Button("Report mesh LOD stats")) {
+        for (const auto& [name, stats] : modelLoader->GetMeshLodStats()) {
+          std::ostringstream summary;
+          summary << "Mesh LODs " << name << ": " << stats.reducedMeshes << " of " << stats.meshes << " meshes reduced, built in " << stats.buildMs << " ms";
+          LOG_INFO("Resources", summary.str());
+          // One record per level; log records hold a single short line
+          for (uint32_t level = 0; level < MaxMeshLodLevels; ++level) {
+            const double ratio = stats.triangles[0] > 0 ? static_cast<double>(stats.triangles[level]) / static_cast<double>(stats.triangles[0]) : 0.0;
+            std::ostringstream line;
+            line << "  LOD" << level << ": " << stats.triangles[level] << " triangles (" << 100.0 * ratio << "%), " << stats.levelMeshes[level]
+                << " meshes, error max " << stats.maxError[level] << ", mean " << stats.meanError[level] << " (relative to mesh radius)";
+            LOG_INFO("Resources", line.str());
+          }
+        }
+      }
+      ImGui::Checkbox("Cluster culling", &enableClusterCulling);
+      if (enableClusterCulling) {
+        ImGui::Checkbox("Cluster back-face (cone) culling", &enableClusterConeCulling);
+        if (lastClusterCullStats.tested > 0) {
+          ImGui::Text("Clusters: %llu tested, %llu outside frustum, %llu back-facing", static_cast<unsigned long long>(lastClusterCullStats.tested),
+                      static_cast<unsigned long long>(lastClusterCullStats.frustumCulled), static_cast<unsigned long long>(lastClusterCullStats.coneCulled));
+          ImGui::Text("Cluster triangles: %llu of %llu drawn, %zu indirect draws (%s)", static_cast<unsigned long long>(lastClusterCullStats.visibleTriangles),
+                      static_cast<unsigned long long>(lastClusterCullStats.triangles), clusterDrawCommands.size(),
+                      multiDrawIndirectEnabled ? "multi-draw" : "one call each");
+        }
+      }
       // Anisotropy control (recreate samplers on change)
       {
         float deviceMaxAniso = physicalDevice.getProperties().limits.maxSamplerAnisotropy;
@@ -2206,6 +2686,176 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       if (lastCullingVisibleCount + lastCullingCulledCount > 0) {
         ImGui::Text("Culling: visible=%u, culled=%u", lastCullingVisibleCount, lastCullingCulledCount);
       }
+      ImGui::Checkbox("Spatial index culling", &enableSpatialCulling);
+      ImGui::Text("Frustum query: %.3f ms (%s, %zu indexed, height %d)", lastCullQueryMs, enableSpatialCulling ? "tree" : FrustumCullKernel::GetIsaName(cullKernelIsa),
+                  sceneSpatialIndex.GetProxyCount(), sceneSpatialIndex.GetHeight());
+      if (enableSpatialCulling) {
+        ImGui::Text("Nodes visited=%u  leaves tested=%u  subtrees accepted=%u", lastCullQueryStats.nodesVisited, lastCullQueryStats.leavesTested, lastCullQueryStats.subtreesAccepted);
+      } else {
+        ImGui::Checkbox("Validate SIMD cull against scalar", &validateCullKernel);
+        if (validateCullKernel) {
+          ImGui::Text("Cull kernel mismatches: %u", lastCullKernelMismatches);
+        }
+      }
+      ImGui::Checkbox("Software occlusion culling", &enableOcclusionCulling);
+      if (enableOcclusionCulling) {
+        const auto& os = occlusionCuller.GetStats();
+        ImGui::Text("Occluders=%u (%u tris)  occluded=%u", os.occluders, os.trianglesRasterized, lastOcclusionCulledCount);
+        ImGui::Text("Setup %.3f ms  raster %.3f ms  pyramid %.3f ms  tests %.3f ms", os.setupMs, os.rasterMs, os.pyramidMs, lastOcclusionTestMs);
+        if (ImGui::Button("Dump occlusion buffer")) {
+          occlusionDumpRequested = true;
+        }
+      }
+      ImGui::Checkbox("Sort opaque draws by state", &enableDrawSorting);
+      if (lastFrameBindStats.draws > 0) {
+        ImGui::Text("Draws=%u  pipeline binds=%u  descriptor binds=%u", lastFrameBindStats.draws, lastFrameBindStats.pipelineBinds, lastFrameBindStats.descriptorBinds);
+        ImGui::Text("Vertex binds=%u  index binds=%u  push constants=%u", lastFrameBindStats.vertexBufferBinds, lastFrameBindStats.indexBufferBinds, lastFrameBindStats.pushConstants);
+      }
+      ImGui::Text("CPU mesh geometry: %.1f MB%s",
+                  static_cast<double>(MeshGeometry::GetResidentBytes()) / (1024.0 * 1024.0),
+                  GetReleaseCpuMeshData() ? " (released after upload)" : "");
+      ImGui::Text("Content dedup: %u textures (%.1f MB), %u mesh buffers (%.1f MB) shared this load", textureDedupHits.load(std::memory_order_relaxed),
+                  static_cast<double>(textureDedupBytesSaved.load(std::memory_order_relaxed)) / (1024.0 * 1024.0), meshDedupHits.load(std::memory_order_relaxed),
+                  static_cast<double>(meshDedupBytesSaved.load(std::memory_order_relaxed)) / (1024.0 * 1024.0));
+      if (modelLoader && ImGui::Button("Report geometry dedup stats")) {
+        for (const auto& [name, stats] : modelLoader->GetGeometryDedupStats()) {
+          LOG_INFO("Resources", "Geometry dedup " + name + ": " + std::to_string(stats.hits) + " of " + std::to_string(stats.meshes) +
+              " meshes reused loaded geometry, " + std::to_string(stats.bytesSaved / 1024) + " KB saved, hashed in " +
+              std::to_string(stats.hashMs) + " ms");
+        }
+      }
+      ImGui::Text("Vertex layout: %s, %u bytes per vertex", packedVertices ? "packed" : "standard", getMeshVertexBindingDescription().stride);
+      if (modelLoader && ImGui::Button("Report packed vertex error")) {
+        for (const auto& [name, stats] : modelLoader->MeasureVertexPackingError()) {
+          if (stats.vertices == 0) {
+            LOG_INFO("Resources", "Packed vertex error " + name + ": no CPU geometry");
+            continue;
+          }
+          std::ostringstream report;
+          report << "Packed vertex error " << name << " (" << stats.vertices << " vertices): normal max " << stats.maxNormalDeg << " deg, mean "
+              << stats.meanNormalDeg << " deg; tangent max " << stats.maxTangentDeg << " deg, mean " << stats.meanTangentDeg
+              << " deg, sign flips " << stats.signFlips << "; uv max " << stats.maxTexCoordError << ", mean " << stats.meanTexCoordError
+              << ", out of half range " << stats.texCoordOverflow;
+          LOG_INFO("Resources", report.str());
+        }
+      }
+      ImGui::Checkbox("Parallel command recording", &enableParallelRecording);
+      ImGui::Text("Record ms: prepass=%.3f  opaque=%.3f  transparent=%.3f",
+                  lastPassRecordMs[static_cast<size_t>(RasterPass::DepthPrepass)],
+                  lastPassRecordMs[static_cast<size_t>(RasterPass::Opaque)],
+                  lastPassRecordMs[static_cast<size_t>(RasterPass::Transparent)]);
+      if (lastRecordChunkCount > 0) {
+        ImGui::Text("Parallel record: %u chunks on %u workers, wall %.3f ms", lastRecordChunkCount, recordWorkerCount, lastParallelRecordWallMs);
+      }
+      {
+        const auto ts = TransformSystem::GetInstance().GetStats();
+        ImGui::Text("Transforms: %u nodes, %u levels, %u updated in %.3f ms", ts.nodes, ts.levels, ts.updatedNodes, ts.updateMs);
+        if (ImGui::Button("Benchmark transform update (100k nodes)")) {
+          transformBenchmarkMs[0] = TransformSystem::Benchmark(100000, 0.01f, recordThreadPool.get(), recordWorkerCount);
+          transformBenchmarkMs[1] = TransformSystem::Benchmark(100000, 1.0f, recordThreadPool.get(), recordWorkerCount);
+        }
+        if (transformBenchmarkMs[1] > 0.0) {
+          ImGui::Text("1%% dirty: %.3f ms  100%% dirty: %.3f ms", transformBenchmarkMs[0], transformBenchmarkMs[1]);
+        }
+      }
+      {
+        const auto as = AnimationSystem::GetInstance().GetStats();
+        ImGui::Text("Animation: %u components, %u tracks, %u seeks, %.3f ms", as.components, as.tracks, as.seeks, as.updateMs);
+        if (ImGui::Button("Benchmark animation sampling (10k nodes)")) {
+          animationBenchmark = AnimationSystem::Benchmark(10000, recordThreadPool.get(), recordWorkerCount);
+        }
+        if (animationBenchmark.cursorMs > 0.0) {
+          ImGui::Text("Cursors %.3f ms  search %.3f ms  parallel %.3f ms", animationBenchmark.cursorMs, animationBenchmark.searchMs, animationBenchmark.parallelMs);
+        }
+      }
+      {
+        const auto& ls = lastLightUpdateStats;
+        ImGui::Text("Lights: %u uploaded, %u written, %u shadow refreshed, %u pending in %.3f ms", ls.lights, ls.written, ls.shadowRefreshed, ls.pending, ls.updateMs);
+        int synthetic = static_cast<int>(syntheticLightCount);
+        if (ImGui::SliderInt("Synthetic dynamic lights", &synthetic, 0, 50000)) {
+          SetSyntheticLightCount(static_cast<uint32_t>(synthetic));
+        }
+        if (ImGui::Button("Benchmark light upload (1k/10k/50k)")) {
+          const uint32_t counts[3] = {1000, 10000, 50000};
+          for (size_t i = 0; i < lightBenchmark.size(); ++i) {
+            lightBenchmark[i] = BenchmarkLightUpload(counts[i]);
+          }
+        }
+        if (lightBenchmark[2].initialMs > 0.0) {
+          const char* labels[3] = {"1k", "10k", "50k"};
+          for (size_t i = 0; i < lightBenchmark.size(); ++i) {
+            ImGui::Text("%s: initial %.3f ms  static %.3f ms  1%% dynamic %.3f ms", labels[i], lightBenchmark[i].initialMs, lightBenchmark[i].staticMs, lightBenchmark[i].dynamicMs);
+          }
+        }
+      }
+
+      // Frame profiler: CPU scopes and GPU passes averaged over the last window
+      ImGui::Separator();
+      {
+        auto& profiler = Profiler::GetInstance();
+        bool profilerEnabled = Profiler::IsEnabled();
+        if (ImGui::Checkbox("Frame profiler", &profilerEnabled)) {
+          profiler.SetEnabled(profilerEnabled);
+        }
+        if (profilerEnabled) {
+          ImGui::Text("Frame %.3f ms, %llu events dropped", profiler.GetFrameMs(), static_cast<unsigned long long>(profiler.GetDroppedEvents()));
+          if (!*gpuProfileQueryPool) {
+            ImGui::TextColored(ImVec4(0.7f, 0.7f, 0.7f, 1.0f), "GPU timestamps not supported");
+          }
+          for (const auto& scope : profiler.GetFrameStats()) {
+            ImGui::Text("%s %-28s %5.1fx %8.3f ms (max %.3f)", scope.gpu ? "GPU" : "CPU", scope.name, scope.calls, scope.totalMs, scope.maxMs);
+          }
+        }
+        const auto capture = profiler.GetCaptureStatus();
+        if (capture.capturing) {
+          ImGui::Text("Capturing trace: %u frames left, %zu events", capture.framesLeft, capture.events);
+        } else {
+          if (ImGui::Button("Capture Chrome trace (120 frames)")) {
+            profiler.StartCapture("frame_trace.json", 120);
+          }
+          if (!capture.path.empty()) {
+            ImGui::SameLine();
+            if (capture.written) {
+              ImGui::Text("%zu events written to %s", capture.events, capture.path.c_str());
+            } else {
+              ImGui::TextColored(ImVec4(1.0f, 0.4f, 0.4f, 1.0f), "Failed to write %s", capture.path.c_str());
+            }
+          }
+        }
+      }
+      {
+        const auto logStats = DebugSystem::GetInstance().GetStats();
+        ImGui::Text("Log: %llu written, %llu dropped, %llu suppressed", static_cast<unsigned long long>(logStats.written),
+                    static_cast<unsigned long long>(logStats.dropped), static_cast<unsigned long long>(logStats.suppressed));
+        if (ImGui::Button("Benchmark logging (8 threads)")) {
+          logBenchmark = DebugSystem::Benchmark(8, 50000);
+        }
+        if (logBenchmark.asyncCallsPerSecond > 0.0) {
+          const auto& lb = logBenchmark;
+          ImGui::Text("Async %.2f M calls/s (%llu written, %llu dropped)", lb.asyncCallsPerSecond / 1e6,
+                      static_cast<unsigned long long>(lb.asyncStats.written), static_cast<unsigned long long>(lb.asyncStats.dropped));
+          ImGui::Text("Sync %.2f M calls/s  repeated %.2f M calls/s (%llu suppressed)", lb.syncCallsPerSecond / 1e6, lb.repeatedCallsPerSecond / 1e6,
+                      static_cast<unsigned long long>(lb.repeatedStats.suppressed));
+        }
+      }
+      {
+        if (ImGui::Button("Benchmark resource handles (10k resources)")) {
+          resourceHandleBenchmark = ResourceManager::Benchmark(10000);
+        }
+        if (resourceHandleBenchmark.handleLookupsPerSecond > 0.0) {
+          const auto& rb = resourceHandleBenchmark;
+          ImGui::Text("Handle %.1f M/s  by ID %.1f M/s  type+string maps %.1f M/s", rb.handleLookupsPerSecond / 1e6, rb.idLookupsPerSecond / 1e6,
+                      rb.nestedMapLookupsPerSecond / 1e6);
+        }
+        if (ImGui::Button("Benchmark async resource loading (16 models)")) {
+          asyncLoadBenchmark = ResourceManager::BenchmarkAsyncLoading(recordThreadPool.get(), 16);
+        }
+        if (asyncLoadBenchmark.synchronousMs > 0.0) {
+          const auto& ab = asyncLoadBenchmark;
+          ImGui::Text("Sync %.1f ms  async %.1f ms  (%u resources, %llu requests coalesced)", ab.synchronousMs, ab.asynchronousMs, ab.resources,
+                      static_cast<unsigned long long>(ab.coalesced));
+        }
+      }
 
       // Basic tone mapping controls
       ImGui::Separator();
@@ -2227,21 +2877,33 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
     }
     */
 
-    // Sort transparent entities back-to-front for correct blending of nested glass/liquids
-    if (!transparentJobs.empty()) {
-      glm::vec3 camPos = camera ? camera->GetPosition() : glm::vec3(0.0f);
-      std::ranges::sort(transparentJobs,
-                        [camPos](const RenderJob& a, const RenderJob& b) {
-                          glm::vec3 pa = a.transformComp ? a.transformComp->GetPosition() : glm::vec3(0.0f);
-                          glm::vec3 pb = b.transformComp ? b.transformComp->GetPosition() : glm::vec3(0.0f);
-                          float da2 = glm::length2(pa - camPos);
-                          float db2 = glm::length2(pb - camPos);
-                          if (da2 != db2) return da2 > db2;
-                          if (a.entityRes->cachedIsLiquid != b.entityRes->cachedIsLiquid) return a.entityRes->cachedIsLiquid;
-                          return a.entity < b.entity;
-                        });
+    // Transparent jobs were already sorted back-to-front by their precomputed keys in the preparation pass.
+
+    // Everything the draw recorders need is known before the first pass starts, so the
+    // chunks for all three passes can be recorded concurrently up front.
+    RasterPassContext passCtx{};
+    passCtx.useBasic = (imguiSystem && !imguiSystem->IsPBREnabled());
+    passCtx.didDepthPrepass = useForwardPlus && !opaqueJobs.empty();
+    passCtx.set1 = (transparentDescriptorSets.empty() || IsLoading())
+                     ? *transparentFallbackDescriptorSets[currentFrame]
+                     : *transparentDescriptorSets[currentFrame];
+    passCtx.viewport = vk::Viewport(0.0f, 0.0f, static_cast<float>(swapChainExtent.width), static_cast<float>(swapChainExtent.height), 0.0f, 1.0f);
+    passCtx.scissor = vk::Rect2D({0, 0}, swapChainExtent);
+
+    for (auto& v : passSecondaries) {
+      v.clear();
     }
-
+    lastPassRecordMs.fill(0.0);
+    lastRecordChunkCount = 0;
+    const bool recordedParallel = recordRasterPassesParallel(opaqueJobs, transparentJobs, passCtx);
+    const auto secondariesFor = [&](RasterPass pass) -> const std::vector<vk::CommandBuffer>& {
+      return passSecondaries[static_cast<size_t>(pass)];
+    };
+    const auto timeInline = [&](RasterPass pass, auto&& fn) {
+      const auto t0 = std::chrono::steady_clock::now();
+      fn();
+      lastPassRecordMs[static_cast<size_t>(pass)] += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    };
 
     // Track whether we executed a depth pre-pass this frame (used to choose depth load op and pipeline state)
     bool didOpaqueDepthPrepass = false;
@@ -2268,39 +2930,23 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
         // Depth-only rendering
         vk::RenderingAttachmentInfo depthOnlyAttachment{.imageView = *depthImageView, .imageLayout = vk::ImageLayout::eDepthAttachmentOptimal, .loadOp = vk::AttachmentLoadOp::eClear, .storeOp = vk::AttachmentStoreOp::eStore, .clearValue = vk::ClearDepthStencilValue{1.0f, 0}};
         vk::RenderingInfo depthOnlyInfo{.renderArea = vk::Rect2D({0, 0}, swapChainExtent), .layerCount = 1, .colorAttachmentCount = 0, .pColorAttachments = nullptr, .pDepthAttachment = &depthOnlyAttachment};
-        commandBuffers[currentFrame].beginRendering(depthOnlyInfo);
-        vk::Viewport viewport(0.0f, 0.0f, static_cast<float>(swapChainExtent.width), static_cast<float>(swapChainExtent.height), 0.0f, 1.0f);
-        commandBuffers[currentFrame].setViewport(0, viewport);
-        vk::Rect2D scissor({0, 0}, swapChainExtent);
-        commandBuffers[currentFrame].setScissor(0, scissor);
-
-        // Bind depth pre-pass pipeline
-        if (!!*depthPrepassPipeline) {
-          commandBuffers[currentFrame].bindPipeline(vk::PipelineBindPoint::eGraphics, *depthPrepassPipeline);
+        if (recordedParallel) {
+          depthOnlyInfo.flags = vk::RenderingFlagBits::eContentsSecondaryCommandBuffers;
         }
-
-        for (const auto& job : opaqueJobs) {
-          if (job.isAlphaMasked) continue;
-
-          // Bind geometry
-          std::array<vk::Buffer, 2> buffers = {*job.meshRes->vertexBuffer, *job.entityRes->instanceBuffer};
-          std::array<vk::DeviceSize, 2> offsets = {0, 0};
-          commandBuffers[currentFrame].bindVertexBuffers(0, buffers, offsets);
-          commandBuffers[currentFrame].bindIndexBuffer(*job.meshRes->indexBuffer, 0, vk::IndexType::eUint32);
-
-          // Bind descriptor set (PBR set 0)
-          commandBuffers[currentFrame].bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-                                                           *pbrPipelineLayout,
-                                                           0,
-                                                           *job.entityRes->pbrDescriptorSets[currentFrame],
-                                                           nullptr);
-
-          // Issue draw
-          uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(job.meshComp->GetInstanceCount()));
-          commandBuffers[currentFrame].drawIndexed(job.meshRes->indexCount, instanceCount, 0, 0, 0);
+        const uint32_t depthGpuPass = beginGpuPass(commandBuffers[currentFrame], "Depth prepass");
+        commandBuffers[currentFrame].beginRendering(depthOnlyInfo);
+        if (recordedParallel) {
+          if (!secondariesFor(RasterPass::DepthPrepass).empty()) {
+            commandBuffers[currentFrame].executeCommands(secondariesFor(RasterPass::DepthPrepass));
+          }
+        } else {
+          timeInline(RasterPass::DepthPrepass, [&]() {
+            recordDepthPrepassDraws(commandBuffers[currentFrame], opaqueJobs, passCtx, frameBindStats);
+          });
         }
 
         commandBuffers[currentFrame].endRendering();
+        endGpuPass(commandBuffers[currentFrame], depthGpuPass);
 
         // Barrier to ensure depth is visible for subsequent passes (Sync2)
         vk::ImageMemoryBarrier2 depthToRead2{
@@ -2335,7 +2981,18 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       // As a last guard before dispatch, make sure compute binding 0 is valid for this frame
       refreshForwardPlusComputeLightsBindingForFrame(currentFrame);
 
-      dispatchForwardPlus(commandBuffers[currentFrame], tilesX, tilesY, forwardPlusSlicesZ);
+      if (forwardPlusOnCpu || !*forwardPlusPipeline) {
+        // Host-visible tile buffers: writes before submit are visible to the fragment shader
+        assignForwardPlusLightsCpu(currentFrame, view, proj, lastFrameLightCount, tilesX, tilesY, forwardPlusSlicesZ, nearZ, farZ, true);
+      } else {
+        if (validateForwardPlusCpu) {
+          compareForwardPlusWithCpu(currentFrame);
+          assignForwardPlusLightsCpu(currentFrame, view, proj, lastFrameLightCount, tilesX, tilesY, forwardPlusSlicesZ, nearZ, farZ, false);
+        }
+        const uint32_t cullGpuPass = beginGpuPass(commandBuffers[currentFrame], "Forward+ cull");
+        dispatchForwardPlus(commandBuffers[currentFrame], tilesX, tilesY, forwardPlusSlicesZ);
+        endGpuPass(commandBuffers[currentFrame], cullGpuPass);
+      }
     }
 
     // PASS 1: RENDER OPAQUE OBJECTS TO OFF-SCREEN TEXTURE
@@ -2381,70 +3038,22 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
     depthAttachment.imageView = *depthImageView;
     depthAttachment.loadOp = (didOpaqueDepthPrepass) ? vk::AttachmentLoadOp::eLoad : vk::AttachmentLoadOp::eClear;
     vk::RenderingInfo passInfo{.renderArea = vk::Rect2D({0, 0}, swapChainExtent), .layerCount = 1, .colorAttachmentCount = 1, .pColorAttachments = &colorAttachment, .pDepthAttachment = &depthAttachment};
+    if (recordedParallel) {
+      passInfo.flags = vk::RenderingFlagBits::eContentsSecondaryCommandBuffers;
+    }
+    const uint32_t opaqueGpuPass = beginGpuPass(commandBuffers[currentFrame], "Opaque");
     commandBuffers[currentFrame].beginRendering(passInfo);
-    vk::Viewport viewport(0.0f, 0.0f, static_cast<float>(swapChainExtent.width), static_cast<float>(swapChainExtent.height), 0.0f, 1.0f);
-    commandBuffers[currentFrame].setViewport(0, viewport);
-    vk::Rect2D scissor({0, 0}, swapChainExtent);
-    commandBuffers[currentFrame].setScissor(0, scissor); {
-      uint32_t opaqueDrawsThisPass = 0;
-      for (const auto& job : opaqueJobs) {
-        bool useBasic = (imguiSystem && !imguiSystem->IsPBREnabled());
-        vk::raii::Pipeline* selectedPipeline = nullptr;
-        vk::raii::PipelineLayout* selectedLayout = nullptr;
-        if (useBasic) {
-          selectedPipeline = &graphicsPipeline;
-          selectedLayout = &pipelineLayout;
-        } else {
-          // If masked, we need depth writes with alpha test; otherwise, after-prepass read-only is fine.
-          if (job.isAlphaMasked) {
-            selectedPipeline = &pbrGraphicsPipeline; // writes depth, compare Less
-          } else {
-            selectedPipeline = didOpaqueDepthPrepass && !!*pbrPrepassGraphicsPipeline ? &pbrPrepassGraphicsPipeline : &pbrGraphicsPipeline;
-          }
-          selectedLayout = &pbrPipelineLayout;
-        }
-        if (currentPipeline != selectedPipeline) {
-          commandBuffers[currentFrame].bindPipeline(vk::PipelineBindPoint::eGraphics, **selectedPipeline);
-          currentPipeline = selectedPipeline;
-          currentLayout = selectedLayout;
-        }
-
-        std::array<vk::Buffer, 2> buffers = {*job.meshRes->vertexBuffer, *job.entityRes->instanceBuffer};
-        std::array<vk::DeviceSize, 2> offsets = {0, 0};
-        commandBuffers[currentFrame].bindVertexBuffers(0, buffers, offsets);
-        commandBuffers[currentFrame].bindIndexBuffer(*job.meshRes->indexBuffer, 0, vk::IndexType::eUint32);
-
-        auto* descSetsPtr = useBasic ? &job.entityRes->basicDescriptorSets : &job.entityRes->pbrDescriptorSets;
-        if (descSetsPtr->empty() || currentFrame >= descSetsPtr->size()) {
-          continue;
-        }
-
-        if (useBasic) {
-          commandBuffers[currentFrame].bindDescriptorSets(
-            vk::PipelineBindPoint::eGraphics,
-            **selectedLayout,
-            0,
-            {*(*descSetsPtr)[currentFrame]},
-            {});
-        } else {
-          vk::DescriptorSet set1Opaque = (transparentDescriptorSets.empty() || IsLoading())
-                                           ? *transparentFallbackDescriptorSets[currentFrame]
-                                           : *transparentDescriptorSets[currentFrame];
-          commandBuffers[currentFrame].bindDescriptorSets(
-            vk::PipelineBindPoint::eGraphics,
-            **selectedLayout,
-            0,
-            {*(*descSetsPtr)[currentFrame], set1Opaque},
-            {});
-
-          commandBuffers[currentFrame].pushConstants<MaterialProperties>(**selectedLayout, vk::ShaderStageFlagBits::eFragment, 0, {job.entityRes->cachedMaterialProps});
-        }
-        uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(job.meshComp->GetInstanceCount()));
-        commandBuffers[currentFrame].drawIndexed(job.meshRes->indexCount, instanceCount, 0, 0, 0);
-        ++opaqueDrawsThisPass;
+    if (recordedParallel) {
+      if (!secondariesFor(RasterPass::Opaque).empty()) {
+        commandBuffers[currentFrame].executeCommands(secondariesFor(RasterPass::Opaque));
       }
+    } else {
+      timeInline(RasterPass::Opaque, [&]() {
+        recordOpaqueDraws(commandBuffers[currentFrame], opaqueJobs, passCtx, frameBindStats);
+      });
     }
     commandBuffers[currentFrame].endRendering();
+    endGpuPass(commandBuffers[currentFrame], opaqueGpuPass);
     // PASS 1b: PRESENT – composite path
     {
       // Transition off-screen to SHADER_READ for sampling (Sync2)
@@ -2490,6 +3099,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       // IMPORTANT: Composite pass does not use a depth attachment. Avoid binding it to satisfy dynamic rendering VUIDs.
       auto savedDepthPtr = renderingInfo.pDepthAttachment; // save to restore later
       renderingInfo.pDepthAttachment = nullptr;
+      const uint32_t compositeGpuPass = beginGpuPass(commandBuffers[currentFrame], "Composite");
       commandBuffers[currentFrame].beginRendering(renderingInfo);
 
       // Bind composite pipeline
@@ -2528,6 +3138,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       commandBuffers[currentFrame].draw(3, 1, 0, 0);
 
       commandBuffers[currentFrame].endRendering();
+      endGpuPass(commandBuffers[currentFrame], compositeGpuPass);
       // Restore depth attachment pointer for subsequent passes
       renderingInfo.pDepthAttachment = savedDepthPtr;
     }
@@ -2539,51 +3150,24 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       colorAttachments[0].loadOp = vk::AttachmentLoadOp::eLoad;
       depthAttachment.loadOp = vk::AttachmentLoadOp::eLoad;
       renderingInfo.renderArea = vk::Rect2D({0, 0}, swapChainExtent);
+      if (recordedParallel) {
+        renderingInfo.flags = vk::RenderingFlagBits::eContentsSecondaryCommandBuffers;
+      }
+      const uint32_t transparentGpuPass = beginGpuPass(commandBuffers[currentFrame], "Transparent");
       commandBuffers[currentFrame].beginRendering(renderingInfo);
-      commandBuffers[currentFrame].setViewport(0, viewport);
-      commandBuffers[currentFrame].setScissor(0, scissor);
-
-      if (!transparentJobs.empty()) {
-        currentLayout = &pbrTransparentPipelineLayout;
-        vk::raii::Pipeline* activeTransparentPipeline = nullptr;
-
-        for (const auto& job : transparentJobs) {
-          vk::raii::Pipeline* desiredPipeline = job.entityRes->cachedIsGlass ? &glassGraphicsPipeline : &pbrBlendGraphicsPipeline;
-          if (desiredPipeline != activeTransparentPipeline) {
-            commandBuffers[currentFrame].bindPipeline(vk::PipelineBindPoint::eGraphics, **desiredPipeline);
-            activeTransparentPipeline = desiredPipeline;
-          }
-
-          std::array<vk::Buffer, 2> buffers = {*job.meshRes->vertexBuffer, *job.entityRes->instanceBuffer};
-          std::array<vk::DeviceSize, 2> offsets = {0, 0};
-          commandBuffers[currentFrame].bindVertexBuffers(0, buffers, offsets);
-          commandBuffers[currentFrame].bindIndexBuffer(*job.meshRes->indexBuffer, 0, vk::IndexType::eUint32);
-
-          vk::DescriptorSet set1 = (transparentDescriptorSets.empty() || IsLoading())
-                                     ? *transparentFallbackDescriptorSets[currentFrame]
-                                     : *transparentDescriptorSets[currentFrame];
-          commandBuffers[currentFrame].bindDescriptorSets(
-            vk::PipelineBindPoint::eGraphics,
-            **currentLayout,
-            0,
-            {*job.entityRes->pbrDescriptorSets[currentFrame], set1},
-            {});
-
-          MaterialProperties pushConstants = job.entityRes->cachedMaterialProps;
-          if (job.entityRes->cachedIsLiquid) {
-            pushConstants.transmissionFactor = 0.0f;
-          }
-          commandBuffers[currentFrame].pushConstants < MaterialProperties > (**currentLayout, vk::ShaderStageFlagBits::eFragment, 0,  {
-            pushConstants
-          }
-          )
-          ;
-          uint32_t instanceCountT = std::max(1u, static_cast<uint32_t>(job.meshComp->GetInstanceCount()));
-          commandBuffers[currentFrame].drawIndexed(job.meshRes->indexCount, instanceCountT, 0, 0, 0);
+      if (recordedParallel) {
+        if (!secondariesFor(RasterPass::Transparent).empty()) {
+          commandBuffers[currentFrame].executeCommands(secondariesFor(RasterPass::Transparent));
         }
+      } else if (!transparentJobs.empty()) {
+        timeInline(RasterPass::Transparent, [&]() {
+          recordTransparentDraws(commandBuffers[currentFrame], transparentJobs, passCtx, frameBindStats);
+        });
       }
       // End transparent rendering pass before any layout transitions (even if no transparent draws)
       commandBuffers[currentFrame].endRendering();
+      endGpuPass(commandBuffers[currentFrame], transparentGpuPass);
+      renderingInfo.flags = {};
     } {
       // Screenshot and final present transition are handled in rasterization path only
       // Ray query path handles these separately
@@ -2596,7 +3180,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
           .dstStageMask = vk::PipelineStageFlagBits2::eNone,
           .dstAccessMask = {},
           .oldLayout = vk::ImageLayout::eColorAttachmentOptimal,
-          .newLayout = vk::ImageLayout::ePresentSrcKHR,
+          .newLayout = presentImageLayout,
           .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
           .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
           .image = swapChainImages[imageIndex],
@@ -2647,11 +3231,13 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       .pColorAttachments = &imguiColorAttachment,
       .pDepthAttachment = nullptr
     };
+    const uint32_t imguiGpuPass = beginGpuPass(commandBuffers[currentFrame], "ImGui");
     commandBuffers[currentFrame].beginRendering(imguiRenderingInfo);
 
     imguiSystem->Render(commandBuffers[currentFrame], currentFrame);
 
     commandBuffers[currentFrame].endRendering();
+    endGpuPass(commandBuffers[currentFrame], imguiGpuPass);
 
     // Transition swapchain back to PRESENT layout after ImGui renders
     vk::ImageMemoryBarrier2 colorToPresent{
@@ -2660,7 +3246,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
       .dstStageMask = vk::PipelineStageFlagBits2::eBottomOfPipe,
       .dstAccessMask = vk::AccessFlagBits2::eNone,
       .oldLayout = vk::ImageLayout::eColorAttachmentOptimal,
-      .newLayout = vk::ImageLayout::ePresentSrcKHR,
+      .newLayout = presentImageLayout,
       .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
       .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
       .image = swapChainImages[imageIndex],
@@ -2674,6 +3260,7 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
 
   commandBuffers[currentFrame].end();
   isRecordingCmd.store(false, std::memory_order_relaxed);
+  lastFrameBindStats = frameBindStats;
 
   // Submit and present (Synchronization 2)
   uint64_t uploadsValueToWait = uploadTimelineLastSubmitted.load(std::memory_order_relaxed);
@@ -2706,6 +3293,13 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
     .signalSemaphoreInfoCount = 1,
     .pSignalSemaphoreInfos = &signalInfo
   };
+  if (headless) {
+    // Nothing was acquired and nothing will be presented: only wait for the uploads
+    submit2.waitSemaphoreInfoCount = 1;
+    submit2.pWaitSemaphoreInfos = &waitInfos[1];
+    submit2.signalSemaphoreInfoCount = 0;
+    submit2.pSignalSemaphoreInfos = nullptr;
+  }
 
   if (framebufferResized.load(std::memory_order_relaxed)) {
     vk::SubmitInfo2 emptySubmit2{}; {
@@ -2718,14 +3312,25 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
 
   // Update watchdog BEFORE queue submit because submit can block waiting for GPU
   // This proves frame CPU work is complete even if GPU queue is busy
+  if (currentFrame < gpuProfileFrames.size() && gpuProfileFrames[currentFrame].recording) {
+    gpuProfileFrames[currentFrame].pending = true;
+    gpuProfileFrames[currentFrame].submitNs = Profiler::Now();
+  }
   lastFrameUpdateTime.store(std::chrono::steady_clock::now(), std::memory_order_relaxed); {
+    PROFILE_SCOPE("Queue submit");
     std::lock_guard<std::mutex> lock(queueMutex);
     graphicsQueue.submit2(submit2, *inFlightFences[currentFrame]);
   }
 
+  if (headless) {
+    currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
+    return;
+  }
+
   vk::PresentInfoKHR presentInfo{.waitSemaphoreCount = 1, .pWaitSemaphores = &*renderFinishedSemaphores[imageIndex], .swapchainCount = 1, .pSwapchains = &*swapChain, .pImageIndices = &imageIndex};
   vk::Result presentResult = vk::Result::eSuccess;
   try {
+    PROFILE_SCOPE("Present");
     std::lock_guard<std::mutex> lock(queueMutex);
     presentResult = presentQueue.presentKHR(presentInfo);
   } catch (const vk::OutOfDateKHRError&) {
@@ -2741,6 +3346,329 @@ void Renderer::Render(const std::vector<Entity *>& entities, CameraComponent* ca
   currentFrame = (currentFrame + 1) % MAX_FRAMES_IN_FLIGHT;
 }
 
+void Renderer::sortRenderJobs(std::vector<RenderJob>& jobs) {
+  if (jobs.size() < 2)
+    return;
+  drawSortEntries.resize(jobs.size());
+  for (uint32_t i = 0; i < static_cast<uint32_t>(jobs.size()); ++i) {
+    drawSortEntries[i] = {jobs[i].sortKey, i};
+  }
+  drawKeySorter.Sort(drawSortEntries);
+  drawSortScratch.clear();
+  drawSortScratch.reserve(jobs.size());
+  for (const auto& e : drawSortEntries) {
+    drawSortScratch.push_back(jobs[e.index]);
+  }
+  jobs.swap(drawSortScratch);
+}
+
+void Renderer::recordDepthPrepassDraws(vk::raii::CommandBuffer& cmd, std::span<const RenderJob> jobs, const RasterPassContext& ctx, FrameBindStats& stats) {
+  cmd.setViewport(0, ctx.viewport);
+  cmd.setScissor(0, ctx.scissor);
+
+  if (!!*depthPrepassPipeline) {
+    cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, *depthPrepassPipeline);
+    stats.pipelineBinds++;
+  }
+
+  // Jobs are grouped by mesh, so the shared vertex/index buffers are only rebound on mesh change.
+  MeshResources* boundMesh = nullptr;
+  for (const auto& job : jobs) {
+    if (job.isAlphaMasked)
+      continue;
+
+    if (boundMesh != job.meshRes) {
+      std::array<vk::Buffer, 2> buffers = {*job.meshRes->vertexBuffer, *job.entityRes->instanceBuffer};
+      std::array<vk::DeviceSize, 2> offsets = {0, 0};
+      cmd.bindVertexBuffers(0, buffers, offsets);
+      cmd.bindIndexBuffer(*job.meshRes->indexBuffer, 0, vk::IndexType::eUint32);
+      stats.indexBufferBinds++;
+      boundMesh = job.meshRes;
+    } else {
+      cmd.bindVertexBuffers(1, {*job.entityRes->instanceBuffer}, {vk::DeviceSize{0}});
+    }
+    stats.vertexBufferBinds++;
+
+    cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pbrPipelineLayout, 0, *job.entityRes->pbrDescriptorSets[currentFrame], nullptr);
+    stats.descriptorBinds++;
+
+    uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(job.meshComp->GetInstanceCount()));
+    recordJobDraw(cmd, job, instanceCount, stats);
+  }
+}
+
+void Renderer::recordJobDraw(vk::raii::CommandBuffer& cmd, const RenderJob& job, uint32_t instanceCount, FrameBindStats& stats) {
+  if (job.clusterDrawCount == 0) {
+    const MeshLod lod = job.meshRes->getLod(job.lodLevel);
+    cmd.drawIndexed(lod.indexCount, instanceCount, lod.firstIndex, 0, 0);
+    stats.draws++;
+    return;
+  }
+  // Cluster draws exist only for single-instance jobs, so the commands' instance count of 1 matches
+  const vk::Buffer indirectBuffer = *clusterDrawBuffers[currentFrame].buffer;
+  constexpr uint32_t stride = sizeof(vk::DrawIndexedIndirectCommand);
+  const vk::DeviceSize offset = static_cast<vk::DeviceSize>(job.clusterDrawFirst) * stride;
+  if (multiDrawIndirectEnabled) {
+    cmd.drawIndexedIndirect(indirectBuffer, offset, job.clusterDrawCount, stride);
+    stats.draws++;
+  } else {
+    for (uint32_t i = 0; i < job.clusterDrawCount; ++i) {
+      cmd.drawIndexedIndirect(indirectBuffer, offset + static_cast<vk::DeviceSize>(i) * stride, 1, stride);
+      stats.draws++;
+    }
+  }
+}
+
+void Renderer::recordOpaqueDraws(vk::raii::CommandBuffer& cmd, std::span<const RenderJob> jobs, const RasterPassContext& ctx, FrameBindStats& stats) {
+  cmd.setViewport(0, ctx.viewport);
+  cmd.setScissor(0, ctx.scissor);
+
+  // Redundant-state tracking. Pipelines in this pass share a layout, so set 1 stays bound
+  // across pipeline switches and only the per-entity set 0 changes per draw.
+  vk::raii::Pipeline* currentPipeline = nullptr;
+  MeshResources* boundMesh = nullptr;
+  bool set1Bound = false;
+  const Material* pushedMaterial = nullptr;
+  for (const auto& job : jobs) {
+    vk::raii::Pipeline* selectedPipeline = nullptr;
+    vk::raii::PipelineLayout* selectedLayout = nullptr;
+    if (ctx.useBasic) {
+      selectedPipeline = &graphicsPipeline;
+      selectedLayout = &pipelineLayout;
+    } else {
+      // If masked, we need depth writes with alpha test; otherwise, after-prepass read-only is fine.
+      if (job.isAlphaMasked) {
+        selectedPipeline = &pbrGraphicsPipeline; // writes depth, compare Less
+      } else {
+        selectedPipeline = ctx.didDepthPrepass && !!*pbrPrepassGraphicsPipeline ? &pbrPrepassGraphicsPipeline : &pbrGraphicsPipeline;
+      }
+      selectedLayout = &pbrPipelineLayout;
+    }
+    if (currentPipeline != selectedPipeline) {
+      cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **selectedPipeline);
+      stats.pipelineBinds++;
+      currentPipeline = selectedPipeline;
+      pushedMaterial = nullptr;
+    }
+
+    auto* descSetsPtr = ctx.useBasic ? &job.entityRes->basicDescriptorSets : &job.entityRes->pbrDescriptorSets;
+    if (descSetsPtr->empty() || currentFrame >= descSetsPtr->size()) {
+      continue;
+    }
+
+    if (boundMesh != job.meshRes) {
+      std::array<vk::Buffer, 2> buffers = {*job.meshRes->vertexBuffer, *job.entityRes->instanceBuffer};
+      std::array<vk::DeviceSize, 2> offsets = {0, 0};
+      cmd.bindVertexBuffers(0, buffers, offsets);
+      cmd.bindIndexBuffer(*job.meshRes->indexBuffer, 0, vk::IndexType::eUint32);
+      stats.indexBufferBinds++;
+      boundMesh = job.meshRes;
+    } else {
+      // Same mesh as the previous draw: only the per-entity instance stream changes
+      cmd.bindVertexBuffers(1, {*job.entityRes->instanceBuffer}, {vk::DeviceSize{0}});
+    }
+    stats.vertexBufferBinds++;
+
+    if (ctx.useBasic) {
+      cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, **selectedLayout, 0, {*(*descSetsPtr)[currentFrame]}, {});
+      stats.descriptorBinds++;
+    } else {
+      if (!set1Bound) {
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, **selectedLayout, 0, {*(*descSetsPtr)[currentFrame], ctx.set1}, {});
+        set1Bound = true;
+      } else {
+        cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, **selectedLayout, 0, {*(*descSetsPtr)[currentFrame]}, {});
+      }
+      stats.descriptorBinds++;
+
+      // Push constants are derived only from the material; skip when consecutive draws share it.
+      const Material* mat = job.entityRes->cachedMaterial;
+      if (!mat || mat != pushedMaterial) {
+        cmd.pushConstants<MaterialProperties>(**selectedLayout, vk::ShaderStageFlagBits::eFragment, 0, {job.entityRes->cachedMaterialProps});
+        stats.pushConstants++;
+        pushedMaterial = mat;
+      }
+    }
+    uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(job.meshComp->GetInstanceCount()));
+    recordJobDraw(cmd, job, instanceCount, stats);
+  }
+}
+
+void Renderer::recordTransparentDraws(vk::raii::CommandBuffer& cmd, std::span<const RenderJob> jobs, const RasterPassContext& ctx, FrameBindStats& stats) {
+  cmd.setViewport(0, ctx.viewport);
+  cmd.setScissor(0, ctx.scissor);
+
+  vk::raii::Pipeline* activeTransparentPipeline = nullptr;
+  MeshResources* boundMesh = nullptr;
+  bool set1Bound = false;
+  for (const auto& job : jobs) {
+    vk::raii::Pipeline* desiredPipeline = job.entityRes->cachedIsGlass ? &glassGraphicsPipeline : &pbrBlendGraphicsPipeline;
+    if (desiredPipeline != activeTransparentPipeline) {
+      cmd.bindPipeline(vk::PipelineBindPoint::eGraphics, **desiredPipeline);
+      stats.pipelineBinds++;
+      activeTransparentPipeline = desiredPipeline;
+    }
+
+    if (boundMesh != job.meshRes) {
+      std::array<vk::Buffer, 2> buffers = {*job.meshRes->vertexBuffer, *job.entityRes->instanceBuffer};
+      std::array<vk::DeviceSize, 2> offsets = {0, 0};
+      cmd.bindVertexBuffers(0, buffers, offsets);
+      cmd.bindIndexBuffer(*job.meshRes->indexBuffer, 0, vk::IndexType::eUint32);
+      stats.indexBufferBinds++;
+      boundMesh = job.meshRes;
+    } else {
+      cmd.bindVertexBuffers(1, {*job.entityRes->instanceBuffer}, {vk::DeviceSize{0}});
+    }
+    stats.vertexBufferBinds++;
+
+    if (!set1Bound) {
+      cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pbrTransparentPipelineLayout, 0, {*job.entityRes->pbrDescriptorSets[currentFrame], ctx.set1}, {});
+      set1Bound = true;
+    } else {
+      cmd.bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *pbrTransparentPipelineLayout, 0, {*job.entityRes->pbrDescriptorSets[currentFrame]}, {});
+    }
+    stats.descriptorBinds++;
+
+    MaterialProperties pushConstants = job.entityRes->cachedMaterialProps;
+    if (job.entityRes->cachedIsLiquid) {
+      pushConstants.transmissionFactor = 0.0f;
+    }
+    cmd.pushConstants<MaterialProperties>(*pbrTransparentPipelineLayout, vk::ShaderStageFlagBits::eFragment, 0, {pushConstants});
+    stats.pushConstants++;
+    uint32_t instanceCount = std::max(1u, static_cast<uint32_t>(job.meshComp->GetInstanceCount()));
+    recordJobDraw(cmd, job, instanceCount, stats);
+  }
+}
+
+// Records the depth pre-pass, opaque and transparent draw lists into secondary command buffers,
+// splitting each list into contiguous chunks so that sort order (and therefore state grouping
+// and transparent back-to-front ordering) is preserved when the primary executes them in order.
+// Returns false when the work is too small to be worth the fan-out; the caller then records inline.
+bool Renderer::recordRasterPassesParallel(const std::vector<RenderJob>& opaque, const std::vector<RenderJob>& transparent, const RasterPassContext& ctx) {
+  if (!enableParallelRecording || !recordThreadPool || recordWorkerCount == 0) {
+    return false;
+  }
+  PROFILE_SCOPE("Record raster passes");
+  const size_t totalJobs = (ctx.didDepthPrepass ? opaque.size() : 0) + opaque.size() + transparent.size();
+  const size_t minPerChunk = std::max<size_t>(1, parallelRecordMinJobsPerChunk);
+  if (totalJobs < minPerChunk * 2) {
+    return false;
+  }
+
+  struct Chunk {
+    RasterPass pass;
+    std::span<const RenderJob> jobs;
+  };
+  std::vector<Chunk> chunks;
+  const auto split = [&](RasterPass pass, const std::vector<RenderJob>& list) {
+    if (list.empty())
+      return;
+    const size_t count = std::min<size_t>(recordWorkerCount, (list.size() + minPerChunk - 1) / minPerChunk);
+    const size_t per = (list.size() + count - 1) / count;
+    for (size_t begin = 0; begin < list.size(); begin += per) {
+      chunks.push_back({pass, std::span<const RenderJob>(list).subspan(begin, std::min(per, list.size() - begin))});
+    }
+  };
+  if (ctx.didDepthPrepass) {
+    split(RasterPass::DepthPrepass, opaque);
+  }
+  split(RasterPass::Opaque, opaque);
+  split(RasterPass::Transparent, transparent);
+
+  // One pool per chunk slot and frame in flight; a pool is only ever touched by one thread at a time,
+  // and the frame fence guarantees the GPU is done with it before it is reset.
+  if (recordSlots.size() != MAX_FRAMES_IN_FLIGHT) {
+    recordSlots.resize(MAX_FRAMES_IN_FLIGHT);
+  }
+  auto& slots = recordSlots[currentFrame];
+  while (slots.size() < chunks.size()) {
+    RecordSlot slot;
+    vk::CommandPoolCreateInfo poolInfo{
+      .flags = vk::CommandPoolCreateFlagBits::eTransient,
+      .queueFamilyIndex = queueFamilyIndices.graphicsFamily.value()
+    };
+    slot.pool = vk::raii::CommandPool(device, poolInfo);
+    vk::CommandBufferAllocateInfo allocInfo{.commandPool = *slot.pool, .level = vk::CommandBufferLevel::eSecondary, .commandBufferCount = 1};
+    vk::raii::CommandBuffers buffers(device, allocInfo);
+    slot.cmd = std::move(buffers[0]);
+    slots.push_back(std::move(slot));
+  }
+
+  const vk::Format colorFormat = swapChainImageFormat;
+  const vk::Format depthFormat = findDepthFormat();
+  const auto wallStart = std::chrono::steady_clock::now();
+
+  std::vector<FrameBindStats> chunkStats(chunks.size());
+  std::vector<double> chunkMs(chunks.size(), 0.0);
+  std::vector<std::future<void>> futures;
+  futures.reserve(chunks.size());
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    futures.push_back(recordThreadPool->enqueue([this, i, &chunks, &slots, &chunkStats, &chunkMs, &ctx, colorFormat, depthFormat]() {
+      PROFILE_SCOPE("Record chunk");
+      ensureThreadLocalVulkanInit();
+      const auto t0 = std::chrono::steady_clock::now();
+      const Chunk& chunk = chunks[i];
+      RecordSlot& slot = slots[i];
+      slot.pool.reset();
+
+      const bool depthOnly = chunk.pass == RasterPass::DepthPrepass;
+      vk::CommandBufferInheritanceRenderingInfo inheritRendering{
+        .colorAttachmentCount = depthOnly ? 0u : 1u,
+        .pColorAttachmentFormats = depthOnly ? nullptr : &colorFormat,
+        .depthAttachmentFormat = depthFormat,
+        .rasterizationSamples = vk::SampleCountFlagBits::e1
+      };
+      vk::CommandBufferInheritanceInfo inheritInfo{.pNext = &inheritRendering};
+      slot.cmd.begin(vk::CommandBufferBeginInfo{
+        .flags = vk::CommandBufferUsageFlagBits::eRenderPassContinue | vk::CommandBufferUsageFlagBits::eOneTimeSubmit,
+        .pInheritanceInfo = &inheritInfo
+      });
+      switch (chunk.pass) {
+        case RasterPass::DepthPrepass:
+          recordDepthPrepassDraws(slot.cmd, chunk.jobs, ctx, chunkStats[i]);
+          break;
+        case RasterPass::Opaque:
+          recordOpaqueDraws(slot.cmd, chunk.jobs, ctx, chunkStats[i]);
+          break;
+        default:
+          recordTransparentDraws(slot.cmd, chunk.jobs, ctx, chunkStats[i]);
+          break;
+      }
+      slot.cmd.end();
+      chunkMs[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    }));
+  }
+  // Join every task before rethrowing so no worker is left writing into a slot we unwind past.
+  std::exception_ptr firstError;
+  for (auto& f : futures) {
+    try {
+      f.get();
+    } catch (...) {
+      if (!firstError)
+        firstError = std::current_exception();
+    }
+  }
+  if (firstError) {
+    std::rethrow_exception(firstError);
+  }
+
+  for (size_t i = 0; i < chunks.size(); ++i) {
+    const auto p = static_cast<size_t>(chunks[i].pass);
+    passSecondaries[p].push_back(*slots[i].cmd);
+    lastPassRecordMs[p] += chunkMs[i];
+    const FrameBindStats& s = chunkStats[i];
+    frameBindStats.pipelineBinds += s.pipelineBinds;
+    frameBindStats.descriptorBinds += s.descriptorBinds;
+    frameBindStats.vertexBufferBinds += s.vertexBufferBinds;
+    frameBindStats.indexBufferBinds += s.indexBufferBinds;
+    frameBindStats.pushConstants += s.pushConstants;
+    frameBindStats.draws += s.draws;
+  }
+  lastParallelRecordWallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - wallStart).count();
+  lastRecordChunkCount = static_cast<uint32_t>(chunks.size());
+  return true;
+}
+
 // Public toggle APIs for planar reflections (keyboard/UI)
 void Renderer::SetPlanarReflectionsEnabled(bool enabled) {
   // Flip mode and mark resources dirty so RTs are created/destroyed at the next safe point
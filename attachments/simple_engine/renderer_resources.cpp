@@ -18,8 +18,10 @@
 #include "model_loader.h"
 #include "renderer.h"
 #include "transform_component.h"
+#include "vertex_packing.h"
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
@@ -336,6 +338,16 @@ bool Renderer::createTextureImage(const std::string& texturePath_, TextureResour
       return false;
     }
 
+    // Identical texels already resident under another ID (e.g. a copy in another model's folder): share that texture
+    const uint32_t contentKey[] = {static_cast<uint32_t>(texWidth), static_cast<uint32_t>(texHeight), mipLevels, headerVkFormatRaw, wasTranscoded,
+                                   Renderer::determineTextureFormat(textureId) == vk::Format::eR8G8B8A8Srgb};
+    const ContentHash::Digest contentHash = ContentHash::Compute(ktxTexture_GetData(reinterpret_cast<ktxTexture *>(ktxTex)), static_cast<size_t>(imageSize),
+                                                                 ContentHash::Compute(contentKey, sizeof(contentKey)).low);
+    if (shareTextureByContent(textureId, contentHash, imageSize)) {
+      ktxTexture_Destroy(reinterpret_cast<ktxTexture *>(ktxTex));
+      return true;
+    }
+
     // Create staging buffer
     auto [stagingBuffer, stagingBufferMemory] = createBuffer(
       imageSize,
@@ -477,6 +489,7 @@ bool Renderer::createTextureImage(const std::string& texturePath_, TextureResour
       std::unique_lock<std::shared_mutex> texLock(textureResourcesMutex);
       textureResources[textureId] = std::move(resources);
     }
+    registerTextureContent(contentHash, textureId);
 
     return true;
   } catch (const std::exception& e) {
@@ -485,6 +498,44 @@ bool Renderer::createTextureImage(const std::string& texturePath_, TextureResour
   }
 }
 
+// Alias a texture ID to the loaded texture with the same content, if there is one
+bool Renderer::shareTextureByContent(const std::string& textureId, const ContentHash::Digest& contentHash, vk::DeviceSize bytes) {
+  std::string targetId; {
+    std::shared_lock<std::shared_mutex> texLock(textureResourcesMutex);
+    auto it = textureByContent.find(contentHash);
+    if (it == textureByContent.end() || it->second == textureId || !textureResources.contains(it->second)) {
+      return false;
+    }
+    targetId = it->second;
+  }
+  RegisterTextureAlias(textureId, targetId);
+
+  // Entities registered under the alias now wait for, and bind, the shared texture
+  {
+    std::lock_guard<std::mutex> lk(textureUsersMutex);
+    auto usersIt = textureToEntities.find(textureId);
+    if (usersIt != textureToEntities.end()) {
+      auto& targetUsers = textureToEntities[targetId];
+      targetUsers.insert(targetUsers.end(), usersIt->second.begin(), usersIt->second.end());
+      textureToEntities.erase(textureId);
+    }
+  }
+
+  textureDedupHits.fetch_add(1, std::memory_order_relaxed);
+  textureDedupBytesSaved.fetch_add(bytes, std::memory_order_relaxed);
+  LOG_DEBUG("Resources", "Texture " + textureId + " has the same content as " + targetId + "; sharing it");
+  return true;
+}
+
+// Record the content of a texture just added to textureResources; the first ID loaded with it stays the owner
+void Renderer::registerTextureContent(const ContentHash::Digest& contentHash, const std::string& textureId) {
+  if (!contentHash) {
+    return;
+  }
+  std::unique_lock<std::shared_mutex> texLock(textureResourcesMutex);
+  textureByContent.try_emplace(contentHash, textureId);
+}
+
 // Create texture image view
 bool Renderer::createTextureImageView(TextureResources& resources) {
   try {
@@ -804,6 +855,15 @@ bool Renderer::LoadTextureFromMemory(const std::string& textureId,
     int targetChannels = 4; // Always use RGBA for consistency
     vk::DeviceSize imageSize = width * height * targetChannels;
 
+    // Identical texels already resident under another ID (e.g. the same image embedded in two glTF files): share that texture
+    const uint32_t contentKey[] = {static_cast<uint32_t>(width), static_cast<uint32_t>(height), static_cast<uint32_t>(channels),
+                                   static_cast<uint32_t>(determineTextureFormat(textureId))};
+    const ContentHash::Digest contentHash = ContentHash::Compute(imageData, static_cast<size_t>(width) * height * channels,
+                                                                 ContentHash::Compute(contentKey, sizeof(contentKey)).low);
+    if (shareTextureByContent(resolvedId, contentHash, imageSize)) {
+      return true;
+    }
+
     // Create a staging buffer
     auto [stagingBuffer, stagingBufferMemory] = createBuffer(
       imageSize,
@@ -956,6 +1016,7 @@ bool Renderer::LoadTextureFromMemory(const std::string& textureId,
       std::unique_lock<std::shared_mutex> texLock(textureResourcesMutex);
       textureResources[cacheId] = std::move(resources);
     }
+    registerTextureContent(contentHash, cacheId);
 
     std::cout << "Successfully loaded texture from memory: " << cacheId
         << " (" << width << "x" << height << ", " << channels << " channels)" << std::endl;
@@ -978,16 +1039,25 @@ bool Renderer::createMeshResources(MeshComponent* meshComponent, bool deferUploa
       // flush the pending staging copies right here.
       if (!deferUpload) {
         MeshResources& res = it->second;
+        // Shared buffers have no staging of their own: flush the owner's copy, which is also ours
+        if (res.bufferOwner && (res.vertexBufferSizeBytes > 0 || res.indexBufferSizeBytes > 0) && !*res.stagingVertexBuffer &&
+          !*res.stagingIndexBuffer) {
+          if (!createMeshResources(res.bufferOwner, false)) {
+            return false;
+          }
+          res.vertexBufferSizeBytes = 0;
+          res.indexBufferSizeBytes = 0;
+        }
         if ((res.vertexBufferSizeBytes > 0 && !!*res.stagingVertexBuffer && !!*res.vertexBuffer) ||
           (res.indexBufferSizeBytes > 0 && !!*res.stagingIndexBuffer && !!*res.indexBuffer)) {
           if (res.vertexBufferSizeBytes > 0 && !!*res.stagingVertexBuffer && !!*res.vertexBuffer) {
-            copyBuffer(res.stagingVertexBuffer, res.vertexBuffer, res.vertexBufferSizeBytes);
+            copyBuffer(res.stagingVertexBuffer, res.vertexBuffer.get(), res.vertexBufferSizeBytes);
             res.stagingVertexBuffer = vk::raii::Buffer(nullptr);
             res.stagingVertexBufferMemory = vk::raii::DeviceMemory(nullptr);
             res.vertexBufferSizeBytes = 0;
           }
           if (res.indexBufferSizeBytes > 0 && !!*res.stagingIndexBuffer && !!*res.indexBuffer) {
-            copyBuffer(res.stagingIndexBuffer, res.indexBuffer, res.indexBufferSizeBytes);
+            copyBuffer(res.stagingIndexBuffer, res.indexBuffer.get(), res.indexBufferSizeBytes);
             res.stagingIndexBuffer = vk::raii::Buffer(nullptr);
             res.stagingIndexBufferMemory = vk::raii::DeviceMemory(nullptr);
             res.indexBufferSizeBytes = 0;
@@ -1006,25 +1076,69 @@ bool Renderer::createMeshResources(MeshComponent* meshComponent, bool deferUploa
       return false;
     }
 
+    // The same content already resident under another mesh: share its buffers instead of uploading a copy
+    const MeshGeometryPtr& geometry = meshComponent->GetGeometry();
+    if (geometry && geometry->contentHash) {
+      auto ownerIt = meshBuffersByContent.find(geometry->contentHash);
+      if (ownerIt != meshBuffersByContent.end()) {
+        MeshComponent* owner = ownerIt->second;
+        // An immediate caller needs the data on the GPU now
+        if (!deferUpload && !createMeshResources(owner, false)) {
+          return false;
+        }
+        const MeshResources& ownerRes = meshResources.at(owner);
+        MeshResources resources;
+        resources.vertexBuffer = ownerRes.vertexBuffer;
+        resources.indexBuffer = ownerRes.indexBuffer;
+        resources.bufferOwner = owner;
+        resources.indexCount = ownerRes.indexCount;
+        resources.lods = ownerRes.lods;
+        resources.meshlets = ownerRes.meshlets;
+        // Still pending if the owner's copy is: batches are submitted in order, so ours completes after it
+        resources.vertexBufferSizeBytes = ownerRes.vertexBufferSizeBytes;
+        resources.indexBufferSizeBytes = ownerRes.indexBufferSizeBytes;
+        meshResources[meshComponent] = std::move(resources);
+
+        meshDedupHits.fetch_add(1, std::memory_order_relaxed);
+        meshDedupBytesSaved.fetch_add(static_cast<uint64_t>(getMeshVertexBindingDescription().stride) * vertices.size() +
+                                      sizeof(uint32_t) * (indices.size() + geometry->lodIndices.size()), std::memory_order_relaxed);
+        return true;
+      }
+    }
+
     // --- 1. Create and fill per-mesh staging buffers on the host ---
-    vk::DeviceSize vertexBufferSize = sizeof(vertices[0]) * vertices.size();
+    vk::DeviceSize vertexBufferSize = static_cast<vk::DeviceSize>(getMeshVertexBindingDescription().stride) * vertices.size();
     auto [stagingVertexBuffer, stagingVertexBufferMemory] = createBuffer(
       vertexBufferSize,
       vk::BufferUsageFlagBits::eTransferSrc,
       vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
 
     void* vertexData = stagingVertexBufferMemory.mapMemory(0, vertexBufferSize);
-    std::memcpy(vertexData, vertices.data(), static_cast<size_t>(vertexBufferSize));
+    if (packedVertices) {
+      // Encode straight into the mapped staging memory
+      auto* packed = static_cast<PackedVertex*>(vertexData);
+      for (size_t i = 0; i < vertices.size(); ++i) {
+        packed[i] = VertexPacking::Pack(vertices[i]);
+      }
+    } else {
+      std::memcpy(vertexData, vertices.data(), static_cast<size_t>(vertexBufferSize));
+    }
     stagingVertexBufferMemory.unmapMemory();
 
-    vk::DeviceSize indexBufferSize = sizeof(indices[0]) * indices.size();
+    // The reduced LOD levels are appended to the full-detail indices in one index buffer
+    const std::vector<uint32_t> noLodIndices;
+    const std::vector<uint32_t>& lodIndices = geometry ? geometry->lodIndices : noLodIndices;
+    vk::DeviceSize indexBufferSize = sizeof(indices[0]) * (indices.size() + lodIndices.size());
     auto [stagingIndexBuffer, stagingIndexBufferMemory] = createBuffer(
       indexBufferSize,
       vk::BufferUsageFlagBits::eTransferSrc,
       vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
 
-    void* indexData = stagingIndexBufferMemory.mapMemory(0, indexBufferSize);
-    std::memcpy(indexData, indices.data(), static_cast<size_t>(indexBufferSize));
+    auto* indexData = static_cast<uint32_t*>(stagingIndexBufferMemory.mapMemory(0, indexBufferSize));
+    std::memcpy(indexData, indices.data(), indices.size() * sizeof(uint32_t));
+    if (!lodIndices.empty()) {
+      std::memcpy(indexData + indices.size(), lodIndices.data(), lodIndices.size() * sizeof(uint32_t));
+    }
     stagingIndexBufferMemory.unmapMemory();
 
     // --- 2. Create device-local vertex and index buffers via the memory pool ---
@@ -1044,11 +1158,13 @@ bool Renderer::createMeshResources(MeshComponent* meshComponent, bool deferUploa
 
     // --- 3. Either copy now (legacy path) or defer copies for batched submission ---
     MeshResources resources;
-    resources.vertexBuffer = std::move(vertexBuffer);
-    resources.vertexBufferAllocation = std::move(vertexBufferAllocation);
-    resources.indexBuffer = std::move(indexBuffer);
-    resources.indexBufferAllocation = std::move(indexBufferAllocation);
+    resources.vertexBuffer = SharedDeviceBuffer(std::move(vertexBuffer), std::move(vertexBufferAllocation));
+    resources.indexBuffer = SharedDeviceBuffer(std::move(indexBuffer), std::move(indexBufferAllocation));
     resources.indexCount = static_cast<uint32_t>(indices.size());
+    if (geometry) {
+      resources.lods = geometry->lods;
+      resources.meshlets = geometry->meshlets;
+    }
 
     if (deferUpload) {
       // Keep staging buffers alive and record their sizes; copies will be
@@ -1063,13 +1179,16 @@ bool Renderer::createMeshResources(MeshComponent* meshComponent, bool deferUploa
     } else {
       // Immediate upload path used by preAllocateEntityResources() and other
       // small-object callers. This preserves existing behaviour.
-      copyBuffer(stagingVertexBuffer, resources.vertexBuffer, vertexBufferSize);
-      copyBuffer(stagingIndexBuffer, resources.indexBuffer, indexBufferSize);
+      copyBuffer(stagingVertexBuffer, resources.vertexBuffer.get(), vertexBufferSize);
+      copyBuffer(stagingIndexBuffer, resources.indexBuffer.get(), indexBufferSize);
       // staging* buffers are RAII objects and will be destroyed on scope exit.
     }
 
     // Add to mesh resources map
     meshResources[meshComponent] = std::move(resources);
+    if (geometry && geometry->contentHash) {
+      meshBuffersByContent.emplace(geometry->contentHash, meshComponent);
+    }
 
     return true;
   } catch (const std::exception& e) {
@@ -1126,16 +1245,12 @@ bool Renderer::createUniformBuffers(Entity* entity) {
     // Create instance buffer for all entities (shaders always expect instance data)
     auto* meshComponent = entity->GetComponent<MeshComponent>();
     if (meshComponent) {
-      std::vector<InstanceData> instanceData;
-
+      // Instance data from glTF loading (whether 1 or many instances) is uploaded as stored.
+      // Without instances a single IDENTITY instance avoids a double transform with UBO.model.
+      static const InstanceData identityInstance;
+      std::span<const InstanceData> instanceData(&identityInstance, 1);
       if (meshComponent->GetInstanceCount() > 0) {
-        // Use existing instance data from GLTF loading (whether 1 or many instances)
         instanceData = meshComponent->GetInstances();
-      } else {
-        // Create single instance data using IDENTITY matrix to avoid double-transform with UBO.model
-        InstanceData singleInstance;
-        singleInstance.setModelMatrix(glm::mat4(1.0f));
-        instanceData = {singleInstance};
       }
 
       vk::DeviceSize instanceBufferSize = sizeof(InstanceData) * instanceData.size();
@@ -1800,15 +1915,18 @@ void Renderer::ProcessPendingMeshUploads() {
         res.stagingIndexBuffer = vk::raii::Buffer(nullptr);
         res.stagingIndexBufferMemory = vk::raii::DeviceMemory(nullptr);
         res.indexBufferSizeBytes = 0;
+        if (GetReleaseCpuMeshData()) {
+          meshComponent->ReleaseCpuGeometry();
+        }
       }
 
       anyCompleted = true;
     }
 
     if (anyCompleted) {
-      // Now that more meshes are READY (uploads finished), request a TLAS rebuild so
+      // Now that more meshes are READY (uploads finished), request an AS update so
       // non‑instanced and previously missing meshes are included in the acceleration structure.
-      asDevOverrideAllowRebuild = true; // allow rebuild even if frozen
+      // The update only builds BLAS for these meshes; existing BLAS are reused.
       RequestAccelerationStructureBuild("uploads completed");
     }
   }
@@ -1957,9 +2075,11 @@ void Renderer::ProcessPendingMeshUploads() {
       res.stagingIndexBuffer.clear();
       res.stagingIndexBufferMemory.clear();
       res.indexBufferSizeBytes = 0;
+      if (GetReleaseCpuMeshData()) {
+        meshComponent->ReleaseCpuGeometry();
+      }
     }
 
-    asDevOverrideAllowRebuild = true;
     RequestAccelerationStructureBuild("uploads completed");
   }
 }
@@ -1978,9 +2098,7 @@ bool Renderer::recreateInstanceBuffer(Entity* entity) {
     EntityResources& resources = it->second;
 
     // Create a single instance with identity matrix
-    InstanceData singleInstance;
-    singleInstance.setModelMatrix(glm::mat4(1.0f));
-    std::vector<InstanceData> instanceData = {singleInstance};
+    std::vector<InstanceData> instanceData(1);
 
     vk::DeviceSize instanceBufferSize = sizeof(InstanceData) * instanceData.size();
 
@@ -2592,6 +2710,8 @@ bool Renderer::createOrResizeLightStorageBuffers(size_t lightCount) {
       buffer.mapped = mapped;
       buffer.capacity = newCapacity;
       buffer.size = 0;
+      buffer.versions.assign(newCapacity, 0);
+      buffer.hasShadowCamera = false;
     }
 
     // Update all existing descriptor sets to reference the new light storage buffers
@@ -2630,6 +2750,36 @@ bool Renderer::createOrResizeLightStorageBuffers(size_t lightCount) {
   }
 }
 
+bool Renderer::uploadClusterDrawCommands() {
+  if (clusterDrawCommands.empty()) {
+    return true;
+  }
+  try {
+    if (clusterDrawBuffers.size() != MAX_FRAMES_IN_FLIGHT) {
+      clusterDrawBuffers.resize(MAX_FRAMES_IN_FLIGHT);
+    }
+    // Only this frame's buffer is replaced: its previous contents were consumed before its fence signaled
+    auto& target = clusterDrawBuffers[currentFrame];
+    if (target.capacity < clusterDrawCommands.size()) {
+      const size_t newCapacity = std::max(clusterDrawCommands.size() * 2, static_cast<size_t>(1024));
+      target.buffer = vk::raii::Buffer(nullptr);
+      target.allocation.reset();
+      auto [newBuffer, newAllocation] = createBufferPooled(
+        sizeof(vk::DrawIndexedIndirectCommand) * newCapacity,
+        vk::BufferUsageFlagBits::eIndirectBuffer,
+        vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent);
+      target.buffer = std::move(newBuffer);
+      target.allocation = std::move(newAllocation);
+      target.capacity = newCapacity;
+    }
+    std::memcpy(target.allocation->mappedPtr, clusterDrawCommands.data(), clusterDrawCommands.size() * sizeof(vk::DrawIndexedIndirectCommand));
+    return true;
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to upload cluster draw commands: " << e.what() << std::endl;
+    return false;
+  }
+}
+
 // Update all existing descriptor sets with new light storage buffer references
 void Renderer::updateAllDescriptorSetsWithNewLightBuffers(bool allFrames) {
   try {
@@ -2723,6 +2873,7 @@ void Renderer::refreshPBRForwardPlusBindingsForFrame(uint32_t frameIndex) {
         lightStorageBuffers[frameIndex].mapped = lightStorageBuffers[frameIndex].allocation->mappedPtr;
         lightStorageBuffers[frameIndex].capacity = 1;
         lightStorageBuffers[frameIndex].size = 0;
+        lightStorageBuffers[frameIndex].versions.assign(1, 0);
         // Zero-initialize to prevent garbage data
         if (!!lightStorageBuffers[frameIndex].mapped) {
           std::memset(lightStorageBuffers[frameIndex].mapped, 0, minSize);
@@ -2881,95 +3032,259 @@ void Renderer::refreshPBRForwardPlusBindingsForFrame(uint32_t frameIndex) {
   }
 }
 
+// Light entries that only depend on the light itself (everything but a directional shadow matrix)
+static bool SameLight(const ExtractedLight& a, const ExtractedLight& b) {
+  return a.type == b.type && a.position == b.position && a.direction == b.direction && a.color == b.color &&
+         a.intensity == b.intensity && a.range == b.range && a.innerConeAngle == b.innerConeAngle &&
+         a.outerConeAngle == b.outerConeAngle;
+}
+
+// Light space matrix for shadow mapping; directional lights are centered on the camera when there is one
+static glm::mat4 ComputeLightSpaceMatrix(const ExtractedLight& light, const glm::vec3* cameraPos) {
+  glm::mat4 lightProjection, lightView;
+  if (light.type == ExtractedLight::Type::Directional) {
+    float orthoSize = 50.0f;
+    glm::vec3 shadowCamPos = light.position;
+    glm::vec3 lightDir = glm::normalize(light.direction);
+    if (cameraPos) {
+      // Center shadow map on camera frustum
+      shadowCamPos = *cameraPos - lightDir * 50.0f;
+    }
+    lightProjection = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, 0.1f, 200.0f);
+
+    // Robust up vector to avoid LookAt singularities with vertical lights
+    glm::vec3 up = (std::abs(lightDir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+    lightView = glm::lookAt(shadowCamPos, shadowCamPos + lightDir, up);
+  } else {
+    lightProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, light.range);
+    lightView = glm::lookAt(light.position, light.position + light.direction, glm::vec3(0.0f, 1.0f, 0.0f));
+  }
+  return lightProjection * lightView;
+}
+
+static void WriteLightData(LightData& dst, const ExtractedLight& light, const glm::vec3* cameraPos) {
+  // For directional lights, store direction in position field (they don't need position)
+  // For other lights, store position
+  if (light.type == ExtractedLight::Type::Directional) {
+    dst.position = glm::vec4(light.direction, 0.0f); // w=0 indicates direction
+  } else {
+    dst.position = glm::vec4(light.position, 1.0f); // w=1 indicates position
+  }
+
+  dst.color = glm::vec4(light.color * light.intensity, 1.0f);
+  dst.direction = glm::vec4(light.direction, 0.0f);
+  dst.lightSpaceMatrix = ComputeLightSpaceMatrix(light, cameraPos);
+
+  // Set light type
+  switch (light.type) {
+    case ExtractedLight::Type::Point:
+      dst.lightType = 0;
+      break;
+    case ExtractedLight::Type::Directional:
+      dst.lightType = 1;
+      break;
+    case ExtractedLight::Type::Spot:
+      dst.lightType = 2;
+      break;
+    case ExtractedLight::Type::Emissive:
+      dst.lightType = 3;
+      break;
+  }
+
+  // Set other light properties
+  dst.range = light.range;
+  dst.innerConeAngle = light.innerConeAngle;
+  dst.outerConeAngle = light.outerConeAngle;
+}
+
+// Replace a light set, giving a new version stamp to every entry that differs from the previous one
+void Renderer::stampLightVersions(std::vector<ExtractedLight>& current, const std::vector<ExtractedLight>& lights, std::vector<uint32_t>& versions) {
+  versions.resize(lights.size(), 0);
+  for (size_t i = 0; i < lights.size(); ++i) {
+    if (versions[i] == 0 || i >= current.size() || !SameLight(current[i], lights[i])) {
+      versions[i] = nextLightVersion++;
+      if (nextLightVersion == 0)
+        nextLightVersion = 1;
+    }
+  }
+  current = lights;
+}
+
+// Bring one frame's light buffer up to date with the given sets (concatenated in order).
+// Entries already present are rewritten only when their version changed; entries beyond the
+// buffer's current size are appended at most streamBudget per call.
+uint32_t Renderer::writeLightEntries(LightStorageBuffer& buffer, std::span<const LightSet> sets, const glm::vec3* cameraPos, size_t streamBudget, LightUpdateStats& stats) {
+  size_t total = 0;
+  for (const auto& set : sets)
+    total += set.count;
+  total = std::min(total, buffer.capacity);
+  if (buffer.versions.size() < buffer.capacity)
+    buffer.versions.resize(buffer.capacity, 0);
+
+  // Directional shadow matrices follow the camera; refresh them only when it moved
+  const bool cameraMoved = cameraPos ? (!buffer.hasShadowCamera || buffer.shadowCameraPos != *cameraPos) : buffer.hasShadowCamera;
+  auto* lightData = static_cast<LightData *>(buffer.mapped);
+  const size_t valid = std::min(buffer.size, total);
+  const size_t target = std::min(total, valid + streamBudget);
+
+  size_t slot = 0;
+  for (const auto& set : sets) {
+    for (size_t i = 0; i < set.count && slot < target; ++i, ++slot) {
+      const ExtractedLight& light = set.lights[i];
+      if (slot >= valid || buffer.versions[slot] != set.versions[i]) {
+        WriteLightData(lightData[slot], light, cameraPos);
+        buffer.versions[slot] = set.versions[i];
+        ++stats.written;
+      } else if (cameraMoved && light.type == ExtractedLight::Type::Directional) {
+        lightData[slot].lightSpaceMatrix = ComputeLightSpaceMatrix(light, cameraPos);
+        ++stats.shadowRefreshed;
+      }
+    }
+  }
+
+  buffer.hasShadowCamera = cameraPos != nullptr;
+  if (cameraPos)
+    buffer.shadowCameraPos = *cameraPos;
+  buffer.size = target;
+  stats.lights += static_cast<uint32_t>(total);
+  stats.pending += static_cast<uint32_t>(total - target);
+  return static_cast<uint32_t>(target);
+}
+
 // Update the light storage buffer with current light data
-bool Renderer::updateLightStorageBuffer(uint32_t frameIndex, const std::vector<ExtractedLight>& lights, CameraComponent* camera) {
+uint32_t Renderer::updateLightStorageBuffer(uint32_t frameIndex, size_t lightCount, CameraComponent* camera) {
   try {
-    // Ensure buffers are large enough and properly initialized
-    if (!createOrResizeLightStorageBuffers(lights.size())) {
-      return false;
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Grow only when a buffer is actually too small; growth is geometric, so this stays off the per-frame path
+    if (frameIndex >= lightStorageBuffers.size() || lightStorageBuffers[frameIndex].capacity < lightCount) {
+      if (!createOrResizeLightStorageBuffers(lightCount)) {
+        return 0;
+      }
     }
 
     // Now check frame index after buffers are properly initialized
     if (frameIndex >= lightStorageBuffers.size()) {
       std::cerr << "Invalid frame index for light storage buffer update: " << frameIndex
           << " >= " << lightStorageBuffers.size() << std::endl;
-      return false;
+      return 0;
     }
 
     auto& buffer = lightStorageBuffers[frameIndex];
     if (!buffer.mapped) {
       std::cerr << "Light storage buffer not mapped" << std::endl;
-      return false;
+      return 0;
     }
 
-    // Convert ExtractedLight data to LightData format
-    auto* lightData = static_cast<LightData *>(buffer.mapped);
-    for (size_t i = 0; i < lights.size(); ++i) {
-      const auto& light = lights[i];
-
-      // For directional lights, store direction in position field (they don't need position)
-      // For other lights, store position
-      if (light.type == ExtractedLight::Type::Directional) {
-        lightData[i].position = glm::vec4(light.direction, 0.0f); // w=0 indicates direction
-      } else {
-        lightData[i].position = glm::vec4(light.position, 1.0f); // w=1 indicates position
-      }
-
-      lightData[i].color = glm::vec4(light.color * light.intensity, 1.0f);
-      lightData[i].direction = glm::vec4(light.direction, 0.0f);
-
-      // Calculate light space matrix for shadow mapping
-      glm::mat4 lightProjection, lightView;
-      if (light.type == ExtractedLight::Type::Directional) {
-        float orthoSize = 50.0f;
-        glm::vec3 shadowCamPos = light.position;
-        glm::vec3 lightDir = glm::normalize(light.direction);
-        if (camera) {
-             // Center shadow map on camera frustum
-             glm::vec3 camPos = camera->GetPosition();
-             shadowCamPos = camPos - lightDir * 50.0f;
-        }
-        lightProjection = glm::ortho(-orthoSize, orthoSize, -orthoSize, orthoSize, 0.1f, 200.0f);
+    const size_t staticCount = std::min(staticLights.size(), lightCount);
+    const std::array<LightSet, 2> sets = {
+      LightSet{staticLights.data(), staticLightVersions.data(), staticCount},
+      LightSet{dynamicLights.data(), dynamicLightVersions.data(), std::min(dynamicLights.size(), lightCount - staticCount)}
+    };
 
-        // Robust up vector to avoid LookAt singularities with vertical lights
-        glm::vec3 up = (std::abs(lightDir.y) > 0.99f) ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
-        lightView = glm::lookAt(shadowCamPos, shadowCamPos + lightDir, up);
-      } else {
-        lightProjection = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, light.range);
-        lightView = glm::lookAt(light.position, light.position + light.direction, glm::vec3(0.0f, 1.0f, 0.0f));
-      }
-      lightData[i].lightSpaceMatrix = lightProjection * lightView;
+    LightUpdateStats stats;
+    glm::vec3 cameraPos = camera ? camera->GetPosition() : glm::vec3(0.0f);
+    uint32_t validCount = writeLightEntries(buffer, sets, camera ? &cameraPos : nullptr, lightStreamBudget, stats);
+    stats.updateMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    lastLightUpdateStats = stats;
+    return validCount;
+  } catch (const std::exception& e) {
+    std::cerr << "Failed to update light storage buffer: " << e.what() << std::endl;
+    return 0;
+  }
+}
 
-      // Set light type
-      switch (light.type) {
-        case ExtractedLight::Type::Point:
-          lightData[i].lightType = 0;
-          break;
-        case ExtractedLight::Type::Directional:
-          lightData[i].lightType = 1;
-          break;
-        case ExtractedLight::Type::Spot:
-          lightData[i].lightType = 2;
-          break;
-        case ExtractedLight::Type::Emissive:
-          lightData[i].lightType = 3;
-          break;
-      }
+// Deterministic pseudo-random lights: a handful of directional lights, the rest point and spot lights over a 200 m square
+static std::vector<ExtractedLight> MakeSyntheticLights(uint32_t lightCount, uint32_t& seed) {
+  auto next = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+  };
+  std::vector<ExtractedLight> lights(lightCount);
+  for (uint32_t i = 0; i < lightCount; ++i) {
+    auto& L = lights[i];
+    L.type = (i % 512 == 0) ? ExtractedLight::Type::Directional : (i % 3 == 0 ? ExtractedLight::Type::Spot : ExtractedLight::Type::Point);
+    L.position = glm::vec3(next() * 200.0f - 100.0f, next() * 20.0f, next() * 200.0f - 100.0f);
+    L.direction = glm::normalize(glm::vec3(next() - 0.5f, -1.0f, next() - 0.5f));
+    L.color = glm::vec3(next(), next(), next());
+    L.range = 5.0f + next() * 20.0f;
+  }
+  return lights;
+}
 
-      // Set other light properties
-      lightData[i].range = light.range;
-      lightData[i].innerConeAngle = light.innerConeAngle;
-      lightData[i].outerConeAngle = light.outerConeAngle;
+// Feed the synthetic lights to the dynamic set, moving 1% of them each frame
+void Renderer::updateSyntheticLights() {
+  if (syntheticLightCount == 0) {
+    if (!syntheticLights.empty()) {
+      syntheticLights.clear();
+      SetDynamicLights(syntheticLights);
     }
+    return;
+  }
+  if (syntheticLights.size() != syntheticLightCount) {
+    uint32_t seed = 12345u;
+    syntheticLights = MakeSyntheticLights(syntheticLightCount, seed);
+  } else {
+    const uint32_t changed = std::max(1u, syntheticLightCount / 100);
+    const float offset = (syntheticLightFrame & 1u) ? -0.01f : 0.01f;
+    for (uint32_t c = 0; c < changed; ++c) {
+      syntheticLights[(syntheticLightFrame * changed + c) % syntheticLightCount].position.y += offset;
+    }
+    ++syntheticLightFrame;
+  }
+  SetDynamicLights(syntheticLights);
+}
 
-    // Update buffer size
-    buffer.size = lights.size();
+// Time writeLightEntries on lightCount synthetic lights in host memory (no GPU involved)
+Renderer::LightBenchmarkResult Renderer::BenchmarkLightUpload(uint32_t lightCount) {
+  using Clock = std::chrono::steady_clock;
+  constexpr int frames = 32;
 
-    return true;
-  } catch (const std::exception& e) {
-    std::cerr << "Failed to update light storage buffer: " << e.what() << std::endl;
-    return false;
+  uint32_t seed = 12345u;
+  auto next = [&seed]() {
+    seed = seed * 1664525u + 1013904223u;
+    return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+  };
+  std::vector<ExtractedLight> lights = MakeSyntheticLights(lightCount, seed);
+  std::vector<uint32_t> versions(lightCount);
+  for (uint32_t i = 0; i < lightCount; ++i) {
+    versions[i] = i + 1;
+  }
+  uint32_t nextVersion = lightCount + 1;
+
+  std::vector<LightData> storage(lightCount);
+  LightStorageBuffer buffer;
+  buffer.mapped = storage.data();
+  buffer.capacity = lightCount;
+  const LightSet set{lights.data(), versions.data(), lightCount};
+  glm::vec3 cameraPos(0.0f, 2.0f, 0.0f);
+
+  LightBenchmarkResult result;
+  LightUpdateStats stats;
+  auto t0 = Clock::now();
+  writeLightEntries(buffer, std::span(&set, 1), &cameraPos, lightCount, stats);
+  result.initialMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+
+  t0 = Clock::now();
+  for (int f = 0; f < frames; ++f)
+    writeLightEntries(buffer, std::span(&set, 1), &cameraPos, lightCount, stats);
+  result.staticMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count() / frames;
+
+  const uint32_t changed = std::max(1u, lightCount / 100);
+  double dynamicTotal = 0.0;
+  for (int f = 0; f < frames; ++f) {
+    for (uint32_t c = 0; c < changed; ++c) {
+      uint32_t i = static_cast<uint32_t>(next() * static_cast<float>(lightCount)) % lightCount;
+      lights[i].position.y += 0.01f;
+      versions[i] = nextVersion++;
+    }
+    cameraPos.x += 0.05f;
+    t0 = Clock::now();
+    writeLightEntries(buffer, std::span(&set, 1), &cameraPos, lightCount, stats);
+    dynamicTotal += std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
   }
+  result.dynamicMs = dynamicTotal / frames;
+  return result;
 }
 
 // Asynchronous texture loading implementations using ThreadPool
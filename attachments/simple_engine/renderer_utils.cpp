@@ -146,8 +146,9 @@ QueueFamilyIndices Renderer::findQueueFamilies(const vk::raii::PhysicalDevice& d
     if ((qf.queueFlags & vk::QueueFlagBits::eCompute) && !indices.computeFamily.has_value()) {
       indices.computeFamily = i;
     }
-    // Check for present support
-    if (!indices.presentFamily.has_value() && device.getSurfaceSupportKHR(i, *surface)) {
+    // Check for present support (headless: the graphics queue finishes the frame instead)
+    const bool canPresent = headless ? static_cast<bool>(qf.queueFlags & vk::QueueFlagBits::eGraphics) : static_cast<bool>(device.getSurfaceSupportKHR(i, *surface));
+    if (!indices.presentFamily.has_value() && canPresent) {
       indices.presentFamily = i;
     }
     // Prefer a dedicated transfer queue (transfer bit set, but NOT graphics) if available
@@ -16,7 +16,16 @@
  */
 #include "resource_manager.h"
 
-#include <ranges>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <typeindex>
+
+#include "thread_pool.h"
 
 // Most of the ResourceManager class implementation is in the header file
 // This file is mainly for any methods that might need additional implementation
@@ -24,6 +33,40 @@
 // This implementation corresponds to the Engine_Architecture chapter in the tutorial:
 // @see en/Building_a_Simple_Engine/Engine_Architecture/04_resource_management.adoc
 
+namespace
+{
+/**
+ * A resource whose load waits like a file read, then computes like a decode.
+ */
+class SimulatedAsset final : public Resource
+{
+  public:
+	SimulatedAsset(const std::string &id, uint32_t ioMicroseconds) :
+	    Resource(id), ioMicroseconds(ioMicroseconds)
+	{}
+
+	bool Load() override
+	{
+		std::this_thread::sleep_for(std::chrono::microseconds(ioMicroseconds));
+		const auto decodeEnd = std::chrono::steady_clock::now() + std::chrono::microseconds(ioMicroseconds);
+		uint64_t   state     = 0x9E3779B97F4A7C15ull;
+		while (std::chrono::steady_clock::now() < decodeEnd)
+		{
+			for (int i = 0; i < 1024; ++i)
+			{
+				state = state * 6364136223846793005ull + 1442695040888963407ull;
+			}
+		}
+		checksum = state;
+		return Resource::Load();
+	}
+
+  private:
+	uint32_t ioMicroseconds;
+	uint64_t checksum = 0;
+};
+}        // namespace
+
 bool Resource::Load()
 {
 	loaded = true;
@@ -35,17 +78,619 @@ void Resource::Unload()
 	loaded = false;
 }
 
+uint32_t ResourceManager::NextTypeIndex()
+{
+	static std::atomic<uint32_t> nextTypeIndex{0};
+	return nextTypeIndex.fetch_add(1, std::memory_order_relaxed);
+}
+
+uint32_t ResourceManager::FindSlotByName(uint32_t typeIndex, const std::string &id) const
+{
+	if (typeIndex >= types.size())
+	{
+		return UINT32_MAX;
+	}
+	auto nameIt = nameIds.find(id);
+	if (nameIt == nameIds.end())
+	{
+		return UINT32_MAX;
+	}
+	const auto &slotByNameId = types[typeIndex].slotByNameId;
+	return nameIt->second < slotByNameId.size() ? slotByNameId[nameIt->second] : UINT32_MAX;
+}
+
+uint32_t ResourceManager::InternId(const std::string &id)
+{
+	auto [it, inserted] = nameIds.try_emplace(id, static_cast<uint32_t>(names.size()));
+	if (inserted)
+	{
+		names.push_back(id);
+	}
+	return it->second;
+}
+
+uint32_t ResourceManager::FindOrInternSlot(TypeSlots &typeSlots, const std::string &id, uint32_t &nameId)
+{
+	nameId = InternId(id);
+	if (nameId >= typeSlots.slotByNameId.size())
+	{
+		typeSlots.slotByNameId.resize(names.size(), UINT32_MAX);
+	}
+	return typeSlots.slotByNameId[nameId];
+}
+
+uint32_t ResourceManager::AllocateSlot(TypeSlots &typeSlots, uint32_t nameId, std::unique_ptr<Resource> resource)
+{
+	// Reuse a freed slot if there is one
+	uint32_t index;
+	if (!typeSlots.freeSlots.empty())
+	{
+		index = typeSlots.freeSlots.back();
+		typeSlots.freeSlots.pop_back();
+	}
+	else
+	{
+		index = static_cast<uint32_t>(typeSlots.slots.size());
+		typeSlots.slots.emplace_back();
+	}
+	Slot &slot    = typeSlots.slots[index];
+	slot.resource = std::move(resource);
+	slot.refCount = 0;
+	slot.nameId   = nameId;
+	slot.state    = ResourceState::Loading;
+	typeSlots.slotByNameId[nameId] = index;
+	return index;
+}
+
+void ResourceManager::FreeSlot(TypeSlots &typeSlots, uint32_t index)
+{
+	Slot &slot = typeSlots.slots[index];
+	if (typeSlots.slotByNameId[slot.nameId] == index)
+	{
+		typeSlots.slotByNameId[slot.nameId] = UINT32_MAX;
+	}
+	// A worker is using the resource; FinishLoad frees the slot
+	if (slot.loadInFlight)
+	{
+		slot.unloadRequested = true;
+		return;
+	}
+
+	if (slot.state == ResourceState::Ready)
+	{
+		slot.resource->Unload();
+	}
+	// Whatever was waiting for a load that will not happen now fails
+	for (auto &callback : slot.callbacks)
+	{
+		readyCallbacks.emplace_back(std::move(callback), false);
+	}
+	std::vector<ResourceKey> dependencies = std::move(slot.dependencies);
+	std::vector<ResourceKey> dependents   = std::move(slot.dependents);
+	slot.callbacks.clear();
+	slot.dependencies.clear();
+	slot.dependents.clear();
+	slot.resource.reset();
+	slot.state               = ResourceState::Unloaded;
+	slot.unloadRequested     = false;
+	slot.pendingDependencies = 0;
+	// A new generation invalidates the handles to the old resource; 0 is reserved for empty handles
+	if (++slot.generation == 0)
+	{
+		slot.generation = 1;
+	}
+	slot.refCount = 0;
+	typeSlots.freeSlots.push_back(index);
+
+	for (const ResourceKey &dependency : dependencies)
+	{
+		ReleaseReference(dependency.type, dependency.index, dependency.generation);
+	}
+	for (const ResourceKey &dependent : dependents)
+	{
+		FailLoad(dependent);
+	}
+}
+
+ResourceManager::~ResourceManager()
+{
+	// Workers still hold pointers into this manager
+	while (inFlightLoads > 0)
+	{
+		ProcessCompletedLoads(true);
+	}
+}
+
+ResourceKey ResourceManager::LoadNow(uint32_t typeIndex, const std::string &id, const std::function<std::unique_ptr<Resource>()> &create)
+{
+	loadStats.requests++;
+	TypeSlots &typeSlots = GetTypeSlots(typeIndex);
+	uint32_t   nameId;
+	uint32_t   index = FindOrInternSlot(typeSlots, id, nameId);
+
+	// Check if the resource already exists, finishing its load if one is in progress
+	if (index != UINT32_MAX)
+	{
+		const ResourceKey key{typeIndex, index, typeSlots.slots[index].generation};
+		WaitForSlot(key);
+		if (const Slot *slot = FindSlot(key); slot && slot->state == ResourceState::Ready)
+		{
+			loadStats.coalesced++;
+			return key;
+		}
+		// A failed load is retried; a freed one is simply gone
+		if (typeSlots.slotByNameId[nameId] == index)
+		{
+			FreeSlot(typeSlots, index);
+		}
+	}
+
+	// Create and load the resource
+	std::unique_ptr<Resource> resource = create();
+	if (!resource->Load())
+	{
+		loadStats.failed++;
+		throw std::runtime_error("Failed to load resource: " + id);
+	}
+	loadStats.loaded++;
+
+	index      = AllocateSlot(typeSlots, nameId, std::move(resource));
+	Slot &slot = typeSlots.slots[index];
+	slot.state = ResourceState::Ready;
+	return {typeIndex, index, slot.generation};
+}
+
+ResourceKey ResourceManager::RequestLoad(uint32_t typeIndex, const std::string &id, const std::vector<ResourceKey> &dependencies,
+                                         std::function<void(bool)> onLoaded, const std::function<std::unique_ptr<Resource>()> &create)
+{
+	loadStats.requests++;
+	TypeSlots &typeSlots = GetTypeSlots(typeIndex);
+	uint32_t   nameId;
+	uint32_t   index = FindOrInternSlot(typeSlots, id, nameId);
+
+	// Join a load that is already requested or done; its own dependencies stand
+	if (index != UINT32_MAX && typeSlots.slots[index].state != ResourceState::Failed)
+	{
+		Slot &slot = typeSlots.slots[index];
+		loadStats.coalesced++;
+		if (onLoaded && slot.state == ResourceState::Loading)
+		{
+			slot.callbacks.push_back(std::move(onLoaded));
+		}
+		else if (onLoaded)
+		{
+			readyCallbacks.emplace_back(std::move(onLoaded), true);
+		}
+		return {typeIndex, index, slot.generation};
+	}
+	if (index != UINT32_MAX)
+	{
+		FreeSlot(typeSlots, index);
+	}
+
+	index = AllocateSlot(typeSlots, nameId, create());
+	const ResourceKey key{typeIndex, index, typeSlots.slots[index].generation};
+	if (onLoaded)
+	{
+		typeSlots.slots[index].callbacks.push_back(std::move(onLoaded));
+	}
+
+	// No slot array grows from here on, so slot pointers stay valid
+	bool dependencyFailed = false;
+	for (const ResourceKey &dependency : dependencies)
+	{
+		Slot *dependencySlot = FindSlot(dependency);
+		if (!dependencySlot || dependencySlot->state == ResourceState::Failed)
+		{
+			dependencyFailed = true;
+			continue;
+		}
+		Slot &slot = typeSlots.slots[index];
+		dependencySlot->refCount++;
+		slot.dependencies.push_back(dependency);
+		if (dependencySlot->state == ResourceState::Loading)
+		{
+			dependencySlot->dependents.push_back(key);
+			slot.pendingDependencies++;
+		}
+	}
+
+	if (dependencyFailed)
+	{
+		FailLoad(key);
+	}
+	else if (typeSlots.slots[index].pendingDependencies == 0)
+	{
+		StartLoad(key);
+	}
+	return key;
+}
+
+void ResourceManager::StartLoad(const ResourceKey &key)
+{
+	Slot &slot        = types[key.type].slots[key.index];
+	slot.loadInFlight = true;
+	inFlightLoads++;
+
+	Resource *resource = slot.resource.get();
+	auto load = [resource]() {
+		try
+		{
+			return resource->Load();
+		}
+		catch (const std::exception &e)
+		{
+			std::cerr << "Failed to load resource " << resource->GetId() << ": " << e.what() << std::endl;
+			return false;
+		}
+	};
+
+	if (threadPool)
+	{
+		try
+		{
+			threadPool->enqueue([this, load, key]() {
+				const bool loaded = load();
+				// Notify under the lock: once the main thread sees the completion, the manager may be destroyed
+				std::lock_guard<std::mutex> lock(completedMutex);
+				completedLoads.push_back({key, loaded});
+				completedCondition.notify_all();
+			});
+			return;
+		}
+		catch (const std::exception &)
+		{
+			// The pool is shutting down; load on this thread instead
+		}
+	}
+	FinishLoad(key, load());
+}
+
+void ResourceManager::FinishLoad(const ResourceKey &key, bool loaded)
+{
+	inFlightLoads--;
+	// A slot is never freed while its load is in flight, so the key is still current
+	TypeSlots &typeSlots = types[key.type];
+	Slot      &slot      = typeSlots.slots[key.index];
+	slot.loadInFlight    = false;
+	slot.state           = loaded ? ResourceState::Ready : ResourceState::Failed;
+	if (loaded)
+	{
+		loadStats.loaded++;
+	}
+	else
+	{
+		loadStats.failed++;
+	}
+	// A resource unloaded during its load is gone as soon as the load ends; nothing waiting for it may use it
+	const bool available = loaded && !slot.unloadRequested;
+	const bool freeSlot  = slot.unloadRequested;
+	for (auto &callback : slot.callbacks)
+	{
+		readyCallbacks.emplace_back(std::move(callback), available);
+	}
+	slot.callbacks.clear();
+	std::vector<ResourceKey> dependents = std::move(slot.dependents);
+	slot.dependents.clear();
+
+	// Settle the dependents while this slot's generation is still the one they recorded
+	for (const ResourceKey &dependent : dependents)
+	{
+		Slot *dependentSlot = FindSlot(dependent);
+		if (!dependentSlot || dependentSlot->state != ResourceState::Loading)
+		{
+			continue;
+		}
+		if (!available)
+		{
+			FailLoad(dependent);
+		}
+		else if (--dependentSlot->pendingDependencies == 0)
+		{
+			StartLoad(dependent);
+		}
+	}
+	if (freeSlot)
+	{
+		FreeSlot(typeSlots, key.index);
+	}
+}
+
+void ResourceManager::FailLoad(const ResourceKey &key)
+{
+	Slot *slot = FindSlot(key);
+	if (!slot || slot->state != ResourceState::Loading || slot->loadInFlight)
+	{
+		return;
+	}
+	slot->state = ResourceState::Failed;
+	loadStats.failed++;
+	for (auto &callback : slot->callbacks)
+	{
+		readyCallbacks.emplace_back(std::move(callback), false);
+	}
+	slot->callbacks.clear();
+	std::vector<ResourceKey> dependents = std::move(slot->dependents);
+	slot->dependents.clear();
+	for (const ResourceKey &dependent : dependents)
+	{
+		FailLoad(dependent);
+	}
+}
+
+void ResourceManager::ProcessCompletedLoads(bool wait)
+{
+	std::vector<CompletedLoad> completed;
+	{
+		std::unique_lock<std::mutex> lock(completedMutex);
+		if (wait)
+		{
+			completedCondition.wait(lock, [this]() { return !completedLoads.empty(); });
+		}
+		completed.swap(completedLoads);
+	}
+	for (const CompletedLoad &load : completed)
+	{
+		FinishLoad(load.key, load.loaded);
+	}
+}
+
+void ResourceManager::WaitForSlot(const ResourceKey &key)
+{
+	// Every load that is waiting depends, eventually, on one in flight
+	for (const Slot *slot = FindSlot(key); slot && slot->state == ResourceState::Loading && inFlightLoads > 0; slot = FindSlot(key))
+	{
+		ProcessCompletedLoads(true);
+	}
+}
+
+void ResourceManager::Update()
+{
+	ProcessCompletedLoads(false);
+
+	// Callbacks may request more loads, whose own callbacks wait for the next Update
+	std::vector<std::pair<std::function<void(bool)>, bool>> callbacks = std::move(readyCallbacks);
+	readyCallbacks.clear();
+	for (auto &[callback, loaded] : callbacks)
+	{
+		callback(loaded);
+	}
+}
+
+void ResourceManager::WaitForPendingLoads()
+{
+	do
+	{
+		while (inFlightLoads > 0)
+		{
+			ProcessCompletedLoads(true);
+		}
+		Update();
+	} while (inFlightLoads > 0 || !readyCallbacks.empty());
+}
+
+size_t ResourceManager::UnloadUnusedResources()
+{
+	// Freeing a resource releases its dependencies, which may then be unused too
+	size_t unloaded = 0;
+	size_t unloadedThisPass;
+	do
+	{
+		unloadedThisPass = 0;
+		for (auto &typeSlots : types)
+		{
+			for (uint32_t i = 0; i < typeSlots.slots.size(); ++i)
+			{
+				const Slot &slot = typeSlots.slots[i];
+				if (slot.resource && slot.refCount == 0 && slot.state != ResourceState::Loading)
+				{
+					FreeSlot(typeSlots, i);
+					unloadedThisPass++;
+				}
+			}
+		}
+		unloaded += unloadedThisPass;
+	} while (unloadedThisPass > 0);
+	return unloaded;
+}
+
 void ResourceManager::UnloadAllResources()
 {
-	for (auto &kv : resources)
+	WaitForPendingLoads();
+
+	// Slots stay allocated so that outstanding handles can still release their references safely
+	for (auto &typeSlots : types)
+	{
+		for (uint32_t i = 0; i < typeSlots.slots.size(); ++i)
+		{
+			if (typeSlots.slots[i].resource)
+			{
+				FreeSlot(typeSlots, i);
+			}
+		}
+	}
+}
+
+size_t ResourceManager::GetResourceCount() const
+{
+	size_t count = 0;
+	for (const auto &typeSlots : types)
+	{
+		count += typeSlots.slots.size() - typeSlots.freeSlots.size();
+	}
+	return count;
+}
+
+ResourceManager::HandleBenchmarkResult ResourceManager::Benchmark(uint32_t resourceCount, uint32_t lookups)
+{
+	HandleBenchmarkResult result;
+	result.resources = std::max(1u, resourceCount);
+	result.lookups   = lookups;
+
+	// Path-like IDs, as textures and meshes use
+	std::vector<std::string> ids;
+	ids.reserve(result.resources);
+	char text[96];
+	for (uint32_t i = 0; i < result.resources; ++i)
+	{
+		std::snprintf(text, sizeof(text), "Assets/bistro/textures/material_%05u_baseColor.ktx2", i);
+		ids.emplace_back(text);
+	}
+
+	ResourceManager                       manager;
+	std::vector<ResourceHandle<Resource>> handles;
+	handles.reserve(result.resources);
+	for (const auto &id : ids)
+	{
+		handles.push_back(manager.LoadResource<Resource>(id));
+	}
+
+	// The lookup scheme before handles: type, then ID
+	std::unordered_map<std::type_index, std::unordered_map<std::string, std::unique_ptr<Resource>>> nested;
+	auto &nestedTyped = nested[std::type_index(typeid(Resource))];
+	for (const auto &id : ids)
+	{
+		auto resource = std::make_unique<Resource>(id);
+		resource->Load();
+		nestedTyped[id] = std::move(resource);
+	}
+
+	// Same random order for every method, so each sees the same cache behavior
+	std::vector<uint32_t>                   order(lookups);
+	std::mt19937                            rng(1234);
+	std::uniform_int_distribution<uint32_t> pick(0, result.resources - 1);
+	for (auto &o : order)
+	{
+		o = pick(rng);
+	}
+
+	auto run = [&](auto &&lookup) {
+		uint64_t   hits  = 0;
+		const auto start = std::chrono::steady_clock::now();
+		for (uint32_t o : order)
+		{
+			const Resource *resource = lookup(o);
+			hits += resource && resource->IsLoaded() ? 1u : 0u;
+		}
+		const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (hits != order.size())
+		{
+			return 0.0;
+		}
+		return seconds > 0.0 ? static_cast<double>(order.size()) / seconds : 0.0;
+	};
+
+	result.handleLookupsPerSecond    = run([&](uint32_t i) { return handles[i].Get(); });
+	result.idLookupsPerSecond        = run([&](uint32_t i) { return manager.GetResource<Resource>(ids[i]); });
+	result.nestedMapLookupsPerSecond = run([&](uint32_t i) -> const Resource * {
+		auto typeIt = nested.find(std::type_index(typeid(Resource)));
+		if (typeIt == nested.end())
+		{
+			return nullptr;
+		}
+		auto resourceIt = typeIt->second.find(ids[i]);
+		return resourceIt != typeIt->second.end() ? resourceIt->second.get() : nullptr;
+	});
+	return result;
+}
+
+ResourceManager::AsyncLoadBenchmarkResult ResourceManager::BenchmarkAsyncLoading(ThreadPool *pool, uint32_t models, uint32_t texturesPerModel,
+                                                                                 uint32_t ioMicroseconds)
+{
+	AsyncLoadBenchmarkResult result;
+	result.models    = std::max(1u, models);
+	texturesPerModel = std::max(1u, texturesPerModel);
+
+	// Each model has its own textures plus a set every model shares, as materials often do
+	const uint32_t sharedTextures = std::max(1u, texturesPerModel / 2);
+	result.resources              = result.models * (1 + texturesPerModel - sharedTextures) + sharedTextures;
+	auto textureId = [&](uint32_t model, uint32_t texture) {
+		char text[96];
+		if (texture < sharedTextures)
+		{
+			std::snprintf(text, sizeof(text), "Assets/shared/textures/common_%03u.ktx2", texture);
+		}
+		else
+		{
+			std::snprintf(text, sizeof(text), "Assets/model_%03u/textures/texture_%03u.ktx2", model, texture);
+		}
+		return std::string(text);
+	};
+	auto modelId = [](uint32_t model) {
+		char text[96];
+		std::snprintf(text, sizeof(text), "Assets/model_%03u/model.gltf", model);
+		return std::string(text);
+	};
+
+	// One resource at a time, textures before the model that uses them
+	auto start = std::chrono::steady_clock::now();
 	{
-		auto &val = kv.second;
-		for (auto &innerKv : val)
+		ResourceManager                             manager;
+		std::vector<ResourceHandle<SimulatedAsset>> handles;
+		for (uint32_t m = 0; m < result.models; ++m)
 		{
-			auto &loadedResource = innerKv.second;
-			loadedResource->Unload();
+			for (uint32_t t = 0; t < texturesPerModel; ++t)
+			{
+				handles.push_back(manager.LoadResource<SimulatedAsset>(textureId(m, t), ioMicroseconds));
+			}
+			handles.push_back(manager.LoadResource<SimulatedAsset>(modelId(m), ioMicroseconds));
 		}
-		val.clear();
 	}
-	resources.clear();
+	result.synchronousMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	// Everything requested up front; each model waits only for its own textures
+	start = std::chrono::steady_clock::now();
+	{
+		ResourceManager manager;
+		manager.SetThreadPool(pool);
+		std::vector<ResourceHandle<SimulatedAsset>> modelHandles;
+		uint32_t                                    modelsLoaded = 0;
+		for (uint32_t m = 0; m < result.models; ++m)
+		{
+			std::vector<ResourceKey> textures;
+			for (uint32_t t = 0; t < texturesPerModel; ++t)
+			{
+				textures.push_back(manager.LoadResourceAsync<SimulatedAsset>(textureId(m, t), {}, {}, ioMicroseconds).GetKey());
+			}
+			modelHandles.push_back(manager.LoadResourceAsync<SimulatedAsset>(
+			    modelId(m), textures, [&modelsLoaded](bool loaded) { modelsLoaded += loaded ? 1u : 0u; }, ioMicroseconds));
+		}
+		manager.WaitForPendingLoads();
+		result.coalesced = manager.GetLoadStats().coalesced;
+		if (modelsLoaded != result.models)
+		{
+			return result;
+		}
+	}
+	result.asynchronousMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+uint32_t ResourceManager::CheckUnloadWithQueuedDependent(ThreadPool *pool)
+{
+	if (!pool)
+	{
+		return 0;
+	}
+
+	// A model waits for a texture whose load is still running when the texture is unloaded
+	ResourceManager manager;
+	manager.SetThreadPool(pool);
+	bool textureCallback = true;
+	bool modelCallback   = true;
+	auto texture         = manager.LoadResourceAsync<SimulatedAsset>(
+	    "Assets/check/texture.ktx2", {}, [&textureCallback](bool loaded) { textureCallback = loaded; }, 20000u);
+	auto model = manager.LoadResourceAsync<SimulatedAsset>(
+	    "Assets/check/model.gltf", {texture.GetKey()}, [&modelCallback](bool loaded) { modelCallback = loaded; }, 1000u);
+	const bool unloaded = manager.UnloadResource<SimulatedAsset>("Assets/check/texture.ktx2");
+	manager.WaitForPendingLoads();
+
+	uint32_t failures = 0;
+	failures += unloaded ? 0u : 1u;
+	failures += textureCallback ? 1u : 0u;        // the texture was unloaded before anyone could use it
+	failures += modelCallback ? 1u : 0u;
+	failures += model.GetState() == ResourceState::Failed ? 0u : 1u;
+	failures += manager.GetLoadStats().loaded == 1 ? 0u : 1u;        // only the texture's own load ran
+	failures += texture.Get() == nullptr ? 0u : 1u;
+	return failures;
 }
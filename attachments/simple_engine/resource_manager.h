@@ -16,17 +16,22 @@
  */
 #pragma once
 
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
-#include <typeindex>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 /**
  * @brief Base class for all resources.
  */
-class Resource final
+class Resource
 {
   protected:
 	std::string resourceId;
@@ -76,16 +81,56 @@ class Resource final
 	virtual void Unload();
 };
 
+class ResourceManager;
+class ThreadPool;
+
+/**
+ * @brief Load state of a resource slot.
+ */
+enum class ResourceState : uint8_t
+{
+	Unloaded,        // no such resource, or the handle is stale
+	Loading,         // waiting for its dependencies or for Resource::Load on a worker
+	Ready,
+	Failed
+};
+
+/**
+ * @brief Untyped identity of a resource slot, used to name load dependencies.
+ */
+struct ResourceKey
+{
+	uint32_t type       = 0;
+	uint32_t index      = 0;
+	uint32_t generation = 0;
+};
+
 /**
  * @brief Template class for resource handles.
+ *
+ * A handle is a slot index and generation in its manager's slot array for T, so
+ * dereferencing it is an array access with no hashing. Unloading a resource bumps
+ * its slot's generation, so older handles to it (or to whatever reuses the slot)
+ * return nullptr. Each valid handle holds a reference to its resource; see
+ * ResourceManager::UnloadUnusedResources. Handles must not outlive their manager.
+ * A handle from LoadResourceAsync is valid before its resource is: Get returns
+ * nullptr until GetState is ResourceState::Ready.
  * @tparam T The type of resource.
  */
 template <typename T>
 class ResourceHandle
 {
   private:
-	std::string            resourceId;
-	class ResourceManager *resourceManager = nullptr;
+	ResourceManager *resourceManager = nullptr;
+	uint32_t         index           = 0;
+	uint32_t         generation      = 0;        // 0 never matches a slot
+
+	friend class ResourceManager;
+
+	/**
+	 * @brief Constructor for the manager; takes a reference on the slot.
+	 */
+	ResourceHandle(ResourceManager *manager, uint32_t slotIndex, uint32_t slotGeneration);
 
   public:
 	/**
@@ -95,33 +140,61 @@ class ResourceHandle
 
 	/**
 	 * @brief Constructor with a resource ID and resource manager.
+	 * Resolves the ID once; the handle is invalid if no such resource is loaded.
 	 * @param id The resource ID.
 	 * @param manager The resource manager.
 	 */
-	ResourceHandle(const std::string &id, class ResourceManager *manager) :
-	    resourceId(id), resourceManager(manager)
-	{}
+	ResourceHandle(const std::string &id, ResourceManager *manager);
+
+	ResourceHandle(const ResourceHandle &other);
+	ResourceHandle(ResourceHandle &&other) noexcept;
+	ResourceHandle &operator=(const ResourceHandle &other);
+	ResourceHandle &operator=(ResourceHandle &&other) noexcept;
+	~ResourceHandle();
+
+	/**
+	 * @brief Drop the reference and make the handle invalid.
+	 */
+	void Reset();
 
 	/**
 	 * @brief Get the resource.
-	 * @return A pointer to the resource, or nullptr if not found.
+	 * @return A pointer to the resource, or nullptr if the handle is empty, stale, or not ready.
 	 */
 	T *Get() const;
 
+	/**
+	 * @brief Get the load state of the resource.
+	 */
+	ResourceState GetState() const;
+
+	/**
+	 * @brief Check if the resource has finished loading successfully.
+	 */
+	bool IsReady() const
+	{
+		return GetState() == ResourceState::Ready;
+	}
+
+	/**
+	 * @brief Get the slot identity, to pass as a dependency of another load.
+	 */
+	ResourceKey GetKey() const;
+
 	/**
 	 * @brief Check if the handle is valid.
 	 * @return True if the handle is valid, false otherwise.
 	 */
-	bool IsValid() const;
+	bool IsValid() const
+	{
+		return Get() != nullptr;
+	}
 
 	/**
 	 * @brief Get the resource ID.
-	 * @return The resource ID.
+	 * @return The resource ID, or an empty string if the handle is invalid.
 	 */
-	const std::string &GetId() const
-	{
-		return resourceId;
-	}
+	const std::string &GetId() const;
 
 	/**
 	 * @brief Convenience operator for accessing the resource.
@@ -154,15 +227,227 @@ class ResourceHandle
 /**
  * @brief Class for managing resources.
  *
+ * Resources of each type live in a slot array indexed by handles. Resource IDs are
+ * interned on load: lookups by ID hash the string once to find its interned number,
+ * and handles never touch strings at all.
+ *
+ * LoadResourceAsync runs Resource::Load on the pool set with SetThreadPool; the
+ * engine gives it dedicated load workers, apart from the per-frame job workers.
+ * Each resource is loaded once no matter how many requests name it, after the
+ * resources it depends on, and independent resources load in parallel. The manager
+ * itself is not thread safe: requests, Update, and completion callbacks all happen
+ * on the main thread.
+ *
+ * glTF models, their meshes and their textures do not go through this manager:
+ * the model loader runs on the scene loader thread, and textures go through the
+ * renderer's own upload jobs (Renderer::LoadTextureAsync), which carry upload
+ * priorities and loading-progress counters this manager does not model. Only
+ * resources written as Resource subclasses use it.
+ *
  * This class implements the resource management system as described in the Engine_Architecture chapter:
  * @see en/Building_a_Simple_Engine/Engine_Architecture/04_resource_management.adoc
  */
 class ResourceManager final
 {
   private:
-	std::unordered_map<std::type_index, std::unordered_map<std::string, std::unique_ptr<Resource>>> resources;
+	struct Slot
+	{
+		std::unique_ptr<Resource>              resource;
+		uint32_t                               generation          = 1;
+		uint32_t                               refCount            = 0;        // live handles, plus dependents
+		uint32_t                               nameId              = 0;
+		ResourceState                          state               = ResourceState::Unloaded;
+		bool                                   loadInFlight        = false;        // Resource::Load is running on a worker
+		bool                                   unloadRequested     = false;        // free the slot when that load completes
+		uint32_t                               pendingDependencies = 0;
+		std::vector<ResourceKey>               dependencies;        // each holds a reference until this slot is freed
+		std::vector<ResourceKey>               dependents;          // loads waiting for this one
+		std::vector<std::function<void(bool)>> callbacks;
+	};
+
+	struct TypeSlots
+	{
+		std::vector<Slot>     slots;
+		std::vector<uint32_t> freeSlots;
+		std::vector<uint32_t> slotByNameId;        // interned ID -> slot, UINT32_MAX if none
+	};
+
+	struct CompletedLoad
+	{
+		ResourceKey key;
+		bool        loaded;
+	};
+
+	std::vector<TypeSlots>                    types;        // indexed by TypeIndex<T>()
+	std::unordered_map<std::string, uint32_t> nameIds;
+	std::vector<std::string>                  names;
+
+	ThreadPool                                              *threadPool    = nullptr;
+	uint32_t                                                 inFlightLoads = 0;
+	std::vector<std::pair<std::function<void(bool)>, bool>> readyCallbacks;        // delivered by the next Update
+
+	// Filled by the workers, drained on the main thread
+	std::mutex                 completedMutex;
+	std::condition_variable    completedCondition;
+	std::vector<CompletedLoad> completedLoads;
+
+	template <typename>
+	friend class ResourceHandle;
+
+	static uint32_t NextTypeIndex();
+
+	/**
+	 * @brief Get the dense number of a resource type, assigned on first use.
+	 */
+	template <typename T>
+	static uint32_t TypeIndex()
+	{
+		static const uint32_t typeIndex = NextTypeIndex();
+		return typeIndex;
+	}
+
+	TypeSlots *FindTypeSlots(uint32_t typeIndex)
+	{
+		return typeIndex < types.size() ? &types[typeIndex] : nullptr;
+	}
+
+	Slot *FindSlot(uint32_t typeIndex, uint32_t index, uint32_t generation)
+	{
+		TypeSlots *typeSlots = FindTypeSlots(typeIndex);
+		if (!typeSlots || index >= typeSlots->slots.size())
+		{
+			return nullptr;
+		}
+		Slot &slot = typeSlots->slots[index];
+		return slot.generation == generation && slot.resource ? &slot : nullptr;
+	}
+
+	Slot *FindSlot(const ResourceKey &key)
+	{
+		return FindSlot(key.type, key.index, key.generation);
+	}
+
+	TypeSlots &GetTypeSlots(uint32_t typeIndex)
+	{
+		if (typeIndex >= types.size())
+		{
+			types.resize(typeIndex + 1);
+		}
+		return types[typeIndex];
+	}
+
+	/**
+	 * @brief Find the slot of a loaded resource by ID, without interning the ID.
+	 * @return The slot index, or UINT32_MAX.
+	 */
+	uint32_t FindSlotByName(uint32_t typeIndex, const std::string &id) const;
+
+	/**
+	 * @brief Intern a resource ID.
+	 * @return Its number, stable for the manager's lifetime.
+	 */
+	uint32_t InternId(const std::string &id);
+
+	/**
+	 * @brief Find the slot a resource ID maps to, interning the ID.
+	 * @return The slot index, or UINT32_MAX.
+	 */
+	uint32_t FindOrInternSlot(TypeSlots &typeSlots, const std::string &id, uint32_t &nameId);
+
+	/**
+	 * @brief Put a new resource in a free slot and map its ID to it.
+	 * @return The slot index.
+	 */
+	uint32_t AllocateSlot(TypeSlots &typeSlots, uint32_t nameId, std::unique_ptr<Resource> resource);
+
+	/**
+	 * @brief Unload the resource in a slot and free the slot for reuse.
+	 * A slot whose load is in flight is only unmapped; it is freed when the load completes.
+	 */
+	void FreeSlot(TypeSlots &typeSlots, uint32_t index);
+
+	/**
+	 * @brief Shared part of LoadResource, once T is known to be constructed by create.
+	 * @return The slot, whose resource is ready.
+	 */
+	ResourceKey LoadNow(uint32_t typeIndex, const std::string &id, const std::function<std::unique_ptr<Resource>()> &create);
+
+	/**
+	 * @brief Shared part of LoadResourceAsync, once T is known to be constructed by create.
+	 * @return The slot, in whatever state the request leaves it.
+	 */
+	ResourceKey RequestLoad(uint32_t typeIndex, const std::string &id, const std::vector<ResourceKey> &dependencies,
+	                        std::function<void(bool)> onLoaded, const std::function<std::unique_ptr<Resource>()> &create);
+
+	/**
+	 * @brief Run Resource::Load for a slot whose dependencies are ready, on the thread pool if there is one.
+	 */
+	void StartLoad(const ResourceKey &key);
+
+	/**
+	 * @brief Record the end of a load and start or fail the loads waiting for it.
+	 */
+	void FinishLoad(const ResourceKey &key, bool loaded);
+
+	/**
+	 * @brief Fail a load that is waiting for its dependencies, and the loads waiting for it.
+	 */
+	void FailLoad(const ResourceKey &key);
+
+	/**
+	 * @brief Apply the loads the workers have completed, without running callbacks.
+	 * @param wait Block until at least one load completes if none has.
+	 */
+	void ProcessCompletedLoads(bool wait);
+
+	/**
+	 * @brief Block until a slot leaves the Loading state.
+	 */
+	void WaitForSlot(const ResourceKey &key);
+
+	void AddReference(uint32_t typeIndex, uint32_t index, uint32_t generation)
+	{
+		if (Slot *slot = FindSlot(typeIndex, index, generation))
+		{
+			slot->refCount++;
+		}
+	}
+
+	void ReleaseReference(uint32_t typeIndex, uint32_t index, uint32_t generation)
+	{
+		if (Slot *slot = FindSlot(typeIndex, index, generation); slot && slot->refCount > 0)
+		{
+			slot->refCount--;
+		}
+	}
 
   public:
+	struct HandleBenchmarkResult
+	{
+		uint32_t resources                 = 0;
+		uint64_t lookups                   = 0;
+		double   handleLookupsPerSecond    = 0.0;        // ResourceHandle::Get
+		double   idLookupsPerSecond        = 0.0;        // GetResource by ID: one string hash, then integer lookups
+		double   nestedMapLookupsPerSecond = 0.0;        // type_index map, then string map: the scheme handles replaced
+	};
+
+	struct LoadStats
+	{
+		uint64_t requests  = 0;        // LoadResource and LoadResourceAsync calls
+		uint64_t coalesced = 0;        // requests served by a resource already loaded or loading
+		uint64_t loaded    = 0;
+		uint64_t failed    = 0;
+	};
+
+	struct AsyncLoadBenchmarkResult
+	{
+		uint32_t models         = 0;
+		uint32_t resources      = 0;        // distinct resources loaded per run
+		uint64_t coalesced      = 0;        // asynchronous requests that joined a load already requested
+		double   synchronousMs  = 0.0;
+		double   asynchronousMs = 0.0;
+	};
+
 	/**
 	 * @brief Default constructor.
 	 */
@@ -170,11 +455,51 @@ class ResourceManager final
 
 	/**
 	 * @brief Virtual destructor for proper cleanup.
+	 * Waits for the loads in flight; their callbacks are not run.
+	 */
+	virtual ~ResourceManager();
+
+	/**
+	 * @brief Set the pool LoadResourceAsync runs loads on.
+	 * Without one, asynchronous loads complete before returning; their callbacks still wait for Update.
+	 * Wait for pending loads before destroying the pool.
+	 * @param pool The thread pool, or nullptr.
 	 */
-	virtual ~ResourceManager() = default;
+	void SetThreadPool(ThreadPool *pool)
+	{
+		threadPool = pool;
+	}
+
+	/**
+	 * @brief Apply completed asynchronous loads and run their callbacks.
+	 * Call once per frame on the main thread.
+	 */
+	void Update();
+
+	/**
+	 * @brief Block until every load in flight has completed, then run the callbacks.
+	 */
+	void WaitForPendingLoads();
+
+	/**
+	 * @brief Get the number of loads started and not yet applied; loads waiting for dependencies are not counted.
+	 */
+	uint32_t GetPendingLoadCount() const
+	{
+		return inFlightLoads;
+	}
+
+	/**
+	 * @brief Get the request and load counts since the manager was created.
+	 */
+	const LoadStats &GetLoadStats() const
+	{
+		return loadStats;
+	}
 
 	/**
 	 * @brief Load a resource.
+	 * If an asynchronous load of it is in flight, waits for that load instead.
 	 * @tparam T The type of resource.
 	 * @tparam Args The types of arguments to pass to the resource constructor.
 	 * @param id The resource ID.
@@ -186,76 +511,107 @@ class ResourceManager final
 	{
 		static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
 
-		// Check if the resource already exists
-		auto &typeResources = resources[std::type_index(typeid(T))];
-		auto  it            = typeResources.find(id);
-		if (it != typeResources.end())
-		{
-			return ResourceHandle<T>(id, this);
-		}
+		const ResourceKey key = LoadNow(TypeIndex<T>(), id, [&]() -> std::unique_ptr<Resource> {
+			return std::make_unique<T>(id, std::forward<Args>(args)...);
+		});
+		return ResourceHandle<T>(this, key.index, key.generation);
+	}
 
-		// Create and load the resource
-		auto resource = std::make_unique<T>(id, std::forward<Args>(args)...);
-		if (!resource->Load())
-		{
-			throw std::runtime_error("Failed to load resource: " + id);
-		}
+	/**
+	 * @brief Load a resource on the job thread pool.
+	 * A request for a resource that is already loaded or loading joins it instead of
+	 * loading it again. The resource is constructed on the calling thread; only
+	 * Resource::Load runs on a worker, once every dependency is ready. If a dependency
+	 * fails, so does this load.
+	 * @tparam T The type of resource.
+	 * @tparam Args The types of arguments to pass to the resource constructor.
+	 * @param id The resource ID.
+	 * @param dependencies Resources to load first; each stays loaded while this one is.
+	 * @param onLoaded Called on the main thread, from Update, with whether the load succeeded.
+	 * @param args The arguments to pass to the resource constructor.
+	 * @return A handle to the resource; Get returns nullptr until it is ready.
+	 */
+	template <typename T, typename... Args>
+	ResourceHandle<T> LoadResourceAsync(const std::string &id, const std::vector<ResourceKey> &dependencies = {},
+	                                    std::function<void(bool)> onLoaded = {}, Args &&...args)
+	{
+		static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
 
-		// Store the resource
-		typeResources[id] = std::move(resource);
-		return ResourceHandle<T>(id, this);
+		const ResourceKey key = RequestLoad(TypeIndex<T>(), id, dependencies, std::move(onLoaded), [&]() -> std::unique_ptr<Resource> {
+			return std::make_unique<T>(id, std::forward<Args>(args)...);
+		});
+		return ResourceHandle<T>(this, key.index, key.generation);
 	}
 
 	/**
-	 * @brief Get a resource.
+	 * @brief Get a handle to a loaded resource.
 	 * @tparam T The type of resource.
 	 * @param id The resource ID.
-	 * @return A pointer to the resource, or nullptr if not found.
+	 * @return A handle to the resource, or an invalid handle if it is not loaded.
 	 */
 	template <typename T>
-	T *GetResource(const std::string &id)
+	ResourceHandle<T> GetHandle(const std::string &id)
 	{
 		static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
 
-		auto typeIt = resources.find(std::type_index(typeid(T)));
-		if (typeIt == resources.end())
+		const uint32_t typeIndex = TypeIndex<T>();
+		const uint32_t index     = FindSlotByName(typeIndex, id);
+		if (index == UINT32_MAX)
 		{
-			return nullptr;
+			return {};
 		}
+		return ResourceHandle<T>(this, index, types[typeIndex].slots[index].generation);
+	}
+
+	/**
+	 * @brief Get a resource.
+	 * Prefer keeping a ResourceHandle, which does not hash the ID on every access.
+	 * @tparam T The type of resource.
+	 * @param id The resource ID.
+	 * @return A pointer to the resource, or nullptr if not found or not ready.
+	 */
+	template <typename T>
+	T *GetResource(const std::string &id)
+	{
+		static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
 
-		auto &typeResources = typeIt->second;
-		auto  resourceIt    = typeResources.find(id);
-		if (resourceIt == typeResources.end())
+		const uint32_t typeIndex = TypeIndex<T>();
+		const uint32_t index     = FindSlotByName(typeIndex, id);
+		if (index == UINT32_MAX)
 		{
 			return nullptr;
 		}
-
-		return static_cast<T *>(resourceIt->second.get());
+		const Slot &slot = types[typeIndex].slots[index];
+		return slot.state == ResourceState::Ready ? static_cast<T *>(slot.resource.get()) : nullptr;
 	}
 
 	/**
-	 * @brief Check if a resource exists.
+	 * @brief Check if a resource is loaded.
 	 * @tparam T The type of resource.
 	 * @param id The resource ID.
-	 * @return True if the resource exists, false otherwise.
+	 * @return True if the resource exists and is ready, false otherwise.
 	 */
 	template <typename T>
 	bool HasResource(const std::string &id)
 	{
-		static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
-
-		auto typeIt = resources.find(std::type_index(typeid(T)));
-		if (typeIt == resources.end())
-		{
-			return false;
-		}
+		return GetResource<T>(id) != nullptr;
+	}
 
-		auto &typeResources = typeIt->second;
-		return typeResources.contains(id);
+	/**
+	 * @brief Get the number of live handles to a resource.
+	 * @tparam T The type of resource.
+	 * @param handle A handle to the resource.
+	 * @return The count, including the handle itself; 0 if the handle is invalid.
+	 */
+	template <typename T>
+	uint32_t GetReferenceCount(const ResourceHandle<T> &handle)
+	{
+		const Slot *slot = FindSlot(TypeIndex<T>(), handle.index, handle.generation);
+		return slot ? slot->refCount : 0;
 	}
 
 	/**
-	 * @brief Unload a resource.
+	 * @brief Unload a resource. Its remaining handles become invalid.
 	 * @tparam T The type of resource.
 	 * @param id The resource ID.
 	 * @return True if the resource was unloaded, false otherwise.
@@ -265,43 +621,176 @@ class ResourceManager final
 	{
 		static_assert(std::is_base_of<Resource, T>::value, "T must derive from Resource");
 
-		auto typeIt = resources.find(std::type_index(typeid(T)));
-		if (typeIt == resources.end())
-		{
-			return false;
-		}
-
-		auto &typeResources = typeIt->second;
-		auto  resourceIt    = typeResources.find(id);
-		if (resourceIt == typeResources.end())
+		const uint32_t typeIndex = TypeIndex<T>();
+		const uint32_t index     = FindSlotByName(typeIndex, id);
+		if (index == UINT32_MAX)
 		{
 			return false;
 		}
-
-		resourceIt->second->Unload();
-		typeResources.erase(resourceIt);
+		FreeSlot(types[typeIndex], index);
 		return true;
 	}
 
 	/**
-	 * @brief Unload all resources.
+	 * @brief Unload the resources that no handle or dependent refers to.
+	 * Resources still loading are kept.
+	 * @return The number of resources unloaded.
+	 */
+	size_t UnloadUnusedResources();
+
+	/**
+	 * @brief Unload all resources, after waiting for pending loads. Existing handles become invalid.
 	 */
 	void UnloadAllResources();
+
+	/**
+	 * @brief Get the number of loaded resources of all types.
+	 */
+	size_t GetResourceCount() const;
+
+	/**
+	 * @brief Measure resource lookups per second through handles, through IDs, and
+	 * through nested type and string maps, over the same resources in the same random order.
+	 * @param resourceCount Number of resources, with path-like IDs.
+	 * @param lookups Lookups per method.
+	 * @return The lookup rates.
+	 */
+	static HandleBenchmarkResult Benchmark(uint32_t resourceCount = 10000, uint32_t lookups = 4000000);
+
+	/**
+	 * @brief Measure loading models that share textures, one resource at a time versus
+	 * with LoadResourceAsync on a thread pool. Loads are simulated: each sleeps for its
+	 * I/O time, then decodes for a comparable time.
+	 * @param pool The pool for the asynchronous run; nullptr measures the synchronous fallback.
+	 * @param models Number of models; each depends on texturesPerModel textures, half of them shared.
+	 * @param texturesPerModel Textures per model.
+	 * @param ioMicroseconds Simulated I/O time per resource.
+	 * @return The wall times of both runs.
+	 */
+	static AsyncLoadBenchmarkResult BenchmarkAsyncLoading(ThreadPool *pool, uint32_t models = 16, uint32_t texturesPerModel = 8,
+	                                                      uint32_t ioMicroseconds = 2000);
+
+	/**
+	 * @brief Unload a resource while its load is in flight and another load waits for it,
+	 * and check that the waiting load fails instead of starting against the freed slot.
+	 * @param pool The pool the loads run on; nullptr skips the check.
+	 * @return Number of failed expectations; 0 when the dependent load was failed.
+	 */
+	static uint32_t CheckUnloadWithQueuedDependent(ThreadPool *pool);
+
+  private:
+	LoadStats loadStats;
 };
 
 // Implementation of ResourceHandle methods
+template <typename T>
+ResourceHandle<T>::ResourceHandle(ResourceManager *manager, uint32_t slotIndex, uint32_t slotGeneration) :
+    resourceManager(manager), index(slotIndex), generation(slotGeneration)
+{
+	resourceManager->AddReference(ResourceManager::TypeIndex<T>(), index, generation);
+}
+
+template <typename T>
+ResourceHandle<T>::ResourceHandle(const std::string &id, ResourceManager *manager)
+{
+	if (manager)
+	{
+		*this = manager->GetHandle<T>(id);
+	}
+}
+
+template <typename T>
+ResourceHandle<T>::ResourceHandle(const ResourceHandle &other) :
+    resourceManager(other.resourceManager), index(other.index), generation(other.generation)
+{
+	if (resourceManager)
+	{
+		resourceManager->AddReference(ResourceManager::TypeIndex<T>(), index, generation);
+	}
+}
+
+template <typename T>
+ResourceHandle<T>::ResourceHandle(ResourceHandle &&other) noexcept :
+    resourceManager(std::exchange(other.resourceManager, nullptr)), index(other.index), generation(std::exchange(other.generation, 0))
+{}
+
+template <typename T>
+ResourceHandle<T> &ResourceHandle<T>::operator=(const ResourceHandle &other)
+{
+	if (this != &other)
+	{
+		if (other.resourceManager)
+		{
+			other.resourceManager->AddReference(ResourceManager::TypeIndex<T>(), other.index, other.generation);
+		}
+		Reset();
+		resourceManager = other.resourceManager;
+		index           = other.index;
+		generation      = other.generation;
+	}
+	return *this;
+}
+
+template <typename T>
+ResourceHandle<T> &ResourceHandle<T>::operator=(ResourceHandle &&other) noexcept
+{
+	if (this != &other)
+	{
+		Reset();
+		resourceManager = std::exchange(other.resourceManager, nullptr);
+		index           = other.index;
+		generation      = std::exchange(other.generation, 0);
+	}
+	return *this;
+}
+
+template <typename T>
+ResourceHandle<T>::~ResourceHandle()
+{
+	Reset();
+}
+
+template <typename T>
+void ResourceHandle<T>::Reset()
+{
+	if (resourceManager)
+	{
+		resourceManager->ReleaseReference(ResourceManager::TypeIndex<T>(), index, generation);
+	}
+	resourceManager = nullptr;
+	generation      = 0;
+}
+
 template <typename T>
 T *ResourceHandle<T>::Get() const
 {
 	if (!resourceManager)
 		return nullptr;
-	return resourceManager->GetResource<T>(resourceId);
+	const ResourceManager::Slot *slot = resourceManager->FindSlot(ResourceManager::TypeIndex<T>(), index, generation);
+	return slot && slot->state == ResourceState::Ready ? static_cast<T *>(slot->resource.get()) : nullptr;
+}
+
+template <typename T>
+ResourceState ResourceHandle<T>::GetState() const
+{
+	if (!resourceManager)
+		return ResourceState::Unloaded;
+	const ResourceManager::Slot *slot = resourceManager->FindSlot(ResourceManager::TypeIndex<T>(), index, generation);
+	return slot ? slot->state : ResourceState::Unloaded;
+}
+
+template <typename T>
+ResourceKey ResourceHandle<T>::GetKey() const
+{
+	return {ResourceManager::TypeIndex<T>(), index, generation};
 }
 
 template <typename T>
-bool ResourceHandle<T>::IsValid() const
+const std::string &ResourceHandle<T>::GetId() const
 {
+	static const std::string empty;
 	if (!resourceManager)
-		return false;
-	return resourceManager->HasResource<T>(resourceId);
+		return empty;
+	const ResourceManager::Slot *slot = resourceManager->FindSlot(ResourceManager::TypeIndex<T>(), index, generation);
+	return slot ? resourceManager->names[slot->nameId] : empty;
 }
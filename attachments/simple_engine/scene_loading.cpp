@@ -30,19 +30,8 @@
  * @return The size of the bounding box (max - min for each axis).
  */
 glm::vec3 CalculateBoundingBoxSize(const MaterialMesh& materialMesh) {
-  if (materialMesh.vertices.empty()) {
-    return glm::vec3(0.0f);
-  }
-
-  glm::vec3 minBounds = materialMesh.vertices[0].position;
-  glm::vec3 maxBounds = materialMesh.vertices[0].position;
-
-  for (const auto& vertex : materialMesh.vertices) {
-    minBounds = glm::min(minBounds, vertex.position);
-    maxBounds = glm::max(maxBounds, vertex.position);
-  }
-
-  return maxBounds - minBounds;
+  // The bounds are computed once, when the loader freezes the geometry
+  return materialMesh.aabbMax - materialMesh.aabbMin;
 }
 
 /**
@@ -218,8 +207,7 @@ bool LoadGLTFModel(Engine* engine,
 
         // Add a mesh component with material-specific data
         auto* mesh = materialEntity->AddComponent<MeshComponent>();
-        mesh->SetVertices(materialMesh.vertices);
-        mesh->SetIndices(materialMesh.indices);
+        mesh->SetGeometry(materialMesh.geometry);
 
         if (materialMesh.GetInstanceCount() > 0) {
           mesh->SetInstances(materialMesh.instances);
@@ -340,6 +328,8 @@ bool LoadGLTFModel(Engine* engine,
             bool nearGround = (minWS.y <= groundY + maxDistanceFromGround);
 
             if (nearGround) {
+              // Mesh colliders test rays against the CPU triangles
+              mc->SetKeepCpuGeometry(true);
               physicsSystem->EnqueueRigidBodyCreation(
                 materialEntity,
                 CollisionShape::Mesh,
@@ -396,8 +386,11 @@ bool LoadGLTFModel(Engine* engine,
       // Create an animation controller entity
       Entity* animController = engine->CreateEntity(modelName + "_AnimController");
       if (animController) {
+        // Animated nodes are parented to the controller so they follow the model placement
         auto* animTransform = animController->AddComponent<TransformComponent>();
         animTransform->SetPosition(position);
+        animTransform->SetRotation(glm::radians(rotation));
+        animTransform->SetScale(scale);
 
         auto* animComponent = animController->AddComponent<AnimationComponent>();
         animComponent->SetAnimations(animations);
@@ -484,8 +477,7 @@ bool LoadGLTFModel(Engine* engine,
 
               // Clone the mesh component from the source MaterialMesh
               auto* mesh = nodeEntity->AddComponent<MeshComponent>();
-              mesh->SetVertices(sourceMaterialMesh->vertices);
-              mesh->SetIndices(sourceMaterialMesh->indices);
+              mesh->SetGeometry(sourceMaterialMesh->geometry);
 
               // Copy all texture paths
               if (!sourceMaterialMesh->baseColorTexturePath.empty())
@@ -529,11 +521,12 @@ bool LoadGLTFModel(Engine* engine,
               glm::vec4 perspective;
               glm::decompose(nodeTransform, nodeScale, nodeRotation, nodePosition, skew, perspective);
 
-              // Apply the node's local transform to the entity
+              // Apply the node's model-space transform to the entity, relative to the controller
               auto* transform = nodeEntity->GetComponent<TransformComponent>();
               if (transform) {
+                transform->SetParent(animTransform);
                 transform->SetPosition(nodePosition);
-                transform->SetRotation(glm::eulerAngles(nodeRotation));
+                transform->SetRotationQuaternion(nodeRotation);
                 transform->SetScale(nodeScale);
                 std::cout << "[Animation] Applied base transform to entity '" << nodeEntity->GetName()
                     << "' - pos(" << nodePosition.x << "," << nodePosition.y << "," << nodePosition.z << ")" << std::endl;
@@ -564,6 +557,15 @@ bool LoadGLTFModel(Engine* engine,
     return false;
   }
 
+  // Every entity references its geometry now. With the release policy on, the loader lets go of
+  // its references, so the CPU copies are freed as the meshes finish uploading.
+  if (renderer->GetReleaseCpuMeshData()) {
+    LOG_INFO("Loading", "CPU mesh geometry resident: " + std::to_string(MeshGeometry::GetResidentBytes() >> 20) + " MB (released after upload)");
+    modelLoader->ReleaseCpuGeometry(modelPath);
+  } else {
+    LOG_INFO("Loading", "CPU mesh geometry resident: " + std::to_string(MeshGeometry::GetResidentBytes() >> 20) + " MB");
+  }
+
   // Request acceleration structure build at next safe frame point
   // Don't build here in background thread to avoid threading issues with command pools
   if (renderer->GetRayQueryEnabled() && renderer->GetAccelerationStructureEnabled()) {
@@ -580,8 +582,9 @@ bool LoadGLTFModel(Engine* engine,
  * @brief Load a GLTF model with default transform values.
  * @param engine The engine to create entities in.
  * @param modelPath The path to the GLTF model file.
+ * @return True if the model was loaded.
  */
-void LoadGLTFModel(Engine* engine, const std::string& modelPath) {
+bool LoadGLTFModel(Engine* engine, const std::string& modelPath) {
   // Use default transform values: slight Y offset, no rotation, unit scale
-  LoadGLTFModel(engine, modelPath, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+  return LoadGLTFModel(engine, modelPath, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f));
 }
\ No newline at end of file
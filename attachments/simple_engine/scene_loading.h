@@ -40,5 +40,6 @@ bool LoadGLTFModel(Engine *engine, const std::string &modelPath,
  * @brief Load a GLTF model with default transform values.
  * @param engine The engine to create entities in.
  * @param modelPath The path to the GLTF model file.
+ * @return True if the model was loaded.
  */
-void LoadGLTFModel(Engine *engine, const std::string &modelPath);
+bool LoadGLTFModel(Engine *engine, const std::string &modelPath);
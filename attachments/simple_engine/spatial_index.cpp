@@ -0,0 +1,396 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "spatial_index.h"
+
+#include "frustum_cull.h"
+
+#include <cassert>
+#include <chrono>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+namespace
+{
+float SurfaceArea(const glm::vec3 &min, const glm::vec3 &max)
+{
+	const glm::vec3 d = max - min;
+	return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+// Margin added around leaves so small movements do not restructure the tree
+glm::vec3 FatMargin(const glm::vec3 &min, const glm::vec3 &max)
+{
+	return 0.1f * (max - min) + glm::vec3(0.05f);
+}
+}        // namespace
+
+int32_t SpatialIndex::AllocateNode()
+{
+	if (freeList == InvalidProxy)
+	{
+		nodes.emplace_back();
+		return static_cast<int32_t>(nodes.size() - 1);
+	}
+	const int32_t node = freeList;
+	freeList           = nodes[node].parent;
+	nodes[node]        = Node{};
+	return node;
+}
+
+void SpatialIndex::FreeNode(int32_t node)
+{
+	nodes[node]        = Node{};
+	nodes[node].parent = freeList;
+	freeList           = node;
+}
+
+int32_t SpatialIndex::Insert(const glm::vec3 &min, const glm::vec3 &max, void *userData)
+{
+	const int32_t leaf   = AllocateNode();
+	Node         &n      = nodes[leaf];
+	const glm::vec3 m    = FatMargin(min, max);
+	n.min                = min;
+	n.max                = max;
+	n.fatMin             = min - m;
+	n.fatMax             = max + m;
+	n.userData           = userData;
+	n.height             = 0;
+	InsertLeaf(leaf);
+	++proxyCount;
+	return leaf;
+}
+
+void SpatialIndex::Remove(int32_t proxy)
+{
+	assert(proxy >= 0 && proxy < static_cast<int32_t>(nodes.size()) && nodes[proxy].IsLeaf());
+	RemoveLeaf(proxy);
+	FreeNode(proxy);
+	--proxyCount;
+}
+
+bool SpatialIndex::Update(int32_t proxy, const glm::vec3 &min, const glm::vec3 &max)
+{
+	Node &n = nodes[proxy];
+	n.min   = min;
+	n.max   = max;
+	if (glm::all(glm::greaterThanEqual(min, n.fatMin)) && glm::all(glm::lessThanEqual(max, n.fatMax)))
+	{
+		return false;
+	}
+
+	RemoveLeaf(proxy);
+	const glm::vec3 m = FatMargin(min, max);
+	nodes[proxy].fatMin = min - m;
+	nodes[proxy].fatMax = max + m;
+	InsertLeaf(proxy);
+	return true;
+}
+
+void SpatialIndex::Clear()
+{
+	nodes.clear();
+	root       = InvalidProxy;
+	freeList   = InvalidProxy;
+	proxyCount = 0;
+}
+
+void SpatialIndex::InsertLeaf(int32_t leaf)
+{
+	if (root == InvalidProxy)
+	{
+		root                = leaf;
+		nodes[leaf].parent  = InvalidProxy;
+		return;
+	}
+
+	// Descend towards the sibling with the lowest surface-area cost
+	const glm::vec3 leafMin = nodes[leaf].fatMin;
+	const glm::vec3 leafMax = nodes[leaf].fatMax;
+	int32_t         index   = root;
+	while (!nodes[index].IsLeaf())
+	{
+		const Node &node = nodes[index];
+		const float area = SurfaceArea(node.fatMin, node.fatMax);
+		const float combinedArea =
+		    SurfaceArea(glm::min(node.fatMin, leafMin), glm::max(node.fatMax, leafMax));
+
+		// Cost of making a new parent for this node and the leaf
+		const float cost = 2.0f * combinedArea;
+		// Minimum cost of pushing the leaf further down the tree
+		const float inheritanceCost = 2.0f * (combinedArea - area);
+
+		const auto childCost = [&](int32_t child) {
+			const Node &c       = nodes[child];
+			const float enlarged = SurfaceArea(glm::min(c.fatMin, leafMin), glm::max(c.fatMax, leafMax));
+			return c.IsLeaf() ? enlarged + inheritanceCost
+			                  : (enlarged - SurfaceArea(c.fatMin, c.fatMax)) + inheritanceCost;
+		};
+		const float cost1 = childCost(node.child1);
+		const float cost2 = childCost(node.child2);
+
+		if (cost < cost1 && cost < cost2)
+		{
+			break;
+		}
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	const int32_t sibling   = index;
+	const int32_t oldParent = nodes[sibling].parent;
+	const int32_t newParent = AllocateNode();
+	Node         &np        = nodes[newParent];
+	np.parent               = oldParent;
+	np.fatMin               = glm::min(leafMin, nodes[sibling].fatMin);
+	np.fatMax               = glm::max(leafMax, nodes[sibling].fatMax);
+	np.height               = nodes[sibling].height + 1;
+	np.child1               = sibling;
+	np.child2               = leaf;
+	nodes[sibling].parent   = newParent;
+	nodes[leaf].parent      = newParent;
+
+	if (oldParent != InvalidProxy)
+	{
+		if (nodes[oldParent].child1 == sibling)
+		{
+			nodes[oldParent].child1 = newParent;
+		}
+		else
+		{
+			nodes[oldParent].child2 = newParent;
+		}
+	}
+	else
+	{
+		root = newParent;
+	}
+
+	RefitAncestors(nodes[leaf].parent);
+}
+
+void SpatialIndex::RemoveLeaf(int32_t leaf)
+{
+	if (leaf == root)
+	{
+		root = InvalidProxy;
+		return;
+	}
+
+	const int32_t parent      = nodes[leaf].parent;
+	const int32_t grandParent = nodes[parent].parent;
+	const int32_t sibling     = nodes[parent].child1 == leaf ? nodes[parent].child2 : nodes[parent].child1;
+
+	if (grandParent != InvalidProxy)
+	{
+		if (nodes[grandParent].child1 == parent)
+		{
+			nodes[grandParent].child1 = sibling;
+		}
+		else
+		{
+			nodes[grandParent].child2 = sibling;
+		}
+		nodes[sibling].parent = grandParent;
+		FreeNode(parent);
+		RefitAncestors(grandParent);
+	}
+	else
+	{
+		root                  = sibling;
+		nodes[sibling].parent = InvalidProxy;
+		FreeNode(parent);
+	}
+}
+
+void SpatialIndex::RefitAncestors(int32_t index)
+{
+	while (index != InvalidProxy)
+	{
+		index = Balance(index);
+
+		Node       &node = nodes[index];
+		const Node &c1   = nodes[node.child1];
+		const Node &c2   = nodes[node.child2];
+		node.height      = 1 + std::max(c1.height, c2.height);
+		node.fatMin      = glm::min(c1.fatMin, c2.fatMin);
+		node.fatMax      = glm::max(c1.fatMax, c2.fatMax);
+
+		index = node.parent;
+	}
+}
+
+// Rotate a node up if its subtrees differ in height by more than one. Returns the new subtree root.
+int32_t SpatialIndex::Balance(int32_t iA)
+{
+	Node &A = nodes[iA];
+	if (A.IsLeaf() || A.height < 2)
+	{
+		return iA;
+	}
+
+	const int32_t iB      = A.child1;
+	const int32_t iC      = A.child2;
+	const int32_t balance = nodes[iC].height - nodes[iB].height;
+
+	// Promote the taller child (iUp) and hand one of its children to A
+	const auto rotate = [&](int32_t iUp, int32_t iOther, bool upIsChild2) {
+		Node         &up = nodes[iUp];
+		const int32_t iF = up.child1;
+		const int32_t iG = up.child2;
+
+		up.child1   = iA;
+		up.parent   = A.parent;
+		A.parent    = iUp;
+
+		if (up.parent != InvalidProxy)
+		{
+			if (nodes[up.parent].child1 == iA)
+			{
+				nodes[up.parent].child1 = iUp;
+			}
+			else
+			{
+				nodes[up.parent].child2 = iUp;
+			}
+		}
+		else
+		{
+			root = iUp;
+		}
+
+		// Keep the taller grandchild under the promoted node
+		const int32_t keep = nodes[iF].height > nodes[iG].height ? iF : iG;
+		const int32_t give = keep == iF ? iG : iF;
+		up.child2          = keep;
+		if (upIsChild2)
+		{
+			A.child2 = give;
+		}
+		else
+		{
+			A.child1 = give;
+		}
+		nodes[give].parent = iA;
+
+		const Node &o = nodes[iOther];
+		const Node &g = nodes[give];
+		A.fatMin      = glm::min(o.fatMin, g.fatMin);
+		A.fatMax      = glm::max(o.fatMax, g.fatMax);
+		A.height      = 1 + std::max(o.height, g.height);
+
+		const Node &k = nodes[keep];
+		up.fatMin     = glm::min(A.fatMin, k.fatMin);
+		up.fatMax     = glm::max(A.fatMax, k.fatMax);
+		up.height     = 1 + std::max(A.height, k.height);
+	};
+
+	if (balance > 1)
+	{
+		rotate(iC, iB, true);
+		return iC;
+	}
+	if (balance < -1)
+	{
+		rotate(iB, iC, false);
+		return iB;
+	}
+	return iA;
+}
+
+SpatialIndex::BenchmarkResult SpatialIndex::Benchmark(uint32_t boxCount, uint32_t views)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto msSince = [](Clock::time_point start) { return std::chrono::duration<double, std::milli>(Clock::now() - start).count(); };
+
+	BenchmarkResult                       result;
+	std::mt19937                          rng(28);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::vector<glm::vec3>                corners(static_cast<size_t>(boxCount) * 2);
+	AABBSoA                               soa;
+	for (uint32_t i = 0; i < boxCount; ++i)
+	{
+		const glm::vec3 center(unit(rng) * 1000.0f - 500.0f, unit(rng) * 1000.0f - 500.0f, unit(rng) * 1000.0f - 500.0f);
+		const glm::vec3 extent(0.25f + unit(rng) * 2.0f);
+		corners[2 * i]     = center - extent;
+		corners[2 * i + 1] = center + extent;
+		soa.Add(corners[2 * i], corners[2 * i + 1]);
+	}
+
+	SpatialIndex index;
+	auto         start = Clock::now();
+	for (uint32_t i = 0; i < boxCount; ++i)
+	{
+		index.Insert(corners[2 * i], corners[2 * i + 1], reinterpret_cast<void *>(static_cast<uintptr_t>(i)));
+	}
+	result.buildMs = msSince(start);
+	result.height  = index.GetHeight();
+
+	const FrustumCullKernel::Isa isa = FrustumCullKernel::DetectBestIsa();
+	std::vector<uint32_t>        treeVisible, flatVisible, kernelVisible;
+	uint64_t                     visibleTotal = 0;
+	for (uint32_t v = 0; v < views; ++v)
+	{
+		// A camera inside the cube looking in a random direction, planes extracted from its view-projection
+		const glm::vec3 eye(unit(rng) * 600.0f - 300.0f, unit(rng) * 600.0f - 300.0f, unit(rng) * 600.0f - 300.0f);
+		const glm::vec3 dir = glm::normalize(glm::vec3(unit(rng) - 0.5f, unit(rng) - 0.5f, unit(rng) - 0.5f) + glm::vec3(1e-3f));
+		const glm::mat4 vp  = glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 400.0f) * glm::lookAt(eye, eye + dir, glm::vec3(0.0f, 1.0f, 0.0f));
+		glm::vec4       planes[6];
+		for (int i = 0; i < 3; ++i)
+		{
+			const glm::vec4 row(vp[0][i], vp[1][i], vp[2][i], vp[3][i]);
+			const glm::vec4 w(vp[0][3], vp[1][3], vp[2][3], vp[3][3]);
+			planes[2 * i]     = w + row;
+			planes[2 * i + 1] = w - row;
+		}
+		for (auto &plane : planes)
+		{
+			plane /= glm::length(glm::vec3(plane));
+		}
+
+		treeVisible.clear();
+		start = Clock::now();
+		index.QueryPlanes(planes, [&treeVisible](void *userData) { treeVisible.push_back(static_cast<uint32_t>(reinterpret_cast<uintptr_t>(userData))); });
+		result.treeMs += msSince(start);
+
+		flatVisible.clear();
+		start = Clock::now();
+		for (uint32_t i = 0; i < boxCount; ++i)
+		{
+			if (FrustumCullKernel::IntersectsBox(corners[2 * i], corners[2 * i + 1], planes))
+			{
+				flatVisible.push_back(i);
+			}
+		}
+		result.flatMs += msSince(start);
+
+		start = Clock::now();
+		FrustumCullKernel::Cull(isa, soa, planes, kernelVisible);
+		result.kernelMs += msSince(start);
+
+		std::sort(treeVisible.begin(), treeVisible.end());
+		result.mismatches += treeVisible == flatVisible ? 0u : 1u;
+		visibleTotal += flatVisible.size();
+	}
+	if (views > 0)
+	{
+		result.treeMs /= views;
+		result.flatMs /= views;
+		result.kernelMs /= views;
+		result.visible = static_cast<uint32_t>(visibleTotal / views);
+	}
+	return result;
+}
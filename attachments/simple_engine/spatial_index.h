@@ -0,0 +1,294 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+/**
+ * @brief Dynamic AABB tree over world-space bounds.
+ *
+ * Each leaf keeps the tight box of its object and a fattened copy that the
+ * tree is built from, so objects that move a little only rewrite their leaf
+ * instead of being reinserted. Inserts pick the sibling with the lowest
+ * surface-area cost and the ancestors are rebalanced with AVL-style rotations.
+ *
+ * Frustum queries carry a bit mask of planes the current node still straddles:
+ * a node outside any plane prunes its subtree, and once the mask is empty the
+ * whole subtree is accepted without further plane tests.
+ */
+class SpatialIndex
+{
+  public:
+	static constexpr int32_t InvalidProxy = -1;
+
+	struct QueryStats
+	{
+		uint32_t nodesVisited     = 0;
+		uint32_t leavesTested     = 0;
+		uint32_t subtreesAccepted = 0;
+	};
+
+	struct BenchmarkResult
+	{
+		double   buildMs    = 0.0;        // inserting every box
+		double   treeMs     = 0.0;        // one QueryPlanes call, averaged over the views
+		double   flatMs     = 0.0;        // IntersectsBox on every box
+		double   kernelMs   = 0.0;        // FrustumCullKernel at the best instruction set
+		uint32_t visible    = 0;          // per view, averaged
+		uint32_t mismatches = 0;          // views whose tree result differs from the flat test
+		int32_t  height     = 0;
+	};
+
+	/**
+	 * @brief Add an object to the index.
+	 * @param min World-space box minimum.
+	 * @param max World-space box maximum.
+	 * @param userData Opaque pointer handed back by queries.
+	 * @return The proxy id used to update or remove the object.
+	 */
+	int32_t Insert(const glm::vec3 &min, const glm::vec3 &max, void *userData);
+
+	/**
+	 * @brief Remove an object from the index.
+	 * @param proxy The proxy returned by Insert.
+	 */
+	void Remove(int32_t proxy);
+
+	/**
+	 * @brief Move an object to new bounds.
+	 * @return True if the tree had to be restructured, false if the new box
+	 *         still fit inside the fattened leaf.
+	 */
+	bool Update(int32_t proxy, const glm::vec3 &min, const glm::vec3 &max);
+
+	void Clear();
+
+	void *GetUserData(int32_t proxy) const
+	{
+		return nodes[proxy].userData;
+	}
+
+	size_t GetProxyCount() const
+	{
+		return proxyCount;
+	}
+
+	int32_t GetHeight() const
+	{
+		return root == InvalidProxy ? 0 : nodes[root].height;
+	}
+
+	/**
+	 * @brief Visit every object whose tight box is not completely outside the planes.
+	 *
+	 * Planes are (n, d) with n.x*x + n.y*y + n.z*z + d >= 0 inside, using the same
+	 * test and tolerance as FrustumCullKernel::IntersectsBox so both agree on borderline boxes.
+	 * At most 32 planes are supported.
+	 * @param planes The bounding planes.
+	 * @param visit Called with the user data of each visible object.
+	 * @param stats Optional traversal counters.
+	 */
+	template <typename Visitor>
+	void QueryPlanes(std::span<const glm::vec4> planes, Visitor &&visit, QueryStats *stats = nullptr) const;
+
+	/**
+	 * @brief Visit every object whose tight box overlaps the given box.
+	 */
+	template <typename Visitor>
+	void QueryAABB(const glm::vec3 &min, const glm::vec3 &max, Visitor &&visit) const;
+
+	/**
+	 * @brief Time frustum queries on random static boxes against flat tests of the same boxes.
+	 * @param boxCount Number of boxes, spread over a 1 km cube.
+	 * @param views Number of random camera views.
+	 */
+	static BenchmarkResult Benchmark(uint32_t boxCount, uint32_t views);
+
+  private:
+	struct Node
+	{
+		glm::vec3 fatMin{0.0f};
+		glm::vec3 fatMax{0.0f};
+		glm::vec3 min{0.0f};        // tight bounds (leaves only)
+		glm::vec3 max{0.0f};
+		void     *userData = nullptr;
+		int32_t   parent   = InvalidProxy;        // next free node while on the free list
+		int32_t   child1   = InvalidProxy;
+		int32_t   child2   = InvalidProxy;
+		int32_t   height   = -1;        // 0 for leaves, -1 for free nodes
+
+		bool IsLeaf() const
+		{
+			return child1 == InvalidProxy;
+		}
+	};
+
+	static constexpr float PlaneEpsilon = 0.01f;
+	// Queries walk the tree with a fixed stack. A depth-first walk holds at most height + 1
+	// entries, and the AVL rotations keep the height below 1.44 log2(leaves), far under this.
+	static constexpr int32_t MaxQueryDepth = 128;
+
+	int32_t AllocateNode();
+	void    FreeNode(int32_t node);
+	void    InsertLeaf(int32_t leaf);
+	void    RemoveLeaf(int32_t leaf);
+	int32_t Balance(int32_t a);
+	void    RefitAncestors(int32_t node);
+
+	// Returns -1 if outside, otherwise the mask of planes still intersected.
+	static int64_t ClassifyBox(const glm::vec3 &min, const glm::vec3 &max, std::span<const glm::vec4> planes, uint32_t mask);
+
+	std::vector<Node> nodes;
+	int32_t           root       = InvalidProxy;
+	int32_t           freeList   = InvalidProxy;
+	size_t            proxyCount = 0;
+};
+
+inline int64_t SpatialIndex::ClassifyBox(const glm::vec3 &min, const glm::vec3 &max, std::span<const glm::vec4> planes, uint32_t mask)
+{
+	uint32_t remaining = mask;
+	for (uint32_t i = 0; i < planes.size(); ++i)
+	{
+		const uint32_t bit = 1u << i;
+		if (!(mask & bit))
+		{
+			continue;
+		}
+		const glm::vec4 &p = planes[i];
+		// Positive vertex (furthest along the normal) and negative vertex (nearest)
+		const glm::vec3 pv{p.x >= 0.0f ? max.x : min.x, p.y >= 0.0f ? max.y : min.y, p.z >= 0.0f ? max.z : min.z};
+		const glm::vec3 nv{p.x >= 0.0f ? min.x : max.x, p.y >= 0.0f ? min.y : max.y, p.z >= 0.0f ? min.z : max.z};
+		if (p.x * pv.x + p.y * pv.y + p.z * pv.z + p.w < -PlaneEpsilon)
+		{
+			return -1;
+		}
+		if (p.x * nv.x + p.y * nv.y + p.z * nv.z + p.w >= 0.0f)
+		{
+			remaining &= ~bit;
+		}
+	}
+	return remaining;
+}
+
+template <typename Visitor>
+void SpatialIndex::QueryPlanes(std::span<const glm::vec4> planes, Visitor &&visit, QueryStats *stats) const
+{
+	if (root == InvalidProxy)
+	{
+		return;
+	}
+	const uint32_t fullMask = planes.size() >= 32 ? ~0u : ((1u << planes.size()) - 1u);
+	planes                  = planes.first(std::min<size_t>(planes.size(), 32));
+
+	struct Entry
+	{
+		int32_t  node;
+		uint32_t mask;
+	};
+	assert(nodes[root].height < MaxQueryDepth);
+	Entry   stack[MaxQueryDepth];
+	int32_t top  = 0;
+	stack[top++] = {root, fullMask};
+	while (top > 0)
+	{
+		const Entry entry = stack[--top];
+		const Node &node  = nodes[entry.node];
+		if (stats)
+		{
+			stats->nodesVisited++;
+		}
+
+		if (entry.mask == 0)
+		{
+			// Fully inside: every descendant is visible, no plane tests needed.
+			if (node.IsLeaf())
+			{
+				visit(node.userData);
+			}
+			else
+			{
+				stack[top++] = {node.child1, 0u};
+				stack[top++] = {node.child2, 0u};
+			}
+			continue;
+		}
+
+		if (node.IsLeaf())
+		{
+			if (stats)
+			{
+				stats->leavesTested++;
+			}
+			if (ClassifyBox(node.min, node.max, planes, entry.mask) >= 0)
+			{
+				visit(node.userData);
+			}
+			continue;
+		}
+
+		const int64_t mask = ClassifyBox(node.fatMin, node.fatMax, planes, entry.mask);
+		if (mask < 0)
+		{
+			continue;
+		}
+		if (mask == 0 && stats)
+		{
+			stats->subtreesAccepted++;
+		}
+		stack[top++] = {node.child1, static_cast<uint32_t>(mask)};
+		stack[top++] = {node.child2, static_cast<uint32_t>(mask)};
+	}
+}
+
+template <typename Visitor>
+void SpatialIndex::QueryAABB(const glm::vec3 &min, const glm::vec3 &max, Visitor &&visit) const
+{
+	if (root == InvalidProxy)
+	{
+		return;
+	}
+	assert(nodes[root].height < MaxQueryDepth);
+	int32_t stack[MaxQueryDepth];
+	int32_t top  = 0;
+	stack[top++] = root;
+	while (top > 0)
+	{
+		const Node &node = nodes[stack[--top]];
+		const glm::vec3 &nmin = node.IsLeaf() ? node.min : node.fatMin;
+		const glm::vec3 &nmax = node.IsLeaf() ? node.max : node.fatMax;
+		if (glm::any(glm::lessThan(nmax, min)) || glm::any(glm::greaterThan(nmin, max)))
+		{
+			continue;
+		}
+		if (node.IsLeaf())
+		{
+			visit(node.userData);
+		}
+		else
+		{
+			stack[top++] = node.child1;
+			stack[top++] = node.child2;
+		}
+	}
+}
@@ -15,6 +15,7 @@
  * limitations under the License.
  */
 #include "transform_component.h"
+#include "transform_system.h"
 
 // Most of the TransformComponent class implementation is in the header file
 // This file is mainly for any methods that might need additional implementation
@@ -22,10 +23,84 @@
 // This implementation corresponds to the Camera_Transformations chapter in the tutorial:
 // @see en/Building_a_Simple_Engine/Camera_Transformations/04_transformation_matrices.adoc#model-matrix
 
+TransformComponent::~TransformComponent()
+{
+	if (system)
+	{
+		system->DestroyNode(node);
+	}
+}
+
+// Backs the transform with a node of the shared hierarchy so world matrices are batched per frame
+void TransformComponent::Initialize()
+{
+	if (system)
+	{
+		return;
+	}
+	system = &TransformSystem::GetInstance();
+	node   = system->CreateNode(this);
+	system->SetLocal(node, position, orientation, scale);
+}
+
+bool TransformComponent::SetParent(TransformComponent *parent)
+{
+	if (!system || (parent && parent->system != system))
+	{
+		return false;
+	}
+	if (!system->SetParent(node, parent ? parent->node : TransformSystem::InvalidNode))
+	{
+		return false;
+	}
+	matrixDirty = true;
+	++version;
+	return true;
+}
+
+TransformComponent *TransformComponent::GetParent() const
+{
+	if (!system)
+	{
+		return nullptr;
+	}
+	const uint32_t parentNode = system->GetParent(node);
+	return parentNode == TransformSystem::InvalidNode ? nullptr : system->GetOwner(parentNode);
+}
+
+void TransformComponent::UpdateOrientation()
+{
+	// Compose rotation with quaternions for stability and to avoid rad/deg ambiguity
+	glm::quat qx = glm::angleAxis(rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+	glm::quat qy = glm::angleAxis(rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+	glm::quat qz = glm::angleAxis(rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+	orientation  = qz * qy * qx;        // ZYX order is conventional for Euler composition
+}
+
+void TransformComponent::MarkChanged()
+{
+	matrixDirty = true;
+	++version;
+	if (system)
+	{
+		system->SetLocal(node, position, orientation, scale);
+	}
+}
+
 // Returns the model matrix, updating it if necessary
 // @see en/Building_a_Simple_Engine/Camera_Transformations/04_transformation_matrices.adoc#model-matrix
 const glm::mat4 &TransformComponent::GetModelMatrix()
 {
+	if (system)
+	{
+		// Between a change anywhere in the hierarchy and the next batched update, walk the ancestors
+		if (matrixDirty || system->HasPendingChanges())
+		{
+			modelMatrix = system->ComputeWorldMatrix(node);
+			matrixDirty = false;
+		}
+		return modelMatrix;
+	}
 	if (matrixDirty)
 	{
 		UpdateModelMatrix();
@@ -37,14 +112,9 @@ const glm::mat4 &TransformComponent::GetModelMatrix()
 // @see en/Building_a_Simple_Engine/Camera_Transformations/04_transformation_matrices.adoc#model-matrix
 void TransformComponent::UpdateModelMatrix()
 {
-	// Compose rotation with quaternions for stability and to avoid rad/deg ambiguity
-	glm::mat4 T  = glm::translate(glm::mat4(1.0f), position);
-	glm::quat qx = glm::angleAxis(rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
-	glm::quat qy = glm::angleAxis(rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
-	glm::quat qz = glm::angleAxis(rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
-	glm::quat q  = qz * qy * qx;        // ZYX order is conventional for Euler composition
-	glm::mat4 R  = glm::mat4_cast(q);
-	glm::mat4 S  = glm::scale(glm::mat4(1.0f), scale);
-	modelMatrix  = T * R * S;
-	matrixDirty  = false;
+	glm::mat4 T = glm::translate(glm::mat4(1.0f), position);
+	glm::mat4 R = glm::mat4_cast(orientation);
+	glm::mat4 S = glm::scale(glm::mat4(1.0f), scale);
+	modelMatrix = T * R * S;
+	matrixDirty = false;
 }
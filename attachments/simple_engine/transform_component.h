@@ -22,21 +22,37 @@
 
 #include "component.h"
 
+class TransformSystem;
+
 /**
  * @brief Component that handles the position, rotation, and scale of an entity.
  *
  * This class implements the transform system as described in the Camera_Transformations chapter:
  * @see en/Building_a_Simple_Engine/Camera_Transformations/04_transformation_matrices.adoc#model-matrix
+ *
+ * Once added to an entity the component is backed by a TransformSystem node:
+ * position, rotation and scale are relative to the parent transform (if any),
+ * and the model matrix is the world matrix produced by the system's batched
+ * update. A component that was never initialized keeps a standalone matrix.
  */
 class TransformComponent final : public Component
 {
   private:
-	glm::vec3 position = {0.0f, 0.0f, 0.0f};
-	glm::vec3 rotation = {0.0f, 0.0f, 0.0f};        // Euler angles in radians
-	glm::vec3 scale    = {1.0f, 1.0f, 1.0f};
+	glm::vec3         position    = {0.0f, 0.0f, 0.0f};
+	mutable glm::vec3 rotation    = {0.0f, 0.0f, 0.0f};            // Euler angles in radians
+	glm::vec3         scale       = {1.0f, 1.0f, 1.0f};
+	glm::quat         orientation = {1.0f, 0.0f, 0.0f, 0.0f};        // same rotation as a quaternion
+	mutable bool      eulerDirty  = false;                         // rotation is re-derived from orientation on demand
+
+	glm::mat4 modelMatrix  = glm::mat4(1.0f);
+	bool      matrixDirty  = true;
+	uint32_t  version      = 0;        // bumped on every local change
+	uint32_t  worldVersion = 0;        // bumped whenever the transform system writes a new world matrix
 
-	glm::mat4 modelMatrix = glm::mat4(1.0f);
-	bool      matrixDirty = true;
+	TransformSystem *system = nullptr;
+	uint32_t         node   = UINT32_MAX;
+
+	friend class TransformSystem;
 
   public:
 	/**
@@ -47,14 +63,37 @@ class TransformComponent final : public Component
 	    Component(componentName)
 	{}
 
+	/**
+	 * @brief Destructor; detaches any children, which keep their local transforms.
+	 */
+	~TransformComponent() override;
+
+	/**
+	 * @brief Register the transform with the shared TransformSystem.
+	 */
+	void Initialize() override;
+
+	/**
+	 * @brief Parent this transform to another one.
+	 * @param parent The new parent, or nullptr to make this a root.
+	 * @return False if either transform is not registered or the change would create a cycle.
+	 */
+	bool SetParent(TransformComponent *parent);
+
+	/**
+	 * @brief Get the parent transform.
+	 * @return The parent, or nullptr for roots.
+	 */
+	TransformComponent *GetParent() const;
+
 	/**
 	 * @brief Set the position of the entity.
 	 * @param newPosition The new position.
 	 */
 	void SetPosition(const glm::vec3 &newPosition)
 	{
-		position    = newPosition;
-		matrixDirty = true;
+		position = newPosition;
+		MarkChanged();
 	}
 
 	/**
@@ -72,8 +111,10 @@ class TransformComponent final : public Component
 	 */
 	void SetRotation(const glm::vec3 &newRotation)
 	{
-		rotation    = newRotation;
-		matrixDirty = true;
+		rotation   = newRotation;
+		eulerDirty = false;
+		UpdateOrientation();
+		MarkChanged();
 	}
 
 	/**
@@ -82,17 +123,43 @@ class TransformComponent final : public Component
 	 */
 	const glm::vec3 &GetRotation() const
 	{
+		if (eulerDirty)
+		{
+			rotation   = glm::eulerAngles(orientation);
+			eulerDirty = false;
+		}
 		return rotation;
 	}
 
+	/**
+	 * @brief Set the rotation of the entity from a quaternion.
+	 * Avoids the Euler round trip for callers that already work with quaternions (e.g. animation).
+	 * @param newOrientation The new unit rotation.
+	 */
+	void SetRotationQuaternion(const glm::quat &newOrientation)
+	{
+		orientation = newOrientation;
+		eulerDirty  = true;
+		MarkChanged();
+	}
+
+	/**
+	 * @brief Get the rotation of the entity as a quaternion.
+	 * @return The rotation.
+	 */
+	const glm::quat &GetRotationQuaternion() const
+	{
+		return orientation;
+	}
+
 	/**
 	 * @brief Set the scale of the entity.
 	 * @param newScale The new scale.
 	 */
 	void SetScale(const glm::vec3 &newScale)
 	{
-		scale       = newScale;
-		matrixDirty = true;
+		scale = newScale;
+		MarkChanged();
 	}
 
 	/**
@@ -110,8 +177,8 @@ class TransformComponent final : public Component
 	 */
 	void SetUniformScale(float uniformScale)
 	{
-		scale       = glm::vec3(uniformScale);
-		matrixDirty = true;
+		scale = glm::vec3(uniformScale);
+		MarkChanged();
 	}
 
 	/**
@@ -121,7 +188,7 @@ class TransformComponent final : public Component
 	void Translate(const glm::vec3 &translation)
 	{
 		position += translation;
-		matrixDirty = true;
+		MarkChanged();
 	}
 
 	/**
@@ -130,8 +197,9 @@ class TransformComponent final : public Component
 	 */
 	void Rotate(const glm::vec3 &eulerAngles)
 	{
-		rotation += eulerAngles;
-		matrixDirty = true;
+		rotation = GetRotation() + eulerAngles;
+		UpdateOrientation();
+		MarkChanged();
 	}
 
 	/**
@@ -141,16 +209,46 @@ class TransformComponent final : public Component
 	void Scale(const glm::vec3 &scaleFactors)
 	{
 		scale *= scaleFactors;
-		matrixDirty = true;
+		MarkChanged();
 	}
 
 	/**
-	 * @brief Get the model matrix for this transform.
+	 * @brief Get a counter that changes whenever the local or world transform changes.
+	 * @return The change counter.
+	 */
+	uint32_t GetVersion() const
+	{
+		return version + worldVersion;
+	}
+
+	/**
+	 * @brief Get the world (model) matrix for this transform.
 	 * @return The model matrix.
 	 */
 	const glm::mat4 &GetModelMatrix();
 
   private:
+	/**
+	 * @brief Recompute the cached quaternion from the Euler angles (ZYX order).
+	 */
+	void UpdateOrientation();
+
+	/**
+	 * @brief Flag the local transform as changed and forward it to the transform system.
+	 */
+	void MarkChanged();
+
+	/**
+	 * @brief Receive a freshly computed world matrix from the transform system.
+	 * @param world The world matrix.
+	 */
+	void OnWorldMatrixUpdated(const glm::mat4 &world)
+	{
+		modelMatrix = world;
+		matrixDirty = false;
+		++worldVersion;
+	}
+
 	/**
 	 * @brief Update the model matrix based on position, rotation, and scale.
 	 */
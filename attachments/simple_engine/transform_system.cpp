@@ -0,0 +1,566 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "transform_system.h"
+
+#include "profiler.h"
+#include "thread_pool.h"
+#include "transform_component.h"
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <random>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define TRANSFORM_SSE2 1
+#	include <xmmintrin.h>
+#endif
+
+namespace
+{
+// Levels smaller than this are not worth handing to the pool
+constexpr uint32_t ParallelLevelThreshold = 4096;
+
+double MsSince(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+#if defined(TRANSFORM_SSE2)
+// out = a * b for column-major 4x4 matrices; out must not alias a.
+inline void MultiplyMat4(const float *a, const float *b, float *out)
+{
+	const __m128 a0 = _mm_loadu_ps(a + 0);
+	const __m128 a1 = _mm_loadu_ps(a + 4);
+	const __m128 a2 = _mm_loadu_ps(a + 8);
+	const __m128 a3 = _mm_loadu_ps(a + 12);
+	for (int c = 0; c < 4; ++c)
+	{
+		const float *col = b + c * 4;
+		__m128       r   = _mm_mul_ps(a0, _mm_set1_ps(col[0]));
+		r                = _mm_add_ps(r, _mm_mul_ps(a1, _mm_set1_ps(col[1])));
+		r                = _mm_add_ps(r, _mm_mul_ps(a2, _mm_set1_ps(col[2])));
+		r                = _mm_add_ps(r, _mm_mul_ps(a3, _mm_set1_ps(col[3])));
+		_mm_storeu_ps(out + c * 4, r);
+	}
+}
+
+// Store column `col` of four matrices given its rows as lane vectors.
+inline void StoreColumn(float (*out)[16], int col, __m128 r0, __m128 r1, __m128 r2, __m128 r3)
+{
+	_MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+	_mm_storeu_ps(out[0] + col * 4, r0);
+	_mm_storeu_ps(out[1] + col * 4, r1);
+	_mm_storeu_ps(out[2] + col * 4, r2);
+	_mm_storeu_ps(out[3] + col * 4, r3);
+}
+#endif
+}        // namespace
+
+TransformSystem &TransformSystem::GetInstance()
+{
+	static TransformSystem instance;
+	return instance;
+}
+
+uint32_t TransformSystem::CreateNode(TransformComponent *owner)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	uint32_t handle;
+	if (!freeHandles.empty())
+	{
+		handle = freeHandles.back();
+		freeHandles.pop_back();
+	}
+	else
+	{
+		handle = static_cast<uint32_t>(slotOf.size());
+		slotOf.push_back(InvalidNode);
+		parentOf.push_back(InvalidNode);
+		ownerOf.push_back(nullptr);
+		childCount.push_back(0);
+	}
+
+	// New nodes go to the end; the depth ordering is restored on the next update
+	const auto slot  = static_cast<uint32_t>(handleAt.size());
+	slotOf[handle]   = slot;
+	parentOf[handle] = InvalidNode;
+	ownerOf[handle]  = owner;
+	handleAt.push_back(handle);
+	parentSlot.push_back(InvalidNode);
+	tx.push_back(0.0f);
+	ty.push_back(0.0f);
+	tz.push_back(0.0f);
+	qx.push_back(0.0f);
+	qy.push_back(0.0f);
+	qz.push_back(0.0f);
+	qw.push_back(1.0f);
+	sx.push_back(1.0f);
+	sy.push_back(1.0f);
+	sz.push_back(1.0f);
+	localDirty.push_back(1);
+	worldChanged.push_back(0);
+	world.emplace_back(1.0f);
+
+	orderDirty = true;
+	pendingChanges.store(true, std::memory_order_release);
+	return handle;
+}
+
+void TransformSystem::DestroyNode(uint32_t node)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (node >= slotOf.size() || slotOf[node] == InvalidNode)
+	{
+		return;
+	}
+
+	// Orphan the children; they keep their local transform and become roots
+	for (uint32_t h = 0; childCount[node] > 0 && h < parentOf.size(); ++h)
+	{
+		if (parentOf[h] == node && slotOf[h] != InvalidNode)
+		{
+			parentOf[h]           = InvalidNode;
+			localDirty[slotOf[h]] = 1;
+			--childCount[node];
+		}
+	}
+	if (parentOf[node] != InvalidNode)
+	{
+		--childCount[parentOf[node]];
+	}
+
+	handleAt[slotOf[node]] = InvalidNode;
+	slotOf[node]           = InvalidNode;
+	parentOf[node]         = InvalidNode;
+	ownerOf[node]          = nullptr;
+	freeHandles.push_back(node);
+
+	orderDirty = true;
+	pendingChanges.store(true, std::memory_order_release);
+}
+
+bool TransformSystem::SetParent(uint32_t node, uint32_t parent)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (node >= slotOf.size() || slotOf[node] == InvalidNode)
+	{
+		return false;
+	}
+	if (parent != InvalidNode)
+	{
+		if (parent >= slotOf.size() || slotOf[parent] == InvalidNode)
+		{
+			return false;
+		}
+		for (uint32_t p = parent; p != InvalidNode; p = parentOf[p])
+		{
+			if (p == node)
+			{
+				return false;        // would create a cycle
+			}
+		}
+	}
+	if (parentOf[node] == parent)
+	{
+		return true;
+	}
+
+	if (parentOf[node] != InvalidNode)
+	{
+		--childCount[parentOf[node]];
+	}
+	if (parent != InvalidNode)
+	{
+		++childCount[parent];
+	}
+	parentOf[node]           = parent;
+	localDirty[slotOf[node]] = 1;
+	orderDirty               = true;
+	pendingChanges.store(true, std::memory_order_release);
+	return true;
+}
+
+uint32_t TransformSystem::GetParent(uint32_t node) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return node < parentOf.size() ? parentOf[node] : InvalidNode;
+}
+
+TransformComponent *TransformSystem::GetOwner(uint32_t node) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return node < ownerOf.size() ? ownerOf[node] : nullptr;
+}
+
+void TransformSystem::SetLocal(uint32_t node, const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (node >= slotOf.size() || slotOf[node] == InvalidNode)
+	{
+		return;
+	}
+	const uint32_t s = slotOf[node];
+	tx[s]            = translation.x;
+	ty[s]            = translation.y;
+	tz[s]            = translation.z;
+	qx[s]            = rotation.x;
+	qy[s]            = rotation.y;
+	qz[s]            = rotation.z;
+	qw[s]            = rotation.w;
+	sx[s]            = scale.x;
+	sy[s]            = scale.y;
+	sz[s]            = scale.z;
+	localDirty[s]    = 1;
+	pendingChanges.store(true, std::memory_order_release);
+}
+
+glm::mat4 TransformSystem::ComputeWorldMatrix(uint32_t node) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return ComputeWorldLocked(node);
+}
+
+glm::mat4 TransformSystem::GetWorldMatrix(uint32_t node) const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (node >= slotOf.size() || slotOf[node] == InvalidNode)
+	{
+		return glm::mat4(1.0f);
+	}
+	return world[slotOf[node]];
+}
+
+TransformSystem::Stats TransformSystem::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+glm::mat4 TransformSystem::LocalMatrix(uint32_t slot) const
+{
+	// T * R * S, matching TransformComponent's standalone path
+	glm::mat4 m = glm::mat4_cast(glm::quat(qw[slot], qx[slot], qy[slot], qz[slot]));
+	m[0] *= sx[slot];
+	m[1] *= sy[slot];
+	m[2] *= sz[slot];
+	m[3] = glm::vec4(tx[slot], ty[slot], tz[slot], 1.0f);
+	return m;
+}
+
+glm::mat4 TransformSystem::ComputeWorldLocked(uint32_t node) const
+{
+	glm::mat4 result(1.0f);
+	for (uint32_t h = node; h < slotOf.size() && slotOf[h] != InvalidNode; h = parentOf[h])
+	{
+		result = LocalMatrix(slotOf[h]) * result;
+	}
+	return result;
+}
+
+void TransformSystem::RebuildOrder()
+{
+	const auto handleCount = static_cast<uint32_t>(slotOf.size());
+
+	// Depth of every live node; ancestors are resolved on demand and memoized
+	std::vector<uint32_t> depthOf(handleCount, InvalidNode);
+	std::vector<uint32_t> chain;
+	uint32_t              maxDepth = 0;
+	for (uint32_t h = 0; h < handleCount; ++h)
+	{
+		if (slotOf[h] == InvalidNode || depthOf[h] != InvalidNode)
+		{
+			continue;
+		}
+		chain.clear();
+		uint32_t cur = h;
+		while (cur != InvalidNode && depthOf[cur] == InvalidNode)
+		{
+			chain.push_back(cur);
+			cur = parentOf[cur];
+		}
+		uint32_t depth = cur == InvalidNode ? 0u : depthOf[cur] + 1u;
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it)
+		{
+			depthOf[*it] = depth++;
+		}
+		maxDepth = std::max(maxDepth, depth - 1u);
+	}
+
+	// Counting sort by depth, stable with respect to the current slot order
+	levelOffsets.assign(maxDepth + 2u, 0u);
+	uint32_t liveCount = 0;
+	for (uint32_t h : handleAt)
+	{
+		if (h != InvalidNode)
+		{
+			++levelOffsets[depthOf[h] + 1u];
+			++liveCount;
+		}
+	}
+	for (size_t d = 1; d < levelOffsets.size(); ++d)
+	{
+		levelOffsets[d] += levelOffsets[d - 1];
+	}
+
+	std::vector<uint32_t> oldSlotAt(liveCount);
+	std::vector<uint32_t> cursor(levelOffsets.begin(), levelOffsets.end() - 1);
+	for (uint32_t oldSlot = 0; oldSlot < handleAt.size(); ++oldSlot)
+	{
+		const uint32_t h = handleAt[oldSlot];
+		if (h != InvalidNode)
+		{
+			oldSlotAt[cursor[depthOf[h]]++] = oldSlot;
+		}
+	}
+
+	auto gather = [&](auto &array) {
+		std::remove_reference_t<decltype(array)> sorted(liveCount);
+		for (uint32_t s = 0; s < liveCount; ++s)
+		{
+			sorted[s] = array[oldSlotAt[s]];
+		}
+		array.swap(sorted);
+	};
+	gather(handleAt);
+	gather(tx);
+	gather(ty);
+	gather(tz);
+	gather(qx);
+	gather(qy);
+	gather(qz);
+	gather(qw);
+	gather(sx);
+	gather(sy);
+	gather(sz);
+	gather(localDirty);
+	gather(world);
+
+	for (uint32_t s = 0; s < liveCount; ++s)
+	{
+		slotOf[handleAt[s]] = s;
+	}
+	parentSlot.resize(liveCount);
+	for (uint32_t s = 0; s < liveCount; ++s)
+	{
+		const uint32_t p = parentOf[handleAt[s]];
+		parentSlot[s]    = p == InvalidNode ? InvalidNode : slotOf[p];
+	}
+	worldChanged.assign(liveCount, 0);
+	orderDirty = false;
+}
+
+uint32_t TransformSystem::UpdateRange(uint32_t begin, uint32_t end)
+{
+	uint32_t updated = 0;
+	auto     isDirty = [&](uint32_t s) {
+		return localDirty[s] != 0 || (parentSlot[s] != InvalidNode && worldChanged[parentSlot[s]] != 0);
+	};
+	auto finish = [&](uint32_t s) {
+		localDirty[s]   = 0;
+		worldChanged[s] = 1;
+		if (TransformComponent *owner = ownerOf[handleAt[s]])
+		{
+			owner->OnWorldMatrixUpdated(world[s]);
+		}
+		++updated;
+	};
+
+	uint32_t s = begin;
+#if defined(TRANSFORM_SSE2)
+	alignas(16) float local[4][16];
+	for (; s + 4 <= end; s += 4)
+	{
+		unsigned mask = 0;
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			mask |= isDirty(s + k) ? (1u << k) : 0u;
+		}
+		if (mask == 0)
+		{
+			continue;
+		}
+
+		// Compose T * R * S for four nodes at once from the SoA inputs
+		const __m128 x  = _mm_loadu_ps(&qx[s]);
+		const __m128 y  = _mm_loadu_ps(&qy[s]);
+		const __m128 z  = _mm_loadu_ps(&qz[s]);
+		const __m128 w  = _mm_loadu_ps(&qw[s]);
+		const __m128 x2 = _mm_add_ps(x, x);
+		const __m128 y2 = _mm_add_ps(y, y);
+		const __m128 z2 = _mm_add_ps(z, z);
+		const __m128 xx = _mm_mul_ps(x, x2);
+		const __m128 yy = _mm_mul_ps(y, y2);
+		const __m128 zz = _mm_mul_ps(z, z2);
+		const __m128 xy = _mm_mul_ps(x, y2);
+		const __m128 xz = _mm_mul_ps(x, z2);
+		const __m128 yz = _mm_mul_ps(y, z2);
+		const __m128 wx = _mm_mul_ps(w, x2);
+		const __m128 wy = _mm_mul_ps(w, y2);
+		const __m128 wz = _mm_mul_ps(w, z2);
+
+		const __m128 one  = _mm_set1_ps(1.0f);
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 scx  = _mm_loadu_ps(&sx[s]);
+		const __m128 scy  = _mm_loadu_ps(&sy[s]);
+		const __m128 scz  = _mm_loadu_ps(&sz[s]);
+
+		StoreColumn(local, 0,
+		            _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(yy, zz)), scx),
+		            _mm_mul_ps(_mm_add_ps(xy, wz), scx),
+		            _mm_mul_ps(_mm_sub_ps(xz, wy), scx),
+		            zero);
+		StoreColumn(local, 1,
+		            _mm_mul_ps(_mm_sub_ps(xy, wz), scy),
+		            _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, zz)), scy),
+		            _mm_mul_ps(_mm_add_ps(yz, wx), scy),
+		            zero);
+		StoreColumn(local, 2,
+		            _mm_mul_ps(_mm_add_ps(xz, wy), scz),
+		            _mm_mul_ps(_mm_sub_ps(yz, wx), scz),
+		            _mm_mul_ps(_mm_sub_ps(one, _mm_add_ps(xx, yy)), scz),
+		            zero);
+		StoreColumn(local, 3, _mm_loadu_ps(&tx[s]), _mm_loadu_ps(&ty[s]), _mm_loadu_ps(&tz[s]), one);
+
+		for (uint32_t k = 0; k < 4; ++k)
+		{
+			if ((mask & (1u << k)) == 0)
+			{
+				continue;
+			}
+			float         *out = &world[s + k][0][0];
+			const uint32_t p   = parentSlot[s + k];
+			if (p == InvalidNode)
+			{
+				std::copy_n(local[k], 16, out);
+			}
+			else
+			{
+				MultiplyMat4(&world[p][0][0], local[k], out);
+			}
+			finish(s + k);
+		}
+	}
+#endif
+	for (; s < end; ++s)
+	{
+		if (!isDirty(s))
+		{
+			continue;
+		}
+		const uint32_t p = parentSlot[s];
+		world[s]         = p == InvalidNode ? LocalMatrix(s) : world[p] * LocalMatrix(s);
+		finish(s);
+	}
+	return updated;
+}
+
+void TransformSystem::Update(ThreadPool *pool, uint32_t taskCount)
+{
+	PROFILE_SCOPE("TransformSystem::Update");
+	std::lock_guard<std::mutex> lock(mutex);
+	const auto                  start = std::chrono::steady_clock::now();
+
+	stats.reorderMs = 0.0;
+	if (orderDirty)
+	{
+		RebuildOrder();
+		stats.reorderMs = MsSince(start);
+	}
+	stats.nodes        = static_cast<uint32_t>(handleAt.size());
+	stats.levels       = levelOffsets.empty() ? 0u : static_cast<uint32_t>(levelOffsets.size() - 1);
+	stats.updatedNodes = 0;
+	if (!pendingChanges.load(std::memory_order_acquire))
+	{
+		stats.updateMs = MsSince(start);
+		return;
+	}
+
+	std::fill(worldChanged.begin(), worldChanged.end(), uint8_t{0});
+	std::vector<std::future<uint32_t>> futures;
+	for (size_t level = 0; level + 1 < levelOffsets.size(); ++level)
+	{
+		const uint32_t begin = levelOffsets[level];
+		const uint32_t end   = levelOffsets[level + 1];
+		const uint32_t count = end - begin;
+		if (!pool || taskCount <= 1 || count < ParallelLevelThreshold)
+		{
+			stats.updatedNodes += UpdateRange(begin, end);
+			continue;
+		}
+
+		// Chunks are multiples of four so every task keeps full SIMD blocks
+		const uint32_t chunk = ((count + taskCount - 1) / taskCount + 3u) & ~3u;
+		futures.clear();
+		for (uint32_t b = begin; b < end; b += chunk)
+		{
+			futures.push_back(pool->enqueue([this, b, e = std::min(end, b + chunk)]() { return UpdateRange(b, e); }));
+		}
+		// Wait for every chunk before looking at errors so no task outlives this level
+		for (auto &f : futures)
+		{
+			f.wait();
+		}
+		for (auto &f : futures)
+		{
+			stats.updatedNodes += f.get();
+		}
+	}
+
+	pendingChanges.store(false, std::memory_order_release);
+	stats.updateMs = MsSince(start);
+}
+
+double TransformSystem::Benchmark(uint32_t nodeCount, float dirtyFraction, ThreadPool *pool, uint32_t taskCount, uint32_t iterations)
+{
+	if (nodeCount == 0 || iterations == 0)
+	{
+		return 0.0;
+	}
+
+	TransformSystem system;
+	std::mt19937    rng(1234u);
+	std::uniform_real_distribution<float> offset(-1.0f, 1.0f);
+	for (uint32_t i = 0; i < nodeCount; ++i)
+	{
+		const uint32_t node = system.CreateNode();
+		if (i > 0)
+		{
+			system.SetParent(node, (i - 1u) / 4u);
+		}
+		system.SetLocal(node, glm::vec3(offset(rng), offset(rng), offset(rng)),
+		                glm::angleAxis(offset(rng), glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f));
+	}
+	system.Update(pool, taskCount);
+
+	const auto dirtyCount = std::max<uint32_t>(1u, static_cast<uint32_t>(static_cast<float>(nodeCount) * dirtyFraction));
+	std::uniform_int_distribution<uint32_t> pick(0u, nodeCount - 1u);
+	double                                  totalMs = 0.0;
+	for (uint32_t it = 0; it < iterations; ++it)
+	{
+		for (uint32_t d = 0; d < dirtyCount; ++d)
+		{
+			const uint32_t node = dirtyFraction >= 1.0f ? d : pick(rng);
+			system.SetLocal(node, glm::vec3(offset(rng), offset(rng), offset(rng)),
+			                glm::angleAxis(offset(rng), glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(1.0f));
+		}
+		system.Update(pool, taskCount);
+		totalMs += system.GetStats().updateMs;
+	}
+	return totalMs / static_cast<double>(iterations);
+}
@@ -0,0 +1,181 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+class ThreadPool;
+class TransformComponent;
+
+/**
+ * @brief Scene-graph storage for local transforms and batched world-matrix updates.
+ *
+ * Nodes are addressed by stable handles. Their local translation, rotation and
+ * scale live in structure-of-arrays storage ordered by hierarchy depth, so a
+ * single front-to-back sweep always sees a parent before its children. Changing
+ * a node only flags it; Update() then recomputes, level by level, exactly the
+ * nodes that were flagged or whose parent changed, four at a time with SSE2
+ * where available, and optionally split across a thread pool.
+ *
+ * Structural changes (create, destroy, reparent) are cheap and only mark the
+ * depth ordering stale; it is rebuilt once at the start of the next Update().
+ * All public functions are thread-safe.
+ */
+class TransformSystem
+{
+  public:
+	static constexpr uint32_t InvalidNode = UINT32_MAX;
+
+	struct Stats
+	{
+		uint32_t nodes        = 0;
+		uint32_t levels       = 0;
+		uint32_t updatedNodes = 0;        // nodes whose world matrix was recomputed by the last Update
+		double   updateMs     = 0.0;
+		double   reorderMs    = 0.0;        // part of updateMs spent rebuilding the depth ordering
+	};
+
+	/**
+	 * @brief Get the system that TransformComponents attach to when they are added to an entity.
+	 * @return The shared transform system.
+	 */
+	static TransformSystem &GetInstance();
+
+	/**
+	 * @brief Create a root node with an identity local transform.
+	 * @param owner Optional component that receives the node's world matrix after each update.
+	 * @return The node handle.
+	 */
+	uint32_t CreateNode(TransformComponent *owner = nullptr);
+
+	/**
+	 * @brief Destroy a node. Its children become roots and keep their local transforms.
+	 * @param node The node handle.
+	 */
+	void DestroyNode(uint32_t node);
+
+	/**
+	 * @brief Attach a node to a new parent.
+	 * @param node The node handle.
+	 * @param parent The parent handle, or InvalidNode to make the node a root.
+	 * @return False if the parent is unknown or would create a cycle.
+	 */
+	bool SetParent(uint32_t node, uint32_t parent);
+
+	/**
+	 * @brief Get the parent of a node.
+	 * @param node The node handle.
+	 * @return The parent handle, or InvalidNode for roots.
+	 */
+	uint32_t GetParent(uint32_t node) const;
+
+	/**
+	 * @brief Get the component that owns a node.
+	 * @param node The node handle.
+	 * @return The owner passed to CreateNode, or nullptr.
+	 */
+	TransformComponent *GetOwner(uint32_t node) const;
+
+	/**
+	 * @brief Set the local transform of a node and flag it for the next update.
+	 * @param node The node handle.
+	 * @param translation The translation relative to the parent.
+	 * @param rotation The unit rotation relative to the parent.
+	 * @param scale The scale relative to the parent.
+	 */
+	void SetLocal(uint32_t node, const glm::vec3 &translation, const glm::quat &rotation, const glm::vec3 &scale);
+
+	/**
+	 * @brief Compute the current world matrix of a node by walking its ancestors.
+	 * Used to answer reads made between a change and the next Update().
+	 * @param node The node handle.
+	 * @return The world matrix.
+	 */
+	glm::mat4 ComputeWorldMatrix(uint32_t node) const;
+
+	/**
+	 * @brief Get the world matrix produced by the last Update().
+	 * @param node The node handle.
+	 * @return The world matrix.
+	 */
+	glm::mat4 GetWorldMatrix(uint32_t node) const;
+
+	/**
+	 * @brief Check whether any node changed since the last Update().
+	 * @return True if world matrices are stale.
+	 */
+	bool HasPendingChanges() const
+	{
+		return pendingChanges.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief Recompute the world matrices of all changed nodes and their descendants.
+	 * @param pool Optional pool used to split large depth levels.
+	 * @param taskCount Number of tasks a large level is split into.
+	 */
+	void Update(ThreadPool *pool = nullptr, uint32_t taskCount = 1);
+
+	/**
+	 * @brief Get statistics from the last Update().
+	 * @return The statistics.
+	 */
+	Stats GetStats() const;
+
+	/**
+	 * @brief Time Update() on a synthetic hierarchy.
+	 * Builds a four-way tree of nodeCount nodes, then repeatedly changes a random
+	 * dirtyFraction of them and updates.
+	 * @return Average milliseconds per Update().
+	 */
+	static double Benchmark(uint32_t nodeCount, float dirtyFraction, ThreadPool *pool, uint32_t taskCount, uint32_t iterations = 16);
+
+  private:
+	// Indexed by handle
+	std::vector<uint32_t>             slotOf;        // InvalidNode for free handles
+	std::vector<uint32_t>             parentOf;
+	std::vector<TransformComponent *> ownerOf;
+	std::vector<uint32_t>             childCount;        // lets DestroyNode skip the orphan scan for leaves
+	std::vector<uint32_t>             freeHandles;
+
+	// Indexed by slot, ordered by depth once the ordering is up to date
+	std::vector<uint32_t>  handleAt;        // InvalidNode for destroyed nodes awaiting compaction
+	std::vector<uint32_t>  parentSlot;
+	std::vector<float>     tx, ty, tz;
+	std::vector<float>     qx, qy, qz, qw;
+	std::vector<float>     sx, sy, sz;
+	std::vector<uint8_t>   localDirty;
+	std::vector<uint8_t>   worldChanged;
+	std::vector<glm::mat4> world;
+	std::vector<uint32_t>  levelOffsets;        // slot range of each depth level, plus the end
+
+	bool               orderDirty = false;
+	std::atomic<bool>  pendingChanges{false};
+	Stats              stats;
+	mutable std::mutex mutex;
+
+	void      RebuildOrder();
+	uint32_t  UpdateRange(uint32_t begin, uint32_t end);
+	glm::mat4 ComputeWorldLocked(uint32_t node) const;
+	glm::mat4 LocalMatrix(uint32_t slot) const;
+};
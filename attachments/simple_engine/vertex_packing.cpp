@@ -0,0 +1,266 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "vertex_packing.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+constexpr float SnormScale = 32767.0f;
+constexpr float HalfMax    = 65504.0f;
+
+float SignNotZero(float v)
+{
+	return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+// Project a unit vector onto the octahedron and unfold it into [-1, 1]^2
+glm::vec2 OctEncode(const glm::vec3 &v)
+{
+	const float l1 = std::abs(v.x) + std::abs(v.y) + std::abs(v.z);
+	if (l1 <= 0.0f)
+	{
+		return glm::vec2(0.0f);
+	}
+	glm::vec2 p(v.x / l1, v.y / l1);
+	if (v.z < 0.0f)
+	{
+		p = glm::vec2((1.0f - std::abs(p.y)) * SignNotZero(p.x), (1.0f - std::abs(p.x)) * SignNotZero(p.y));
+	}
+	return p;
+}
+
+// Inverse of OctEncode; matches octDecode in shaders/vertex_packing.slang
+glm::vec3 OctDecode(const glm::vec2 &e)
+{
+	glm::vec3   n(e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y));
+	const float t = std::max(-n.z, 0.0f);
+	n.x += n.x >= 0.0f ? -t : t;
+	n.y += n.y >= 0.0f ? -t : t;
+	return glm::normalize(n);
+}
+
+float SnormToFloat(int32_t value)
+{
+	return std::max(static_cast<float>(value) / SnormScale, -1.0f);
+}
+
+uint32_t PackInt16Pair(int32_t x, int32_t y)
+{
+	return static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(x))) | (static_cast<uint32_t>(static_cast<uint16_t>(static_cast<int16_t>(y))) << 16);
+}
+
+int32_t LowInt16(uint32_t packed)
+{
+	return static_cast<int16_t>(static_cast<uint16_t>(packed & 0xFFFFu));
+}
+
+int32_t HighInt16(uint32_t packed)
+{
+	return static_cast<int16_t>(static_cast<uint16_t>(packed >> 16));
+}
+
+/**
+ * Quantize octahedral coordinates, trying the floor and ceiling of each one.
+ * With evenY only even values are used for y, which leaves its lowest bit free.
+ */
+void QuantizeOct(const glm::vec3 &v, bool evenY, int32_t &outX, int32_t &outY)
+{
+	const glm::vec2 p    = OctEncode(v);
+	const float     yDiv = evenY ? 2.0f : 1.0f;
+	const float     fx   = std::clamp(p.x, -1.0f, 1.0f) * SnormScale;
+	const float     fy   = std::clamp(p.y, -1.0f, 1.0f) * SnormScale / yDiv;
+	const int32_t   yMax = evenY ? 32766 : 32767;
+
+	float best = -2.0f;
+	outX = outY = 0;
+	for (float cx : {std::floor(fx), std::ceil(fx)})
+	{
+		for (float cy : {std::floor(fy), std::ceil(fy)})
+		{
+			const int32_t qx = std::clamp(static_cast<int32_t>(cx), -32767, 32767);
+			const int32_t qy = std::clamp(static_cast<int32_t>(cy * yDiv), -32767 - (evenY ? 1 : 0), yMax);
+			const float   d  = glm::dot(OctDecode(glm::vec2(SnormToFloat(qx), SnormToFloat(qy))), v);
+			if (d > best)
+			{
+				best = d;
+				outX = qx;
+				outY = qy;
+			}
+		}
+	}
+}
+
+// atan2 of cross and dot in double precision; acos of a float dot cannot resolve the small angles measured here
+double AngleDeg(const glm::vec3 &a, const glm::vec3 &b)
+{
+	const double ax = a.x, ay = a.y, az = a.z;
+	const double bx = b.x, by = b.y, bz = b.z;
+	const double cx = ay * bz - az * by;
+	const double cy = az * bx - ax * bz;
+	const double cz = ax * by - ay * bx;
+	return std::atan2(std::sqrt(cx * cx + cy * cy + cz * cz), ax * bx + ay * by + az * bz) * 57.29577951308232;
+}
+}        // namespace
+
+namespace VertexPacking
+{
+uint32_t EncodeNormal(const glm::vec3 &normal)
+{
+	const float len = glm::length(normal);
+	if (len <= 0.0f)
+	{
+		return PackInt16Pair(0, 0);
+	}
+	int32_t x;
+	int32_t y;
+	QuantizeOct(normal / len, false, x, y);
+	return PackInt16Pair(x, y);
+}
+
+glm::vec3 DecodeNormal(uint32_t encoded)
+{
+	return OctDecode(glm::vec2(SnormToFloat(LowInt16(encoded)), SnormToFloat(HighInt16(encoded))));
+}
+
+uint32_t EncodeTangent(const glm::vec4 &tangent)
+{
+	const glm::vec3 t(tangent);
+	const float     len = glm::length(t);
+	int32_t         x   = 0;
+	int32_t         y   = 0;
+	if (len > 0.0f)
+	{
+		QuantizeOct(t / len, true, x, y);
+	}
+	return PackInt16Pair(x, y) | (tangent.w < 0.0f ? 0x10000u : 0u);
+}
+
+glm::vec4 DecodeTangent(uint32_t encoded)
+{
+	const glm::vec3 t = OctDecode(glm::vec2(SnormToFloat(LowInt16(encoded)), SnormToFloat(HighInt16(encoded & ~0x10000u))));
+	return glm::vec4(t, (encoded & 0x10000u) ? -1.0f : 1.0f);
+}
+
+uint32_t EncodeTexCoord(const glm::vec2 &texCoord)
+{
+	return glm::packHalf2x16(glm::clamp(texCoord, glm::vec2(-HalfMax), glm::vec2(HalfMax)));
+}
+
+glm::vec2 DecodeTexCoord(uint32_t encoded)
+{
+	return glm::unpackHalf2x16(encoded);
+}
+
+PackedVertex Pack(const Vertex &vertex)
+{
+	return PackedVertex{
+	    .position = vertex.position,
+	    .normal   = EncodeNormal(vertex.normal),
+	    .tangent  = EncodeTangent(vertex.tangent),
+	    .texCoord = EncodeTexCoord(vertex.texCoord)};
+}
+
+Vertex Unpack(const PackedVertex &vertex)
+{
+	return Vertex{
+	    .position = vertex.position,
+	    .normal   = DecodeNormal(vertex.normal),
+	    .texCoord = DecodeTexCoord(vertex.texCoord),
+	    .tangent  = DecodeTangent(vertex.tangent)};
+}
+
+void PackVertices(const std::vector<Vertex> &vertices, std::vector<PackedVertex> &out)
+{
+	out.resize(vertices.size());
+	std::transform(vertices.begin(), vertices.end(), out.begin(), Pack);
+}
+
+void ErrorStats::Merge(const ErrorStats &other)
+{
+	const size_t total = vertices + other.vertices;
+	if (total == 0)
+	{
+		return;
+	}
+	const auto mergeMean = [&](double a, double b) {
+		return (a * static_cast<double>(vertices) + b * static_cast<double>(other.vertices)) / static_cast<double>(total);
+	};
+	meanNormalDeg     = mergeMean(meanNormalDeg, other.meanNormalDeg);
+	meanTangentDeg    = mergeMean(meanTangentDeg, other.meanTangentDeg);
+	meanTexCoordError = mergeMean(meanTexCoordError, other.meanTexCoordError);
+	maxNormalDeg      = std::max(maxNormalDeg, other.maxNormalDeg);
+	maxTangentDeg     = std::max(maxTangentDeg, other.maxTangentDeg);
+	maxTexCoordError  = std::max(maxTexCoordError, other.maxTexCoordError);
+	signFlips += other.signFlips;
+	texCoordOverflow += other.texCoordOverflow;
+	vertices = total;
+}
+
+ErrorStats MeasureError(const std::vector<Vertex> &vertices)
+{
+	ErrorStats stats;
+	if (vertices.empty())
+	{
+		return stats;
+	}
+	stats.vertices = vertices.size();
+
+	// Zero-length source vectors have no direction to preserve and are not measured
+	size_t normalCount  = 0;
+	size_t tangentCount = 0;
+	for (const Vertex &v : vertices)
+	{
+		const Vertex decoded = Unpack(Pack(v));
+
+		if (glm::length(v.normal) > 0.0f)
+		{
+			const double angle = AngleDeg(glm::normalize(v.normal), decoded.normal);
+			stats.maxNormalDeg = std::max(stats.maxNormalDeg, angle);
+			stats.meanNormalDeg += angle;
+			normalCount++;
+		}
+
+		const glm::vec3 tangent(v.tangent);
+		if (glm::length(tangent) > 0.0f)
+		{
+			const double angle  = AngleDeg(glm::normalize(tangent), glm::vec3(decoded.tangent));
+			stats.maxTangentDeg = std::max(stats.maxTangentDeg, angle);
+			stats.meanTangentDeg += angle;
+			tangentCount++;
+		}
+		if ((v.tangent.w < 0.0f) != (decoded.tangent.w < 0.0f))
+		{
+			stats.signFlips++;
+		}
+
+		if (std::abs(v.texCoord.x) > HalfMax || std::abs(v.texCoord.y) > HalfMax)
+		{
+			stats.texCoordOverflow++;
+		}
+		const double uvError = std::max(std::abs(static_cast<double>(v.texCoord.x - decoded.texCoord.x)), std::abs(static_cast<double>(v.texCoord.y - decoded.texCoord.y)));
+		stats.maxTexCoordError = std::max(stats.maxTexCoordError, uvError);
+		stats.meanTexCoordError += uvError;
+	}
+
+	stats.meanNormalDeg     = normalCount > 0 ? stats.meanNormalDeg / static_cast<double>(normalCount) : 0.0;
+	stats.meanTangentDeg    = tangentCount > 0 ? stats.meanTangentDeg / static_cast<double>(tangentCount) : 0.0;
+	stats.meanTexCoordError = stats.meanTexCoordError / static_cast<double>(vertices.size());
+	return stats;
+}
+}        // namespace VertexPacking
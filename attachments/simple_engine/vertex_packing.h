@@ -0,0 +1,127 @@
+/* Copyright (c) 2025 Holochip Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 the "License";
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+#include <vulkan/vulkan.hpp>
+
+#include "mesh_component.h"
+
+/**
+ * @brief Compact GPU vertex, half the size of Vertex.
+ *
+ * The position stays 32-bit float: it is also the BLAS build input, and
+ * exact positions keep raster depth and ray hits identical to the unpacked
+ * format. The other attributes are quantized:
+ * - normal: octahedral encoding, two snorm16 values;
+ * - tangent: octahedral encoding, two snorm16 values, with the bitangent
+ *   sign in the lowest bit of the second one;
+ * - texCoord: two half floats.
+ *
+ * The three packed words are fetched as R32_UINT attributes and decoded by
+ * the functions in shaders/vertex_packing.slang, which ray_query.slang also
+ * uses to read vertices through buffer device addresses.
+ */
+struct PackedVertex
+{
+	glm::vec3 position;
+	uint32_t  normal;
+	uint32_t  tangent;
+	uint32_t  texCoord;
+
+	static vk::VertexInputBindingDescription getBindingDescription()
+	{
+		return {0, sizeof(PackedVertex), vk::VertexInputRate::eVertex};
+	}
+
+	// Same locations as Vertex: 0 position, 1 normal, 2 texCoord, 3 tangent
+	static std::array<vk::VertexInputAttributeDescription, 4> getAttributeDescriptions()
+	{
+		return {
+		    vk::VertexInputAttributeDescription{.location = 0, .binding = 0, .format = vk::Format::eR32G32B32Sfloat, .offset = offsetof(PackedVertex, position)},
+		    vk::VertexInputAttributeDescription{.location = 1, .binding = 0, .format = vk::Format::eR32Uint, .offset = offsetof(PackedVertex, normal)},
+		    vk::VertexInputAttributeDescription{.location = 2, .binding = 0, .format = vk::Format::eR32Uint, .offset = offsetof(PackedVertex, texCoord)},
+		    vk::VertexInputAttributeDescription{.location = 3, .binding = 0, .format = vk::Format::eR32Uint, .offset = offsetof(PackedVertex, tangent)}};
+	}
+};
+
+static_assert(sizeof(PackedVertex) == 24, "PackedVertex must match the 6-word layout decoded by the shaders");
+static_assert(offsetof(PackedVertex, position) == offsetof(Vertex, position), "BLAS builds read positions at the same offset in both formats");
+
+namespace VertexPacking
+{
+/**
+ * @brief Encode a unit vector as two snorm16 octahedral coordinates.
+ * Of the four neighbouring quantized points, the one that decodes closest to
+ * the input is chosen.
+ */
+uint32_t  EncodeNormal(const glm::vec3 &normal);
+glm::vec3 DecodeNormal(uint32_t encoded);
+
+/**
+ * @brief Encode a tangent; w < 0 is stored as a set lowest bit of the second coordinate.
+ */
+uint32_t  EncodeTangent(const glm::vec4 &tangent);
+glm::vec4 DecodeTangent(uint32_t encoded);
+
+uint32_t  EncodeTexCoord(const glm::vec2 &texCoord);
+glm::vec2 DecodeTexCoord(uint32_t encoded);
+
+PackedVertex Pack(const Vertex &vertex);
+Vertex       Unpack(const PackedVertex &vertex);
+
+/**
+ * @brief Convert vertices to the packed format.
+ * @param vertices Source vertices.
+ * @param out Receives one packed vertex per source vertex.
+ */
+void PackVertices(const std::vector<Vertex> &vertices, std::vector<PackedVertex> &out);
+
+/**
+ * @brief Round-trip error of packing a set of vertices.
+ * Angles are in degrees, texture coordinate errors in UV units.
+ */
+struct ErrorStats
+{
+	size_t   vertices          = 0;
+	double   maxNormalDeg      = 0.0;
+	double   meanNormalDeg     = 0.0;
+	double   maxTangentDeg     = 0.0;
+	double   meanTangentDeg    = 0.0;
+	double   maxTexCoordError  = 0.0;
+	double   meanTexCoordError = 0.0;
+	uint32_t signFlips         = 0;        // tangents whose bitangent sign changed
+	uint32_t texCoordOverflow  = 0;        // texture coordinates outside the half-float range
+
+	/**
+	 * @brief Combine the statistics of another vertex set.
+	 */
+	void Merge(const ErrorStats &other);
+};
+
+/**
+ * @brief Measure the round-trip error of packing vertices.
+ * @param vertices The vertices.
+ * @return The statistics; all zero for an empty set.
+ */
+ErrorStats MeasureError(const std::vector<Vertex> &vertices);
+}        // namespace VertexPacking